@@ -37,6 +37,10 @@ func (w *smbClientWrapper) OpenFile(remotePath string) (io.ReadCloser, error) {
 	return w.client.OpenFile(remotePath)
 }
 
+func (w *smbClientWrapper) OpenFileAt(ctx context.Context, remotePath string) (cloudfiles.RemoteFile, error) {
+	return w.client.OpenFileAt(ctx, remotePath)
+}
+
 func (w *smbClientWrapper) ReadFile(remotePath string) ([]byte, error) {
 	return w.client.ReadFile(remotePath)
 }
@@ -37,6 +37,7 @@ func convertDBJobToAppJob(dbJob *database.SyncJob) *SyncJob {
 		SyncOnStartup:     opts.SyncOnStartup,
 		FilesOnDemand:     opts.FilesOnDemand,
 		AutoDehydrateDays: opts.AutoDehydrateDays,
+		PartialPopulation: opts.PartialPopulation,
 		TrustSource:       opts.TrustSource,
 		FirstSyncDone:     opts.FirstSyncDone,
 	}
@@ -62,6 +63,7 @@ func convertAppJobToDBJob(job *SyncJob) *database.SyncJob {
 		SyncOnStartup:     job.SyncOnStartup,
 		FilesOnDemand:     job.FilesOnDemand,
 		AutoDehydrateDays: job.AutoDehydrateDays,
+		PartialPopulation: job.PartialPopulation,
 		TrustSource:       job.TrustSource,
 		FirstSyncDone:     job.FirstSyncDone,
 	}
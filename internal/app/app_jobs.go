@@ -93,6 +93,13 @@ func (a *App) DeleteSyncJob(id int64) error {
 		a.watcher.UnwatchJob(id)
 	}
 
+	// Disconnect its Files On Demand provider, which drops its manifest index
+	if a.syncManager != nil {
+		if err := a.syncManager.CloseProvider(id); err != nil {
+			a.logger.Warn("Failed to close provider of deleted job", zap.Error(err))
+		}
+	}
+
 	// Delete from database
 	if a.db != nil {
 		if err := a.db.DeleteSyncJob(id); err != nil {
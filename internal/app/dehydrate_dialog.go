@@ -28,11 +28,17 @@ type DehydrateDialog struct {
 	fileCountLabel *widget.Label
 	dehydrateBtn   *widget.Button
 	refreshBtn     *widget.Button
+	stopBtn        *widget.Button
+	progressBar    *widget.ProgressBar
+	progressLabel  *widget.Label
 
 	// Data
 	files         []cloudfiles.HydratedFileInfo
 	filteredFiles []cloudfiles.HydratedFileInfo
 	minDays       int
+
+	// Cancels the dehydration pass in progress, nil when idle
+	stopPass func()
 }
 
 // ShowDehydrateDialog displays the dehydration dialog for a job.
@@ -112,6 +118,10 @@ func (d *DehydrateDialog) show() {
 	d.dehydrateBtn = widget.NewButton("Free Up Space", d.onDehydrate)
 	d.dehydrateBtn.Importance = widget.HighImportance
 
+	d.stopBtn = widget.NewButton("Stop", d.onStop)
+	d.stopBtn.Importance = widget.DangerImportance
+	d.stopBtn.Hide()
+
 	cancelBtn := widget.NewButton("Close", func() {
 		d.window.Close()
 	})
@@ -120,9 +130,16 @@ func (d *DehydrateDialog) show() {
 		d.refreshBtn,
 		container.NewHBox(), // spacer
 		cancelBtn,
+		d.stopBtn,
 		d.dehydrateBtn,
 	)
 
+	// Pass progress, shown while dehydrating
+	d.progressBar = widget.NewProgressBar()
+	d.progressBar.Hide()
+	d.progressLabel = widget.NewLabel("")
+	d.progressLabel.Hide()
+
 	// Layout
 	content := container.NewBorder(
 		container.NewVBox(
@@ -133,6 +150,8 @@ func (d *DehydrateDialog) show() {
 		container.NewVBox(
 			widget.NewSeparator(),
 			statsContainer,
+			d.progressBar,
+			d.progressLabel,
 			buttonContainer,
 		),
 		nil, nil,
@@ -141,6 +160,9 @@ func (d *DehydrateDialog) show() {
 
 	d.window.SetContent(content)
 
+	// Closing the window stops the pass
+	d.window.SetOnClosed(d.onStop)
+
 	// Initial scan
 	d.refresh()
 
@@ -259,6 +281,57 @@ func (d *DehydrateDialog) onDehydrate() {
 	}, d.window)
 }
 
+func (d *DehydrateDialog) onStop() {
+	if d.stopPass != nil {
+		d.stopBtn.Disable()
+		d.stopPass()
+	}
+}
+
+// showProgress switches between the pass progress and the idle buttons.
+func (d *DehydrateDialog) showProgress(running bool) {
+	if running {
+		d.progressBar.SetValue(0)
+		d.progressLabel.SetText("Starting...")
+		d.progressBar.Show()
+		d.progressLabel.Show()
+		d.stopBtn.Enable()
+		d.stopBtn.Show()
+		return
+	}
+	d.progressBar.Hide()
+	d.progressLabel.Hide()
+	d.stopBtn.Hide()
+}
+
+// watchProgress shows the pass progress from the manager stats until done is closed.
+func (d *DehydrateDialog) watchProgress(dm *cloudfiles.DehydrationManager, done <-chan struct{}) {
+	skippedBefore := dm.GetStats().FilesSkipped
+
+	ticker := time.NewTicker(250 * time.Millisecond)
+	defer ticker.Stop()
+	for {
+		select {
+		case <-done:
+			return
+		case <-ticker.C:
+		}
+
+		stats := dm.GetStats()
+		if !stats.PassRunning || stats.PassTotal == 0 {
+			continue
+		}
+		fyne.Do(func() {
+			d.progressBar.SetValue(float64(stats.PassDone) / float64(stats.PassTotal))
+			text := fmt.Sprintf("%d / %d files", stats.PassDone, stats.PassTotal)
+			if skipped := stats.FilesSkipped - skippedBefore; skipped > 0 {
+				text += fmt.Sprintf(" (%d in use, skipped)", skipped)
+			}
+			d.progressLabel.SetText(text)
+		})
+	}
+}
+
 func (d *DehydrateDialog) doDehydrate() {
 	d.dehydrateBtn.Disable()
 	d.refreshBtn.Disable()
@@ -285,29 +358,45 @@ func (d *DehydrateDialog) doDehydrate() {
 			return
 		}
 
-		ctx := context.Background()
-		successCount := 0
-		var bytesFreed int64
-		var lastErr error
-
-		for _, file := range filesToDehydrate {
-			if err := dm.DehydrateFile(ctx, file.Path); err != nil {
-				lastErr = err
-				d.app.Logger().Warn("Failed to dehydrate file: " + file.Path + ": " + err.Error())
-				continue
-			}
-			successCount++
-			bytesFreed += file.Size
+		ctx, cancel := context.WithCancel(context.Background())
+		defer cancel()
+		stopped := false
+		stop := func() {
+			stopped = true
+			cancel()
+			dm.CancelDehydration()
 		}
+		fyne.Do(func() {
+			d.stopPass = stop
+			d.showProgress(true)
+		})
+
+		done := make(chan struct{})
+		go d.watchProgress(dm, done)
+
+		// Dehydrate in parallel; files in use are skipped
+		result := dm.DehydrateFiles(ctx, filesToDehydrate)
+		close(done)
+		successCount := result.Dehydrated
+		bytesFreed := result.BytesFreed
+		lastErr := result.LastError
 
 		fyne.Do(func() {
+			d.stopPass = nil
+			d.showProgress(false)
 			d.refreshBtn.Enable()
 
 			if successCount > 0 {
 				msg := fmt.Sprintf("Freed %s from %d files", cloudfiles.FormatBytes(bytesFreed), successCount)
+				if stopped {
+					msg = "Stopped. " + msg
+				}
 				if lastErr != nil {
 					msg += fmt.Sprintf("\n\nSome files failed: %v", lastErr)
 				}
+				if result.Skipped > 0 {
+					msg += fmt.Sprintf("\n\n%d files in use were skipped", result.Skipped)
+				}
 				dialog.ShowInformation("Complete", msg, d.window)
 			} else if lastErr != nil {
 				dialog.ShowError(fmt.Errorf("Failed to dehydrate files: %w", lastErr), d.window)
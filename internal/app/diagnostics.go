@@ -0,0 +1,120 @@
+package app
+
+import (
+	"fmt"
+	"strings"
+	"time"
+
+	"fyne.io/fyne/v2"
+	"fyne.io/fyne/v2/container"
+	"fyne.io/fyne/v2/theme"
+	"fyne.io/fyne/v2/widget"
+	"github.com/juste-un-gars/anemone_sync_windows/internal/cloudfiles"
+)
+
+// diagnosticsTraceEvents is the number of recent bridge trace events shown.
+const diagnosticsTraceEvents = 50
+
+// createDiagnosticsTab creates the Files On Demand diagnostics tab, showing
+// where hydration latency goes (bridge hot-path histograms) and the most
+// recent bridge trace events.
+func (sw *SettingsWindow) createDiagnosticsTab() fyne.CanvasObject {
+	stats := widget.NewLabel("")
+	stats.TextStyle = fyne.TextStyle{Monospace: true}
+	trace := widget.NewLabel("")
+	trace.TextStyle = fyne.TextStyle{Monospace: true}
+
+	refresh := func() {
+		stats.SetText(formatBridgeStats(cloudfiles.GetBridgeStats()))
+		trace.SetText(formatBridgeTrace(cloudfiles.GetBridgeTrace(), diagnosticsTraceEvents))
+	}
+	refresh()
+
+	refreshBtn := widget.NewButtonWithIcon("Refresh", theme.ViewRefreshIcon(), refresh)
+	resetBtn := widget.NewButtonWithIcon("Reset", theme.ContentClearIcon(), func() {
+		cloudfiles.ResetBridgeStats()
+		refresh()
+	})
+
+	content := container.NewVBox(
+		widget.NewLabel("Files On Demand - hydration latency"),
+		container.NewHBox(refreshBtn, resetBtn),
+		widget.NewSeparator(),
+		stats,
+		widget.NewSeparator(),
+		widget.NewLabel("Recent bridge events"),
+		trace,
+	)
+
+	return container.NewVScroll(content)
+}
+
+// formatBridgeStats renders the bridge statistics as a fixed-width table.
+func formatBridgeStats(s cloudfiles.BridgeStats) string {
+	var b strings.Builder
+
+	fmt.Fprintf(&b, "%-18s %8s %9s %9s %9s %9s\n", "Stage", "Count", "Mean", "p50", "p99", "Max")
+	stages := []struct {
+		name string
+		hist cloudfiles.LatencyHistogram
+	}{
+		{"Callback->queue", s.CallbackEnqueue},
+		{"Queue wait", s.QueueWait},
+		{"Dispatch", s.Dispatch},
+		{"SMB first byte", s.FirstByte},
+		{"CfExecute", s.CfExecute},
+		{"Hydration", s.Hydration},
+	}
+	for _, st := range stages {
+		h := st.hist
+		fmt.Fprintf(&b, "%-18s %8d %9s %9s %9s %9s\n", st.name, h.Count,
+			formatLatency(h.Mean()), formatLatency(h.Quantile(0.5)),
+			formatLatency(h.Quantile(0.99)), formatLatency(h.Max))
+	}
+
+	fmt.Fprintf(&b, "\n%-18s %8s\n", "Callback", "Count")
+	counters := []struct {
+		name  string
+		count int64
+	}{
+		{"FETCH_DATA", s.Callbacks.FetchData},
+		{"CANCEL_FETCH", s.Callbacks.CancelFetch},
+		{"NOTIFY_DELETE", s.Callbacks.NotifyDelete},
+		{"NOTIFY_RENAME", s.Callbacks.NotifyRename},
+	}
+	for _, c := range counters {
+		fmt.Fprintf(&b, "%-18s %8d\n", c.name, c.count)
+	}
+	fmt.Fprintf(&b, "\n%-18s %s\n", "Transferred", formatBytes(s.TransferredBytes))
+
+	return b.String()
+}
+
+// formatBridgeTrace renders the last max trace events, newest last.
+func formatBridgeTrace(events []cloudfiles.BridgeTraceEvent, max int) string {
+	if len(events) == 0 {
+		return "(no events)"
+	}
+	if len(events) > max {
+		events = events[len(events)-max:]
+	}
+	lines := make([]string, len(events))
+	for i, e := range events {
+		lines[i] = e.String()
+	}
+	return strings.Join(lines, "\n")
+}
+
+// formatLatency formats a duration with a unit suited to its magnitude.
+func formatLatency(d time.Duration) string {
+	switch {
+	case d == 0:
+		return "-"
+	case d < time.Millisecond:
+		return fmt.Sprintf("%dus", d/time.Microsecond)
+	case d < time.Second:
+		return fmt.Sprintf("%.1fms", float64(d)/float64(time.Millisecond))
+	default:
+		return fmt.Sprintf("%.2fs", d.Seconds())
+	}
+}
@@ -263,7 +263,7 @@ func (a *FirstSyncAnalyzer) compareFiles(path string, local, remote *cache.FileI
 	} else if local != nil && remote != nil {
 		// Both exist - check if same
 		if local.Size == remote.Size {
-			if local.Hash != "" && remote.Hash != "" {
+			if cache.HashesComparable(local.Hash, remote.Hash) {
 				if local.Hash == remote.Hash {
 					diff.Type = DiffTypeSame
 				} else {
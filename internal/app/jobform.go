@@ -30,6 +30,7 @@ type JobForm struct {
 	// Files On Demand
 	filesOnDemandCheck      *widget.Check
 	autoDehydrateDaysSelect *widget.Select
+	partialPopulationCheck  *widget.Check
 
 	// SMB connections and shares
 	smbConnections  []*SMBConnection
@@ -175,6 +176,10 @@ func (jf *JobForm) createFields() {
 		"After 90 days",
 	}, nil)
 	jf.autoDehydrateDaysSelect.SetSelectedIndex(jf.autoDehydrateDaysToIndex(jf.job.AutoDehydrateDays))
+
+	// Lazy folder population for very large shares
+	jf.partialPopulationCheck = widget.NewCheck("Load folder contents when first opened (large shares)", nil)
+	jf.partialPopulationCheck.SetChecked(jf.job.PartialPopulation)
 }
 
 // Show displays the form dialog.
@@ -263,6 +268,7 @@ func (jf *JobForm) Show(parent fyne.Window) {
 				jf.autoDehydrateDaysSelect,
 			),
 		),
+		jf.partialPopulationCheck,
 	)
 
 	scroll := container.NewVScroll(form)
@@ -336,6 +342,7 @@ func (jf *JobForm) saveJob(parent fyne.Window) {
 	jf.job.SyncOnStartup = jf.syncOnStartupCheck.Checked
 	jf.job.FilesOnDemand = jf.filesOnDemandCheck.Checked
 	jf.job.AutoDehydrateDays = jf.indexToAutoDehydrateDays(jf.autoDehydrateDaysSelect.SelectedIndex())
+	jf.job.PartialPopulation = jf.partialPopulationCheck.Checked
 
 	// Save job first
 	var err error
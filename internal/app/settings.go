@@ -48,6 +48,7 @@ func (sw *SettingsWindow) Show() {
 		container.NewTabItemWithIcon("SMB Servers", theme.ComputerIcon(), sw.createSMBTab()),
 		container.NewTabItemWithIcon("Sync Jobs", theme.FolderIcon(), sw.createJobsTab()),
 		container.NewTabItemWithIcon("General", theme.SettingsIcon(), sw.createGeneralTab()),
+		container.NewTabItemWithIcon("Diagnostics", theme.InfoIcon(), sw.createDiagnosticsTab()),
 		container.NewTabItemWithIcon("About", theme.InfoIcon(), sw.createAboutTab()),
 	)
 	tabs.SetTabLocation(container.TabLocationLeading)
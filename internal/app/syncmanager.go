@@ -65,6 +65,7 @@ func createDefaultConfig() *config.Config {
 				ParallelTransfers: 4,
 				BufferSizeMB:      8,
 				HashAlgorithm:     "sha256",
+				DeltaMinSizeMB:    0, // Opt-in: remote files are rewritten in place
 			},
 		},
 		Logging: config.LoggingConfig{
@@ -144,6 +145,7 @@ func (m *SyncManager) ExecuteSync(job *SyncJob) error {
 		} else {
 			// Set placeholder callback
 			req.PlaceholderCallback = m.createPlaceholderCallback(provider, job)
+			req.RemoteChangeCallback = m.createRemoteChangeCallback(provider)
 		}
 	}
 
@@ -439,6 +441,7 @@ func (m *SyncManager) ExecuteSyncAndWait(ctx context.Context, job *SyncJob) erro
 		} else {
 			// Set placeholder callback
 			req.PlaceholderCallback = m.createPlaceholderCallback(provider, job)
+			req.RemoteChangeCallback = m.createRemoteChangeCallback(provider)
 		}
 	}
 
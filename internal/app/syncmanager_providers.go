@@ -5,8 +5,11 @@ import (
 	"context"
 	"fmt"
 	"io"
+	"os"
+	"path"
 	"path/filepath"
 	"strings"
+	"sync"
 	"time"
 
 	"github.com/juste-un-gars/anemone_sync_windows/internal/cloudfiles"
@@ -20,15 +23,19 @@ type smbClientWrapper struct {
 	client *smb.SMBClient
 }
 
-func (w *smbClientWrapper) OpenFile(remotePath string) (io.ReadCloser, error) {
+func (w *smbClientWrapper) OpenFile(ctx context.Context, remotePath string) (io.ReadCloser, error) {
 	return w.client.OpenFile(remotePath)
 }
 
-func (w *smbClientWrapper) ReadFile(remotePath string) ([]byte, error) {
+func (w *smbClientWrapper) OpenFileAt(ctx context.Context, remotePath string) (cloudfiles.RemoteFile, error) {
+	return w.client.OpenFileAt(ctx, remotePath)
+}
+
+func (w *smbClientWrapper) ReadFile(ctx context.Context, remotePath string) ([]byte, error) {
 	return w.client.ReadFile(remotePath)
 }
 
-func (w *smbClientWrapper) ListRemote(remotePath string) ([]cloudfiles.SMBRemoteFileInfo, error) {
+func (w *smbClientWrapper) ListRemote(ctx context.Context, remotePath string) ([]cloudfiles.SMBRemoteFileInfo, error) {
 	files, err := w.client.ListRemote(remotePath)
 	if err != nil {
 		return nil, err
@@ -81,6 +88,7 @@ func (m *SyncManager) getOrCreateProvider(job *SyncJob) (*cloudfiles.CloudFilesP
 		ProviderName: "AnemoneSync",
 		Logger:       m.logger.Named("cloudfiles"),
 		UseCGOBridge: true, // Enable CGO bridge for proper hydration callbacks
+		Population:   cloudfiles.PopulationConfig{Partial: job.PartialPopulation},
 	}
 
 	// Create provider
@@ -104,6 +112,7 @@ func (m *SyncManager) getOrCreateProvider(job *SyncJob) (*cloudfiles.CloudFilesP
 	if err := provider.Initialize(m.ctx); err != nil {
 		return nil, fmt.Errorf("failed to initialize provider: %w", err)
 	}
+	provider.SetNotifyBatchCallback(m.createLocalChangeCallback(provider, job))
 
 	// Configure auto-dehydration if enabled
 	if job.AutoDehydrateDays > 0 {
@@ -124,7 +133,10 @@ func (m *SyncManager) getOrCreateProvider(job *SyncJob) (*cloudfiles.CloudFilesP
 
 	// IMPORTANT: Populate placeholders immediately so the folder is browsable.
 	// Without this, Windows can't display the folder contents.
-	go m.populatePlaceholdersAsync(provider, job)
+	// With partial population, Windows asks for each folder when it is opened.
+	if !provider.PartialPopulation() {
+		go m.populatePlaceholdersAsync(provider, job, dataSource)
+	}
 
 	return provider, nil
 }
@@ -132,65 +144,83 @@ func (m *SyncManager) getOrCreateProvider(job *SyncJob) (*cloudfiles.CloudFilesP
 // populatePlaceholdersAsync populates placeholders in the background.
 // This is called after provider initialization to make the folder browsable.
 // It tries the manifest first (instant), then falls back to full SMB scan.
-func (m *SyncManager) populatePlaceholdersAsync(provider *cloudfiles.CloudFilesProvider, job *SyncJob) {
+// The manifest index then serves the file versions of hydrations from
+// dataSource (if not nil) for the provider's lifetime.
+func (m *SyncManager) populatePlaceholdersAsync(provider *cloudfiles.CloudFilesProvider, job *SyncJob, dataSource *pooledSMBDataSource) {
 	m.logger.Info("Populating placeholders for Cloud Files provider",
 		zap.String("job", job.Name),
 		zap.String("local_path", job.LocalPath),
 	)
 
 	// Try manifest first (much faster than full SMB scan)
-	remoteFiles, err := m.populateFromManifest(job)
+	manifest, indexPath, err := m.populateFromManifest(job)
 	if err != nil {
 		m.logger.Info("Manifest not available, falling back to SMB scan",
 			zap.String("reason", err.Error()),
 		)
-		// Fallback to full SMB scan
-		remoteFiles, err = m.populateFromSMBScan(job)
+		// Fallback to full SMB scan, creating placeholders as it lists
+		count, err := m.populateFromSMBScan(provider, job)
 		if err != nil {
-			m.logger.Error("Failed to list remote files for placeholder population",
+			m.logger.Error("Failed to populate placeholders from SMB scan",
+				zap.Int("created", count),
 				zap.Error(err),
 			)
 			return
 		}
+		m.logger.Info("Placeholders created successfully",
+			zap.Int("count", count),
+		)
+		return
 	}
+	if dataSource != nil {
+		dataSource.SetManifest(manifest)
+	} else {
+		defer manifest.Close()
+	}
+	removeManifestIndexes(job.ID, indexPath, m.logger)
 
 	m.logger.Info("Creating placeholders from remote file list",
-		zap.Int("file_count", len(remoteFiles)),
+		zap.Int("file_count", manifest.Len()),
 	)
 
-	// Create placeholders
-	if err := provider.SyncPlaceholders(m.ctx, remoteFiles); err != nil {
+	// Create placeholders, decoding the manifest entries one at a time
+	count, err := provider.SyncPlaceholdersStream(m.ctx, cloudfiles.NewManifestIndexDataSource(manifest, nil))
+	if err != nil {
 		m.logger.Error("Failed to create placeholders",
+			zap.Int("created", count),
 			zap.Error(err),
 		)
 		return
 	}
 
 	m.logger.Info("Placeholders created successfully",
-		zap.Int("count", len(remoteFiles)),
+		zap.Int("count", count),
 	)
 }
 
-// populateFromManifest reads the Anemone Server manifest and converts it to RemoteFileInfo.
-func (m *SyncManager) populateFromManifest(job *SyncJob) ([]cloudfiles.RemoteFileInfo, error) {
+// populateFromManifest reads the Anemone Server manifest and stores it as a
+// memory-mapped index, so large manifests do not stay on the heap.
+// It returns the index, which the caller closes, and its file ("" when it
+// is kept in memory).
+func (m *SyncManager) populateFromManifest(job *SyncJob) (*cloudfiles.ManifestIndex, string, error) {
 	smbClient, err := smb.NewSMBClientFromKeyring(job.RemoteHost, job.RemoteShare, m.logger.Named("smb"))
 	if err != nil {
-		return nil, fmt.Errorf("failed to create SMB client: %w", err)
+		return nil, "", fmt.Errorf("failed to create SMB client: %w", err)
 	}
 	defer smbClient.Disconnect()
 
 	if err := smbClient.Connect(); err != nil {
-		return nil, fmt.Errorf("failed to connect: %w", err)
+		return nil, "", fmt.Errorf("failed to connect: %w", err)
 	}
 
 	manifestReader := syncpkg.NewManifestReader(smbClient, m.logger.Named("manifest"))
 	result := manifestReader.ReadManifest(m.ctx, job.RemotePath)
 
 	if result.Error != nil {
-		return nil, fmt.Errorf("manifest error: %w", result.Error)
+		return nil, "", fmt.Errorf("manifest error: %w", result.Error)
 	}
 	if !result.Found {
-		return nil, fmt.Errorf("no manifest found")
+		return nil, "", fmt.Errorf("no manifest found")
 	}
 
 	// Convert manifest files to cloudfiles.RemoteFileInfo
@@ -214,115 +244,301 @@ func (m *SyncManager) populateFromManifest(job *SyncJob) ([]cloudfiles.RemoteFil
 		})
 	}
 
-	remoteFiles := cloudfiles.FromManifestFiles(manifestFiles)
-
 	m.logger.Info("Placeholders from manifest",
-		zap.Int("file_count", len(remoteFiles)),
+		zap.Int("file_count", len(manifestFiles)),
 		zap.Duration("manifest_read", result.Duration),
 	)
 
-	return remoteFiles, nil
+	indexPath := newManifestIndexPath(job.ID)
+	if err := cloudfiles.WriteManifestIndex(indexPath, manifestFiles); err != nil {
+		m.logger.Warn("Failed to store manifest index, keeping it in memory", zap.Error(err))
+		index, err := cloudfiles.NewManifestIndex(cloudfiles.EncodeManifestIndex(manifestFiles))
+		return index, "", err
+	}
+	index, err := cloudfiles.OpenManifestIndex(indexPath)
+	if err != nil {
+		os.Remove(indexPath)
+		return nil, "", err
+	}
+	return index, indexPath, nil
+}
+
+// manifestIndexDir returns the directory of the manifest indexes, next to
+// the database in the user's app data.
+func manifestIndexDir() string {
+	localAppData := os.Getenv("LOCALAPPDATA")
+	if localAppData == "" {
+		localAppData = "."
+	}
+	return filepath.Join(localAppData, "AnemoneSync", "data", "manifests")
+}
+
+// newManifestIndexPath returns a new file name for a manifest index of a
+// job. Each index gets its own file: the previous one may still be mapped,
+// and Windows cannot replace a mapped file.
+func newManifestIndexPath(jobID int64) string {
+	return filepath.Join(manifestIndexDir(), fmt.Sprintf("job_%d_%d.idx", jobID, time.Now().UnixNano()))
 }
 
-// populateFromSMBScan does a full recursive SMB scan to list all remote files.
-func (m *SyncManager) populateFromSMBScan(job *SyncJob) ([]cloudfiles.RemoteFileInfo, error) {
-	dataSource, err := m.createSMBDataSource(job)
-	if err != nil {
-		return nil, fmt.Errorf("failed to create SMB data source: %w", err)
+// removeManifestIndexes deletes the manifest indexes of a job except keep.
+// An index still mapped cannot be deleted; it is retried next time.
+func removeManifestIndexes(jobID int64, keep string, logger *zap.Logger) {
+	dir := manifestIndexDir()
+	legacy := filepath.Join(dir, fmt.Sprintf("job_%d.idx", jobID))
+	paths, _ := filepath.Glob(filepath.Join(dir, fmt.Sprintf("job_%d_*.idx", jobID)))
+	for _, path := range append(paths, legacy, legacy+".tmp") {
+		if path == keep {
+			continue
+		}
+		if err := os.Remove(path); err != nil && !os.IsNotExist(err) {
+			logger.Debug("Stale manifest index not removed", zap.String("path", path), zap.Error(err))
+		}
 	}
+}
 
-	remoteFiles, err := dataSource.ListFiles(m.ctx)
+// populateFromSMBScan does a full recursive SMB scan of the remote files,
+// creating placeholders while the scan runs. Returns the number created.
+func (m *SyncManager) populateFromSMBScan(provider *cloudfiles.CloudFilesProvider, job *SyncJob) (int, error) {
+	dataSource, err := m.createSMBDataSource(job)
 	if err != nil {
-		return nil, fmt.Errorf("failed to list remote files: %w", err)
+		return 0, fmt.Errorf("failed to create SMB data source: %w", err)
 	}
+	defer dataSource.Close()
 
-	return remoteFiles, nil
+	return provider.SyncPlaceholdersStream(m.ctx, dataSource)
 }
 
-// createSMBDataSource creates a reconnectable SMB data source for hydration.
-func (m *SyncManager) createSMBDataSource(job *SyncJob) (cloudfiles.DataSource, error) {
-	// Create initial SMB client to verify connectivity
-	smbClient, err := smb.NewSMBClientFromKeyring(job.RemoteHost, job.RemoteShare, m.logger.Named("smb"))
+// createSMBDataSource creates a pooled SMB data source for hydration.
+func (m *SyncManager) createSMBDataSource(job *SyncJob) (*pooledSMBDataSource, error) {
+	pool, err := smb.NewPoolFromKeyring(job.RemoteHost, job.RemoteShare, nil, m.logger.Named("smb_hydration"))
 	if err != nil {
-		return nil, fmt.Errorf("failed to create SMB client: %w", err)
+		return nil, fmt.Errorf("failed to create SMB pool: %w", err)
 	}
 
-	if err := smbClient.Connect(); err != nil {
+	// Connect a first session to verify connectivity
+	lease, err := pool.Acquire(m.ctx, smb.SubsystemHydration)
+	if err != nil {
+		pool.Close()
 		return nil, fmt.Errorf("failed to connect to SMB server: %w", err)
 	}
+	lease.Release()
+
+	return newPooledSMBDataSource(pool, job.RemotePath, filepath.FromSlash(job.LocalPath), m.logger.Named("smb_hydration")), nil
+}
+
+// pooledSMBDataSource serves hydration from a pool of SMB sessions.
+// Reads and folder listings asked by Windows use the hydration quota; full
+// scans use the bulk quota, so they cannot delay a file being opened.
+// Broken sessions are reconnected by the pool.
+type pooledSMBDataSource struct {
+	pool      *smb.Pool
+	hydration *cloudfiles.SMBClientAdapter
+	bulk      *cloudfiles.SMBClientAdapter
+	localPath string // Sync root, to check manifest entries against placeholders
+
+	// Manifest of the last population, for file versions (nil = none)
+	manifestMu sync.RWMutex
+	manifest   *cloudfiles.ManifestIndex
+	closed     bool
+}
 
-	// Wrap in reconnectable adapter that handles dropped connections
-	reconnectable := &reconnectableSMBDataSource{
-		host:       job.RemoteHost,
-		share:      job.RemoteShare,
-		remotePath: job.RemotePath,
-		client:     smbClient,
-		logger:     m.logger.Named("smb_hydration"),
+func newPooledSMBDataSource(pool *smb.Pool, remotePath, localPath string, logger *zap.Logger) *pooledSMBDataSource {
+	return &pooledSMBDataSource{
+		pool:      pool,
+		localPath: localPath,
+		hydration: cloudfiles.NewSMBClientAdapter(&pooledSMBClient{pool: pool, sub: smb.SubsystemHydration}, remotePath, logger),
+		bulk:      cloudfiles.NewSMBClientAdapter(&pooledSMBClient{pool: pool, sub: smb.SubsystemBulk}, remotePath, logger),
 	}
+}
+
+func (d *pooledSMBDataSource) GetFileReader(ctx context.Context, relativePath string, offset int64) (io.ReadCloser, error) {
+	return d.hydration.GetFileReader(ctx, relativePath, offset)
+}
+
+func (d *pooledSMBDataSource) GetFileReaderAt(ctx context.Context, relativePath string) (cloudfiles.RemoteFile, error) {
+	return d.hydration.GetFileReaderAt(ctx, relativePath)
+}
 
-	return reconnectable, nil
+func (d *pooledSMBDataSource) ListFiles(ctx context.Context) ([]cloudfiles.RemoteFileInfo, error) {
+	return d.bulk.ListFiles(ctx)
 }
 
-// reconnectableSMBDataSource wraps an SMB client with auto-reconnection.
-// When the connection drops (EOF, reset, timeout), it creates a fresh connection.
-type reconnectableSMBDataSource struct {
-	host       string
-	share      string
-	remotePath string
-	client     *smb.SMBClient
-	logger     *zap.Logger
+func (d *pooledSMBDataSource) ListFilesStream(ctx context.Context, fn func(cloudfiles.RemoteFileInfo) error) error {
+	return d.bulk.ListFilesStream(ctx, fn)
 }
 
-func (r *reconnectableSMBDataSource) reconnect() error {
-	// Close old connection (ignore errors)
-	if r.client != nil {
-		r.client.Disconnect()
+func (d *pooledSMBDataSource) ListDirectory(ctx context.Context, relativeDir string) ([]cloudfiles.RemoteFileInfo, error) {
+	return d.hydration.ListDirectory(ctx, relativeDir)
+}
+
+// SetManifest makes the data source serve file versions from a manifest
+// index, closing the previous one. The index is closed with the data source.
+func (d *pooledSMBDataSource) SetManifest(index *cloudfiles.ManifestIndex) {
+	d.manifestMu.Lock()
+	old := d.manifest
+	if d.closed {
+		old, index = index, nil
 	}
+	d.manifest = index
+	d.manifestMu.Unlock()
 
-	r.logger.Info("reconnecting SMB for hydration",
-		zap.String("host", r.host),
-		zap.String("share", r.share),
-	)
+	if old != nil {
+		old.Close()
+	}
+}
 
-	newClient, err := smb.NewSMBClientFromKeyring(r.host, r.share, r.logger)
-	if err != nil {
-		return fmt.Errorf("failed to create SMB client: %w", err)
+// FileVersion implements cloudfiles.FileVersionProvider from the manifest,
+// while the placeholder still has the manifest's mtime (else the file was
+// updated since, and the hydration uses the placeholder's own version).
+func (d *pooledSMBDataSource) FileVersion(relativePath string) (string, bool) {
+	d.manifestMu.RLock()
+	var entry cloudfiles.ManifestFileEntry
+	found := false
+	if d.manifest != nil {
+		entry, found = d.manifest.Lookup(relativePath)
 	}
-	if err := newClient.Connect(); err != nil {
-		return fmt.Errorf("failed to reconnect: %w", err)
+	d.manifestMu.RUnlock()
+	if !found || entry.Hash == "" {
+		return "", false
 	}
 
-	r.client = newClient
-	return nil
+	info, err := os.Stat(filepath.Join(d.localPath, filepath.FromSlash(relativePath)))
+	if err != nil || info.ModTime().Unix() != entry.MTime {
+		return "", false
+	}
+	return "h" + entry.Hash, true
 }
 
-func (r *reconnectableSMBDataSource) GetFileReader(ctx context.Context, relativePath string, offset int64) (io.ReadCloser, error) {
-	wrapper := &smbClientWrapper{client: r.client}
-	adapter := cloudfiles.NewSMBClientAdapter(wrapper, r.remotePath, r.logger)
+// Close disconnects the pool's sessions and closes the manifest index.
+func (d *pooledSMBDataSource) Close() error {
+	d.manifestMu.Lock()
+	manifest := d.manifest
+	d.manifest = nil
+	d.closed = true
+	d.manifestMu.Unlock()
 
-	reader, err := adapter.GetFileReader(ctx, relativePath, offset)
-	if err != nil {
-		// Try reconnecting once on connection error
-		if reconnErr := r.reconnect(); reconnErr != nil {
-			return nil, fmt.Errorf("connection lost and reconnect failed: %w (original: %v)", reconnErr, err)
+	if manifest != nil {
+		manifest.Close()
+	}
+	return d.pool.Close()
+}
+
+// pooledSMBClient implements cloudfiles.SMBFileClient on a pool, leasing a
+// session of one subsystem per operation.
+type pooledSMBClient struct {
+	pool *smb.Pool
+	sub  smb.Subsystem
+}
+
+func (c *pooledSMBClient) OpenFile(ctx context.Context, remotePath string) (io.ReadCloser, error) {
+	return c.pool.OpenFile(ctx, c.sub, remotePath)
+}
+
+func (c *pooledSMBClient) OpenFileAt(ctx context.Context, remotePath string) (cloudfiles.RemoteFile, error) {
+	return c.pool.OpenFileAt(ctx, c.sub, remotePath)
+}
+
+func (c *pooledSMBClient) ReadFile(ctx context.Context, remotePath string) ([]byte, error) {
+	var data []byte
+	err := c.pool.Do(ctx, c.sub, func(client *smb.SMBClient) error {
+		var err error
+		data, err = client.ReadFile(remotePath)
+		return err
+	})
+	return data, err
+}
+
+func (c *pooledSMBClient) ListRemote(ctx context.Context, remotePath string) ([]cloudfiles.SMBRemoteFileInfo, error) {
+	var files []cloudfiles.SMBRemoteFileInfo
+	err := c.pool.Do(ctx, c.sub, func(client *smb.SMBClient) error {
+		var err error
+		files, err = (&smbClientWrapper{client: client}).ListRemote(ctx, remotePath)
+		return err
+	})
+	return files, err
+}
+
+func (c *pooledSMBClient) IsConnected() bool {
+	return !c.pool.IsClosed()
+}
+
+// createRemoteChangeCallback creates a callback that closes the hydration
+// pool's cached handles of a remote file before the sync changes it: an open
+// handle would make the upload's rename or the delete fail on the server.
+func (m *SyncManager) createRemoteChangeCallback(provider *cloudfiles.CloudFilesProvider) func(remotePath string) {
+	return func(remotePath string) {
+		if source, ok := provider.GetDataSource().(*pooledSMBDataSource); ok {
+			source.pool.InvalidatePath(remotePath)
 		}
-		// Retry with new connection
-		wrapper = &smbClientWrapper{client: r.client}
-		adapter = cloudfiles.NewSMBClientAdapter(wrapper, r.remotePath, r.logger)
-		return adapter.GetFileReader(ctx, relativePath, offset)
 	}
-	return reader, nil
 }
 
-func (r *reconnectableSMBDataSource) ListFiles(ctx context.Context) ([]cloudfiles.RemoteFileInfo, error) {
-	wrapper := &smbClientWrapper{client: r.client}
-	adapter := cloudfiles.NewSMBClientAdapter(wrapper, r.remotePath, r.logger)
-	return adapter.ListFiles(ctx)
+// createLocalChangeCallback creates a callback applying the deletes and
+// renames made in the sync root to the remote as Windows reports them, with
+// one recursive remote operation per folder. Entries the engine skips (or
+// all of them, without a data source) are left to the next sync.
+func (m *SyncManager) createLocalChangeCallback(provider *cloudfiles.CloudFilesProvider, job *SyncJob) cloudfiles.NotifyBatchCallback {
+	return func(batch *cloudfiles.NotifyBatch) {
+		source, ok := provider.GetDataSource().(*pooledSMBDataSource)
+		if !ok {
+			return
+		}
+
+		// Deletes of a folder's content are covered by the folder's entry
+		changes := make([]syncpkg.LocalChange, 0, len(batch.Entries))
+		for _, entry := range batch.Entries {
+			relPath, ok := provider.RelativePath(entry.Path)
+			if !ok || relPath == "" {
+				continue
+			}
+			change := syncpkg.LocalChange{Path: relPath, IsDirectory: entry.IsDirectory}
+			if batch.Kind == cloudfiles.NotifyRename {
+				// Moved out of the sync root (e.g. to the recycle bin): a delete
+				if target, ok := provider.RelativePath(entry.TargetPath); ok && target != "" {
+					change.NewPath = target
+				}
+			}
+			changes = append(changes, change)
+		}
+		if len(changes) == 0 {
+			return
+		}
+
+		req := &syncpkg.SyncRequest{
+			JobID:                job.ID,
+			LocalPath:            job.LocalPath,
+			RemotePath:           job.FullRemotePath(),
+			Mode:                 job.Mode,
+			ConflictResolution:   job.ConflictResolution,
+			FilesOnDemand:        true,
+			RemoteChangeCallback: m.createRemoteChangeCallback(provider),
+		}
+		err := source.pool.Do(m.ctx, smb.SubsystemBulk, func(client *smb.SMBClient) error {
+			_, err := m.engine.ApplyLocalChanges(m.ctx, req, client, changes)
+			return err
+		})
+		if err != nil {
+			m.logger.Debug("Local changes left to the next sync",
+				zap.String("job", job.Name),
+				zap.Int("changes", len(changes)),
+				zap.Error(err),
+			)
+		}
+	}
 }
 
 // createPlaceholderCallback creates a callback for creating placeholders.
 func (m *SyncManager) createPlaceholderCallback(provider *cloudfiles.CloudFilesProvider, job *SyncJob) syncpkg.PlaceholderCallback {
 	return func(files []syncpkg.PlaceholderFileInfo) (int, error) {
+		// Partial population: folders not opened yet get these files when
+		// Windows enumerates them; drop stale listings of the opened ones
+		if provider.PartialPopulation() {
+			for _, f := range files {
+				provider.InvalidateDirectory(path.Dir(filepath.ToSlash(f.RelativePath)))
+			}
+			return len(files), nil
+		}
+
 		// Convert to cloudfiles.RemoteFileInfo
 		remoteFiles := make([]cloudfiles.RemoteFileInfo, len(files))
 		for i, f := range files {
@@ -362,6 +578,7 @@ func (m *SyncManager) CloseProvider(jobID int64) error {
 	if err := provider.Close(); err != nil {
 		return err
 	}
+	removeManifestIndexes(jobID, "", m.logger)
 
 	delete(m.providers, jobID)
 	return nil
@@ -400,6 +617,7 @@ func (m *SyncManager) UnregisterProvider(jobID int64) error {
 	if err := provider.Unregister(); err != nil {
 		return err
 	}
+	removeManifestIndexes(jobID, "", m.logger)
 
 	delete(m.providers, jobID)
 	return nil
@@ -423,6 +641,7 @@ func (m *SyncManager) closeAllProviders() {
 		m.logger.Info("Closing Cloud Files provider", zap.Int64("job_id", jobID))
 		provider.StopAutoDehydration()
 		provider.Close()
+		removeManifestIndexes(jobID, "", m.logger)
 	}
 	m.providers = make(map[int64]*cloudfiles.CloudFilesProvider)
 }
@@ -13,6 +13,7 @@ type JobOptions struct {
 	// Files On Demand (Cloud Files API)
 	FilesOnDemand     bool `json:"files_on_demand,omitempty"`     // Enable placeholder files
 	AutoDehydrateDays int  `json:"auto_dehydrate_days,omitempty"` // Auto-dehydrate files not accessed for X days (0 = disabled)
+	PartialPopulation bool `json:"partial_population,omitempty"`  // Populate folders when first opened instead of at startup
 	// Trust source for conflict resolution
 	TrustSource    string `json:"trust_source,omitempty"`    // "ask", "server", "local", "recent"
 	FirstSyncDone  bool   `json:"first_sync_done,omitempty"` // True after first sync wizard is completed
@@ -71,6 +72,7 @@ type SyncJob struct {
 	// Files On Demand (Cloud Files API)
 	FilesOnDemand     bool // Enable placeholder files (download on demand)
 	AutoDehydrateDays int  // Auto-dehydrate files not accessed for X days (0 = disabled)
+	PartialPopulation bool // Populate folders when first opened (large shares)
 	// Trust source for conflict resolution
 	TrustSource   string // "ask", "server", "local", "recent"
 	FirstSyncDone bool   // True after first sync wizard is completed
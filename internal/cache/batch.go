@@ -0,0 +1,85 @@
+package cache
+
+import (
+	"fmt"
+	"time"
+
+	"github.com/juste-un-gars/anemone_sync_windows/internal/database"
+	"go.uber.org/zap"
+)
+
+// CacheBatch collects the cache changes of a sync phase in memory and writes
+// them in a single transaction on Flush. The last change of a path wins.
+// A CacheBatch is not safe for concurrent use.
+type CacheBatch struct {
+	cm    *CacheManager
+	jobID int64
+
+	updates     map[string]*FileInfo
+	remotePaths map[string]string
+}
+
+// NewBatch starts a batch of cache changes for a job
+func (cm *CacheManager) NewBatch(jobID int64) *CacheBatch {
+	return &CacheBatch{
+		cm:          cm,
+		jobID:       jobID,
+		updates:     make(map[string]*FileInfo),
+		remotePaths: make(map[string]string),
+	}
+}
+
+// Update records the synced state of a file (remotePath defaults to localPath)
+func (b *CacheBatch) Update(localPath, remotePath string, info *FileInfo) {
+	if info == nil {
+		return
+	}
+	if remotePath == "" {
+		remotePath = localPath
+	}
+	b.updates[localPath] = info
+	b.remotePaths[localPath] = remotePath
+}
+
+// Len returns the number of pending changes
+func (b *CacheBatch) Len() int {
+	return len(b.updates)
+}
+
+// Flush writes the pending changes and resets the batch.
+// On error nothing is written and the changes stay pending.
+func (b *CacheBatch) Flush() error {
+	if b.Len() == 0 {
+		return nil
+	}
+
+	now := time.Now().Unix()
+	states := make([]*database.FileState, 0, len(b.updates))
+	for localPath, info := range b.updates {
+		states = append(states, &database.FileState{
+			JobID:       b.jobID,
+			LocalPath:   localPath,
+			RemotePath:  b.remotePaths[localPath],
+			Size:        info.Size,
+			MTime:       info.MTime.Unix(),
+			Hash:        info.Hash,
+			FileID:      info.FileID,
+			USN:         info.USN,
+			RemoteMTime: unixSeconds(info.RemoteMTime),
+			LastSync:    &now,
+			SyncStatus:  "idle",
+			CreatedAt:   now,
+			UpdatedAt:   now,
+		})
+	}
+	if err := b.cm.db.BulkUpdateFileStates(states); err != nil {
+		return fmt.Errorf("failed to flush cache batch: %w", err)
+	}
+
+	b.cm.logger.Info("cache batch flushed",
+		zap.Int("updated", len(states)))
+
+	b.updates = make(map[string]*FileInfo)
+	b.remotePaths = make(map[string]string)
+	return nil
+}
@@ -0,0 +1,61 @@
+package cache
+
+import (
+	"testing"
+	"time"
+
+	"go.uber.org/zap"
+)
+
+func TestCacheBatch_Flush(t *testing.T) {
+	db, cleanup := setupTestDB(t)
+	defer cleanup()
+
+	cm := NewCacheManager(db, zap.NewNop())
+	jobID := int64(1)
+	mtime := time.Now().Truncate(time.Second)
+
+	if err := cm.UpdateCache(jobID, "old.txt", "", &FileInfo{Path: "old.txt", Size: 10, MTime: mtime}); err != nil {
+		t.Fatalf("failed to update cache: %v", err)
+	}
+
+	batch := cm.NewBatch(jobID)
+	batch.Update("a.txt", "", &FileInfo{Path: "a.txt", Size: 1, MTime: mtime})
+	batch.Update("b.txt", "remote/b.txt", &FileInfo{Path: "b.txt", Size: 2, MTime: mtime})
+	batch.Update("a.txt", "", &FileInfo{Path: "a.txt", Size: 3, MTime: mtime}) // Last change wins
+
+	if batch.Len() != 2 {
+		t.Errorf("expected 2 pending changes, got %d", batch.Len())
+	}
+
+	// Nothing is written before Flush
+	if files, _ := cm.GetAllCachedFiles(jobID); len(files) != 1 {
+		t.Errorf("expected 1 cached file before flush, got %d", len(files))
+	}
+
+	if err := batch.Flush(); err != nil {
+		t.Fatalf("failed to flush batch: %v", err)
+	}
+	if batch.Len() != 0 {
+		t.Errorf("expected an empty batch after flush, got %d", batch.Len())
+	}
+
+	files, err := cm.GetAllCachedFiles(jobID)
+	if err != nil {
+		t.Fatalf("failed to get cached files: %v", err)
+	}
+	if len(files) != 3 {
+		t.Fatalf("expected 3 cached files, got %d", len(files))
+	}
+	if files["a.txt"] == nil || files["a.txt"].Size != 3 {
+		t.Errorf("expected a.txt with size 3, got %+v", files["a.txt"])
+	}
+	if files["b.txt"] == nil || files["b.txt"].Size != 2 {
+		t.Errorf("expected b.txt with size 2, got %+v", files["b.txt"])
+	}
+
+	state, err := db.GetFileState(jobID, "b.txt")
+	if err != nil || state.RemotePath != "remote/b.txt" {
+		t.Errorf("expected remote path remote/b.txt, got %+v (%v)", state, err)
+	}
+}
@@ -2,6 +2,7 @@ package cache
 
 import (
 	"fmt"
+	"strings"
 	"time"
 
 	"github.com/juste-un-gars/anemone_sync_windows/internal/database"
@@ -35,6 +36,15 @@ type FileInfo struct {
 	Size  int64     // File size in bytes
 	MTime time.Time // Modification time
 	Hash  string    // SHA256 hash (empty if not computed)
+
+	// NTFS identity of local files (empty/0 if unknown)
+	FileID string // Volume serial + file index
+	USN    int64  // USN of the last change
+
+	// Modification time of the remote file at sync time (zero if unknown).
+	// Cache entries only: MTime is the local one, and the two differ after
+	// a transfer.
+	RemoteMTime time.Time
 }
 
 // CacheManager handles intelligent caching and change detection
@@ -76,6 +86,10 @@ func (cm *CacheManager) GetCachedState(jobID int64, localPath string) (*FileInfo
 		Size:  state.Size,
 		MTime: time.Unix(state.MTime, 0),
 		Hash:  state.Hash,
+
+		FileID:      state.FileID,
+		USN:         state.USN,
+		RemoteMTime: unixTime(state.RemoteMTime),
 	}, nil
 }
 
@@ -87,16 +101,19 @@ func (cm *CacheManager) UpdateCache(jobID int64, localPath, remotePath string, i
 
 	now := time.Now().Unix()
 	state := &database.FileState{
-		JobID:      jobID,
-		LocalPath:  localPath,
-		RemotePath: remotePath,
-		Size:       info.Size,
-		MTime:      info.MTime.Unix(),
-		Hash:       info.Hash,
-		LastSync:   &now,
-		SyncStatus: "idle",
-		CreatedAt:  now,
-		UpdatedAt:  now,
+		JobID:       jobID,
+		LocalPath:   localPath,
+		RemotePath:  remotePath,
+		Size:        info.Size,
+		MTime:       info.MTime.Unix(),
+		Hash:        info.Hash,
+		FileID:      info.FileID,
+		USN:         info.USN,
+		RemoteMTime: unixSeconds(info.RemoteMTime),
+		LastSync:    &now,
+		SyncStatus:  "idle",
+		CreatedAt:   now,
+		UpdatedAt:   now,
 	}
 
 	if err := cm.db.UpsertFileState(state); err != nil {
@@ -113,42 +130,11 @@ func (cm *CacheManager) UpdateCache(jobID int64, localPath, remotePath string, i
 
 // UpdateCacheBatch updates multiple cache entries in a single transaction
 func (cm *CacheManager) UpdateCacheBatch(jobID int64, updates map[string]*FileInfo, remotePaths map[string]string) error {
-	if len(updates) == 0 {
-		return nil
-	}
-
-	now := time.Now().Unix()
-	states := make([]*database.FileState, 0, len(updates))
-
+	batch := cm.NewBatch(jobID)
 	for localPath, info := range updates {
-		remotePath := remotePaths[localPath]
-		if remotePath == "" {
-			remotePath = localPath // Default to same path
-		}
-
-		state := &database.FileState{
-			JobID:      jobID,
-			LocalPath:  localPath,
-			RemotePath: remotePath,
-			Size:       info.Size,
-			MTime:      info.MTime.Unix(),
-			Hash:       info.Hash,
-			LastSync:   &now,
-			SyncStatus: "idle",
-			CreatedAt:  now,
-			UpdatedAt:  now,
-		}
-		states = append(states, state)
-	}
-
-	if err := cm.db.BulkUpdateFileStates(states); err != nil {
-		return fmt.Errorf("failed to batch update cache: %w", err)
+		batch.Update(localPath, remotePaths[localPath], info)
 	}
-
-	cm.logger.Info("cache batch updated",
-		zap.Int("count", len(updates)))
-
-	return nil
+	return batch.Flush()
 }
 
 // RemoveFromCache removes a file from the cache
@@ -156,6 +142,9 @@ func (cm *CacheManager) RemoveFromCache(jobID int64, localPath string) error {
 	if err := cm.db.DeleteFileState(jobID, localPath); err != nil {
 		return fmt.Errorf("failed to remove from cache: %w", err)
 	}
+	if err := cm.db.DeleteChunkSignature(jobID, localPath); err != nil {
+		cm.logger.Warn("failed to remove chunk signature", zap.String("local_path", localPath), zap.Error(err))
+	}
 
 	cm.logger.Debug("removed from cache",
 		zap.String("local_path", localPath))
@@ -219,14 +208,25 @@ func (cm *CacheManager) hasFileChanged(cached, current *FileInfo) bool {
 		return true
 	}
 
+	// Same NTFS file with no change journaled since the sync - unchanged
+	// whatever its mtime; another file (replaced in place) - modified
+	if cached.FileID != "" && current.FileID != "" {
+		if cached.FileID != current.FileID {
+			return true
+		}
+		if cached.USN != 0 && cached.USN == current.USN {
+			return false
+		}
+	}
+
 	// Modification time changed - likely modified
 	// Note: We use truncation to second precision as some filesystems don't support subsecond precision
 	if !cached.MTime.Truncate(time.Second).Equal(current.MTime.Truncate(time.Second)) {
 		return true
 	}
 
-	// If both have hashes and they differ - definitely modified
-	if cached.Hash != "" && current.Hash != "" && cached.Hash != current.Hash {
+	// If both have hashes of the same algorithm and they differ - definitely modified
+	if HashesComparable(cached.Hash, current.Hash) && cached.Hash != current.Hash {
 		return true
 	}
 
@@ -234,9 +234,28 @@ func (cm *CacheManager) hasFileChanged(cached, current *FileInfo) bool {
 	return false
 }
 
+// HashAlgorithm returns the algorithm of a stored hash. SHA256 hashes are
+// plain hex; other algorithms are tagged "<algorithm>:<hex>" by the scanner.
+func HashAlgorithm(hash string) string {
+	if i := strings.IndexByte(hash, ':'); i > 0 {
+		return hash[:i]
+	}
+	return "sha256"
+}
+
+// HashesComparable checks if two hashes are both known and of the same
+// algorithm. Hashes of different algorithms say nothing about the content,
+// so entries cached before an algorithm switch are not seen as modified.
+func HashesComparable(a, b string) bool {
+	return a != "" && b != "" && HashAlgorithm(a) == HashAlgorithm(b)
+}
+
 // GetAllCachedFiles retrieves all files in cache for a job that have been synced at least once.
 // Files that have never been synced (last_sync is NULL) are excluded, as they are considered
 // "not cached" for the purpose of 3-way merge detection.
+// This is the in-memory index of a sync: load it once and look paths up in
+// the map rather than calling GetCachedState per file. Each key shares its
+// string with the entry's Path.
 func (cm *CacheManager) GetAllCachedFiles(jobID int64) (map[string]*FileInfo, error) {
 	states, err := cm.db.GetAllFileStates(jobID)
 	if err != nil {
@@ -254,6 +273,10 @@ func (cm *CacheManager) GetAllCachedFiles(jobID int64) (map[string]*FileInfo, er
 			Size:  state.Size,
 			MTime: time.Unix(state.MTime, 0),
 			Hash:  state.Hash,
+
+			FileID:      state.FileID,
+			USN:         state.USN,
+			RemoteMTime: unixTime(state.RemoteMTime),
 		}
 	}
 
@@ -302,3 +325,19 @@ func (cm *CacheManager) GetFilesWithStatus(jobID int64, status string) ([]*FileI
 
 	return result, nil
 }
+
+// unixTime converts a cached Unix timestamp, 0 meaning unknown
+func unixTime(sec int64) time.Time {
+	if sec == 0 {
+		return time.Time{}
+	}
+	return time.Unix(sec, 0)
+}
+
+// unixSeconds converts a time to a cached Unix timestamp, 0 meaning unknown
+func unixSeconds(t time.Time) int64 {
+	if t.IsZero() {
+		return 0
+	}
+	return t.Unix()
+}
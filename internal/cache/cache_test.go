@@ -328,3 +328,51 @@ func TestCacheManager_GetAllCachedFiles(t *testing.T) {
 		}
 	}
 }
+
+func TestHashesComparable(t *testing.T) {
+	sha := "b94d27b9934d3e08a52e52d7da7dabfac484efe37a5380ee9088f7ace2efcde9"
+	tree := "sha256-tree:6d2d0b6ab5bdf8bf9c02a6b43e080bef8c8e1d8129de6c9f3ed5ed0fe0c0b3c4"
+
+	tests := []struct {
+		a, b string
+		want bool
+	}{
+		{sha, sha, true},
+		{tree, tree, true},
+		{sha, tree, false},
+		{sha, "", false},
+		{"", "", false},
+	}
+	for _, tt := range tests {
+		if got := HashesComparable(tt.a, tt.b); got != tt.want {
+			t.Errorf("HashesComparable(%q, %q) = %v, want %v", tt.a, tt.b, got, tt.want)
+		}
+	}
+
+	if HashAlgorithm(tree) != "sha256-tree" || HashAlgorithm(sha) != "sha256" {
+		t.Errorf("unexpected algorithms %q, %q", HashAlgorithm(tree), HashAlgorithm(sha))
+	}
+}
+
+func TestHasFileChanged_Identity(t *testing.T) {
+	cm := NewCacheManager(nil, zap.NewNop())
+	mtime := time.Now().Truncate(time.Second)
+	cached := &FileInfo{Size: 100, MTime: mtime, FileID: "a", USN: 10}
+
+	tests := []struct {
+		name    string
+		current *FileInfo
+		want    bool
+	}{
+		{"same file and USN, mtime changed", &FileInfo{Size: 100, MTime: mtime.Add(time.Hour), FileID: "a", USN: 10}, false},
+		{"same file, changed since", &FileInfo{Size: 100, MTime: mtime.Add(time.Hour), FileID: "a", USN: 12}, true},
+		{"replaced file, same metadata", &FileInfo{Size: 100, MTime: mtime, FileID: "b", USN: 10}, true},
+		{"identity unknown, same metadata", &FileInfo{Size: 100, MTime: mtime}, false},
+		{"size changed", &FileInfo{Size: 200, MTime: mtime, FileID: "a", USN: 10}, true},
+	}
+	for _, tt := range tests {
+		if got := cm.hasFileChanged(cached, tt.current); got != tt.want {
+			t.Errorf("%s: hasFileChanged = %v, want %v", tt.name, got, tt.want)
+		}
+	}
+}
@@ -64,7 +64,14 @@ func (cd *ChangeDetector) DetermineSyncAction(jobID int64, localPath, remotePath
 	if err != nil {
 		return nil, fmt.Errorf("failed to get cached state: %w", err)
 	}
+
+	return cd.decide(decision, cachedInfo), nil
+}
+
+// decide completes a decision from the cached state of its file
+func (cd *ChangeDetector) decide(decision *SyncDecision, cachedInfo *FileInfo) *SyncDecision {
 	decision.CachedInfo = cachedInfo
+	localInfo, remoteInfo := decision.LocalInfo, decision.RemoteInfo
 
 	// Determine action based on 3-way comparison
 	decision.Action, decision.Reason = cd.decide3Way(localInfo, remoteInfo, cachedInfo)
@@ -73,11 +80,11 @@ func (cd *ChangeDetector) DetermineSyncAction(jobID int64, localPath, remotePath
 	decision.NeedsResolution = decision.Action == ActionConflict
 
 	cd.logger.Debug("sync decision made",
-		zap.String("path", localPath),
+		zap.String("path", decision.LocalPath),
 		zap.String("action", string(decision.Action)),
 		zap.String("reason", decision.Reason))
 
-	return decision, nil
+	return decision
 }
 
 // decide3Way implements 3-way merge decision logic
@@ -142,7 +149,7 @@ func (cd *ChangeDetector) decide3Way(local, remote, cached *FileInfo) (SyncActio
 	// Case 6: File exists in all three places
 	if localExists && remoteExists && cachedExists {
 		localChanged := !cd.filesAreSame(local, cached)
-		remoteChanged := !cd.filesAreSame(remote, cached)
+		remoteChanged := !cd.filesAreSame(remote, remoteCachedState(cached))
 
 		if !localChanged && !remoteChanged {
 			// No changes anywhere
@@ -184,8 +191,13 @@ func (cd *ChangeDetector) filesContentSame(f1, f2 *FileInfo) bool {
 		return false
 	}
 
+	// Same local file, unchanged since it was cached
+	if sameJournaledFile(f1, f2) {
+		return true
+	}
+
 	// If both have hashes, compare them
-	if f1.Hash != "" && f2.Hash != "" {
+	if HashesComparable(f1.Hash, f2.Hash) {
 		return f1.Hash == f2.Hash
 	}
 
@@ -206,8 +218,13 @@ func (cd *ChangeDetector) filesAreSame(f1, f2 *FileInfo) bool {
 		return false
 	}
 
+	// Same local file, unchanged since it was cached
+	if sameJournaledFile(f1, f2) {
+		return true
+	}
+
 	// If both have hashes, compare them (most reliable)
-	if f1.Hash != "" && f2.Hash != "" {
+	if HashesComparable(f1.Hash, f2.Hash) {
 		return f1.Hash == f2.Hash
 	}
 
@@ -226,6 +243,24 @@ func (cd *ChangeDetector) filesAreSame(f1, f2 *FileInfo) bool {
 	return f1.MTime.Truncate(time.Second).Equal(f2.MTime.Truncate(time.Second))
 }
 
+// remoteCachedState returns the cached state of a file as last seen on the
+// remote side: after a transfer the remote mtime is not the local one.
+func remoteCachedState(cached *FileInfo) *FileInfo {
+	if cached == nil || cached.RemoteMTime.IsZero() {
+		return cached
+	}
+	remote := *cached
+	remote.MTime = cached.RemoteMTime
+	return &remote
+}
+
+// sameJournaledFile checks if f1 and f2 are the same NTFS file with the same
+// USN, i.e. no change was journaled between them. Only local scans and the
+// cache carry an identity, so this never matches a remote file.
+func sameJournaledFile(f1, f2 *FileInfo) bool {
+	return f1.FileID != "" && f1.FileID == f2.FileID && f1.USN != 0 && f1.USN == f2.USN
+}
+
 // isFileRecreated checks if f1 appears to be a re-creation of f2.
 // A file is considered "re-created" if it has:
 // - Same content (same size and hash) as the cached version
@@ -240,7 +275,7 @@ func (cd *ChangeDetector) isFileRecreated(f1, f2 *FileInfo) bool {
 	if f1.Size != f2.Size {
 		return false
 	}
-	if f1.Hash != "" && f2.Hash != "" && f1.Hash != f2.Hash {
+	if HashesComparable(f1.Hash, f2.Hash) && f1.Hash != f2.Hash {
 		return false
 	}
 
@@ -253,14 +288,21 @@ func (cd *ChangeDetector) isFileRecreated(f1, f2 *FileInfo) bool {
 
 // BatchDetermineSyncActions determines sync actions for multiple files
 func (cd *ChangeDetector) BatchDetermineSyncActions(jobID int64, files map[string]*FileInfo, remoteFiles map[string]*FileInfo) ([]*SyncDecision, error) {
-	decisions := make([]*SyncDecision, 0)
-
 	// Get all cached files
 	cachedFiles, err := cd.cache.GetAllCachedFiles(jobID)
 	if err != nil {
 		return nil, fmt.Errorf("failed to get cached files: %w", err)
 	}
 
+	return cd.DetermineSyncActionsFromCache(files, remoteFiles, cachedFiles), nil
+}
+
+// DetermineSyncActionsFromCache determines sync actions for multiple files
+// against cached states already loaded with GetAllCachedFiles, without
+// querying the database per file
+func (cd *ChangeDetector) DetermineSyncActionsFromCache(files, remoteFiles, cachedFiles map[string]*FileInfo) []*SyncDecision {
+	decisions := make([]*SyncDecision, 0)
+
 	// Build a set of all unique paths
 	allPaths := make(map[string]bool)
 	for path := range files {
@@ -278,13 +320,12 @@ func (cd *ChangeDetector) BatchDetermineSyncActions(jobID int64, files map[strin
 		local := files[path]
 		remote := remoteFiles[path]
 
-		decision, err := cd.DetermineSyncAction(jobID, path, path, local, remote)
-		if err != nil {
-			cd.logger.Warn("failed to determine sync action",
-				zap.String("path", path),
-				zap.Error(err))
-			continue
-		}
+		decision := cd.decide(&SyncDecision{
+			LocalPath:  path,
+			RemotePath: path,
+			LocalInfo:  local,
+			RemoteInfo: remote,
+		}, cachedFiles[path])
 
 		// Only include if action is needed
 		if decision.Action != ActionNone {
@@ -296,7 +337,7 @@ func (cd *ChangeDetector) BatchDetermineSyncActions(jobID int64, files map[strin
 		zap.Int("total_paths", len(allPaths)),
 		zap.Int("actions_needed", len(decisions)))
 
-	return decisions, nil
+	return decisions
 }
 
 // ResolveConflict resolves a conflict with a user-specified strategy
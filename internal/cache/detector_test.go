@@ -132,6 +132,20 @@ func TestChangeDetector_DetermineSyncAction(t *testing.T) {
 			cached:         &FileInfo{Size: 100, MTime: now, Hash: "hash1"},
 			expectedAction: ActionNone,
 		},
+		{
+			name:           "uploaded file unchanged (remote mtime is the upload time)",
+			local:          &FileInfo{Size: 100, MTime: now.Add(-time.Hour), Hash: "hash1"},
+			remote:         &FileInfo{Size: 100, MTime: now},
+			cached:         &FileInfo{Size: 100, MTime: now.Add(-time.Hour), RemoteMTime: now},
+			expectedAction: ActionNone,
+		},
+		{
+			name:           "uploaded file modified remotely",
+			local:          &FileInfo{Size: 100, MTime: now.Add(-time.Hour), Hash: "hash1"},
+			remote:         &FileInfo{Size: 100, MTime: now.Add(time.Hour)},
+			cached:         &FileInfo{Size: 100, MTime: now.Add(-time.Hour), RemoteMTime: now},
+			expectedAction: ActionDownload,
+		},
 	}
 
 	for _, tt := range tests {
@@ -0,0 +1,71 @@
+package cache
+
+import (
+	"fmt"
+	"time"
+
+	"github.com/juste-un-gars/anemone_sync_windows/internal/database"
+	"go.uber.org/zap"
+)
+
+// ChunkSignature holds the content-defined chunks of a file as last uploaded,
+// with the remote state right after that upload. A delta upload is only safe
+// while the remote file still matches RemoteSize and RemoteMTime.
+type ChunkSignature struct {
+	Size        int64     // Local file size when chunked
+	RemoteSize  int64     // Remote file size after the upload
+	RemoteMTime time.Time // Remote modification time after the upload
+	Chunks      []byte    // Encoded chunk signatures (scanner.EncodeChunks)
+}
+
+// GetChunkSignature retrieves the chunk signatures of a file
+// Returns nil if the file has none
+func (cm *CacheManager) GetChunkSignature(jobID int64, localPath string) (*ChunkSignature, error) {
+	sig, err := cm.db.GetChunkSignature(jobID, localPath)
+	if err != nil {
+		return nil, fmt.Errorf("failed to get chunk signature: %w", err)
+	}
+	if sig == nil {
+		return nil, nil
+	}
+
+	return &ChunkSignature{
+		Size:        sig.Size,
+		RemoteSize:  sig.RemoteSize,
+		RemoteMTime: time.Unix(sig.RemoteMTime, 0),
+		Chunks:      sig.Chunks,
+	}, nil
+}
+
+// UpdateChunkSignature stores the chunk signatures of a file after an upload
+func (cm *CacheManager) UpdateChunkSignature(jobID int64, localPath string, sig *ChunkSignature) error {
+	if sig == nil {
+		return fmt.Errorf("chunk signature cannot be nil")
+	}
+
+	err := cm.db.UpsertChunkSignature(&database.ChunkSignature{
+		JobID:       jobID,
+		LocalPath:   localPath,
+		Size:        sig.Size,
+		RemoteSize:  sig.RemoteSize,
+		RemoteMTime: sig.RemoteMTime.Unix(),
+		Chunks:      sig.Chunks,
+	})
+	if err != nil {
+		return fmt.Errorf("failed to update chunk signature: %w", err)
+	}
+
+	cm.logger.Debug("chunk signature updated",
+		zap.String("local_path", localPath),
+		zap.Int("bytes", len(sig.Chunks)))
+
+	return nil
+}
+
+// RemoveChunkSignature removes the chunk signatures of a file
+func (cm *CacheManager) RemoveChunkSignature(jobID int64, localPath string) error {
+	if err := cm.db.DeleteChunkSignature(jobID, localPath); err != nil {
+		return fmt.Errorf("failed to remove chunk signature: %w", err)
+	}
+	return nil
+}
@@ -0,0 +1,61 @@
+package cache
+
+import (
+	"bytes"
+	"testing"
+	"time"
+
+	"go.uber.org/zap"
+)
+
+func TestCacheManager_ChunkSignature(t *testing.T) {
+	db, cleanup := setupTestDB(t)
+	defer cleanup()
+
+	cm := NewCacheManager(db, zap.NewNop())
+
+	jobID := int64(1)
+	localPath := "/test/disk.vhdx"
+
+	// No signature yet
+	sig, err := cm.GetChunkSignature(jobID, localPath)
+	if err != nil {
+		t.Fatalf("unexpected error: %v", err)
+	}
+	if sig != nil {
+		t.Fatal("expected nil for a file without signature")
+	}
+
+	stored := &ChunkSignature{
+		Size:        4096,
+		RemoteSize:  4096,
+		RemoteMTime: time.Now().Truncate(time.Second),
+		Chunks:      []byte{1, 2, 3, 4},
+	}
+	if err := cm.UpdateChunkSignature(jobID, localPath, stored); err != nil {
+		t.Fatalf("failed to update chunk signature: %v", err)
+	}
+
+	sig, err = cm.GetChunkSignature(jobID, localPath)
+	if err != nil || sig == nil {
+		t.Fatalf("expected chunk signature, got %v (%v)", sig, err)
+	}
+	if sig.Size != stored.Size || sig.RemoteSize != stored.RemoteSize || !sig.RemoteMTime.Equal(stored.RemoteMTime) {
+		t.Errorf("expected %+v, got %+v", stored, sig)
+	}
+	if !bytes.Equal(sig.Chunks, stored.Chunks) {
+		t.Errorf("chunks: expected %v, got %v", stored.Chunks, sig.Chunks)
+	}
+
+	// Removing the file from cache drops its signature
+	if err := cm.RemoveFromCache(jobID, localPath); err != nil {
+		t.Fatalf("failed to remove from cache: %v", err)
+	}
+	sig, err = cm.GetChunkSignature(jobID, localPath)
+	if err != nil {
+		t.Fatalf("unexpected error: %v", err)
+	}
+	if sig != nil {
+		t.Error("chunk signature should be removed with the file")
+	}
+}
@@ -0,0 +1,422 @@
+//go:build windows
+// +build windows
+
+// Package cloudfiles provides Go bindings for the Windows Cloud Files API.
+package cloudfiles
+
+import (
+	"container/list"
+	"crypto/sha256"
+	"encoding/hex"
+	"fmt"
+	"os"
+	"path/filepath"
+	"sort"
+	"strconv"
+	"strings"
+	"sync"
+	"sync/atomic"
+
+	"go.uber.org/zap"
+)
+
+// Block cache defaults.
+const (
+	DefaultBlockCacheMaxBytes  = 2 * 1024 * 1024 * 1024 // 2GB on-disk budget
+	DefaultBlockCacheBlockSize = 1024 * 1024            // 1MB blocks
+)
+
+// blockFileExt is the extension of cached block files.
+const blockFileExt = ".blk"
+
+// BlockCacheConfig configures the on-disk cache of hydrated ranges.
+type BlockCacheConfig struct {
+	Dir       string // Cache directory ("" = cache disabled)
+	MaxBytes  int64  // LRU size budget (0 = DefaultBlockCacheMaxBytes)
+	BlockSize int64  // Bytes per cached block (0 = DefaultBlockCacheBlockSize)
+}
+
+// BlockCacheKey identifies one version of a remote file. A change in size or
+// version (hash, else mtime) yields a new key, so stale blocks are never served.
+type BlockCacheKey struct {
+	Path    string
+	Size    int64
+	Version string
+}
+
+// id returns the directory name holding the key's blocks.
+func (k BlockCacheKey) id() string {
+	sum := sha256.Sum256([]byte(k.Path + "\x00" + strconv.FormatInt(k.Size, 10) + "\x00" + k.Version))
+	return hex.EncodeToString(sum[:16])
+}
+
+// BlockCacheStats contains block cache counters.
+type BlockCacheStats struct {
+	Hits      int64
+	Misses    int64
+	Evictions int64
+	Blocks    int
+	Bytes     int64
+}
+
+// BlockCache keeps hydrated file blocks on local disk so a file re-opened
+// after dehydration is served locally instead of re-streamed from SMB.
+// Blocks are fixed-size and aligned on BlockSize; the last block of a file
+// may be shorter. Eviction is least-recently-used within MaxBytes.
+type BlockCache struct {
+	dir       string
+	maxBytes  int64
+	blockSize int64
+	logger    *zap.Logger
+
+	mu     sync.Mutex
+	lru    *list.List // Front = most recently used *cachedBlock
+	blocks map[string]*list.Element
+	bytes  int64
+
+	hits      int64
+	misses    int64
+	evictions int64
+}
+
+// cachedBlock is one block file tracked by the LRU.
+type cachedBlock struct {
+	name string // "<key id>/<index>.blk", relative to the cache dir
+	size int64
+}
+
+// NewBlockCache opens (or creates) the block cache in config.Dir and loads
+// the blocks already on disk.
+func NewBlockCache(config BlockCacheConfig, logger *zap.Logger) (*BlockCache, error) {
+	if config.Dir == "" {
+		return nil, fmt.Errorf("block cache directory is required")
+	}
+	if logger == nil {
+		logger = zap.NewNop()
+	}
+	if config.MaxBytes <= 0 {
+		config.MaxBytes = DefaultBlockCacheMaxBytes
+	}
+	if config.BlockSize <= 0 {
+		config.BlockSize = DefaultBlockCacheBlockSize
+	}
+	// Cached blocks are transferred as is, so keep them on the 4KB boundary
+	if rem := config.BlockSize % prefetchAlignment; rem != 0 {
+		config.BlockSize += prefetchAlignment - rem
+	}
+	if err := os.MkdirAll(config.Dir, 0700); err != nil {
+		return nil, fmt.Errorf("failed to create block cache directory: %w", err)
+	}
+
+	c := &BlockCache{
+		dir:       config.Dir,
+		maxBytes:  config.MaxBytes,
+		blockSize: config.BlockSize,
+		logger:    logger,
+		lru:       list.New(),
+		blocks:    make(map[string]*list.Element),
+	}
+	if err := c.load(); err != nil {
+		return nil, err
+	}
+	return c, nil
+}
+
+// load indexes existing block files, most recently written first, and trims
+// the cache to its budget.
+func (c *BlockCache) load() error {
+	dirs, err := os.ReadDir(c.dir)
+	if err != nil {
+		return fmt.Errorf("failed to read block cache directory: %w", err)
+	}
+
+	type diskBlock struct {
+		cachedBlock
+		modTime int64
+	}
+	var found []diskBlock
+	for _, d := range dirs {
+		if !d.IsDir() {
+			continue
+		}
+		entries, err := os.ReadDir(filepath.Join(c.dir, d.Name()))
+		if err != nil {
+			continue
+		}
+		for _, e := range entries {
+			path := filepath.Join(c.dir, d.Name(), e.Name())
+			if !strings.HasSuffix(e.Name(), blockFileExt) {
+				// Leftover temp file from an interrupted write
+				os.Remove(path)
+				continue
+			}
+			info, err := e.Info()
+			if err != nil {
+				continue
+			}
+			found = append(found, diskBlock{
+				cachedBlock: cachedBlock{name: d.Name() + "/" + e.Name(), size: info.Size()},
+				modTime:     info.ModTime().UnixNano(),
+			})
+		}
+	}
+
+	// Most recently written at the front
+	sort.Slice(found, func(i, j int) bool { return found[i].modTime > found[j].modTime })
+
+	c.mu.Lock()
+	for i := range found {
+		b := found[i].cachedBlock
+		c.blocks[b.name] = c.lru.PushBack(&b)
+		c.bytes += b.size
+	}
+	evicted := c.evictLocked()
+	c.mu.Unlock()
+	c.removeFiles(evicted)
+
+	c.logger.Debug("block cache loaded",
+		zap.Int("blocks", len(found)),
+		zap.Int64("bytes", c.bytes),
+	)
+	return nil
+}
+
+// BlockSize returns the size of a cached block.
+func (c *BlockCache) BlockSize() int64 {
+	return c.blockSize
+}
+
+// blockLength returns the length of block index of a file of the given size.
+func (c *BlockCache) blockLength(key BlockCacheKey, index int64) int64 {
+	start := index * c.blockSize
+	if start >= key.Size {
+		return 0
+	}
+	if key.Size-start < c.blockSize {
+		return key.Size - start
+	}
+	return c.blockSize
+}
+
+// blockName returns the index name of a block.
+func blockName(key BlockCacheKey, index int64) string {
+	return key.id() + "/" + strconv.FormatInt(index, 16) + blockFileExt
+}
+
+// Get reads block index of key into buf, which must hold BlockSize bytes.
+// Returns the block data and true on a hit.
+func (c *BlockCache) Get(key BlockCacheKey, index int64, buf []byte) ([]byte, bool) {
+	length := c.blockLength(key, index)
+	name := blockName(key, index)
+
+	c.mu.Lock()
+	elem, ok := c.blocks[name]
+	if ok {
+		c.lru.MoveToFront(elem)
+	}
+	c.mu.Unlock()
+
+	if !ok || length == 0 || int64(len(buf)) < length {
+		atomic.AddInt64(&c.misses, 1)
+		return nil, false
+	}
+
+	f, err := os.Open(filepath.Join(c.dir, filepath.FromSlash(name)))
+	if err != nil {
+		c.drop(name)
+		atomic.AddInt64(&c.misses, 1)
+		return nil, false
+	}
+	defer f.Close()
+
+	n, err := f.ReadAt(buf[:length], 0)
+	if int64(n) != length {
+		// Truncated or unreadable block: forget it
+		c.logger.Debug("dropping unreadable cache block",
+			zap.String("block", name),
+			zap.Error(err),
+		)
+		c.drop(name)
+		atomic.AddInt64(&c.misses, 1)
+		return nil, false
+	}
+
+	atomic.AddInt64(&c.hits, 1)
+	return buf[:length], true
+}
+
+// Put stores block index of key. data must be the whole block; partial
+// blocks are ignored.
+func (c *BlockCache) Put(key BlockCacheKey, index int64, data []byte) error {
+	length := c.blockLength(key, index)
+	if length == 0 || int64(len(data)) != length {
+		return nil
+	}
+	name := blockName(key, index)
+
+	c.mu.Lock()
+	_, exists := c.blocks[name]
+	c.mu.Unlock()
+	if exists {
+		return nil
+	}
+
+	dir := filepath.Join(c.dir, key.id())
+	if err := os.MkdirAll(dir, 0700); err != nil {
+		return fmt.Errorf("failed to create cache directory: %w", err)
+	}
+
+	// Write to a temp file then rename, so a crash never leaves a short block
+	tmp, err := os.CreateTemp(dir, "block-*.tmp")
+	if err != nil {
+		return fmt.Errorf("failed to create cache block: %w", err)
+	}
+	if _, err := tmp.Write(data); err != nil {
+		tmp.Close()
+		os.Remove(tmp.Name())
+		return fmt.Errorf("failed to write cache block: %w", err)
+	}
+	if err := tmp.Close(); err != nil {
+		os.Remove(tmp.Name())
+		return fmt.Errorf("failed to write cache block: %w", err)
+	}
+	if err := os.Rename(tmp.Name(), filepath.Join(c.dir, filepath.FromSlash(name))); err != nil {
+		os.Remove(tmp.Name())
+		return fmt.Errorf("failed to commit cache block: %w", err)
+	}
+
+	c.mu.Lock()
+	if _, exists := c.blocks[name]; !exists {
+		c.blocks[name] = c.lru.PushFront(&cachedBlock{name: name, size: length})
+		c.bytes += length
+	}
+	evicted := c.evictLocked()
+	c.mu.Unlock()
+	c.removeFiles(evicted)
+	return nil
+}
+
+// evictLocked unlinks least recently used blocks until the cache fits its
+// budget and returns their names. Caller must hold c.mu.
+func (c *BlockCache) evictLocked() []string {
+	var evicted []string
+	for c.bytes > c.maxBytes {
+		elem := c.lru.Back()
+		if elem == nil {
+			break
+		}
+		b := elem.Value.(*cachedBlock)
+		c.lru.Remove(elem)
+		delete(c.blocks, b.name)
+		c.bytes -= b.size
+		c.evictions++
+		evicted = append(evicted, b.name)
+	}
+	return evicted
+}
+
+// removeFiles deletes evicted block files.
+func (c *BlockCache) removeFiles(names []string) {
+	for _, name := range names {
+		path := filepath.Join(c.dir, filepath.FromSlash(name))
+		if err := os.Remove(path); err != nil && !os.IsNotExist(err) {
+			c.logger.Debug("failed to remove cache block",
+				zap.String("block", name),
+				zap.Error(err),
+			)
+		}
+		// Drop the key directory once its last block is gone
+		os.Remove(filepath.Dir(path))
+	}
+}
+
+// drop forgets a block whose file is missing or damaged.
+func (c *BlockCache) drop(name string) {
+	c.mu.Lock()
+	if elem, ok := c.blocks[name]; ok {
+		b := elem.Value.(*cachedBlock)
+		c.lru.Remove(elem)
+		delete(c.blocks, name)
+		c.bytes -= b.size
+	}
+	c.mu.Unlock()
+	c.removeFiles([]string{name})
+}
+
+// Stats returns the cache counters.
+func (c *BlockCache) Stats() BlockCacheStats {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	return BlockCacheStats{
+		Hits:      atomic.LoadInt64(&c.hits),
+		Misses:    atomic.LoadInt64(&c.misses),
+		Evictions: c.evictions,
+		Blocks:    len(c.blocks),
+		Bytes:     c.bytes,
+	}
+}
+
+// blockCacheWriter collects delivered hydration data into whole blocks and
+// stores them in the cache. Data before the first block boundary is skipped.
+type blockCacheWriter struct {
+	cache  *BlockCache
+	key    BlockCacheKey
+	offset int64  // File offset of the next delivered byte
+	buf    []byte // Partial block being assembled
+	index  int64  // Block index of buf
+	skip   bool   // Still before the first block boundary
+}
+
+func newBlockCacheWriter(cache *BlockCache, key BlockCacheKey, offset int64) *blockCacheWriter {
+	return &blockCacheWriter{
+		cache:  cache,
+		key:    key,
+		offset: offset,
+		index:  (offset + cache.blockSize - 1) / cache.blockSize,
+		skip:   offset%cache.blockSize != 0,
+	}
+}
+
+// Write records data delivered at the writer's current offset.
+func (w *blockCacheWriter) Write(data []byte) {
+	bs := w.cache.blockSize
+	for len(data) > 0 {
+		if w.skip {
+			// Skip up to the next block boundary
+			n := bs - w.offset%bs
+			if n > int64(len(data)) {
+				n = int64(len(data))
+			}
+			data = data[n:]
+			w.offset += n
+			w.skip = w.offset%bs != 0
+			continue
+		}
+
+		length := w.cache.blockLength(w.key, w.index)
+		if length == 0 {
+			return
+		}
+		if w.buf == nil {
+			w.buf = make([]byte, 0, bs)
+		}
+		n := length - int64(len(w.buf))
+		if n > int64(len(data)) {
+			n = int64(len(data))
+		}
+		w.buf = append(w.buf, data[:n]...)
+		data = data[n:]
+		w.offset += n
+
+		if int64(len(w.buf)) == length {
+			if err := w.cache.Put(w.key, w.index, w.buf); err != nil {
+				w.cache.logger.Debug("failed to cache block",
+					zap.String("file", w.key.Path),
+					zap.Error(err),
+				)
+			}
+			w.buf = w.buf[:0]
+			w.index++
+		}
+	}
+}
@@ -0,0 +1,179 @@
+//go:build windows
+// +build windows
+
+package cloudfiles
+
+import (
+	"bytes"
+	"testing"
+)
+
+func testBlockContent(size int) []byte {
+	content := make([]byte, size)
+	for i := range content {
+		content[i] = byte(i % 241)
+	}
+	return content
+}
+
+func TestNewBlockCacheRequiresDir(t *testing.T) {
+	if _, err := NewBlockCache(BlockCacheConfig{}, nil); err == nil {
+		t.Error("Expected error for empty cache directory")
+	}
+}
+
+func TestBlockCachePutGet(t *testing.T) {
+	cache, err := NewBlockCache(BlockCacheConfig{Dir: t.TempDir(), BlockSize: 4096}, nil)
+	if err != nil {
+		t.Fatalf("NewBlockCache failed: %v", err)
+	}
+
+	content := testBlockContent(4096 + 100)
+	key := BlockCacheKey{Path: "dir/file.bin", Size: int64(len(content)), Version: "m1"}
+
+	if err := cache.Put(key, 0, content[:4096]); err != nil {
+		t.Fatalf("Put failed: %v", err)
+	}
+	// Last block is short
+	if err := cache.Put(key, 1, content[4096:]); err != nil {
+		t.Fatalf("Put failed: %v", err)
+	}
+
+	buf := make([]byte, cache.BlockSize())
+	data, ok := cache.Get(key, 1, buf)
+	if !ok {
+		t.Fatal("Expected hit for last block")
+	}
+	if !bytes.Equal(data, content[4096:]) {
+		t.Errorf("Last block mismatch: got %d bytes", len(data))
+	}
+
+	// Another version of the file misses
+	stale := key
+	stale.Version = "m2"
+	if _, ok := cache.Get(stale, 0, buf); ok {
+		t.Error("Expected miss for a different version")
+	}
+
+	stats := cache.Stats()
+	if stats.Hits != 1 || stats.Misses != 1 || stats.Blocks != 2 {
+		t.Errorf("Unexpected stats: %+v", stats)
+	}
+}
+
+func TestBlockCacheIgnoresPartialBlocks(t *testing.T) {
+	cache, _ := NewBlockCache(BlockCacheConfig{Dir: t.TempDir(), BlockSize: 4096}, nil)
+	key := BlockCacheKey{Path: "file.bin", Size: 8192, Version: "m1"}
+
+	cache.Put(key, 0, make([]byte, 100))
+	if stats := cache.Stats(); stats.Blocks != 0 {
+		t.Errorf("Expected partial block to be ignored, got %d blocks", stats.Blocks)
+	}
+}
+
+func TestBlockCacheEvictsLRU(t *testing.T) {
+	cache, _ := NewBlockCache(BlockCacheConfig{Dir: t.TempDir(), BlockSize: 4096, MaxBytes: 2 * 4096}, nil)
+	key := BlockCacheKey{Path: "file.bin", Size: 3 * 4096, Version: "m1"}
+	content := testBlockContent(3 * 4096)
+	buf := make([]byte, 4096)
+
+	cache.Put(key, 0, content[:4096])
+	cache.Put(key, 1, content[4096:8192])
+	cache.Get(key, 0, buf) // Block 1 becomes least recently used
+	cache.Put(key, 2, content[8192:])
+
+	if _, ok := cache.Get(key, 1, buf); ok {
+		t.Error("Expected block 1 to be evicted")
+	}
+	if _, ok := cache.Get(key, 0, buf); !ok {
+		t.Error("Expected block 0 to stay cached")
+	}
+	if stats := cache.Stats(); stats.Evictions != 1 || stats.Bytes != 2*4096 {
+		t.Errorf("Unexpected stats: %+v", stats)
+	}
+}
+
+func TestBlockCacheReload(t *testing.T) {
+	dir := t.TempDir()
+	key := BlockCacheKey{Path: "file.bin", Size: 4096, Version: "h1"}
+	content := testBlockContent(4096)
+
+	cache, _ := NewBlockCache(BlockCacheConfig{Dir: dir, BlockSize: 4096}, nil)
+	cache.Put(key, 0, content)
+
+	reopened, err := NewBlockCache(BlockCacheConfig{Dir: dir, BlockSize: 4096}, nil)
+	if err != nil {
+		t.Fatalf("NewBlockCache failed: %v", err)
+	}
+	data, ok := reopened.Get(key, 0, make([]byte, 4096))
+	if !ok || !bytes.Equal(data, content) {
+		t.Error("Expected block to survive reopening the cache")
+	}
+}
+
+func TestBlockCacheWriterAlignment(t *testing.T) {
+	cache, _ := NewBlockCache(BlockCacheConfig{Dir: t.TempDir(), BlockSize: 4096}, nil)
+	content := testBlockContent(3*4096 + 10)
+	key := BlockCacheKey{Path: "file.bin", Size: int64(len(content)), Version: "m1"}
+
+	// Delivery starts mid-block and arrives in odd-sized pieces
+	const start = 1000
+	writer := newBlockCacheWriter(cache, key, start)
+	for pos := start; pos < len(content); {
+		end := pos + 3000
+		if end > len(content) {
+			end = len(content)
+		}
+		writer.Write(content[pos:end])
+		pos = end
+	}
+
+	buf := make([]byte, 4096)
+	if _, ok := cache.Get(key, 0, buf); ok {
+		t.Error("Expected the partially delivered first block to be skipped")
+	}
+	for index := int64(1); index <= 3; index++ {
+		data, ok := cache.Get(key, index, buf)
+		if !ok {
+			t.Fatalf("Expected block %d to be cached", index)
+		}
+		if !bytes.Equal(data, content[index*4096:index*4096+int64(len(data))]) {
+			t.Errorf("Block %d mismatch", index)
+		}
+	}
+}
+
+func TestServeCachedBlocks(t *testing.T) {
+	cache, _ := NewBlockCache(BlockCacheConfig{Dir: t.TempDir(), BlockSize: 8192}, nil)
+	content := testBlockContent(4 * 8192)
+	key := BlockCacheKey{Path: "file.bin", Size: int64(len(content)), Version: "m1"}
+	cache.Put(key, 0, content[:8192])
+	cache.Put(key, 1, content[8192:16384])
+	// Block 2 is missing
+
+	config := SyncRootConfig{
+		Path:         t.TempDir(),
+		ProviderName: "TestProvider",
+	}
+	syncRoot, _ := NewSyncRootManager(config)
+	handler := NewHydrationHandler(syncRoot, newMockDataProvider(), nil)
+	handler.SetChunkSize(4096)
+
+	var got []byte
+	served, err := handler.serveCachedBlocks(cache, key, 4096, int64(len(content))-4096, deliverFunc(func(data []byte) error {
+		if len(data) > 4096 {
+			t.Errorf("Delivered %d bytes, larger than chunk size", len(data))
+		}
+		got = append(got, data...)
+		return nil
+	}))
+	if err != nil {
+		t.Fatalf("serveCachedBlocks failed: %v", err)
+	}
+	if served != 16384-4096 {
+		t.Errorf("Expected %d bytes served, got %d", 16384-4096, served)
+	}
+	if !bytes.Equal(got, content[4096:16384]) {
+		t.Error("Served data mismatch")
+	}
+}
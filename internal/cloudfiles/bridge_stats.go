@@ -0,0 +1,93 @@
+//go:build windows
+// +build windows
+
+// Package cloudfiles provides Go bindings for the Windows Cloud Files API.
+package cloudfiles
+
+import (
+	"time"
+)
+
+// HistogramBuckets is the number of log2 buckets of a LatencyHistogram
+// (CFAPI_BRIDGE_HISTOGRAM_BUCKETS).
+const HistogramBuckets = 32
+
+// bridgeStage identifies a hot-path stage (must match CfapiBridgeStage).
+type bridgeStage int32
+
+const (
+	stageCallbackEnqueue bridgeStage = iota
+	stageQueueWait
+	stageDispatch
+	stageFirstByte
+	stageCfExecute
+	stageHydration
+)
+
+// LatencyHistogram is a log2-bucketed latency distribution.
+// Buckets[0] counts durations under 1us, Buckets[i] those in
+// [2^(i-1), 2^i) us, and the last bucket everything longer.
+type LatencyHistogram struct {
+	Count   int64
+	Sum     time.Duration
+	Max     time.Duration
+	Buckets [HistogramBuckets]int64
+}
+
+// Mean returns the average duration (0 when empty).
+func (h LatencyHistogram) Mean() time.Duration {
+	if h.Count == 0 {
+		return 0
+	}
+	return h.Sum / time.Duration(h.Count)
+}
+
+// Quantile returns an upper bound of the q-quantile (0 < q <= 1): the upper
+// edge of the bucket holding it, capped at Max.
+func (h LatencyHistogram) Quantile(q float64) time.Duration {
+	var total int64
+	for _, n := range h.Buckets {
+		total += n
+	}
+	if total == 0 {
+		return 0
+	}
+
+	rank := int64(q*float64(total) + 0.5)
+	if rank < 1 {
+		rank = 1
+	}
+	var seen int64
+	for i, n := range h.Buckets {
+		seen += n
+		if seen >= rank {
+			upper := time.Duration(int64(1)<<uint(i)) * time.Microsecond
+			if i == HistogramBuckets-1 || upper > h.Max {
+				return h.Max
+			}
+			return upper
+		}
+	}
+	return h.Max
+}
+
+// CallbackCounters holds one counter per bridged callback type.
+type CallbackCounters struct {
+	FetchData    int64
+	CancelFetch  int64
+	NotifyDelete int64
+	NotifyRename int64
+}
+
+// BridgeStats is a snapshot of the bridge hot-path statistics (process-wide).
+type BridgeStats struct {
+	CallbackEnqueue LatencyHistogram // Callback entry until queued
+	QueueWait       LatencyHistogram // Queued until polled by a worker
+	Dispatch        LatencyHistogram // Polled until the fetch handler starts (scheduler wait)
+	FirstByte       LatencyHistogram // Remote open until its first byte
+	CfExecute       LatencyHistogram // One CfExecute transfer call
+	Hydration       LatencyHistogram // Whole fetch handler
+
+	Callbacks        CallbackCounters // Callbacks received
+	TransferredBytes int64            // Bytes handed to Windows by TRANSFER_DATA
+}
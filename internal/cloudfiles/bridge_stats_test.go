@@ -0,0 +1,37 @@
+//go:build windows
+// +build windows
+
+package cloudfiles
+
+import (
+	"testing"
+	"time"
+)
+
+func TestLatencyHistogramEmpty(t *testing.T) {
+	var h LatencyHistogram
+	if h.Mean() != 0 || h.Quantile(0.5) != 0 {
+		t.Errorf("Expected zero mean and quantile, got %v and %v", h.Mean(), h.Quantile(0.5))
+	}
+}
+
+func TestLatencyHistogramQuantile(t *testing.T) {
+	h := LatencyHistogram{
+		Count: 100,
+		Sum:   100 * 300 * time.Microsecond,
+		Max:   3 * time.Millisecond,
+	}
+	h.Buckets[9] = 90  // [256us, 512us)
+	h.Buckets[12] = 10 // [2048us, 4096us)
+
+	if h.Mean() != 300*time.Microsecond {
+		t.Errorf("Expected mean 300us, got %v", h.Mean())
+	}
+	if got := h.Quantile(0.5); got != 512*time.Microsecond {
+		t.Errorf("Expected p50 bound 512us, got %v", got)
+	}
+	// The top bucket's upper edge is past Max
+	if got := h.Quantile(0.99); got != h.Max {
+		t.Errorf("Expected p99 capped at max %v, got %v", h.Max, got)
+	}
+}
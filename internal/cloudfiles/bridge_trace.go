@@ -0,0 +1,133 @@
+//go:build windows
+// +build windows
+
+package cloudfiles
+
+import (
+	"fmt"
+	"time"
+)
+
+// BridgeTraceKind identifies a bridge trace event (must match CfapiBridgeTraceEventType).
+type BridgeTraceKind int32
+
+const (
+	TraceCallback      BridgeTraceKind = 1  // Callback received
+	TraceEnqueueFailed BridgeTraceKind = 2  // Request dropped
+	TraceDequeue       BridgeTraceKind = 3  // Request polled by a worker
+	TraceCancel        BridgeTraceKind = 4  // Cancellation posted on the lane
+	TraceTransfer      BridgeTraceKind = 5  // CfExecute(TRANSFER_DATA)
+	TraceComplete      BridgeTraceKind = 6  // CfExecute(ACK_DATA)
+	TraceError         BridgeTraceKind = 7  // Transfer failed
+	TraceConnect       BridgeTraceKind = 8  // Sync root connected
+	TraceDisconnect    BridgeTraceKind = 9  // Sync root disconnected
+	TracePlaceholders  BridgeTraceKind = 10 // CfExecute(TRANSFER_PLACEHOLDERS)
+)
+
+// String returns the event name.
+func (k BridgeTraceKind) String() string {
+	switch k {
+	case TraceCallback:
+		return "CALLBACK"
+	case TraceEnqueueFailed:
+		return "ENQUEUE_FAILED"
+	case TraceDequeue:
+		return "DEQUEUE"
+	case TraceCancel:
+		return "CANCEL"
+	case TraceTransfer:
+		return "TRANSFER"
+	case TraceComplete:
+		return "COMPLETE"
+	case TraceError:
+		return "ERROR"
+	case TraceConnect:
+		return "CONNECT"
+	case TraceDisconnect:
+		return "DISCONNECT"
+	case TracePlaceholders:
+		return "PLACEHOLDERS"
+	default:
+		return fmt.Sprintf("EVENT(%d)", int32(k))
+	}
+}
+
+// BridgeLogLevel is the level of the bridge text log (CfapiBridgeLogLevel).
+type BridgeLogLevel int32
+
+const (
+	BridgeLogOff BridgeLogLevel = iota
+	BridgeLogError
+	BridgeLogWarn
+	BridgeLogInfo
+	BridgeLogDebug
+)
+
+// BridgeTraceEvent is one event of the bridge trace ring.
+type BridgeTraceEvent struct {
+	Time          time.Duration // Since the bridge was initialized
+	Kind          BridgeTraceKind
+	CallbackType  int32 // CFAPI_CALLBACK_*, -1 = none
+	ConnectionKey int64
+	TransferKey   int64
+	Arg1          int64 // Offset (CALLBACK, DEQUEUE, TRANSFER), reported HRESULT (ERROR) or batch count (PLACEHOLDERS)
+	Arg2          int64 // Length (CALLBACK, DEQUEUE, TRANSFER) or listing total (PLACEHOLDERS)
+	Result        int32 // Bridge error or HRESULT, depending on Kind
+	ThreadID      uint32
+}
+
+// String formats the event as a single trace line.
+func (e BridgeTraceEvent) String() string {
+	s := fmt.Sprintf("%12.6f [%5d] %-14s", e.Time.Seconds(), e.ThreadID, e.Kind)
+	if name := callbackTypeName(e.CallbackType); name != "" {
+		s += " " + name
+	}
+	if e.TransferKey != 0 {
+		s += fmt.Sprintf(" xfer=%d", e.TransferKey)
+	}
+
+	switch e.Kind {
+	case TraceCallback, TraceDequeue, TraceTransfer:
+		if e.Arg2 != 0 {
+			s += fmt.Sprintf(" range=%d+%d", e.Arg1, e.Arg2)
+		}
+	case TraceError:
+		s += fmt.Sprintf(" status=0x%08X", uint32(e.Arg1))
+	case TracePlaceholders:
+		s += fmt.Sprintf(" entries=%d/%d", e.Arg1, e.Arg2)
+	}
+
+	switch e.Kind {
+	case TraceTransfer, TraceComplete, TraceError, TraceConnect, TraceDisconnect, TracePlaceholders:
+		if e.Result != 0 {
+			s += fmt.Sprintf(" hr=0x%08X", uint32(e.Result))
+		}
+	default:
+		if e.Result != 0 {
+			s += fmt.Sprintf(" result=%d", e.Result)
+		}
+	}
+	return s
+}
+
+// callbackTypeName names a bridged callback type ("" for none).
+func callbackTypeName(t int32) string {
+	switch t {
+	case 0:
+		return "FETCH_DATA"
+	case 2:
+		return "CANCEL_FETCH_DATA"
+	case 3:
+		return "FETCH_PLACEHOLDERS"
+	case 8:
+		return "NOTIFY_DEHYDRATE_COMPLETION"
+	case 9:
+		return "NOTIFY_DELETE"
+	case 11:
+		return "NOTIFY_RENAME"
+	case -1:
+		return ""
+	default:
+		return fmt.Sprintf("TYPE(%d)", t)
+	}
+}
@@ -0,0 +1,42 @@
+//go:build windows
+// +build windows
+
+package cloudfiles
+
+import (
+	"strings"
+	"testing"
+	"time"
+)
+
+func TestBridgeTraceEventString(t *testing.T) {
+	e := BridgeTraceEvent{
+		Time:         1500 * time.Millisecond,
+		Kind:         TraceTransfer,
+		CallbackType: 0,
+		TransferKey:  42,
+		Arg1:         4096,
+		Arg2:         65536,
+		ThreadID:     7,
+	}
+	got := e.String()
+	for _, want := range []string{"TRANSFER", "FETCH_DATA", "xfer=42", "range=4096+65536"} {
+		if !strings.Contains(got, want) {
+			t.Errorf("Expected %q in %q", want, got)
+		}
+	}
+	if strings.Contains(got, "hr=") {
+		t.Errorf("Expected no HRESULT for a successful transfer, got %q", got)
+	}
+
+	failed := BridgeTraceEvent{Kind: TraceError, CallbackType: 0, Arg1: 0x80004005, Result: -2147024809}
+	got = failed.String()
+	if !strings.Contains(got, "status=0x80004005") || !strings.Contains(got, "hr=0x80070057") {
+		t.Errorf("Expected reported and returned HRESULTs, got %q", got)
+	}
+
+	connect := BridgeTraceEvent{Kind: TraceConnect, CallbackType: -1}
+	if strings.Contains(connect.String(), "TYPE(") {
+		t.Errorf("Expected no callback type for a connect event, got %q", connect.String())
+	}
+}
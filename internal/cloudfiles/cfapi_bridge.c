@@ -6,6 +6,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdarg.h>
+#include <stddef.h>
 #include <time.h>
 
 // Error codes
@@ -13,12 +14,16 @@
 #define E_OUTOFMEMORY ((HRESULT)0x8007000EL)
 #endif
 
-// --- Debug logging ---
-static int g_debugLogging = 0; // Disabled by default (set to 1 for troubleshooting)
-
-static void DebugLog(const char* format, ...) {
-    if (!g_debugLogging) return;
+// --- Logging ---
+// Text logging to stderr is compiled in only by debug builds (Go build tag
+// cfapi_debug, which defines CFAPI_BRIDGE_DEBUG). In release builds the
+// BRIDGE_LOG_* macros expand to an unevaluated sizeof: nothing runs on the
+// filter threads, yet variables only used for logging still count as used.
+// Field diagnostics go through the binary trace ring (BridgeTrace) instead.
+#ifdef CFAPI_BRIDGE_DEBUG
+static int g_logLevel = CFAPI_BRIDGE_LOG_DEBUG; // Set by CfapiBridgeSetLogLevel
 
+static void BridgeLog(const char* format, ...) {
     // Get timestamp
     time_t now = time(NULL);
     struct tm* t = localtime(&now);
@@ -34,9 +39,7 @@ static void DebugLog(const char* format, ...) {
     fflush(stderr);
 }
 
-static void DebugLogW(const wchar_t* prefix, const wchar_t* path) {
-    if (!g_debugLogging) return;
-
+static void BridgeLogW(const wchar_t* prefix, const wchar_t* path) {
     time_t now = time(NULL);
     struct tm* t = localtime(&now);
 
@@ -44,6 +47,25 @@ static void DebugLogW(const wchar_t* prefix, const wchar_t* path) {
     fflush(stderr);
 }
 
+#define BRIDGE_LOG(level, ...) \
+    do { if ((level) <= g_logLevel) BridgeLog(__VA_ARGS__); } while (0)
+#define BRIDGE_LOG_PATH(prefix, path) \
+    do { if (CFAPI_BRIDGE_LOG_DEBUG <= g_logLevel) BridgeLogW((prefix), (path)); } while (0)
+#else
+static inline int BridgeLogDiscard(const char* format, ...) {
+    (void)format;
+    return 0;
+}
+
+#define BRIDGE_LOG(level, ...) ((void)sizeof(BridgeLogDiscard(__VA_ARGS__)))
+#define BRIDGE_LOG_PATH(prefix, path) ((void)sizeof(BridgeLogDiscard("", (prefix), (path))))
+#endif
+
+#define BRIDGE_LOG_ERROR(...) BRIDGE_LOG(CFAPI_BRIDGE_LOG_ERROR, __VA_ARGS__)
+#define BRIDGE_LOG_WARN(...)  BRIDGE_LOG(CFAPI_BRIDGE_LOG_WARN, __VA_ARGS__)
+#define BRIDGE_LOG_INFO(...)  BRIDGE_LOG(CFAPI_BRIDGE_LOG_INFO, __VA_ARGS__)
+#define BRIDGE_LOG_DEBUG(...) BRIDGE_LOG(CFAPI_BRIDGE_LOG_DEBUG, __VA_ARGS__)
+
 // --- Cloud Files API definitions (from cfapi.h) ---
 // We define these ourselves to avoid SDK dependency
 
@@ -121,6 +143,17 @@ typedef struct {
     LONGLONG RequestKey;
 } CF_CALLBACK_INFO;
 
+// Process info, provided with CF_CONNECT_FLAG_REQUIRE_PROCESS_INFO
+typedef struct {
+    DWORD StructSize;
+    DWORD ProcessId;
+    LPCWSTR ImagePath;
+    LPCWSTR PackageName;
+    LPCWSTR ApplicationId;
+    LPCWSTR CommandLine;
+    DWORD SessionId;
+} CF_PROCESS_INFO;
+
 // Callback parameter structures
 typedef struct {
     DWORD Flags;
@@ -132,6 +165,13 @@ typedef struct {
     DWORD LastDehydrationReason;
 } CF_CALLBACK_PARAMETERS_FETCHDATA;
 
+// Cancel.FetchData of the SDK (FileOffset and Length are LARGE_INTEGERs)
+typedef struct {
+    DWORD Flags;
+    LONGLONG FileOffset;
+    LONGLONG Length;
+} CF_CALLBACK_PARAMETERS_CANCEL;
+
 typedef struct {
     DWORD Flags;
 } CF_CALLBACK_PARAMETERS_DELETE;
@@ -141,12 +181,27 @@ typedef struct {
     LPCWSTR TargetPath;
 } CF_CALLBACK_PARAMETERS_RENAME;
 
+typedef struct {
+    DWORD Flags;
+    LPCWSTR Pattern;
+} CF_CALLBACK_PARAMETERS_FETCHPLACEHOLDERS;
+
+typedef struct {
+    DWORD Flags;
+    DWORD Reason;
+} CF_CALLBACK_PARAMETERS_DEHYDRATECOMPLETION;
+
+#define CF_CALLBACK_DEHYDRATE_COMPLETION_FLAG_DEHYDRATED 0x00000002
+
 typedef struct {
     DWORD ParamSize;
     union {
         CF_CALLBACK_PARAMETERS_FETCHDATA FetchData;
+        CF_CALLBACK_PARAMETERS_CANCEL Cancel;
         CF_CALLBACK_PARAMETERS_DELETE Delete;
         CF_CALLBACK_PARAMETERS_RENAME Rename;
+        CF_CALLBACK_PARAMETERS_FETCHPLACEHOLDERS FetchPlaceholders;
+        CF_CALLBACK_PARAMETERS_DEHYDRATECOMPLETION DehydrateCompletion;
         BYTE Reserved[64];
     };
 } CF_CALLBACK_PARAMETERS;
@@ -193,32 +248,160 @@ typedef struct {
     LARGE_INTEGER Length;
 } CF_OPERATION_ACK_DATA_PARAMS;
 
+// Operation parameters for transfer placeholders
+typedef struct {
+    DWORD Flags;                    // 0-3
+    HRESULT CompletionStatus;       // 4-7
+    LARGE_INTEGER PlaceholderTotalCount; // 8-15
+    LPVOID PlaceholderArray;        // 16-23 (CF_PLACEHOLDER_CREATE_INFO*)
+    DWORD PlaceholderCount;         // 24-27
+    DWORD EntriesProcessed;         // 28-31
+} CF_OPERATION_TRANSFER_PLACEHOLDERS_PARAMS;
+
 typedef struct {
     DWORD ParamSize;
     union {
         CF_OPERATION_TRANSFER_DATA_PARAMS TransferData;
         CF_OPERATION_ACK_DATA_PARAMS AckData;
+        CF_OPERATION_TRANSFER_PLACEHOLDERS_PARAMS TransferPlaceholders;
         BYTE Reserved[128];
     };
 } CF_OPERATION_PARAMETERS;
 
 // --- Internal State ---
 
-// Request queue (circular buffer)
-static CfapiBridgeRequest g_requestQueue[CFAPI_BRIDGE_MAX_QUEUE_SIZE];
-static int g_queueHead = 0;
-static int g_queueTail = 0;
-static int g_queueCount = 0;
+// --- Atomics ---
+// Plain volatile reads carry no acquire semantics under GCC/MinGW, so the
+// lock-free queue uses explicit acquire/release accessors.
+#if defined(__GNUC__)
+#define BRIDGE_LOAD_ACQUIRE(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define BRIDGE_STORE_RELEASE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#else
+#define BRIDGE_LOAD_ACQUIRE(p) InterlockedCompareExchange((p), 0, 0)
+#define BRIDGE_STORE_RELEASE(p, v) InterlockedExchange((p), (v))
+#endif
+
+#define CFAPI_BRIDGE_QUEUE_MASK (CFAPI_BRIDGE_MAX_QUEUE_SIZE - 1)
+#define CFAPI_BRIDGE_CACHE_LINE 64
+
+// One ring cell. The sequence number tells producers and consumers whose
+// turn it is: seq == pos means free for the producer claiming pos,
+// seq == pos + 1 means filled and ready for the consumer claiming pos.
+typedef struct {
+    volatile LONG sequence;
+    CfapiBridgeRequest request;
+} CfapiBridgeQueueCell;
+
+// Path slab block: paths are stored as chains of fixed-size blocks so a
+// request only carries a block index and a length. With the link field a
+// block is exactly 128 bytes.
+typedef struct {
+    volatile LONG next;         // Next block index + 1 in the chain or free list (0 = end)
+    wchar_t chars[CFAPI_BRIDGE_PATH_BLOCK_CHARS];
+} CfapiBridgePathBlock;
+
+// Overflow chunk, allocated when the ring is full (bursts of bulk operations)
+typedef struct CfapiBridgeQueueChunk {
+    struct CfapiBridgeQueueChunk* next;
+    int32_t head;               // Next request to consume
+    int32_t tail;               // Next free entry
+    CfapiBridgeRequest requests[CFAPI_BRIDGE_QUEUE_CHUNK_SIZE];
+} CfapiBridgeQueueChunk;
+
+// Per-connection request queue, one per connected sync root.
+// Lock-free bounded ring (Vyukov style): filter threads claim a cell with a
+// single InterlockedCompareExchange on enqueuePos and copy the request
+// without holding any lock; consumers do the same on dequeuePos. The
+// semaphore only wakes sleeping consumers.
+// When the ring is full, requests spill into a list of overflow chunks
+// (guarded by overflowLock) that grows up to queueLimit total requests.
+// While the overflow holds anything, producers append there so requests
+// stay in FIFO order; consumers always drain the ring first.
+typedef struct {
+    int64_t connectionKey;
+    int inUse;
+    HANDLE requestSemaphore;    // One count per queued request
+    HANDLE stopEvent;           // Manual-reset, wakes every worker on stop
+    HANDLE spaceEvent;          // Auto-reset, signaled on dequeue while producers wait
+
+    int32_t queueLimit;         // Ring + overflow capacity cap, fixed at creation
+    CRITICAL_SECTION overflowLock;
+    CfapiBridgeQueueChunk* overflowHead;
+    CfapiBridgeQueueChunk* overflowTail;
+    CfapiBridgeQueueChunk* spareChunk;  // One drained chunk kept to avoid alloc churn
+    int32_t overflowChunks;             // Chunks linked in the overflow list
+    volatile LONG overflowCount;        // Requests in the overflow list
+
+    // Path slab: segments of CFAPI_BRIDGE_PATH_SEGMENT_BLOCKS blocks, added
+    // on demand. Free blocks form a lock-free stack whose head packs an ABA
+    // tag (high 32 bits) with the top block index + 1 (low 32 bits, 0 = empty).
+    CfapiBridgePathBlock* pathSegments[CFAPI_BRIDGE_MAX_PATH_SEGMENTS];
+    volatile LONG pathSegmentCount;
+    volatile LONGLONG pathFreeHead;
+    CRITICAL_SECTION pathGrowLock;
+
+    // Backpressure statistics
+    volatile LONG waitingProducers;
+    volatile LONG highWater;
+    volatile LONGLONG producerWaits;
+    volatile LONGLONG dropped[CFAPI_BRIDGE_DROP_TYPE_COUNT];
+
+    // Cancellation lane: transfer keys and ranges of CANCEL_FETCH_DATA callbacks.
+    // A dedicated thread waits on its semaphore (CfapiBridgeWaitForCancel), so
+    // a cancel overtakes the queued fetches even while every worker is busy.
+    CRITICAL_SECTION cancelLock;
+    HANDLE cancelSemaphore;     // One count per queued cancellation
+    int32_t cancelHead;
+    int32_t cancelCount;
+    CfapiBridgeCancel cancels[CFAPI_BRIDGE_CANCEL_LANE_SIZE];
+
+    volatile LONG enqueuePos;
+    char pad1[CFAPI_BRIDGE_CACHE_LINE - sizeof(LONG)];
+    volatile LONG dequeuePos;
+    char pad2[CFAPI_BRIDGE_CACHE_LINE - sizeof(LONG)];
+
+    CfapiBridgeQueueCell cells[CFAPI_BRIDGE_MAX_QUEUE_SIZE];
+} CfapiBridgeConnectionQueue;
+
+static CfapiBridgeConnectionQueue g_connectionQueues[CFAPI_BRIDGE_MAX_CONNECTIONS];
+
+static int GrowPathSlab(CfapiBridgeConnectionQueue* queue);
+
+// Producer CAS retries (contention left between filter threads)
+static volatile LONGLONG g_queueProducerRetries = 0;
+
+// Hot-path statistics. Every field is updated with interlocked operations,
+// so recording never takes a lock on the filter or worker threads.
+typedef struct {
+    volatile LONGLONG count;
+    volatile LONGLONG sumMicros;
+    volatile LONGLONG maxMicros;
+    volatile LONGLONG buckets[CFAPI_BRIDGE_HISTOGRAM_BUCKETS];
+} BridgeHistogram;
+
+static BridgeHistogram g_stageStats[CFAPI_BRIDGE_STAGE_COUNT];
+static volatile LONGLONG g_callbackCounts[CFAPI_BRIDGE_DROP_TYPE_COUNT];
+static volatile LONGLONG g_transferredBytes;
+static LONGLONG g_qpcFrequency = 0; // Set by CfapiBridgeInit
+
+// Queue limits, set by CfapiBridgeSetQueueLimits
+static int32_t g_queueLimit = CFAPI_BRIDGE_DEFAULT_QUEUE_LIMIT;             // Applies to queues created afterwards
+static volatile LONG g_producerWaitMs = CFAPI_BRIDGE_DEFAULT_PRODUCER_WAIT_MS; // Read on every full-queue enqueue
 
 // Synchronization
-static CRITICAL_SECTION g_queueCS;
-static HANDLE g_newRequestEvent = NULL;
+static SRWLOCK g_queueTableLock = SRWLOCK_INIT; // Guards inUse/connectionKey of the queue table
 static int g_initialized = 0;
 
-// Shared fetch request for thread-safe data transfer
-static CfapiBridgeSharedFetchRequest g_sharedFetchRequest;
-static CRITICAL_SECTION g_sharedFetchCS;
-static int g_sharedFetchInitialized = 0;
+// Transfer buffer pool (one VirtualAlloc region split into chunk buffers)
+static uint8_t* g_transferPoolBase = NULL;
+static volatile LONG g_transferBufferInUse[CFAPI_BRIDGE_MAX_TRANSFER_BUFFERS];
+static int32_t g_transferBufferCount = 0;
+static int32_t g_requestedTransferBuffers = 0;  // Set by CfapiBridgeSetTransferBufferCount before init
+static volatile LONG g_transferBufferNext = 0;  // Round-robin start index
+static HANDLE g_transferBufferSemaphore = NULL; // Counts free buffers
+
+static int32_t InitTransferBufferPool(int32_t count);
+static void CleanupTransferBufferPool(void);
 
 // Cloud Files API function pointers (loaded dynamically)
 typedef HRESULT (WINAPI *PFN_CfConnectSyncRoot)(
@@ -253,47 +436,749 @@ static PFN_CfReportProviderProgress g_pfnCfReportProviderProgress = NULL;
 
 // --- Internal Functions ---
 
-// Enqueue a request (thread-safe)
-static int EnqueueRequest(const CfapiBridgeRequest* request) {
-    EnterCriticalSection(&g_queueCS);
+// Find the queue for a connection (caller holds g_queueTableLock)
+static CfapiBridgeConnectionQueue* FindQueueLocked(int64_t connectionKey) {
+    for (int i = 0; i < CFAPI_BRIDGE_MAX_CONNECTIONS; i++) {
+        if (g_connectionQueues[i].inUse && g_connectionQueues[i].connectionKey == connectionKey) {
+            return &g_connectionQueues[i];
+        }
+    }
+    return NULL;
+}
 
-    if (g_queueCount >= CFAPI_BRIDGE_MAX_QUEUE_SIZE) {
-        LeaveCriticalSection(&g_queueCS);
-        return CFAPI_BRIDGE_ERROR_QUEUE_FULL;
+// Find the queue for a connection.
+// The returned pointer stays valid until RemoveQueue, which only runs after
+// CfDisconnectSyncRoot (no more callbacks) and after the Go consumers stopped.
+static CfapiBridgeConnectionQueue* FindQueue(int64_t connectionKey) {
+    AcquireSRWLockShared(&g_queueTableLock);
+    CfapiBridgeConnectionQueue* queue = FindQueueLocked(connectionKey);
+    ReleaseSRWLockShared(&g_queueTableLock);
+    return queue;
+}
+
+// Find the queue for a connection, creating it on first use.
+// Callbacks may fire before CfConnectSyncRoot returns, so enqueue can come first.
+static CfapiBridgeConnectionQueue* GetOrCreateQueue(int64_t connectionKey) {
+    CfapiBridgeConnectionQueue* queue = FindQueue(connectionKey);
+    if (queue) {
+        return queue;
+    }
+
+    AcquireSRWLockExclusive(&g_queueTableLock);
+    queue = FindQueueLocked(connectionKey);
+    if (!queue) {
+        for (int i = 0; i < CFAPI_BRIDGE_MAX_CONNECTIONS; i++) {
+            if (!g_connectionQueues[i].inUse) {
+                int32_t limit = g_queueLimit;
+                HANDLE sem = CreateSemaphoreW(NULL, 0, limit, NULL);
+                if (!sem) {
+                    BRIDGE_LOG_ERROR("ERROR: Failed to create queue semaphore (error=%lu)", GetLastError());
+                    break;
+                }
+                HANDLE stop = CreateEventW(NULL, TRUE, FALSE, NULL);
+                HANDLE space = CreateEventW(NULL, FALSE, FALSE, NULL);
+                HANDLE cancelSem = CreateSemaphoreW(NULL, 0, CFAPI_BRIDGE_CANCEL_LANE_SIZE, NULL);
+                if (!stop || !space || !cancelSem) {
+                    BRIDGE_LOG_ERROR("ERROR: Failed to create queue events (error=%lu)", GetLastError());
+                    if (stop) CloseHandle(stop);
+                    if (space) CloseHandle(space);
+                    if (cancelSem) CloseHandle(cancelSem);
+                    CloseHandle(sem);
+                    break;
+                }
+                queue = &g_connectionQueues[i];
+                queue->connectionKey = connectionKey;
+                queue->requestSemaphore = sem;
+                queue->stopEvent = stop;
+                queue->spaceEvent = space;
+                queue->cancelSemaphore = cancelSem;
+                queue->cancelHead = 0;
+                queue->cancelCount = 0;
+                queue->queueLimit = limit;
+                queue->enqueuePos = 0;
+                queue->dequeuePos = 0;
+                for (LONG c = 0; c < CFAPI_BRIDGE_MAX_QUEUE_SIZE; c++) {
+                    queue->cells[c].sequence = c;
+                }
+                InitializeCriticalSection(&queue->overflowLock);
+                InitializeCriticalSection(&queue->pathGrowLock);
+                InitializeCriticalSection(&queue->cancelLock);
+                queue->pathSegmentCount = 0;
+                queue->pathFreeHead = 0;
+                if (!GrowPathSlab(queue)) {
+                    BRIDGE_LOG_ERROR("ERROR: Failed to allocate path slab");
+                    DeleteCriticalSection(&queue->cancelLock);
+                    DeleteCriticalSection(&queue->pathGrowLock);
+                    DeleteCriticalSection(&queue->overflowLock);
+                    CloseHandle(stop);
+                    CloseHandle(space);
+                    CloseHandle(cancelSem);
+                    CloseHandle(sem);
+                    queue = NULL;
+                    break;
+                }
+                queue->overflowHead = NULL;
+                queue->overflowTail = NULL;
+                queue->spareChunk = NULL;
+                queue->overflowChunks = 0;
+                queue->overflowCount = 0;
+                queue->waitingProducers = 0;
+                queue->highWater = 0;
+                queue->producerWaits = 0;
+                memset((void*)queue->dropped, 0, sizeof(queue->dropped));
+                MemoryBarrier();
+                queue->inUse = 1;
+                BRIDGE_LOG_DEBUG("Created request queue %d for connectionKey=%lld", i, (long long)connectionKey);
+                break;
+            }
+        }
+    }
+    ReleaseSRWLockExclusive(&g_queueTableLock);
+
+    if (!queue) {
+        BRIDGE_LOG_ERROR("ERROR: No request queue available for connectionKey=%lld", (long long)connectionKey);
+    }
+    return queue;
+}
+
+// Free a queue's overflow chunks and handles (table lock held exclusively,
+// no producers or consumers left on the queue)
+static void ReleaseQueueResources(CfapiBridgeConnectionQueue* queue) {
+    CfapiBridgeQueueChunk* chunk = queue->overflowHead;
+    while (chunk) {
+        CfapiBridgeQueueChunk* next = chunk->next;
+        HeapFree(GetProcessHeap(), 0, chunk);
+        chunk = next;
+    }
+    if (queue->spareChunk) {
+        HeapFree(GetProcessHeap(), 0, queue->spareChunk);
+    }
+    queue->overflowHead = NULL;
+    queue->overflowTail = NULL;
+    queue->spareChunk = NULL;
+    queue->overflowChunks = 0;
+    queue->overflowCount = 0;
+    DeleteCriticalSection(&queue->overflowLock);
+
+    for (LONG i = 0; i < queue->pathSegmentCount; i++) {
+        HeapFree(GetProcessHeap(), 0, queue->pathSegments[i]);
+        queue->pathSegments[i] = NULL;
+    }
+    queue->pathSegmentCount = 0;
+    queue->pathFreeHead = 0;
+    DeleteCriticalSection(&queue->pathGrowLock);
+
+    queue->cancelHead = 0;
+    queue->cancelCount = 0;
+    DeleteCriticalSection(&queue->cancelLock);
+    CloseHandle(queue->cancelSemaphore);
+    queue->cancelSemaphore = NULL;
+
+    CloseHandle(queue->requestSemaphore);
+    queue->requestSemaphore = NULL;
+    CloseHandle(queue->stopEvent);
+    queue->stopEvent = NULL;
+    CloseHandle(queue->spaceEvent);
+    queue->spaceEvent = NULL;
+}
+
+// Remove the queue for a connection, dropping anything still queued
+static void RemoveQueue(int64_t connectionKey) {
+    AcquireSRWLockExclusive(&g_queueTableLock);
+    CfapiBridgeConnectionQueue* queue = FindQueueLocked(connectionKey);
+    if (queue) {
+        LONG pending = (queue->enqueuePos - queue->dequeuePos) + queue->overflowCount;
+        if (pending > 0) {
+            BRIDGE_LOG_DEBUG("Dropping %ld queued requests for connectionKey=%lld", (long)pending, (long long)connectionKey);
+        }
+        queue->inUse = 0;
+        ReleaseQueueResources(queue);
+    }
+    ReleaseSRWLockExclusive(&g_queueTableLock);
+}
+
+// --- Path Slab ---
+
+static CfapiBridgePathBlock* PathBlock(CfapiBridgeConnectionQueue* queue, LONG index) {
+    return &queue->pathSegments[index / CFAPI_BRIDGE_PATH_SEGMENT_BLOCKS][index % CFAPI_BRIDGE_PATH_SEGMENT_BLOCKS];
+}
+
+// Push a linked chain of blocks (first..last) onto the free list
+static void PushPathChain(CfapiBridgeConnectionQueue* queue, LONG first, LONG last) {
+    CfapiBridgePathBlock* tail = PathBlock(queue, last);
+    for (;;) {
+        LONGLONG head = InterlockedCompareExchange64(&queue->pathFreeHead, 0, 0);
+        tail->next = (LONG)(head & 0xFFFFFFFF);
+        LONGLONG tag = (LONGLONG)((ULONGLONG)head >> 32) + 1;
+        LONGLONG newHead = (LONGLONG)(((ULONGLONG)tag << 32) | (ULONG)(first + 1));
+        if (InterlockedCompareExchange64(&queue->pathFreeHead, newHead, head) == head) {
+            return;
+        }
     }
+}
 
-    memcpy(&g_requestQueue[g_queueTail], request, sizeof(CfapiBridgeRequest));
-    g_queueTail = (g_queueTail + 1) % CFAPI_BRIDGE_MAX_QUEUE_SIZE;
-    g_queueCount++;
+// Pop one free block, or -1 if the free list is empty
+static LONG PopPathBlock(CfapiBridgeConnectionQueue* queue) {
+    for (;;) {
+        LONGLONG head = InterlockedCompareExchange64(&queue->pathFreeHead, 0, 0);
+        LONG top = (LONG)(head & 0xFFFFFFFF);
+        if (top == 0) {
+            return -1;
+        }
+        // Segments are never freed while the queue lives, so reading next of a
+        // block another thread just popped is harmless; the tag rejects the CAS.
+        LONG next = PathBlock(queue, top - 1)->next;
+        LONGLONG tag = (LONGLONG)((ULONGLONG)head >> 32) + 1;
+        LONGLONG newHead = (LONGLONG)(((ULONGLONG)tag << 32) | (ULONG)next);
+        if (InterlockedCompareExchange64(&queue->pathFreeHead, newHead, head) == head) {
+            return top - 1;
+        }
+    }
+}
 
-    LeaveCriticalSection(&g_queueCS);
+// Add one segment of blocks to the slab. Returns 1 on success.
+static int GrowPathSlab(CfapiBridgeConnectionQueue* queue) {
+    int grown = 0;
+
+    EnterCriticalSection(&queue->pathGrowLock);
+    LONG segment = queue->pathSegmentCount;
+    if (segment < CFAPI_BRIDGE_MAX_PATH_SEGMENTS) {
+        CfapiBridgePathBlock* blocks = (CfapiBridgePathBlock*)HeapAlloc(
+            GetProcessHeap(), 0, sizeof(CfapiBridgePathBlock) * CFAPI_BRIDGE_PATH_SEGMENT_BLOCKS);
+        if (blocks) {
+            LONG base = segment * CFAPI_BRIDGE_PATH_SEGMENT_BLOCKS;
+            for (LONG i = 0; i < CFAPI_BRIDGE_PATH_SEGMENT_BLOCKS - 1; i++) {
+                blocks[i].next = base + i + 2;
+            }
+            queue->pathSegments[segment] = blocks;
+            BRIDGE_STORE_RELEASE(&queue->pathSegmentCount, segment + 1);
+            PushPathChain(queue, base, base + CFAPI_BRIDGE_PATH_SEGMENT_BLOCKS - 1);
+            grown = 1;
+            BRIDGE_LOG_DEBUG("Path slab for connectionKey=%lld grew to %ld segments",
+                     (long long)queue->connectionKey, (long)(segment + 1));
+        }
+    }
+    LeaveCriticalSection(&queue->pathGrowLock);
 
-    // Signal that a new request is available
-    SetEvent(g_newRequestEvent);
+    return grown;
+}
 
+static LONG AllocPathBlock(CfapiBridgeConnectionQueue* queue) {
+    LONG index = PopPathBlock(queue);
+    while (index < 0) {
+        LONG segments = BRIDGE_LOAD_ACQUIRE(&queue->pathSegmentCount);
+        EnterCriticalSection(&queue->pathGrowLock);
+        // Only grow if nobody else did while we waited for the lock
+        int grow = (queue->pathSegmentCount == segments);
+        LeaveCriticalSection(&queue->pathGrowLock);
+        if (grow && !GrowPathSlab(queue)) {
+            return -1;
+        }
+        index = PopPathBlock(queue);
+    }
+    return index;
+}
+
+// Copy a path into a chain of slab blocks.
+// *offset receives the first block index (-1 for an empty path), *length the
+// number of characters (truncated to CFAPI_BRIDGE_MAX_PATH - 1).
+static int StorePath(CfapiBridgeConnectionQueue* queue, const wchar_t* path, int32_t* offset, int32_t* length) {
+    *offset = -1;
+    *length = 0;
+    if (!path) {
+        return CFAPI_BRIDGE_OK;
+    }
+
+    size_t len = wcsnlen(path, CFAPI_BRIDGE_MAX_PATH - 1);
+    LONG first = -1;
+    LONG prev = -1;
+    for (size_t done = 0; done < len; done += CFAPI_BRIDGE_PATH_BLOCK_CHARS) {
+        LONG index = AllocPathBlock(queue);
+        if (index < 0) {
+            if (first >= 0) {
+                PushPathChain(queue, first, prev);
+            }
+            return CFAPI_BRIDGE_ERROR_QUEUE_FULL;
+        }
+
+        size_t n = len - done;
+        if (n > CFAPI_BRIDGE_PATH_BLOCK_CHARS) n = CFAPI_BRIDGE_PATH_BLOCK_CHARS;
+        CfapiBridgePathBlock* block = PathBlock(queue, index);
+        memcpy(block->chars, path + done, n * sizeof(wchar_t));
+        block->next = 0;
+
+        if (prev >= 0) {
+            PathBlock(queue, prev)->next = index + 1;
+        } else {
+            first = index;
+        }
+        prev = index;
+    }
+
+    *offset = first;
+    *length = (int32_t)len;
     return CFAPI_BRIDGE_OK;
 }
 
-// Dequeue a request (thread-safe)
-static int DequeueRequest(CfapiBridgeRequest* request) {
-    EnterCriticalSection(&g_queueCS);
+// Return a stored path's blocks to the free list
+static void FreePath(CfapiBridgeConnectionQueue* queue, int32_t offset) {
+    if (offset < 0) return;
+    LONG last = offset;
+    while (PathBlock(queue, last)->next != 0) {
+        last = PathBlock(queue, last)->next - 1;
+    }
+    PushPathChain(queue, offset, last);
+}
+
+// Copy a stored path into dest (NUL-terminated) and free its blocks
+static void LoadPath(CfapiBridgeConnectionQueue* queue, int32_t offset, int32_t length, wchar_t* dest) {
+    LONG index = offset;
+    int32_t done = 0;
+    while (index >= 0 && done < length) {
+        CfapiBridgePathBlock* block = PathBlock(queue, index);
+        int32_t n = length - done;
+        if (n > CFAPI_BRIDGE_PATH_BLOCK_CHARS) n = CFAPI_BRIDGE_PATH_BLOCK_CHARS;
+        memcpy(dest + done, block->chars, n * sizeof(wchar_t));
+        done += n;
+        index = block->next - 1;
+    }
+    dest[done] = L'\0';
+    FreePath(queue, offset);
+}
+
+// Number of requests currently queued (approximate while producers are active)
+static int QueueCount(CfapiBridgeConnectionQueue* queue) {
+    LONG count = BRIDGE_LOAD_ACQUIRE(&queue->enqueuePos) - BRIDGE_LOAD_ACQUIRE(&queue->dequeuePos);
+    if (count < 0) count = 0;
+    return (int)(count + BRIDGE_LOAD_ACQUIRE(&queue->overflowCount));
+}
 
-    if (g_queueCount == 0) {
-        LeaveCriticalSection(&g_queueCS);
-        return CFAPI_BRIDGE_ERROR_QUEUE_EMPTY;
+// Index into CfapiBridgeConnectionQueue.dropped for a callback type
+static int DropIndex(int32_t type) {
+    switch (type) {
+        case CFAPI_CALLBACK_FETCH_DATA:        return CFAPI_BRIDGE_DROP_FETCH_DATA;
+        case CFAPI_CALLBACK_CANCEL_FETCH_DATA: return CFAPI_BRIDGE_DROP_CANCEL_FETCH_DATA;
+        case CFAPI_CALLBACK_NOTIFY_DELETE:     return CFAPI_BRIDGE_DROP_NOTIFY_DELETE;
+        case CFAPI_CALLBACK_NOTIFY_RENAME:     return CFAPI_BRIDGE_DROP_NOTIFY_RENAME;
+        default:                               return -1;
     }
+}
 
-    memcpy(request, &g_requestQueue[g_queueHead], sizeof(CfapiBridgeRequest));
-    g_queueHead = (g_queueHead + 1) % CFAPI_BRIDGE_MAX_QUEUE_SIZE;
-    g_queueCount--;
+// --- Hot-path statistics ---
 
-    LeaveCriticalSection(&g_queueCS);
+// Current QPC ticks (0 before CfapiBridgeInit)
+static int64_t StatsNow(void) {
+    if (g_qpcFrequency == 0) {
+        return 0;
+    }
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+    return (int64_t)now.QuadPart;
+}
+
+// Record a duration in a stage histogram
+static void StatsRecord(int32_t stage, int64_t micros) {
+    if (stage < 0 || stage >= CFAPI_BRIDGE_STAGE_COUNT) {
+        return;
+    }
+    if (micros < 0) {
+        micros = 0;
+    }
+
+    int bucket = 0;
+    for (int64_t v = micros; v > 0 && bucket < CFAPI_BRIDGE_HISTOGRAM_BUCKETS - 1; v >>= 1) {
+        bucket++;
+    }
+
+    BridgeHistogram* h = &g_stageStats[stage];
+    InterlockedIncrement64(&h->count);
+    InterlockedExchangeAdd64(&h->sumMicros, micros);
+    InterlockedIncrement64(&h->buckets[bucket]);
+
+    LONGLONG seen = InterlockedCompareExchange64(&h->maxMicros, 0, 0);
+    while (micros > seen) {
+        LONGLONG prev = InterlockedCompareExchange64(&h->maxMicros, micros, seen);
+        if (prev == seen) break;
+        seen = prev;
+    }
+}
+
+// Record the time elapsed since a StatsNow timestamp
+static void StatsRecordSince(int32_t stage, int64_t start) {
+    if (start == 0) {
+        return;
+    }
+    StatsRecord(stage, (StatsNow() - start) * 1000000 / g_qpcFrequency);
+}
+
+// --- Field trace ---
+// Fixed ring of binary events, kept in release builds. A writer claims a
+// slot with one interlocked increment and publishes it by storing the claim
+// number last; a reader keeps a copied slot only if that number did not move.
+
+#define CFAPI_BRIDGE_TRACE_MASK (CFAPI_BRIDGE_TRACE_SIZE - 1)
+
+typedef struct {
+    volatile LONG sequence;     // Claim number + 1 of the event held, 0 while written
+    CfapiBridgeTraceEvent event;
+} BridgeTraceSlot;
+
+static BridgeTraceSlot g_traceSlots[CFAPI_BRIDGE_TRACE_SIZE];
+static volatile LONG g_traceNext = 0;       // Next claim number
+static volatile LONG g_traceEnabled = 1;    // Set by CfapiBridgeSetTraceEnabled
+static int64_t g_traceEpoch = 0;            // QPC ticks at CfapiBridgeInit
+
+// Record one trace event (any thread, lock-free)
+static void BridgeTrace(int32_t event, int32_t callbackType, int64_t connectionKey,
+                        int64_t transferKey, int64_t arg1, int64_t arg2, int32_t result) {
+    if (!BRIDGE_LOAD_ACQUIRE(&g_traceEnabled)) {
+        return;
+    }
+
+    ULONG claim = (ULONG)InterlockedIncrement(&g_traceNext) - 1;
+    BridgeTraceSlot* slot = &g_traceSlots[claim & CFAPI_BRIDGE_TRACE_MASK];
+    InterlockedExchange(&slot->sequence, 0);
+
+    int64_t micros = 0;
+    int64_t ticks = StatsNow() - g_traceEpoch;
+    if (g_qpcFrequency != 0 && ticks > 0) {
+        micros = ticks / g_qpcFrequency * 1000000 + ticks % g_qpcFrequency * 1000000 / g_qpcFrequency;
+    }
+
+    slot->event.micros = micros;
+    slot->event.connectionKey = connectionKey;
+    slot->event.transferKey = transferKey;
+    slot->event.arg1 = arg1;
+    slot->event.arg2 = arg2;
+    slot->event.event = event;
+    slot->event.callbackType = callbackType;
+    slot->event.result = result;
+    slot->event.threadId = (uint32_t)GetCurrentThreadId();
+    BRIDGE_STORE_RELEASE(&slot->sequence, (LONG)(claim + 1));
+}
+
+// Push a request into the lock-free ring (multi-producer)
+static int RingEnqueue(CfapiBridgeConnectionQueue* queue, const CfapiBridgeRequest* request) {
+    CfapiBridgeQueueCell* cell;
+    LONG pos = BRIDGE_LOAD_ACQUIRE(&queue->enqueuePos);
+    for (;;) {
+        cell = &queue->cells[pos & CFAPI_BRIDGE_QUEUE_MASK];
+        LONG seq = BRIDGE_LOAD_ACQUIRE(&cell->sequence);
+        LONG diff = (LONG)((ULONG)seq - (ULONG)pos);
+
+        if (diff == 0) {
+            // Cell is free for this position - try to claim it
+            LONG prev = InterlockedCompareExchange(&queue->enqueuePos, pos + 1, pos);
+            if (prev == pos) {
+                break;
+            }
+            pos = prev;
+        } else if (diff < 0) {
+            // Cell still holds an unconsumed request from the previous lap
+            return CFAPI_BRIDGE_ERROR_QUEUE_FULL;
+        } else {
+            // Another producer claimed this position first
+            pos = BRIDGE_LOAD_ACQUIRE(&queue->enqueuePos);
+        }
+        InterlockedIncrement64(&g_queueProducerRetries);
+    }
+
+    memcpy(&cell->request, request, sizeof(CfapiBridgeRequest));
+    BRIDGE_STORE_RELEASE(&cell->sequence, pos + 1);
+    return CFAPI_BRIDGE_OK;
+}
+
+// Pop a request from the lock-free ring (multi-consumer)
+static int RingDequeue(CfapiBridgeConnectionQueue* queue, CfapiBridgeRequest* request) {
+    CfapiBridgeQueueCell* cell;
+    LONG pos = BRIDGE_LOAD_ACQUIRE(&queue->dequeuePos);
+    for (;;) {
+        cell = &queue->cells[pos & CFAPI_BRIDGE_QUEUE_MASK];
+        LONG seq = BRIDGE_LOAD_ACQUIRE(&cell->sequence);
+        LONG diff = (LONG)((ULONG)seq - (ULONG)(pos + 1));
+
+        if (diff == 0) {
+            LONG prev = InterlockedCompareExchange(&queue->dequeuePos, pos + 1, pos);
+            if (prev == pos) {
+                break;
+            }
+            pos = prev;
+        } else if (diff < 0) {
+            if (BRIDGE_LOAD_ACQUIRE(&queue->enqueuePos) == pos) {
+                // Nothing claimed at this position - the ring is empty
+                return CFAPI_BRIDGE_ERROR_QUEUE_EMPTY;
+            }
+            // A producer claimed this cell but is still copying; the caller
+            // holds a semaphore count, so wait for it rather than lose it
+            YieldProcessor();
+            pos = BRIDGE_LOAD_ACQUIRE(&queue->dequeuePos);
+        } else {
+            pos = BRIDGE_LOAD_ACQUIRE(&queue->dequeuePos);
+        }
+    }
+
+    memcpy(request, &cell->request, sizeof(CfapiBridgeRequest));
+    // Hand the cell back to producers for the next lap
+    BRIDGE_STORE_RELEASE(&cell->sequence, pos + CFAPI_BRIDGE_MAX_QUEUE_SIZE);
+    return CFAPI_BRIDGE_OK;
+}
+
+// Append a request to the overflow list, growing it by one chunk if needed
+static int OverflowEnqueue(CfapiBridgeConnectionQueue* queue, const CfapiBridgeRequest* request) {
+    int result = CFAPI_BRIDGE_OK;
+
+    EnterCriticalSection(&queue->overflowLock);
+
+    // The ring may have drained while we waited for the lock
+    if (queue->overflowCount == 0 && RingEnqueue(queue, request) == CFAPI_BRIDGE_OK) {
+        LeaveCriticalSection(&queue->overflowLock);
+        return CFAPI_BRIDGE_OK;
+    }
+
+    CfapiBridgeQueueChunk* tail = queue->overflowTail;
+    if (!tail || tail->tail == CFAPI_BRIDGE_QUEUE_CHUNK_SIZE) {
+        int32_t capacity = CFAPI_BRIDGE_MAX_QUEUE_SIZE + (queue->overflowChunks + 1) * CFAPI_BRIDGE_QUEUE_CHUNK_SIZE;
+        if (capacity > queue->queueLimit) {
+            result = CFAPI_BRIDGE_ERROR_QUEUE_FULL;
+            goto done;
+        }
+
+        CfapiBridgeQueueChunk* chunk = queue->spareChunk;
+        if (chunk) {
+            queue->spareChunk = NULL;
+        } else {
+            chunk = (CfapiBridgeQueueChunk*)HeapAlloc(GetProcessHeap(), 0, sizeof(CfapiBridgeQueueChunk));
+            if (!chunk) {
+                result = CFAPI_BRIDGE_ERROR_QUEUE_FULL;
+                goto done;
+            }
+        }
+        chunk->next = NULL;
+        chunk->head = 0;
+        chunk->tail = 0;
+
+        if (tail) {
+            tail->next = chunk;
+        } else {
+            queue->overflowHead = chunk;
+        }
+        queue->overflowTail = chunk;
+        queue->overflowChunks++;
+        tail = chunk;
+        BRIDGE_LOG_DEBUG("Queue for connectionKey=%lld grew to %d overflow chunks",
+                 (long long)queue->connectionKey, queue->overflowChunks);
+    }
+
+    memcpy(&tail->requests[tail->tail], request, sizeof(CfapiBridgeRequest));
+    tail->tail++;
+    InterlockedIncrement(&queue->overflowCount);
+
+done:
+    LeaveCriticalSection(&queue->overflowLock);
+    return result;
+}
+
+// Take the oldest request from the overflow list, releasing drained chunks
+static int OverflowDequeue(CfapiBridgeConnectionQueue* queue, CfapiBridgeRequest* request) {
+    int result = CFAPI_BRIDGE_ERROR_QUEUE_EMPTY;
+
+    EnterCriticalSection(&queue->overflowLock);
+
+    CfapiBridgeQueueChunk* head = queue->overflowHead;
+    if (head && head->head < head->tail) {
+        memcpy(request, &head->requests[head->head], sizeof(CfapiBridgeRequest));
+        head->head++;
+        InterlockedDecrement(&queue->overflowCount);
+        result = CFAPI_BRIDGE_OK;
+
+        // Unlink a chunk once fully written and fully consumed
+        if (head->head == CFAPI_BRIDGE_QUEUE_CHUNK_SIZE || (head->head == head->tail && !head->next)) {
+            queue->overflowHead = head->next;
+            if (!queue->overflowHead) {
+                queue->overflowTail = NULL;
+            }
+            queue->overflowChunks--;
+            if (!queue->spareChunk) {
+                queue->spareChunk = head;
+            } else {
+                HeapFree(GetProcessHeap(), 0, head);
+            }
+        }
+    }
+
+    LeaveCriticalSection(&queue->overflowLock);
+    return result;
+}
+
+// Try once to queue a request: ring fast path, overflow list when full
+static int TryEnqueue(CfapiBridgeConnectionQueue* queue, const CfapiBridgeRequest* request) {
+    // Once requests spilled over, keep appending behind them to preserve order
+    if (BRIDGE_LOAD_ACQUIRE(&queue->overflowCount) == 0 &&
+        RingEnqueue(queue, request) == CFAPI_BRIDGE_OK) {
+        return CFAPI_BRIDGE_OK;
+    }
+    return OverflowEnqueue(queue, request);
+}
+
+// Record a new queue depth in the high-water mark
+static void UpdateHighWater(CfapiBridgeConnectionQueue* queue) {
+    LONG depth = (LONG)QueueCount(queue);
+    LONG seen = BRIDGE_LOAD_ACQUIRE(&queue->highWater);
+    while (depth > seen) {
+        LONG prev = InterlockedCompareExchange(&queue->highWater, depth, seen);
+        if (prev == seen) break;
+        seen = prev;
+    }
+}
+
+// Enqueue a request on its connection's queue, storing its paths in the
+// queue's path slab.
+// When the queue is at its limit the filter thread waits up to the producer
+// wait budget for a consumer to make room, then gives up; every rejected
+// request is counted per callback type.
+static int EnqueueRequest(CfapiBridgeRequest* request, const wchar_t* filePath, const wchar_t* targetPath) {
+    int64_t callbackStart = StatsNow();
+    int statsIdx = DropIndex(request->type);
+    if (statsIdx >= 0) {
+        InterlockedIncrement64(&g_callbackCounts[statsIdx]);
+    }
+    BridgeTrace(CFAPI_BRIDGE_TRACE_CALLBACK, request->type, request->connectionKey, request->transferKey,
+                request->requiredOffset, request->requiredLength, 0);
+
+    CfapiBridgeConnectionQueue* queue = GetOrCreateQueue(request->connectionKey);
+    if (!queue) {
+        BridgeTrace(CFAPI_BRIDGE_TRACE_ENQUEUE_FAILED, request->type, request->connectionKey,
+                    request->transferKey, 0, 0, CFAPI_BRIDGE_ERROR_QUEUE_FULL);
+        return CFAPI_BRIDGE_ERROR_QUEUE_FULL;
+    }
+
+    // Store paths first; if the slab is exhausted, waiting for queue room will not help
+    request->targetPathOffset = -1;
+    int result = StorePath(queue, filePath, &request->filePathOffset, &request->filePathLength);
+    if (result == CFAPI_BRIDGE_OK) {
+        result = StorePath(queue, targetPath, &request->targetPathOffset, &request->targetPathLength);
+    }
+    int pathsStored = (result == CFAPI_BRIDGE_OK);
+    request->timestamp = StatsNow();
+    if (pathsStored) {
+        result = TryEnqueue(queue, request);
+    }
+
+    DWORD budgetMs = (DWORD)BRIDGE_LOAD_ACQUIRE(&g_producerWaitMs);
+    if (result == CFAPI_BRIDGE_ERROR_QUEUE_FULL && pathsStored && budgetMs > 0) {
+        InterlockedIncrement(&queue->waitingProducers);
+        InterlockedIncrement64(&queue->producerWaits);
+
+        ULONGLONG deadline = GetTickCount64() + budgetMs;
+        for (;;) {
+            request->timestamp = StatsNow();
+            result = TryEnqueue(queue, request);
+            if (result != CFAPI_BRIDGE_ERROR_QUEUE_FULL) {
+                break;
+            }
+            ULONGLONG now = GetTickCount64();
+            if (now >= deadline) {
+                break;
+            }
+            WaitForSingleObject(queue->spaceEvent, (DWORD)(deadline - now));
+        }
+
+        InterlockedDecrement(&queue->waitingProducers);
+    }
+
+    if (result != CFAPI_BRIDGE_OK) {
+        FreePath(queue, request->filePathOffset);
+        FreePath(queue, request->targetPathOffset);
+        int idx = DropIndex(request->type);
+        if (idx >= 0) {
+            InterlockedIncrement64(&queue->dropped[idx]);
+        }
+        BridgeTrace(CFAPI_BRIDGE_TRACE_ENQUEUE_FAILED, request->type, request->connectionKey,
+                    request->transferKey, 0, 0, result);
+        return result;
+    }
+
+    UpdateHighWater(queue);
+    StatsRecordSince(CFAPI_BRIDGE_STAGE_CALLBACK_ENQUEUE, callbackStart);
+
+    // Signal that a new request is available (wakes exactly one consumer)
+    ReleaseSemaphore(queue->requestSemaphore, 1, NULL);
 
     return CFAPI_BRIDGE_OK;
 }
 
+// Post a cancellation on its connection's cancellation lane.
+// Returns CFAPI_BRIDGE_ERROR_QUEUE_FULL when the lane is full.
+static int EnqueueCancel(int64_t connectionKey, const CfapiBridgeCancel* cancel) {
+    CfapiBridgeConnectionQueue* queue = GetOrCreateQueue(connectionKey);
+    if (!queue) {
+        return CFAPI_BRIDGE_ERROR_QUEUE_FULL;
+    }
+
+    int result = CFAPI_BRIDGE_ERROR_QUEUE_FULL;
+    EnterCriticalSection(&queue->cancelLock);
+    if (queue->cancelCount < CFAPI_BRIDGE_CANCEL_LANE_SIZE) {
+        int32_t tail = (queue->cancelHead + queue->cancelCount) % CFAPI_BRIDGE_CANCEL_LANE_SIZE;
+        queue->cancels[tail] = *cancel;
+        queue->cancelCount++;
+        result = CFAPI_BRIDGE_OK;
+    }
+    LeaveCriticalSection(&queue->cancelLock);
+
+    if (result == CFAPI_BRIDGE_OK) {
+        ReleaseSemaphore(queue->cancelSemaphore, 1, NULL);
+    }
+    BridgeTrace(CFAPI_BRIDGE_TRACE_CANCEL, CFAPI_CALLBACK_CANCEL_FETCH_DATA, connectionKey, cancel->transferKey,
+                cancel->offset, cancel->length, result);
+    return result;
+}
+
+// Take the oldest cancellation from a connection's lane
+static int DequeueCancel(CfapiBridgeConnectionQueue* queue, CfapiBridgeCancel* cancel) {
+    int result = CFAPI_BRIDGE_ERROR_QUEUE_EMPTY;
+    EnterCriticalSection(&queue->cancelLock);
+    if (queue->cancelCount > 0) {
+        *cancel = queue->cancels[queue->cancelHead];
+        queue->cancelHead = (queue->cancelHead + 1) % CFAPI_BRIDGE_CANCEL_LANE_SIZE;
+        queue->cancelCount--;
+        result = CFAPI_BRIDGE_OK;
+    }
+    LeaveCriticalSection(&queue->cancelLock);
+    return result;
+}
+
+// Dequeue a request from a connection's queue (ring first, then overflow).
+// Paths are copied into pathBuffer (file path first, then target path) and
+// the request's offsets are rewritten to point into it.
+static int DequeueRequest(CfapiBridgeConnectionQueue* queue, CfapiBridgeRequest* request, wchar_t* pathBuffer) {
+    int result = RingDequeue(queue, request);
+    if (result == CFAPI_BRIDGE_ERROR_QUEUE_EMPTY && BRIDGE_LOAD_ACQUIRE(&queue->overflowCount) > 0) {
+        result = OverflowDequeue(queue, request);
+    }
+
+    if (result == CFAPI_BRIDGE_OK) {
+        StatsRecordSince(CFAPI_BRIDGE_STAGE_QUEUE_WAIT, request->timestamp);
+        BridgeTrace(CFAPI_BRIDGE_TRACE_DEQUEUE, request->type, request->connectionKey, request->transferKey,
+                    request->requiredOffset, request->requiredLength, 0);
+        LoadPath(queue, request->filePathOffset, request->filePathLength, pathBuffer);
+        request->filePathOffset = 0;
+        int32_t targetOffset = request->filePathLength + 1;
+        LoadPath(queue, request->targetPathOffset, request->targetPathLength, pathBuffer + targetOffset);
+        request->targetPathOffset = targetOffset;
+    }
+
+    // Let one blocked producer retry now that there is room
+    if (result == CFAPI_BRIDGE_OK && BRIDGE_LOAD_ACQUIRE(&queue->waitingProducers) > 0) {
+        SetEvent(queue->spaceEvent);
+    }
+
+    return result;
+}
+
 // --- Callback Handlers (called by Windows on filter thread) ---
 
+// Callback dumps are only compiled into debug builds
+#ifdef CFAPI_BRIDGE_DEBUG
 // Helper: Dump raw bytes of a structure
 static void DumpHex(const char* label, const void* data, size_t len) {
     const unsigned char* p = (const unsigned char*)data;
@@ -309,21 +1194,23 @@ static void DumpHex(const char* label, const void* data, size_t len) {
 }
 
 // Helper: Print callback info details
-static void PrintCallbackInfo(const char* callbackName, const CF_CALLBACK_INFO* info) {
-    DebugLog("=== %s CALLBACK ===", callbackName);
-    DebugLog("  StructSize from Windows: %u", info->StructSize);
-    DebugLog("  sizeof(CF_CALLBACK_INFO) in our code: %zu", sizeof(CF_CALLBACK_INFO));
-    DebugLog("  offsetof(RequestKey) in our code: %zu", (size_t)((char*)&info->RequestKey - (char*)info));
+static void LogCallbackInfo(const char* callbackName, const CF_CALLBACK_INFO* info) {
+    if (g_logLevel < CFAPI_BRIDGE_LOG_DEBUG) return; // DumpHex below is unconditional
+
+    BRIDGE_LOG_DEBUG("=== %s CALLBACK ===", callbackName);
+    BRIDGE_LOG_DEBUG("  StructSize from Windows: %u", info->StructSize);
+    BRIDGE_LOG_DEBUG("  sizeof(CF_CALLBACK_INFO) in our code: %zu", sizeof(CF_CALLBACK_INFO));
+    BRIDGE_LOG_DEBUG("  offsetof(RequestKey) in our code: %zu", (size_t)((char*)&info->RequestKey - (char*)info));
 
     // Dump raw bytes of the structure to find where RequestKey really is
     DumpHex("CF_CALLBACK_INFO first 160 bytes", info, 160);
 
-    DebugLog("  ConnectionKey: %lld", (long long)info->ConnectionKey);
-    DebugLog("  TransferKey: %lld", (long long)info->TransferKey);
-    DebugLog("  RequestKey (at our offset): %lld", (long long)info->RequestKey);
+    BRIDGE_LOG_DEBUG("  ConnectionKey: %lld", (long long)info->ConnectionKey);
+    BRIDGE_LOG_DEBUG("  TransferKey: %lld", (long long)info->TransferKey);
+    BRIDGE_LOG_DEBUG("  RequestKey (at our offset): %lld", (long long)info->RequestKey);
 
     // Also check bytes 136-152 in case RequestKey is at a different offset
-    DebugLog("  Raw bytes 136-152: %02X %02X %02X %02X %02X %02X %02X %02X | %02X %02X %02X %02X %02X %02X %02X %02X",
+    BRIDGE_LOG_DEBUG("  Raw bytes 136-152: %02X %02X %02X %02X %02X %02X %02X %02X | %02X %02X %02X %02X %02X %02X %02X %02X",
              ((unsigned char*)info)[136], ((unsigned char*)info)[137],
              ((unsigned char*)info)[138], ((unsigned char*)info)[139],
              ((unsigned char*)info)[140], ((unsigned char*)info)[141],
@@ -333,14 +1220,19 @@ static void PrintCallbackInfo(const char* callbackName, const CF_CALLBACK_INFO*
              ((unsigned char*)info)[148], ((unsigned char*)info)[149],
              ((unsigned char*)info)[150], ((unsigned char*)info)[151]);
 
-    DebugLog("  FileId: %lld", (long long)info->FileId);
-    DebugLog("  FileSize: %lld", (long long)info->FileSize);
-    DebugLog("  SyncRootFileId: %lld", (long long)info->SyncRootFileId);
-    DebugLog("  FileIdentityLength: %u", info->FileIdentityLength);
-    DebugLogW(L"  NormalizedPath", info->NormalizedPath);
-    DebugLogW(L"  VolumeDosName", info->VolumeDosName);
+    BRIDGE_LOG_DEBUG("  FileId: %lld", (long long)info->FileId);
+    BRIDGE_LOG_DEBUG("  FileSize: %lld", (long long)info->FileSize);
+    BRIDGE_LOG_DEBUG("  SyncRootFileId: %lld", (long long)info->SyncRootFileId);
+    BRIDGE_LOG_DEBUG("  FileIdentityLength: %u", info->FileIdentityLength);
+    BRIDGE_LOG_PATH(L"  NormalizedPath", info->NormalizedPath);
+    BRIDGE_LOG_PATH(L"  VolumeDosName", info->VolumeDosName);
 }
 
+#define BRIDGE_LOG_CALLBACK(name, info) LogCallbackInfo((name), (info))
+#else
+#define BRIDGE_LOG_CALLBACK(name, info) ((void)(name), (void)(info))
+#endif
+
 // FETCH_DATA callback - file needs hydration
 // Now that we've verified CfExecute works (session 059), use the queue approach:
 // 1. Enqueue the request to Go
@@ -350,19 +1242,23 @@ static void CALLBACK OnFetchDataCallback(
     const CF_CALLBACK_INFO* callbackInfo,
     const CF_CALLBACK_PARAMETERS* callbackParameters
 ) {
-    PrintCallbackInfo("FETCH_DATA", callbackInfo);
+    BRIDGE_LOG_CALLBACK("FETCH_DATA", callbackInfo);
 
     if (!g_initialized) {
-        DebugLog("ERROR: Bridge not initialized!");
+        BRIDGE_LOG_ERROR("ERROR: Bridge not initialized!");
         return;
     }
 
     // Extract fetch parameters
     int64_t requiredOffset = 0;
     int64_t requiredLength = 0;
+    int64_t optionalOffset = 0;
+    int64_t optionalLength = 0;
     if (callbackParameters && callbackParameters->ParamSize >= sizeof(DWORD) + sizeof(CF_CALLBACK_PARAMETERS_FETCHDATA)) {
         requiredOffset = callbackParameters->FetchData.RequiredFileOffset;
         requiredLength = callbackParameters->FetchData.RequiredLength;
+        optionalOffset = callbackParameters->FetchData.OptionalFileOffset;
+        optionalLength = callbackParameters->FetchData.OptionalLength;
     }
 
     // If requiredLength is 0 or negative, use file size
@@ -370,8 +1266,9 @@ static void CALLBACK OnFetchDataCallback(
         requiredLength = callbackInfo->FileSize - requiredOffset;
     }
 
-    DebugLog("  FetchData: offset=%lld, length=%lld, fileSize=%lld",
-             (long long)requiredOffset, (long long)requiredLength, (long long)callbackInfo->FileSize);
+    BRIDGE_LOG_DEBUG("  FetchData: offset=%lld, length=%lld, optional=%lld+%lld, fileSize=%lld",
+             (long long)requiredOffset, (long long)requiredLength,
+             (long long)optionalOffset, (long long)optionalLength, (long long)callbackInfo->FileSize);
 
     // Build request for Go
     CfapiBridgeRequest req;
@@ -384,16 +1281,22 @@ static void CALLBACK OnFetchDataCallback(
     req.fileSize = (int64_t)callbackInfo->FileSize;
     req.requiredOffset = requiredOffset;
     req.requiredLength = requiredLength;
-
-    if (callbackInfo->NormalizedPath) {
-        wcsncpy(req.filePath, callbackInfo->NormalizedPath, CFAPI_BRIDGE_MAX_PATH - 1);
-        req.filePath[CFAPI_BRIDGE_MAX_PATH - 1] = L'\0';
+    req.optionalOffset = optionalOffset;
+    req.optionalLength = optionalLength;
+    req.priorityHint = (int32_t)callbackInfo->PriorityHint;
+
+    // Who is asking, so Go can favour interactive opens over scanners
+    const wchar_t* imagePath = NULL;
+    const CF_PROCESS_INFO* processInfo = (const CF_PROCESS_INFO*)callbackInfo->ProcessInfo;
+    if (processInfo && processInfo->StructSize >= offsetof(CF_PROCESS_INFO, PackageName)) {
+        req.processId = (int32_t)processInfo->ProcessId;
+        imagePath = processInfo->ImagePath;
     }
 
-    // Enqueue the request for Go to process
-    int result = EnqueueRequest(&req);
+    // Enqueue the request for Go to process (image path in the target path slot)
+    int result = EnqueueRequest(&req, callbackInfo->NormalizedPath, imagePath);
     if (result != CFAPI_BRIDGE_OK) {
-        DebugLog("ERROR: Failed to enqueue FETCH_DATA request: %d", result);
+        BRIDGE_LOG_ERROR("ERROR: Failed to enqueue FETCH_DATA request: %d", result);
         // Report error to Windows
         CF_OPERATION_INFO opInfo;
         memset(&opInfo, 0, sizeof(opInfo));
@@ -412,7 +1315,7 @@ static void CALLBACK OnFetchDataCallback(
         return;
     }
 
-    DebugLog("FETCH_DATA enqueued for Go to process");
+    BRIDGE_LOG_DEBUG("FETCH_DATA enqueued for Go to process");
     // Callback returns - Go will call CfapiBridgeTransferData later
 }
 
@@ -421,11 +1324,10 @@ static void CALLBACK OnCancelFetchDataCallback(
     const CF_CALLBACK_INFO* callbackInfo,
     const CF_CALLBACK_PARAMETERS* callbackParameters
 ) {
-    (void)callbackParameters;
-    PrintCallbackInfo("CANCEL_FETCH_DATA", callbackInfo);
+    BRIDGE_LOG_CALLBACK("CANCEL_FETCH_DATA", callbackInfo);
 
     if (!g_initialized) {
-        DebugLog("ERROR: Bridge not initialized!");
+        BRIDGE_LOG_ERROR("ERROR: Bridge not initialized!");
         return;
     }
 
@@ -436,13 +1338,25 @@ static void CALLBACK OnCancelFetchDataCallback(
     req.connectionKey = (int64_t)callbackInfo->ConnectionKey;
     req.transferKey = (int64_t)callbackInfo->TransferKey;
 
-    if (callbackInfo->NormalizedPath) {
-        wcsncpy(req.filePath, callbackInfo->NormalizedPath, CFAPI_BRIDGE_MAX_PATH - 1);
-        req.filePath[CFAPI_BRIDGE_MAX_PATH - 1] = L'\0';
+    // The cancelled range (the transfer key alone is shared by the file's fetches)
+    if (callbackParameters && callbackParameters->ParamSize >= sizeof(DWORD) + sizeof(CF_CALLBACK_PARAMETERS_CANCEL)) {
+        req.requiredOffset = callbackParameters->Cancel.FileOffset;
+        req.requiredLength = callbackParameters->Cancel.Length;
     }
 
-    EnqueueRequest(&req);
-    DebugLog("CANCEL_FETCH_DATA enqueued");
+    // Fast lane first, so the cancel is not stuck behind queued fetches
+    CfapiBridgeCancel cancel = { req.transferKey, req.requiredOffset, req.requiredLength };
+    if (EnqueueCancel(req.connectionKey, &cancel) == CFAPI_BRIDGE_OK) {
+        InterlockedIncrement64(&g_callbackCounts[CFAPI_BRIDGE_DROP_CANCEL_FETCH_DATA]);
+        BRIDGE_LOG_DEBUG("CANCEL_FETCH_DATA posted on cancellation lane");
+        return;
+    }
+
+    if (EnqueueRequest(&req, callbackInfo->NormalizedPath, NULL) != CFAPI_BRIDGE_OK) {
+        BRIDGE_LOG_ERROR("ERROR: Queue full, CANCEL_FETCH_DATA dropped");
+        return;
+    }
+    BRIDGE_LOG_DEBUG("CANCEL_FETCH_DATA enqueued");
 }
 
 // NOTIFY_DELETE callback - file is being deleted
@@ -450,10 +1364,10 @@ static void CALLBACK OnNotifyDeleteCallback(
     const CF_CALLBACK_INFO* callbackInfo,
     const CF_CALLBACK_PARAMETERS* callbackParameters
 ) {
-    PrintCallbackInfo("NOTIFY_DELETE", callbackInfo);
+    BRIDGE_LOG_CALLBACK("NOTIFY_DELETE", callbackInfo);
 
     if (!g_initialized) {
-        DebugLog("ERROR: Bridge not initialized!");
+        BRIDGE_LOG_ERROR("ERROR: Bridge not initialized!");
         return;
     }
 
@@ -464,48 +1378,63 @@ static void CALLBACK OnNotifyDeleteCallback(
     req.connectionKey = (int64_t)callbackInfo->ConnectionKey;
     req.transferKey = (int64_t)callbackInfo->TransferKey;
 
-    if (callbackInfo->NormalizedPath) {
-        wcsncpy(req.filePath, callbackInfo->NormalizedPath, CFAPI_BRIDGE_MAX_PATH - 1);
-        req.filePath[CFAPI_BRIDGE_MAX_PATH - 1] = L'\0';
-    }
-
     // Check if directory from parameters
     if (callbackParameters && callbackParameters->ParamSize >= sizeof(DWORD) + sizeof(CF_CALLBACK_PARAMETERS_DELETE)) {
         req.isDirectory = (callbackParameters->Delete.Flags & CF_CALLBACK_DELETE_FLAG_IS_DIRECTORY) ? 1 : 0;
-        DebugLog("  IsDirectory: %d", req.isDirectory);
+        BRIDGE_LOG_DEBUG("  IsDirectory: %d", req.isDirectory);
     }
 
-    EnqueueRequest(&req);
-    DebugLog("NOTIFY_DELETE enqueued");
+    if (EnqueueRequest(&req, callbackInfo->NormalizedPath, NULL) != CFAPI_BRIDGE_OK) {
+        BRIDGE_LOG_ERROR("ERROR: Queue full, NOTIFY_DELETE dropped");
+        return;
+    }
+    BRIDGE_LOG_DEBUG("NOTIFY_DELETE enqueued");
 }
 
-// Debounce for FETCH_PLACEHOLDERS - track last call time per path
-static DWORD g_lastFetchPlaceholdersTime = 0;
-static wchar_t g_lastFetchPlaceholdersPath[CFAPI_BRIDGE_MAX_PATH] = {0};
-
 // FETCH_PLACEHOLDERS callback - Windows wants us to populate a directory
+// (only registered with CFAPI_BRIDGE_CONNECT_PARTIAL_POPULATION).
+// The request is queued for Go, which lists the remote directory and answers
+// with CfapiBridgeTransferPlaceholders.
 // CRITICAL: Must ALWAYS respond to this callback, never return without acknowledging!
 static void CALLBACK OnFetchPlaceholdersCallback(
     const CF_CALLBACK_INFO* callbackInfo,
     const CF_CALLBACK_PARAMETERS* callbackParameters
 ) {
-    (void)callbackParameters;
-    PrintCallbackInfo("FETCH_PLACEHOLDERS", callbackInfo);
+    BRIDGE_LOG_CALLBACK("FETCH_PLACEHOLDERS", callbackInfo);
 
-    if (!g_initialized) {
-        DebugLog("ERROR: Bridge not initialized!");
-        // Still need to respond even on error!
-    }
+    int result = CFAPI_BRIDGE_ERROR_NOT_INITIALIZED;
+    if (g_initialized) {
+        CfapiBridgeRequest req;
+        memset(&req, 0, sizeof(req));
+
+        req.type = CFAPI_CALLBACK_FETCH_PLACEHOLDERS;
+        req.connectionKey = (int64_t)callbackInfo->ConnectionKey;
+        req.transferKey = (int64_t)callbackInfo->TransferKey;
+        req.requestKey = (int64_t)callbackInfo->RequestKey;
+        req.isDirectory = 1;
+        req.priorityHint = (int32_t)callbackInfo->PriorityHint;
+
+        // Search pattern in the target path slot ("*" for a full listing)
+        const wchar_t* pattern = NULL;
+        if (callbackParameters && callbackParameters->ParamSize >= sizeof(DWORD) + sizeof(CF_CALLBACK_PARAMETERS_FETCHPLACEHOLDERS)) {
+            pattern = callbackParameters->FetchPlaceholders.Pattern;
+        }
 
-    DebugLog("FETCH_PLACEHOLDERS: Acknowledging with TRANSFER_PLACEHOLDERS...");
+        result = EnqueueRequest(&req, callbackInfo->NormalizedPath, pattern);
+        if (result == CFAPI_BRIDGE_OK) {
+            BRIDGE_LOG_DEBUG("FETCH_PLACEHOLDERS enqueued for Go to process");
+            return;
+        }
+    }
 
-    // ALWAYS acknowledge the callback - Windows will freeze if we don't respond!
-    int result = CfapiBridgeAckFetchPlaceholders(
+    // ALWAYS answer the callback - Windows will freeze if we don't respond!
+    BRIDGE_LOG_ERROR("ERROR: Failed to enqueue FETCH_PLACEHOLDERS request: %d", result);
+    CfapiBridgeTransferPlaceholders(
         (int64_t)callbackInfo->ConnectionKey,
-        (int64_t)callbackInfo->TransferKey
+        (int64_t)callbackInfo->TransferKey,
+        (int64_t)callbackInfo->RequestKey,
+        NULL, 0, 0, 0, (int32_t)E_OUTOFMEMORY, NULL
     );
-
-    DebugLog("FETCH_PLACEHOLDERS ack result: %d", result);
 }
 
 // CANCEL_FETCH_PLACEHOLDERS callback
@@ -514,7 +1443,7 @@ static void CALLBACK OnCancelFetchPlaceholdersCallback(
     const CF_CALLBACK_PARAMETERS* callbackParameters
 ) {
     (void)callbackParameters;
-    PrintCallbackInfo("CANCEL_FETCH_PLACEHOLDERS", callbackInfo);
+    BRIDGE_LOG_CALLBACK("CANCEL_FETCH_PLACEHOLDERS", callbackInfo);
 }
 
 // NOTIFY_FILE_OPEN_COMPLETION callback - file was opened
@@ -523,7 +1452,7 @@ static void CALLBACK OnNotifyFileOpenCompletionCallback(
     const CF_CALLBACK_PARAMETERS* callbackParameters
 ) {
     (void)callbackParameters;
-    PrintCallbackInfo("FILE_OPEN_COMPLETION", callbackInfo);
+    BRIDGE_LOG_CALLBACK("FILE_OPEN_COMPLETION", callbackInfo);
     // Info only - no action needed
 }
 
@@ -533,7 +1462,7 @@ static void CALLBACK OnNotifyFileCloseCompletionCallback(
     const CF_CALLBACK_PARAMETERS* callbackParameters
 ) {
     (void)callbackParameters;
-    PrintCallbackInfo("FILE_CLOSE_COMPLETION", callbackInfo);
+    BRIDGE_LOG_CALLBACK("FILE_CLOSE_COMPLETION", callbackInfo);
     // Info only - no action needed
 }
 
@@ -543,18 +1472,44 @@ static void CALLBACK OnNotifyDehydrateCallback(
     const CF_CALLBACK_PARAMETERS* callbackParameters
 ) {
     (void)callbackParameters;
-    PrintCallbackInfo("NOTIFY_DEHYDRATE", callbackInfo);
+    BRIDGE_LOG_CALLBACK("NOTIFY_DEHYDRATE", callbackInfo);
     // Info only - no action needed
 }
 
 // NOTIFY_DEHYDRATE_COMPLETION callback - file dehydration completed
+// Queued for Go so the index of hydrated files drops the file without a scan.
 static void CALLBACK OnNotifyDehydrateCompletionCallback(
     const CF_CALLBACK_INFO* callbackInfo,
     const CF_CALLBACK_PARAMETERS* callbackParameters
 ) {
-    (void)callbackParameters;
-    PrintCallbackInfo("NOTIFY_DEHYDRATE_COMPLETION", callbackInfo);
-    // Info only - no action needed
+    BRIDGE_LOG_CALLBACK("NOTIFY_DEHYDRATE_COMPLETION", callbackInfo);
+
+    if (!g_initialized) {
+        BRIDGE_LOG_ERROR("ERROR: Bridge not initialized!");
+        return;
+    }
+
+    // Nothing changed when the dehydration failed
+    if (callbackParameters && callbackParameters->ParamSize >= sizeof(DWORD) + sizeof(CF_CALLBACK_PARAMETERS_DEHYDRATECOMPLETION)) {
+        BRIDGE_LOG_DEBUG("  Flags: 0x%08lX, Reason: %lu",
+                 callbackParameters->DehydrateCompletion.Flags, callbackParameters->DehydrateCompletion.Reason);
+        if (!(callbackParameters->DehydrateCompletion.Flags & CF_CALLBACK_DEHYDRATE_COMPLETION_FLAG_DEHYDRATED)) {
+            return;
+        }
+    }
+
+    CfapiBridgeRequest req;
+    memset(&req, 0, sizeof(req));
+
+    req.type = CFAPI_CALLBACK_NOTIFY_DEHYDRATE_COMPLETION;
+    req.connectionKey = (int64_t)callbackInfo->ConnectionKey;
+    req.transferKey = (int64_t)callbackInfo->TransferKey;
+
+    if (EnqueueRequest(&req, callbackInfo->NormalizedPath, NULL) != CFAPI_BRIDGE_OK) {
+        BRIDGE_LOG_ERROR("ERROR: Queue full, NOTIFY_DEHYDRATE_COMPLETION dropped");
+        return;
+    }
+    BRIDGE_LOG_DEBUG("NOTIFY_DEHYDRATE_COMPLETION enqueued");
 }
 
 // NOTIFY_RENAME callback - file is being renamed
@@ -562,10 +1517,10 @@ static void CALLBACK OnNotifyRenameCallback(
     const CF_CALLBACK_INFO* callbackInfo,
     const CF_CALLBACK_PARAMETERS* callbackParameters
 ) {
-    PrintCallbackInfo("NOTIFY_RENAME", callbackInfo);
+    BRIDGE_LOG_CALLBACK("NOTIFY_RENAME", callbackInfo);
 
     if (!g_initialized) {
-        DebugLog("ERROR: Bridge not initialized!");
+        BRIDGE_LOG_ERROR("ERROR: Bridge not initialized!");
         return;
     }
 
@@ -576,25 +1531,22 @@ static void CALLBACK OnNotifyRenameCallback(
     req.connectionKey = (int64_t)callbackInfo->ConnectionKey;
     req.transferKey = (int64_t)callbackInfo->TransferKey;
 
-    // Source path
-    if (callbackInfo->NormalizedPath) {
-        wcsncpy(req.filePath, callbackInfo->NormalizedPath, CFAPI_BRIDGE_MAX_PATH - 1);
-        req.filePath[CFAPI_BRIDGE_MAX_PATH - 1] = L'\0';
-    }
-
-    // Target path from parameters
+    // Target path from parameters (source path is the normalized path)
+    const wchar_t* targetPath = NULL;
     if (callbackParameters && callbackParameters->ParamSize >= sizeof(DWORD) + sizeof(CF_CALLBACK_PARAMETERS_RENAME)) {
         if (callbackParameters->Rename.TargetPath) {
-            wcsncpy(req.targetPath, callbackParameters->Rename.TargetPath, CFAPI_BRIDGE_MAX_PATH - 1);
-            req.targetPath[CFAPI_BRIDGE_MAX_PATH - 1] = L'\0';
-            DebugLogW(L"  TargetPath", req.targetPath);
+            targetPath = callbackParameters->Rename.TargetPath;
+            BRIDGE_LOG_PATH(L"  TargetPath", targetPath);
         }
         req.isDirectory = (callbackParameters->Rename.Flags & CF_CALLBACK_RENAME_FLAG_IS_DIRECTORY) ? 1 : 0;
-        DebugLog("  IsDirectory: %d", req.isDirectory);
+        BRIDGE_LOG_DEBUG("  IsDirectory: %d", req.isDirectory);
     }
 
-    EnqueueRequest(&req);
-    DebugLog("NOTIFY_RENAME enqueued");
+    if (EnqueueRequest(&req, callbackInfo->NormalizedPath, targetPath) != CFAPI_BRIDGE_OK) {
+        BRIDGE_LOG_ERROR("ERROR: Queue full, NOTIFY_RENAME dropped");
+        return;
+    }
+    BRIDGE_LOG_DEBUG("NOTIFY_RENAME enqueued");
 }
 
 // VALIDATE_DATA callback - Windows wants to validate data before allowing access
@@ -603,8 +1555,8 @@ static void CALLBACK OnValidateDataCallback(
     const CF_CALLBACK_PARAMETERS* callbackParameters
 ) {
     (void)callbackParameters;
-    PrintCallbackInfo("VALIDATE_DATA", callbackInfo);
-    DebugLog("VALIDATE_DATA: Acknowledging validation for entire file (size=%lld)...",
+    BRIDGE_LOG_CALLBACK("VALIDATE_DATA", callbackInfo);
+    BRIDGE_LOG_DEBUG("VALIDATE_DATA: Acknowledging validation for entire file (size=%lld)...",
              (long long)callbackInfo->FileSize);
 
     // Acknowledge validation - required to not block access!
@@ -628,7 +1580,7 @@ static void CALLBACK OnValidateDataCallback(
         opParams.AckData.Length.QuadPart = callbackInfo->FileSize;  // Entire file
 
         HRESULT hr = g_pfnCfExecute(&opInfo, &opParams);
-        DebugLog("VALIDATE_DATA ack result: HRESULT=0x%08lX (offset=0, length=%lld)",
+        BRIDGE_LOG_DEBUG("VALIDATE_DATA ack result: HRESULT=0x%08lX (offset=0, length=%lld)",
                  hr, (long long)callbackInfo->FileSize);
     }
 }
@@ -639,7 +1591,7 @@ static void CALLBACK OnNotifyDeleteCompletionCallback(
     const CF_CALLBACK_PARAMETERS* callbackParameters
 ) {
     (void)callbackParameters;
-    PrintCallbackInfo("NOTIFY_DELETE_COMPLETION", callbackInfo);
+    BRIDGE_LOG_CALLBACK("NOTIFY_DELETE_COMPLETION", callbackInfo);
     // Info only - no action needed
 }
 
@@ -649,27 +1601,33 @@ static void CALLBACK OnNotifyRenameCompletionCallback(
     const CF_CALLBACK_PARAMETERS* callbackParameters
 ) {
     (void)callbackParameters;
-    PrintCallbackInfo("NOTIFY_RENAME_COMPLETION", callbackInfo);
+    BRIDGE_LOG_CALLBACK("NOTIFY_RENAME_COMPLETION", callbackInfo);
     // Info only - no action needed
 }
 
 // --- Public API ---
 
 int32_t CfapiBridgeInit(void) {
-    DebugLog("CfapiBridgeInit called");
+    BRIDGE_LOG_DEBUG("CfapiBridgeInit called");
 
     if (g_initialized) {
-        DebugLog("Already initialized");
+        BRIDGE_LOG_DEBUG("Already initialized");
         return CFAPI_BRIDGE_OK;
     }
 
+    LARGE_INTEGER frequency;
+    if (QueryPerformanceFrequency(&frequency)) {
+        g_qpcFrequency = (LONGLONG)frequency.QuadPart;
+        g_traceEpoch = StatsNow();
+    }
+
     // Load cldapi.dll
     g_cldapiModule = LoadLibraryW(L"cldapi.dll");
     if (!g_cldapiModule) {
-        DebugLog("ERROR: Failed to load cldapi.dll (error=%lu)", GetLastError());
+        BRIDGE_LOG_ERROR("ERROR: Failed to load cldapi.dll (error=%lu)", GetLastError());
         return CFAPI_BRIDGE_ERROR_API_FAILED;
     }
-    DebugLog("cldapi.dll loaded OK");
+    BRIDGE_LOG_DEBUG("cldapi.dll loaded OK");
 
     // Get function pointers
     g_pfnCfConnectSyncRoot = (PFN_CfConnectSyncRoot)GetProcAddress(g_cldapiModule, "CfConnectSyncRoot");
@@ -677,47 +1635,27 @@ int32_t CfapiBridgeInit(void) {
     g_pfnCfExecute = (PFN_CfExecute)GetProcAddress(g_cldapiModule, "CfExecute");
     g_pfnCfReportProviderProgress = (PFN_CfReportProviderProgress)GetProcAddress(g_cldapiModule, "CfReportProviderProgress");
 
-    DebugLog("Function pointers: CfConnectSyncRoot=%p, CfDisconnectSyncRoot=%p, CfExecute=%p",
+    BRIDGE_LOG_DEBUG("Function pointers: CfConnectSyncRoot=%p, CfDisconnectSyncRoot=%p, CfExecute=%p",
              (void*)g_pfnCfConnectSyncRoot, (void*)g_pfnCfDisconnectSyncRoot, (void*)g_pfnCfExecute);
 
     if (!g_pfnCfConnectSyncRoot || !g_pfnCfDisconnectSyncRoot || !g_pfnCfExecute) {
-        DebugLog("ERROR: Failed to get function pointers");
+        BRIDGE_LOG_ERROR("ERROR: Failed to get function pointers");
         FreeLibrary(g_cldapiModule);
         g_cldapiModule = NULL;
         return CFAPI_BRIDGE_ERROR_API_FAILED;
     }
 
-    // Initialize critical section
-    InitializeCriticalSection(&g_queueCS);
+    // Reset queues
+    memset(g_connectionQueues, 0, sizeof(g_connectionQueues));
+    g_queueProducerRetries = 0;
 
-    // Create event for signaling new requests
-    g_newRequestEvent = CreateEventW(NULL, FALSE, FALSE, NULL);
-    if (!g_newRequestEvent) {
-        DebugLog("ERROR: Failed to create event (error=%lu)", GetLastError());
-        DeleteCriticalSection(&g_queueCS);
-        FreeLibrary(g_cldapiModule);
-        g_cldapiModule = NULL;
-        return CFAPI_BRIDGE_ERROR_API_FAILED;
-    }
-
-    // Reset queue
-    g_queueHead = 0;
-    g_queueTail = 0;
-    g_queueCount = 0;
-
-    // Initialize shared fetch for thread-safe data transfer
-    if (CfapiBridgeInitSharedFetch() != CFAPI_BRIDGE_OK) {
-        DebugLog("ERROR: Failed to initialize shared fetch");
-        CloseHandle(g_newRequestEvent);
-        g_newRequestEvent = NULL;
-        DeleteCriticalSection(&g_queueCS);
-        FreeLibrary(g_cldapiModule);
-        g_cldapiModule = NULL;
-        return CFAPI_BRIDGE_ERROR_API_FAILED;
+    // Transfer buffers are an optimization: Go falls back to its own buffers
+    if (InitTransferBufferPool(g_requestedTransferBuffers) != CFAPI_BRIDGE_OK) {
+        BRIDGE_LOG_WARN("WARNING: Transfer buffer pool unavailable");
     }
 
     g_initialized = 1;
-    DebugLog("CfapiBridgeInit SUCCESS");
+    BRIDGE_LOG_INFO("CfapiBridgeInit SUCCESS");
     return CFAPI_BRIDGE_OK;
 }
 
@@ -726,16 +1664,16 @@ void CfapiBridgeCleanup(void) {
 
     g_initialized = 0;
 
-    // Cleanup shared fetch
-    CfapiBridgeCleanupSharedFetch();
+    CleanupTransferBufferPool();
 
-    if (g_newRequestEvent) {
-        CloseHandle(g_newRequestEvent);
-        g_newRequestEvent = NULL;
+    for (int i = 0; i < CFAPI_BRIDGE_MAX_CONNECTIONS; i++) {
+        CfapiBridgeConnectionQueue* queue = &g_connectionQueues[i];
+        if (queue->inUse) {
+            ReleaseQueueResources(queue);
+        }
+        queue->inUse = 0;
     }
 
-    DeleteCriticalSection(&g_queueCS);
-
     if (g_cldapiModule) {
         FreeLibrary(g_cldapiModule);
         g_cldapiModule = NULL;
@@ -750,19 +1688,20 @@ void CfapiBridgeCleanup(void) {
 int32_t CfapiBridgeConnect(
     const wchar_t* syncRootPath,
     void* callbackContext,
+    int32_t flags,
     int64_t* connectionKey
 ) {
     (void)callbackContext; // unused for now
 
-    DebugLogW(L"CfapiBridgeConnect", syncRootPath);
+    BRIDGE_LOG_PATH(L"CfapiBridgeConnect", syncRootPath);
 
     if (!g_initialized) {
-        DebugLog("ERROR: Bridge not initialized");
+        BRIDGE_LOG_ERROR("ERROR: Bridge not initialized");
         return CFAPI_BRIDGE_ERROR_NOT_INITIALIZED;
     }
 
     if (!syncRootPath || !connectionKey) {
-        DebugLog("ERROR: Invalid parameters");
+        BRIDGE_LOG_ERROR("ERROR: Invalid parameters");
         return CFAPI_BRIDGE_ERROR_INVALID_PARAM;
     }
 
@@ -774,73 +1713,85 @@ int32_t CfapiBridgeConnect(
     // FETCH_DATA (0) - for hydration
     callbacks[idx].Type = CF_CALLBACK_TYPE_FETCH_DATA;
     callbacks[idx].Callback = OnFetchDataCallback;
-    DebugLog("  [%d] FETCH_DATA", idx);
+    BRIDGE_LOG_DEBUG("  [%d] FETCH_DATA", idx);
     idx++;
 
     // VALIDATE_DATA (1) - might be required for directory access!
     callbacks[idx].Type = CF_CALLBACK_TYPE_VALIDATE_DATA;
     callbacks[idx].Callback = OnValidateDataCallback;
-    DebugLog("  [%d] VALIDATE_DATA", idx);
+    BRIDGE_LOG_DEBUG("  [%d] VALIDATE_DATA", idx);
     idx++;
 
     // CANCEL_FETCH_DATA (2)
     callbacks[idx].Type = CF_CALLBACK_TYPE_CANCEL_FETCH_DATA;
     callbacks[idx].Callback = OnCancelFetchDataCallback;
-    DebugLog("  [%d] CANCEL_FETCH_DATA", idx);
+    BRIDGE_LOG_DEBUG("  [%d] CANCEL_FETCH_DATA", idx);
     idx++;
 
-    // NOTE: FETCH_PLACEHOLDERS and CANCEL_FETCH_PLACEHOLDERS are NOT registered
-    // because we use CF_POPULATION_POLICY_ALWAYS_FULL which means:
+    // NOTE: FETCH_PLACEHOLDERS and CANCEL_FETCH_PLACEHOLDERS are only registered
+    // for partial population. By default we use CF_POPULATION_POLICY_ALWAYS_FULL:
     // "Provider pre-populates all placeholders, Windows uses what we've created"
     // This allows the folder to remain navigable when the provider is not running
-    DebugLog("  [SKIP] FETCH_PLACEHOLDERS (using ALWAYS_FULL policy)");
+    if (flags & CFAPI_BRIDGE_CONNECT_PARTIAL_POPULATION) {
+        callbacks[idx].Type = CF_CALLBACK_TYPE_FETCH_PLACEHOLDERS;
+        callbacks[idx].Callback = OnFetchPlaceholdersCallback;
+        BRIDGE_LOG_DEBUG("  [%d] FETCH_PLACEHOLDERS", idx);
+        idx++;
+
+        callbacks[idx].Type = CF_CALLBACK_TYPE_CANCEL_FETCH_PLACEHOLDERS;
+        callbacks[idx].Callback = OnCancelFetchPlaceholdersCallback;
+        BRIDGE_LOG_DEBUG("  [%d] CANCEL_FETCH_PLACEHOLDERS", idx);
+        idx++;
+    } else {
+        BRIDGE_LOG_DEBUG("  [SKIP] FETCH_PLACEHOLDERS (using ALWAYS_FULL policy)");
+    }
 
     // NOTIFY callbacks
     callbacks[idx].Type = CF_CALLBACK_TYPE_NOTIFY_FILE_OPEN_COMPLETION;
     callbacks[idx].Callback = OnNotifyFileOpenCompletionCallback;
-    DebugLog("  [%d] NOTIFY_FILE_OPEN_COMPLETION", idx);
+    BRIDGE_LOG_DEBUG("  [%d] NOTIFY_FILE_OPEN_COMPLETION", idx);
     idx++;
 
     callbacks[idx].Type = CF_CALLBACK_TYPE_NOTIFY_FILE_CLOSE_COMPLETION;
     callbacks[idx].Callback = OnNotifyFileCloseCompletionCallback;
-    DebugLog("  [%d] NOTIFY_FILE_CLOSE_COMPLETION", idx);
+    BRIDGE_LOG_DEBUG("  [%d] NOTIFY_FILE_CLOSE_COMPLETION", idx);
     idx++;
 
     callbacks[idx].Type = CF_CALLBACK_TYPE_NOTIFY_DEHYDRATE;
     callbacks[idx].Callback = OnNotifyDehydrateCallback;
-    DebugLog("  [%d] NOTIFY_DEHYDRATE", idx);
+    BRIDGE_LOG_DEBUG("  [%d] NOTIFY_DEHYDRATE", idx);
     idx++;
 
     callbacks[idx].Type = CF_CALLBACK_TYPE_NOTIFY_DEHYDRATE_COMPLETION;
     callbacks[idx].Callback = OnNotifyDehydrateCompletionCallback;
-    DebugLog("  [%d] NOTIFY_DEHYDRATE_COMPLETION", idx);
+    BRIDGE_LOG_DEBUG("  [%d] NOTIFY_DEHYDRATE_COMPLETION", idx);
     idx++;
 
     callbacks[idx].Type = CF_CALLBACK_TYPE_NOTIFY_DELETE;
     callbacks[idx].Callback = OnNotifyDeleteCallback;
-    DebugLog("  [%d] NOTIFY_DELETE", idx);
+    BRIDGE_LOG_DEBUG("  [%d] NOTIFY_DELETE", idx);
     idx++;
 
     callbacks[idx].Type = CF_CALLBACK_TYPE_NOTIFY_DELETE_COMPLETION;
     callbacks[idx].Callback = OnNotifyDeleteCompletionCallback;
-    DebugLog("  [%d] NOTIFY_DELETE_COMPLETION", idx);
+    BRIDGE_LOG_DEBUG("  [%d] NOTIFY_DELETE_COMPLETION", idx);
     idx++;
 
     callbacks[idx].Type = CF_CALLBACK_TYPE_NOTIFY_RENAME;
     callbacks[idx].Callback = OnNotifyRenameCallback;
-    DebugLog("  [%d] NOTIFY_RENAME", idx);
+    BRIDGE_LOG_DEBUG("  [%d] NOTIFY_RENAME", idx);
     idx++;
 
     callbacks[idx].Type = CF_CALLBACK_TYPE_NOTIFY_RENAME_COMPLETION;
     callbacks[idx].Callback = OnNotifyRenameCompletionCallback;
-    DebugLog("  [%d] NOTIFY_RENAME_COMPLETION", idx);
+    BRIDGE_LOG_DEBUG("  [%d] NOTIFY_RENAME_COMPLETION", idx);
     idx++;
 
     // Terminator
     callbacks[idx].Type = CF_CALLBACK_TYPE_NONE;
     callbacks[idx].Callback = NULL;
 
-    DebugLog("Calling CfConnectSyncRoot with %d callbacks (ALL for debugging)...", idx);
+    BRIDGE_LOG_DEBUG("Calling CfConnectSyncRoot with %d callbacks (ALL for debugging)...", idx);
 
     // Use BOTH flags like CloudMirror sample:
     // - CF_CONNECT_FLAG_REQUIRE_PROCESS_INFO: get process info in callbacks
@@ -855,52 +1806,60 @@ int32_t CfapiBridgeConnect(
         connectFlags,
         &connKey
     );
+    BridgeTrace(CFAPI_BRIDGE_TRACE_CONNECT, -1, (int64_t)connKey, 0, 0, 0, (int32_t)hr);
 
     if (FAILED(hr)) {
-        DebugLog("ERROR: CfConnectSyncRoot FAILED: HRESULT=0x%08lX", hr);
+        BRIDGE_LOG_ERROR("ERROR: CfConnectSyncRoot FAILED: HRESULT=0x%08lX", hr);
         return CFAPI_BRIDGE_ERROR_API_FAILED;
     }
 
-    DebugLog("CfConnectSyncRoot SUCCESS, connectionKey=%lld", (long long)connKey);
+    BRIDGE_LOG_INFO("CfConnectSyncRoot SUCCESS, connectionKey=%lld", (long long)connKey);
+
+    // Make sure this connection has its own request queue
+    if (!GetOrCreateQueue((int64_t)connKey)) {
+        BRIDGE_LOG_ERROR("ERROR: Too many connections, no request queue left");
+        g_pfnCfDisconnectSyncRoot(connKey);
+        return CFAPI_BRIDGE_ERROR_QUEUE_FULL;
+    }
 
     *connectionKey = (int64_t)connKey;
     return CFAPI_BRIDGE_OK;
 }
 
 int32_t CfapiBridgeDisconnect(int64_t connectionKey) {
-    DebugLog("CfapiBridgeDisconnect: connectionKey=%lld", (long long)connectionKey);
+    BRIDGE_LOG_DEBUG("CfapiBridgeDisconnect: connectionKey=%lld", (long long)connectionKey);
 
     if (!g_initialized) {
-        DebugLog("ERROR: Bridge not initialized");
+        BRIDGE_LOG_ERROR("ERROR: Bridge not initialized");
         return CFAPI_BRIDGE_ERROR_NOT_INITIALIZED;
     }
 
     HRESULT hr = g_pfnCfDisconnectSyncRoot((CF_CONNECTION_KEY)connectionKey);
+    BridgeTrace(CFAPI_BRIDGE_TRACE_DISCONNECT, -1, connectionKey, 0, 0, 0, (int32_t)hr);
     if (FAILED(hr)) {
-        DebugLog("ERROR: CfDisconnectSyncRoot FAILED: HRESULT=0x%08lX", hr);
+        BRIDGE_LOG_ERROR("ERROR: CfDisconnectSyncRoot FAILED: HRESULT=0x%08lX", hr);
         return CFAPI_BRIDGE_ERROR_API_FAILED;
     }
 
-    DebugLog("CfDisconnectSyncRoot SUCCESS");
+    // No more callbacks can arrive for this connection
+    RemoveQueue(connectionKey);
+
+    BRIDGE_LOG_INFO("CfDisconnectSyncRoot SUCCESS");
     return CFAPI_BRIDGE_OK;
 }
 
-int32_t CfapiBridgeWaitForRequest(uint32_t timeoutMs) {
+int32_t CfapiBridgeWaitForRequest(int64_t connectionKey, uint32_t timeoutMs) {
     if (!g_initialized) {
         return CFAPI_BRIDGE_ERROR_NOT_INITIALIZED;
     }
 
-    // Check if already have requests
-    EnterCriticalSection(&g_queueCS);
-    int hasRequests = (g_queueCount > 0);
-    LeaveCriticalSection(&g_queueCS);
-
-    if (hasRequests) {
-        return CFAPI_BRIDGE_OK;
+    CfapiBridgeConnectionQueue* queue = FindQueue(connectionKey);
+    if (!queue) {
+        return CFAPI_BRIDGE_ERROR_INVALID_PARAM;
     }
 
-    // Wait for new request
-    DWORD result = WaitForSingleObject(g_newRequestEvent, timeoutMs);
+    // Each successful wait consumes one queued request's count
+    DWORD result = WaitForSingleObject(queue->requestSemaphore, timeoutMs);
     if (result == WAIT_OBJECT_0) {
         return CFAPI_BRIDGE_OK;
     } else if (result == WAIT_TIMEOUT) {
@@ -910,16 +1869,123 @@ int32_t CfapiBridgeWaitForRequest(uint32_t timeoutMs) {
     return CFAPI_BRIDGE_ERROR_API_FAILED;
 }
 
-int32_t CfapiBridgePollRequest(CfapiBridgeRequest* request) {
+int32_t CfapiBridgeWaitForWork(int64_t connectionKey, uint32_t timeoutMs) {
+    if (!g_initialized) {
+        return CFAPI_BRIDGE_ERROR_NOT_INITIALIZED;
+    }
+
+    CfapiBridgeConnectionQueue* queue = FindQueue(connectionKey);
+    if (!queue) {
+        return CFAPI_BRIDGE_ERROR_INVALID_PARAM;
+    }
+
+    // WaitForMultipleObjects reports the lowest signaled index, which gives
+    // stop > queued request priority.
+    HANDLE handles[2];
+    DWORD handleCount = 0;
+    handles[handleCount++] = queue->stopEvent;
+    handles[handleCount++] = queue->requestSemaphore;
+
+    DWORD result = WaitForMultipleObjects(handleCount, handles, FALSE, timeoutMs);
+    if (result == WAIT_TIMEOUT) {
+        return CFAPI_BRIDGE_ERROR_TIMEOUT;
+    }
+    if (result >= WAIT_OBJECT_0 + handleCount) {
+        return CFAPI_BRIDGE_ERROR_API_FAILED;
+    }
+
+    HANDLE signaled = handles[result - WAIT_OBJECT_0];
+    if (signaled == queue->stopEvent) {
+        return CFAPI_BRIDGE_WAKE_STOP;
+    }
+    // The semaphore count taken by the wait reserves one request
+    return CFAPI_BRIDGE_WAKE_REQUEST;
+}
+
+int32_t CfapiBridgeWaitForCancel(int64_t connectionKey, uint32_t timeoutMs) {
+    if (!g_initialized) {
+        return CFAPI_BRIDGE_ERROR_NOT_INITIALIZED;
+    }
+
+    CfapiBridgeConnectionQueue* queue = FindQueue(connectionKey);
+    if (!queue) {
+        return CFAPI_BRIDGE_ERROR_INVALID_PARAM;
+    }
+
+    HANDLE handles[2] = { queue->stopEvent, queue->cancelSemaphore };
+    DWORD result = WaitForMultipleObjects(2, handles, FALSE, timeoutMs);
+    if (result == WAIT_TIMEOUT) {
+        return CFAPI_BRIDGE_ERROR_TIMEOUT;
+    }
+    if (result == WAIT_OBJECT_0) {
+        return CFAPI_BRIDGE_WAKE_STOP;
+    }
+    if (result == WAIT_OBJECT_0 + 1) {
+        // The semaphore count taken by the wait reserves one cancellation
+        return CFAPI_BRIDGE_WAKE_CANCEL;
+    }
+    return CFAPI_BRIDGE_ERROR_API_FAILED;
+}
+
+int32_t CfapiBridgeSignalStop(int64_t connectionKey) {
+    if (!g_initialized) {
+        return CFAPI_BRIDGE_ERROR_NOT_INITIALIZED;
+    }
+
+    CfapiBridgeConnectionQueue* queue = FindQueue(connectionKey);
+    if (!queue) {
+        return CFAPI_BRIDGE_ERROR_INVALID_PARAM;
+    }
+
+    return SetEvent(queue->stopEvent) ? CFAPI_BRIDGE_OK : CFAPI_BRIDGE_ERROR_API_FAILED;
+}
+
+int32_t CfapiBridgeResetStop(int64_t connectionKey) {
+    if (!g_initialized) {
+        return CFAPI_BRIDGE_ERROR_NOT_INITIALIZED;
+    }
+
+    CfapiBridgeConnectionQueue* queue = FindQueue(connectionKey);
+    if (!queue) {
+        return CFAPI_BRIDGE_ERROR_INVALID_PARAM;
+    }
+
+    return ResetEvent(queue->stopEvent) ? CFAPI_BRIDGE_OK : CFAPI_BRIDGE_ERROR_API_FAILED;
+}
+
+int32_t CfapiBridgePollRequest(int64_t connectionKey, CfapiBridgeRequest* request,
+                               wchar_t* pathBuffer, int32_t pathBufferChars) {
+    if (!g_initialized) {
+        return CFAPI_BRIDGE_ERROR_NOT_INITIALIZED;
+    }
+
+    if (!request || !pathBuffer || pathBufferChars < CFAPI_BRIDGE_REQUEST_PATH_CHARS) {
+        return CFAPI_BRIDGE_ERROR_INVALID_PARAM;
+    }
+
+    CfapiBridgeConnectionQueue* queue = FindQueue(connectionKey);
+    if (!queue) {
+        return CFAPI_BRIDGE_ERROR_INVALID_PARAM;
+    }
+
+    return DequeueRequest(queue, request, pathBuffer);
+}
+
+int32_t CfapiBridgePollCancel(int64_t connectionKey, CfapiBridgeCancel* cancel) {
     if (!g_initialized) {
         return CFAPI_BRIDGE_ERROR_NOT_INITIALIZED;
     }
 
-    if (!request) {
+    if (!cancel) {
+        return CFAPI_BRIDGE_ERROR_INVALID_PARAM;
+    }
+
+    CfapiBridgeConnectionQueue* queue = FindQueue(connectionKey);
+    if (!queue) {
         return CFAPI_BRIDGE_ERROR_INVALID_PARAM;
     }
 
-    return DequeueRequest(request);
+    return DequeueCancel(queue, cancel);
 }
 
 int32_t CfapiBridgeTransferData(
@@ -931,17 +1997,17 @@ int32_t CfapiBridgeTransferData(
     int64_t offset,
     int32_t flags
 ) {
-    DebugLog("CfapiBridgeTransferData: connKey=%lld, transKey=%lld, reqKey=%lld, len=%lld, offset=%lld, flags=0x%X",
+    BRIDGE_LOG_DEBUG("CfapiBridgeTransferData: connKey=%lld, transKey=%lld, reqKey=%lld, len=%lld, offset=%lld, flags=0x%X",
              (long long)connectionKey, (long long)transferKey, (long long)requestKey,
              (long long)bufferLength, (long long)offset, flags);
 
     if (!g_initialized) {
-        DebugLog("ERROR: Bridge not initialized");
+        BRIDGE_LOG_ERROR("ERROR: Bridge not initialized");
         return CFAPI_BRIDGE_ERROR_NOT_INITIALIZED;
     }
 
     if (!buffer || bufferLength <= 0) {
-        DebugLog("ERROR: Invalid buffer parameters");
+        BRIDGE_LOG_ERROR("ERROR: Invalid buffer parameters");
         return CFAPI_BRIDGE_ERROR_INVALID_PARAM;
     }
 
@@ -962,13 +2028,103 @@ int32_t CfapiBridgeTransferData(
     opParams.TransferData.Offset.QuadPart = offset;
     opParams.TransferData.Length.QuadPart = bufferLength;
 
+    int64_t start = StatsNow();
     HRESULT hr = g_pfnCfExecute(&opInfo, &opParams);
+    StatsRecordSince(CFAPI_BRIDGE_STAGE_CFEXECUTE, start);
+    BridgeTrace(CFAPI_BRIDGE_TRACE_TRANSFER, CFAPI_CALLBACK_FETCH_DATA, connectionKey, transferKey,
+                offset, bufferLength, (int32_t)hr);
     if (FAILED(hr)) {
-        DebugLog("ERROR: CfExecute (TransferData) FAILED: HRESULT=0x%08lX", hr);
+        BRIDGE_LOG_ERROR("ERROR: CfExecute (TransferData) FAILED: HRESULT=0x%08lX", hr);
         return CFAPI_BRIDGE_ERROR_API_FAILED;
     }
+    InterlockedExchangeAdd64(&g_transferredBytes, bufferLength);
+
+    BRIDGE_LOG_DEBUG("TransferData SUCCESS (flags=0x%X)", flags);
+    return CFAPI_BRIDGE_OK;
+}
+
+int32_t CfapiBridgeTransferBatch(
+    int64_t connectionKey,
+    int64_t transferKey,
+    int64_t requestKey,
+    const CfapiBridgeTransferSegment* segments,
+    int32_t segmentCount,
+    int64_t offset,
+    int32_t flags,
+    int64_t progressTotal,
+    int64_t progressCompleted
+) {
+    if (!g_initialized) {
+        BRIDGE_LOG_ERROR("ERROR: Bridge not initialized");
+        return CFAPI_BRIDGE_ERROR_NOT_INITIALIZED;
+    }
+
+    if (!segments || segmentCount <= 0) {
+        BRIDGE_LOG_ERROR("ERROR: Invalid batch parameters");
+        return CFAPI_BRIDGE_ERROR_INVALID_PARAM;
+    }
+
+    // Each run of segments adjacent in memory (transfer pool chunks usually
+    // are) is sent as is with one CfExecute. Only runs smaller than
+    // CFAPI_BRIDGE_MAX_BATCH_STAGING are copied together first, so short
+    // reads do not each cost a kernel round trip.
+    uint8_t* staging = NULL;
+    int64_t staged = 0;
+    int64_t stagedOffset = 0;
+    int32_t result = CFAPI_BRIDGE_OK;
+
+    int32_t i = 0;
+    while (i < segmentCount) {
+        const uint8_t* runStart = (const uint8_t*)segments[i].buffer;
+        int64_t runLength = segments[i].length;
+        int32_t next = i + 1;
+        while (next < segmentCount &&
+               (const uint8_t*)segments[next].buffer == runStart + runLength) {
+            runLength += segments[next].length;
+            next++;
+        }
+        int32_t last = (next == segmentCount);
+
+        if (staged > 0 && (runLength >= CFAPI_BRIDGE_MAX_BATCH_STAGING ||
+                           staged + runLength > CFAPI_BRIDGE_MAX_BATCH_STAGING)) {
+            result = CfapiBridgeTransferData(connectionKey, transferKey, requestKey,
+                                             staging, staged, stagedOffset, 0);
+            staged = 0;
+            if (result != CFAPI_BRIDGE_OK) break;
+        }
+
+        if (runLength < CFAPI_BRIDGE_MAX_BATCH_STAGING && !staging) {
+            staging = (uint8_t*)malloc(CFAPI_BRIDGE_MAX_BATCH_STAGING);
+        }
+        if (runLength < CFAPI_BRIDGE_MAX_BATCH_STAGING && staging) {
+            if (staged == 0) {
+                stagedOffset = offset;
+            }
+            memcpy(staging + staged, runStart, (size_t)runLength);
+            staged += runLength;
+            if (last) {
+                result = CfapiBridgeTransferData(connectionKey, transferKey, requestKey,
+                                                 staging, staged, stagedOffset, flags);
+                staged = 0;
+            }
+        } else {
+            result = CfapiBridgeTransferData(connectionKey, transferKey, requestKey,
+                                             runStart, runLength, offset, last ? flags : 0);
+        }
+        if (result != CFAPI_BRIDGE_OK) break;
+
+        offset += runLength;
+        i = next;
+    }
+    free(staging);
+    if (result != CFAPI_BRIDGE_OK) {
+        return result;
+    }
+
+    if (progressCompleted >= 0) {
+        CfapiBridgeReportProgress(connectionKey, transferKey, progressTotal, progressCompleted);
+    }
 
-    DebugLog("TransferData SUCCESS (flags=0x%X)", flags);
     return CFAPI_BRIDGE_OK;
 }
 
@@ -977,11 +2133,11 @@ int32_t CfapiBridgeTransferComplete(
     int64_t transferKey,
     int64_t requestKey
 ) {
-    DebugLog("CfapiBridgeTransferComplete: connKey=%lld, transKey=%lld, reqKey=%lld",
+    BRIDGE_LOG_DEBUG("CfapiBridgeTransferComplete: connKey=%lld, transKey=%lld, reqKey=%lld",
              (long long)connectionKey, (long long)transferKey, (long long)requestKey);
 
     if (!g_initialized) {
-        DebugLog("ERROR: Bridge not initialized");
+        BRIDGE_LOG_ERROR("ERROR: Bridge not initialized");
         return CFAPI_BRIDGE_ERROR_NOT_INITIALIZED;
     }
 
@@ -999,12 +2155,13 @@ int32_t CfapiBridgeTransferComplete(
     opParams.AckData.CompletionStatus = S_OK;
 
     HRESULT hr = g_pfnCfExecute(&opInfo, &opParams);
+    BridgeTrace(CFAPI_BRIDGE_TRACE_COMPLETE, CFAPI_CALLBACK_FETCH_DATA, connectionKey, transferKey, 0, 0, (int32_t)hr);
     if (FAILED(hr)) {
-        DebugLog("ERROR: CfExecute (AckData) FAILED: HRESULT=0x%08lX", hr);
+        BRIDGE_LOG_ERROR("ERROR: CfExecute (AckData) FAILED: HRESULT=0x%08lX", hr);
         return CFAPI_BRIDGE_ERROR_API_FAILED;
     }
 
-    DebugLog("TransferComplete SUCCESS");
+    BRIDGE_LOG_DEBUG("TransferComplete SUCCESS");
     return CFAPI_BRIDGE_OK;
 }
 
@@ -1014,11 +2171,11 @@ int32_t CfapiBridgeTransferError(
     int64_t requestKey,
     int32_t hresult
 ) {
-    DebugLog("CfapiBridgeTransferError: connKey=%lld, transKey=%lld, reqKey=%lld, hr=0x%08X",
+    BRIDGE_LOG_DEBUG("CfapiBridgeTransferError: connKey=%lld, transKey=%lld, reqKey=%lld, hr=0x%08X",
              (long long)connectionKey, (long long)transferKey, (long long)requestKey, hresult);
 
     if (!g_initialized) {
-        DebugLog("ERROR: Bridge not initialized");
+        BRIDGE_LOG_ERROR("ERROR: Bridge not initialized");
         return CFAPI_BRIDGE_ERROR_NOT_INITIALIZED;
     }
 
@@ -1039,12 +2196,14 @@ int32_t CfapiBridgeTransferError(
     opParams.TransferData.Length.QuadPart = 0;
 
     HRESULT hr = g_pfnCfExecute(&opInfo, &opParams);
+    BridgeTrace(CFAPI_BRIDGE_TRACE_ERROR, CFAPI_CALLBACK_FETCH_DATA, connectionKey, transferKey,
+                hresult, 0, (int32_t)hr);
     if (FAILED(hr)) {
-        DebugLog("ERROR: CfExecute (TransferError) FAILED: HRESULT=0x%08lX", hr);
+        BRIDGE_LOG_ERROR("ERROR: CfExecute (TransferError) FAILED: HRESULT=0x%08lX", hr);
         return CFAPI_BRIDGE_ERROR_API_FAILED;
     }
 
-    DebugLog("TransferError sent OK");
+    BRIDGE_LOG_DEBUG("TransferError sent OK");
     return CFAPI_BRIDGE_OK;
 }
 
@@ -1089,145 +2248,354 @@ int32_t CfapiBridgeIsInitialized(void) {
 int32_t CfapiBridgeGetQueueCount(void) {
     if (!g_initialized) return 0;
 
-    EnterCriticalSection(&g_queueCS);
-    int count = g_queueCount;
-    LeaveCriticalSection(&g_queueCS);
+    int count = 0;
+    AcquireSRWLockShared(&g_queueTableLock);
+    for (int i = 0; i < CFAPI_BRIDGE_MAX_CONNECTIONS; i++) {
+        CfapiBridgeConnectionQueue* queue = &g_connectionQueues[i];
+        if (queue->inUse) {
+            count += QueueCount(queue);
+        }
+    }
+    ReleaseSRWLockShared(&g_queueTableLock);
 
     return count;
 }
 
-// Simple structure for TRANSFER_PLACEHOLDERS params
-typedef struct {
-    DWORD Flags;
-    HRESULT CompletionStatus;
-    LARGE_INTEGER PlaceholderTotalCount;
-} CF_OPERATION_TRANSFER_PLACEHOLDERS_PARAMS_SIMPLE;
+int32_t CfapiBridgeGetConnectionQueueCount(int64_t connectionKey) {
+    if (!g_initialized) return 0;
+
+    CfapiBridgeConnectionQueue* queue = FindQueue(connectionKey);
+    if (!queue) return 0;
+
+    return QueueCount(queue);
+}
+
+int32_t CfapiBridgeGetQueueStats(int64_t connectionKey, CfapiBridgeQueueStats* stats) {
+    if (!stats) {
+        return CFAPI_BRIDGE_ERROR_INVALID_PARAM;
+    }
+    memset(stats, 0, sizeof(*stats));
+
+    if (!g_initialized) {
+        return CFAPI_BRIDGE_ERROR_NOT_INITIALIZED;
+    }
+
+    AcquireSRWLockShared(&g_queueTableLock);
+    CfapiBridgeConnectionQueue* queue = FindQueueLocked(connectionKey);
+    if (queue) {
+        stats->queued = QueueCount(queue);
+        EnterCriticalSection(&queue->overflowLock);
+        stats->capacity = CFAPI_BRIDGE_MAX_QUEUE_SIZE + queue->overflowChunks * CFAPI_BRIDGE_QUEUE_CHUNK_SIZE;
+        LeaveCriticalSection(&queue->overflowLock);
+        stats->limit = queue->queueLimit;
+        stats->highWater = BRIDGE_LOAD_ACQUIRE(&queue->highWater);
+        stats->producerWaits = InterlockedCompareExchange64(&queue->producerWaits, 0, 0);
+        stats->droppedFetchData = InterlockedCompareExchange64(&queue->dropped[CFAPI_BRIDGE_DROP_FETCH_DATA], 0, 0);
+        stats->droppedCancelFetch = InterlockedCompareExchange64(&queue->dropped[CFAPI_BRIDGE_DROP_CANCEL_FETCH_DATA], 0, 0);
+        stats->droppedNotifyDelete = InterlockedCompareExchange64(&queue->dropped[CFAPI_BRIDGE_DROP_NOTIFY_DELETE], 0, 0);
+        stats->droppedNotifyRename = InterlockedCompareExchange64(&queue->dropped[CFAPI_BRIDGE_DROP_NOTIFY_RENAME], 0, 0);
+    }
+    ReleaseSRWLockShared(&g_queueTableLock);
+
+    return queue ? CFAPI_BRIDGE_OK : CFAPI_BRIDGE_ERROR_INVALID_PARAM;
+}
+
+int32_t CfapiBridgeSetQueueLimits(int32_t maxRequests, int32_t producerWaitMs) {
+    if (maxRequests <= 0) {
+        maxRequests = CFAPI_BRIDGE_DEFAULT_QUEUE_LIMIT;
+    }
+    if (maxRequests < CFAPI_BRIDGE_MAX_QUEUE_SIZE) {
+        maxRequests = CFAPI_BRIDGE_MAX_QUEUE_SIZE;
+    }
+    if (maxRequests > CFAPI_BRIDGE_MAX_QUEUE_LIMIT) {
+        maxRequests = CFAPI_BRIDGE_MAX_QUEUE_LIMIT;
+    }
+    if (producerWaitMs < 0) {
+        producerWaitMs = CFAPI_BRIDGE_DEFAULT_PRODUCER_WAIT_MS;
+    }
+
+    g_queueLimit = maxRequests;
+    InterlockedExchange(&g_producerWaitMs, producerWaitMs);
+    return CFAPI_BRIDGE_OK;
+}
+
+int32_t CfapiBridgeGetStats(CfapiBridgeStats* stats) {
+    if (!stats) {
+        return CFAPI_BRIDGE_ERROR_INVALID_PARAM;
+    }
+
+    for (int s = 0; s < CFAPI_BRIDGE_STAGE_COUNT; s++) {
+        BridgeHistogram* h = &g_stageStats[s];
+        stats->stages[s].count = InterlockedCompareExchange64(&h->count, 0, 0);
+        stats->stages[s].sumMicros = InterlockedCompareExchange64(&h->sumMicros, 0, 0);
+        stats->stages[s].maxMicros = InterlockedCompareExchange64(&h->maxMicros, 0, 0);
+        for (int b = 0; b < CFAPI_BRIDGE_HISTOGRAM_BUCKETS; b++) {
+            stats->stages[s].buckets[b] = InterlockedCompareExchange64(&h->buckets[b], 0, 0);
+        }
+    }
+    for (int t = 0; t < CFAPI_BRIDGE_DROP_TYPE_COUNT; t++) {
+        stats->callbacks[t] = InterlockedCompareExchange64(&g_callbackCounts[t], 0, 0);
+    }
+    stats->transferredBytes = InterlockedCompareExchange64(&g_transferredBytes, 0, 0);
+    return CFAPI_BRIDGE_OK;
+}
+
+void CfapiBridgeRecordStage(int32_t stage, int64_t micros) {
+    StatsRecord(stage, micros);
+}
+
+void CfapiBridgeResetStats(void) {
+    for (int s = 0; s < CFAPI_BRIDGE_STAGE_COUNT; s++) {
+        BridgeHistogram* h = &g_stageStats[s];
+        InterlockedExchange64(&h->count, 0);
+        InterlockedExchange64(&h->sumMicros, 0);
+        InterlockedExchange64(&h->maxMicros, 0);
+        for (int b = 0; b < CFAPI_BRIDGE_HISTOGRAM_BUCKETS; b++) {
+            InterlockedExchange64(&h->buckets[b], 0);
+        }
+    }
+    for (int t = 0; t < CFAPI_BRIDGE_DROP_TYPE_COUNT; t++) {
+        InterlockedExchange64(&g_callbackCounts[t], 0);
+    }
+    InterlockedExchange64(&g_transferredBytes, 0);
+}
+
+void CfapiBridgeSetLogLevel(int32_t level) {
+#ifdef CFAPI_BRIDGE_DEBUG
+    g_logLevel = level;
+#else
+    (void)level;
+#endif
+}
+
+int32_t CfapiBridgeHasDebugLog(void) {
+#ifdef CFAPI_BRIDGE_DEBUG
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+void CfapiBridgeSetTraceEnabled(int32_t enabled) {
+    InterlockedExchange(&g_traceEnabled, enabled ? 1 : 0);
+}
+
+int32_t CfapiBridgeReadTrace(CfapiBridgeTraceEvent* events, int32_t maxEvents) {
+    if (!events || maxEvents <= 0) {
+        return 0;
+    }
+
+    ULONG end = (ULONG)BRIDGE_LOAD_ACQUIRE(&g_traceNext);
+    ULONG count = end < CFAPI_BRIDGE_TRACE_SIZE ? end : CFAPI_BRIDGE_TRACE_SIZE;
+    if (count > (ULONG)maxEvents) {
+        count = (ULONG)maxEvents;
+    }
+
+    int32_t copied = 0;
+    for (ULONG claim = end - count; claim != end; claim++) {
+        BridgeTraceSlot* slot = &g_traceSlots[claim & CFAPI_BRIDGE_TRACE_MASK];
+        LONG seq = BRIDGE_LOAD_ACQUIRE(&slot->sequence);
+        if (seq != (LONG)(claim + 1)) {
+            continue; // Being written, or already overwritten by a newer event
+        }
+        CfapiBridgeTraceEvent event = slot->event;
+        MemoryBarrier();
+        if (BRIDGE_LOAD_ACQUIRE(&slot->sequence) != seq) {
+            continue;
+        }
+        events[copied++] = event;
+    }
+    return copied;
+}
+
+int64_t CfapiBridgeGetQueueProducerRetries(void) {
+    return (int64_t)InterlockedCompareExchange64(&g_queueProducerRetries, 0, 0);
+}
 
 int32_t CfapiBridgeAckFetchPlaceholders(
     int64_t connectionKey,
     int64_t transferKey
 ) {
-    DebugLog("CfapiBridgeAckFetchPlaceholders: connKey=%lld, transKey=%lld",
+    BRIDGE_LOG_DEBUG("CfapiBridgeAckFetchPlaceholders: connKey=%lld, transKey=%lld",
              (long long)connectionKey, (long long)transferKey);
 
+    // NOTE: Do NOT use DISABLE_ON_DEMAND_POPULATION (0x00000001) - it causes freeze on subsequent access!
+    // With Flags=0, Windows will call FETCH_PLACEHOLDERS each time the folder is accessed.
+    return CfapiBridgeTransferPlaceholders(connectionKey, transferKey, 0, NULL, 0, 0, 0, S_OK, NULL);
+}
+
+int32_t CfapiBridgeTransferPlaceholders(
+    int64_t connectionKey,
+    int64_t transferKey,
+    int64_t requestKey,
+    void* placeholders,
+    int32_t count,
+    int64_t totalCount,
+    int32_t flags,
+    int32_t completionStatus,
+    int32_t* entriesProcessed
+) {
+    BRIDGE_LOG_DEBUG("CfapiBridgeTransferPlaceholders: connKey=%lld, transKey=%lld, count=%d, total=%lld, flags=0x%08X, status=0x%08X",
+             (long long)connectionKey, (long long)transferKey, count, (long long)totalCount,
+             (unsigned int)flags, (unsigned int)completionStatus);
+
+    if (entriesProcessed) {
+        *entriesProcessed = 0;
+    }
+
     if (!g_initialized) {
-        DebugLog("ERROR: Bridge not initialized");
+        BRIDGE_LOG_ERROR("ERROR: Bridge not initialized");
         return CFAPI_BRIDGE_ERROR_NOT_INITIALIZED;
     }
 
+    if (count < 0 || (count > 0 && !placeholders)) {
+        BRIDGE_LOG_ERROR("ERROR: Invalid placeholder batch");
+        return CFAPI_BRIDGE_ERROR_INVALID_PARAM;
+    }
+
     CF_OPERATION_INFO opInfo;
     memset(&opInfo, 0, sizeof(opInfo));
     opInfo.StructSize = sizeof(CF_OPERATION_INFO);
     opInfo.Type = CF_OPERATION_TYPE_TRANSFER_PLACEHOLDERS;
     opInfo.ConnectionKey = (CF_CONNECTION_KEY)connectionKey;
     opInfo.TransferKey = (CF_TRANSFER_KEY)transferKey;
+    opInfo.RequestKey = (LONGLONG)requestKey;
 
     CF_OPERATION_PARAMETERS opParams;
     memset(&opParams, 0, sizeof(opParams));
     opParams.ParamSize = sizeof(CF_OPERATION_PARAMETERS);
-
-    // Use the simple params embedded in the union
-    CF_OPERATION_TRANSFER_PLACEHOLDERS_PARAMS_SIMPLE* tpParams =
-        (CF_OPERATION_TRANSFER_PLACEHOLDERS_PARAMS_SIMPLE*)&opParams.Reserved[0];
-    // NOTE: Do NOT use DISABLE_ON_DEMAND_POPULATION (0x00000001) - it causes freeze on subsequent access!
-    // With Flags=0, Windows will call FETCH_PLACEHOLDERS each time the folder is accessed.
-    tpParams->Flags = 0x00000000; // No special flags - allow repeated callbacks
-    tpParams->CompletionStatus = S_OK;
-    tpParams->PlaceholderTotalCount.QuadPart = 0;
-
-    DebugLog("  Calling CfExecute(TRANSFER_PLACEHOLDERS) with Flags=0x%08X (no DISABLE_ON_DEMAND)", tpParams->Flags);
+    opParams.TransferPlaceholders.Flags = (DWORD)flags;
+    opParams.TransferPlaceholders.CompletionStatus = (HRESULT)completionStatus;
+    opParams.TransferPlaceholders.PlaceholderTotalCount.QuadPart = totalCount;
+    opParams.TransferPlaceholders.PlaceholderArray = placeholders;
+    opParams.TransferPlaceholders.PlaceholderCount = (DWORD)count;
 
     HRESULT hr = g_pfnCfExecute(&opInfo, &opParams);
+    BridgeTrace(CFAPI_BRIDGE_TRACE_PLACEHOLDERS, CFAPI_CALLBACK_FETCH_PLACEHOLDERS, connectionKey, transferKey,
+                count, totalCount, (int32_t)hr);
+
+    if (entriesProcessed) {
+        *entriesProcessed = (int32_t)opParams.TransferPlaceholders.EntriesProcessed;
+    }
 
     if (FAILED(hr)) {
-        DebugLog("ERROR: CfExecute (AckFetchPlaceholders) FAILED: HRESULT=0x%08lX", hr);
+        BRIDGE_LOG_ERROR("ERROR: CfExecute (TransferPlaceholders) FAILED: HRESULT=0x%08lX", hr);
         return CFAPI_BRIDGE_ERROR_API_FAILED;
     }
 
-    DebugLog("AckFetchPlaceholders SUCCESS");
+    BRIDGE_LOG_DEBUG("TransferPlaceholders SUCCESS (%u processed)",
+             (unsigned int)opParams.TransferPlaceholders.EntriesProcessed);
     return CFAPI_BRIDGE_OK;
 }
 
 int32_t CfapiBridgeSignalTransferComplete(void* completionEvent) {
     if (!completionEvent) {
-        DebugLog("ERROR: CfapiBridgeSignalTransferComplete called with NULL event");
+        BRIDGE_LOG_ERROR("ERROR: CfapiBridgeSignalTransferComplete called with NULL event");
         return CFAPI_BRIDGE_ERROR_INVALID_PARAM;
     }
 
-    DebugLog("Signaling transfer complete");
+    BRIDGE_LOG_DEBUG("Signaling transfer complete");
     if (!SetEvent((HANDLE)completionEvent)) {
-        DebugLog("ERROR: SetEvent failed (error=%lu)", GetLastError());
+        BRIDGE_LOG_ERROR("ERROR: SetEvent failed (error=%lu)", GetLastError());
         return CFAPI_BRIDGE_ERROR_API_FAILED;
     }
 
     return CFAPI_BRIDGE_OK;
 }
 
-// ============================================================================
-// Shared Fetch Request API - for thread-safe data fetching
-// ============================================================================
+// --- Transfer Buffer Pool ---
 
-int32_t CfapiBridgeInitSharedFetch(void) {
-    if (g_sharedFetchInitialized) {
-        return CFAPI_BRIDGE_OK;
+static int32_t InitTransferBufferPool(int32_t count) {
+    if (count <= 0) {
+        count = CFAPI_BRIDGE_DEFAULT_TRANSFER_BUFFERS;
+    }
+    if (count > CFAPI_BRIDGE_MAX_TRANSFER_BUFFERS) {
+        count = CFAPI_BRIDGE_MAX_TRANSFER_BUFFERS;
     }
 
-    InitializeCriticalSection(&g_sharedFetchCS);
-    memset(&g_sharedFetchRequest, 0, sizeof(g_sharedFetchRequest));
-
-    // Create synchronization events
-    g_sharedFetchRequest.requestReadyEvent = CreateEventW(NULL, FALSE, FALSE, NULL);
-    g_sharedFetchRequest.dataReadyEvent = CreateEventW(NULL, FALSE, FALSE, NULL);
+    // VirtualAlloc gives page-aligned memory that is never moved or reused
+    // by any allocator, so CfExecute can read it in place.
+    g_transferPoolBase = (uint8_t*)VirtualAlloc(NULL, (size_t)count * CFAPI_BRIDGE_MAX_CHUNK_SIZE,
+                                                MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+    if (!g_transferPoolBase) {
+        BRIDGE_LOG_ERROR("ERROR: Failed to allocate transfer buffer pool (error=%lu)", GetLastError());
+        return CFAPI_BRIDGE_ERROR_API_FAILED;
+    }
 
-    if (!g_sharedFetchRequest.requestReadyEvent || !g_sharedFetchRequest.dataReadyEvent) {
-        DebugLog("ERROR: Failed to create shared fetch events");
-        if (g_sharedFetchRequest.requestReadyEvent) CloseHandle(g_sharedFetchRequest.requestReadyEvent);
-        if (g_sharedFetchRequest.dataReadyEvent) CloseHandle(g_sharedFetchRequest.dataReadyEvent);
-        DeleteCriticalSection(&g_sharedFetchCS);
+    g_transferBufferSemaphore = CreateSemaphoreW(NULL, count, count, NULL);
+    if (!g_transferBufferSemaphore) {
+        VirtualFree(g_transferPoolBase, 0, MEM_RELEASE);
+        g_transferPoolBase = NULL;
         return CFAPI_BRIDGE_ERROR_API_FAILED;
     }
 
-    g_sharedFetchInitialized = 1;
-    DebugLog("Shared fetch initialized");
+    for (int32_t i = 0; i < count; i++) {
+        g_transferBufferInUse[i] = 0;
+    }
+    g_transferBufferNext = 0;
+    g_transferBufferCount = count;
+    BRIDGE_LOG_DEBUG("Transfer buffer pool initialized (%d x %d bytes)", count, CFAPI_BRIDGE_MAX_CHUNK_SIZE);
     return CFAPI_BRIDGE_OK;
 }
 
-void CfapiBridgeCleanupSharedFetch(void) {
-    if (!g_sharedFetchInitialized) return;
-
-    if (g_sharedFetchRequest.requestReadyEvent) {
-        CloseHandle(g_sharedFetchRequest.requestReadyEvent);
-        g_sharedFetchRequest.requestReadyEvent = NULL;
+static void CleanupTransferBufferPool(void) {
+    if (g_transferBufferSemaphore) {
+        CloseHandle(g_transferBufferSemaphore);
+        g_transferBufferSemaphore = NULL;
     }
-    if (g_sharedFetchRequest.dataReadyEvent) {
-        CloseHandle(g_sharedFetchRequest.dataReadyEvent);
-        g_sharedFetchRequest.dataReadyEvent = NULL;
+    if (g_transferPoolBase) {
+        VirtualFree(g_transferPoolBase, 0, MEM_RELEASE);
+        g_transferPoolBase = NULL;
     }
+    g_transferBufferCount = 0;
+}
 
-    DeleteCriticalSection(&g_sharedFetchCS);
-    g_sharedFetchInitialized = 0;
+int32_t CfapiBridgeSetTransferBufferCount(int32_t count) {
+    if (g_initialized) {
+        return CFAPI_BRIDGE_ERROR_INVALID_PARAM;
+    }
+    g_requestedTransferBuffers = count;
+    return CFAPI_BRIDGE_OK;
 }
 
-int32_t CfapiBridgeWaitForData(uint32_t timeoutMs) {
-    if (!g_sharedFetchInitialized) {
-        return CFAPI_BRIDGE_ERROR_NOT_INITIALIZED;
+int32_t CfapiBridgeGetTransferBufferCount(void) {
+    return g_transferBufferCount;
+}
+
+uint8_t* CfapiBridgeAcquireTransferBuffer(uint32_t timeoutMs) {
+    if (!g_transferPoolBase) {
+        return NULL;
     }
 
-    DWORD result = WaitForSingleObject(g_sharedFetchRequest.dataReadyEvent, timeoutMs);
-    if (result == WAIT_OBJECT_0) {
-        return CFAPI_BRIDGE_OK;
-    } else if (result == WAIT_TIMEOUT) {
-        return CFAPI_BRIDGE_ERROR_TIMEOUT;
+    if (WaitForSingleObject(g_transferBufferSemaphore, timeoutMs) != WAIT_OBJECT_0) {
+        return NULL;
     }
-    return CFAPI_BRIDGE_ERROR_API_FAILED;
-}
 
-CfapiBridgeSharedFetchRequest* CfapiBridgeGetPendingRequest(void) {
-    return &g_sharedFetchRequest;
+    uint32_t start = (uint32_t)InterlockedIncrement(&g_transferBufferNext);
+    for (int32_t n = 0; n < g_transferBufferCount; n++) {
+        int32_t i = (int32_t)((start + (uint32_t)n) % (uint32_t)g_transferBufferCount);
+        if (InterlockedCompareExchange(&g_transferBufferInUse[i], 1, 0) == 0) {
+            return g_transferPoolBase + (size_t)i * CFAPI_BRIDGE_MAX_CHUNK_SIZE;
+        }
+    }
+
+    // Should not happen: semaphore count and buffer flags disagree
+    BRIDGE_LOG_ERROR("ERROR: Transfer buffer semaphore acquired but no free buffer found");
+    ReleaseSemaphore(g_transferBufferSemaphore, 1, NULL);
+    return NULL;
 }
 
-void CfapiBridgeSignalDataReady(void) {
-    if (g_sharedFetchInitialized && g_sharedFetchRequest.dataReadyEvent) {
-        SetEvent(g_sharedFetchRequest.dataReadyEvent);
+void CfapiBridgeReleaseTransferBuffer(uint8_t* buffer) {
+    if (!g_transferPoolBase || !buffer) return;
+
+    size_t delta = (size_t)(buffer - g_transferPoolBase);
+    int32_t i = (int32_t)(delta / CFAPI_BRIDGE_MAX_CHUNK_SIZE);
+    if (buffer < g_transferPoolBase || i >= g_transferBufferCount || delta % CFAPI_BRIDGE_MAX_CHUNK_SIZE != 0) {
+        BRIDGE_LOG_ERROR("ERROR: Released pointer %p is not a transfer buffer", (void*)buffer);
+        return;
+    }
+
+    if (InterlockedExchange(&g_transferBufferInUse[i], 0) == 1) {
+        ReleaseSemaphore(g_transferBufferSemaphore, 1, NULL);
     }
 }
@@ -13,12 +13,11 @@ import "C"
 import (
 	"context"
 	"fmt"
-	"io"
 	"path/filepath"
 	"runtime"
-	"strings"
 	"sync"
 	"syscall"
+	"time"
 	"unsafe"
 
 	"go.uber.org/zap"
@@ -68,110 +67,27 @@ func ClearGlobalDataProvider() {
 	globalProgressCallback = nil
 }
 
-// ============================================================================
-// Shared Fetch Handler
-// ============================================================================
-// Processes fetch requests from C via shared memory.
-// C signals requestReadyEvent, Go reads the request, fetches data, fills buffer,
-// then signals dataReadyEvent. This avoids calling Go from the callback thread.
-
-// handleSharedFetchRequest processes a pending fetch request from C.
-// Called by processLoop when requestReadyEvent is signaled.
-func handleSharedFetchRequest(logger *zap.Logger) {
-	// Get pointer to shared request structure
-	sharedReq := C.CfapiBridgeGetPendingRequest()
-	if sharedReq == nil {
-		logger.Error("handleSharedFetchRequest: shared request is nil")
-		return
-	}
-
-	// Read request parameters
-	filePath := wcharToString((*uint16)(unsafe.Pointer(&sharedReq.filePath[0])))
-	offset := int64(sharedReq.offset)
-	maxLength := int64(sharedReq.maxLength)
-
-	globalDataProviderMu.RLock()
-	provider := globalDataProvider
-	syncRootPath := globalSyncRootPath
-	globalDataProviderMu.RUnlock()
-
-	if provider == nil {
-		logger.Error("handleSharedFetchRequest: no data provider set")
-		sharedReq.errorCode = -1
-		sharedReq.dataLength = 0
-		C.CfapiBridgeSignalDataReady()
-		return
-	}
-
-	// Convert NormalizedPath to relative path
-	relativePath := filePath
-	relativePath = strings.TrimPrefix(relativePath, "\\")
-	relativePath = strings.TrimPrefix(relativePath, "/")
-
-	// Strip sync root folder name
-	syncRootFolderName := filepath.Base(syncRootPath)
-	if strings.HasPrefix(relativePath, syncRootFolderName+"\\") {
-		relativePath = relativePath[len(syncRootFolderName)+1:]
-	} else if strings.HasPrefix(relativePath, syncRootFolderName+"/") {
-		relativePath = relativePath[len(syncRootFolderName)+1:]
-	}
-
-	// Normalize to forward slashes
-	relativePath = strings.ReplaceAll(relativePath, "\\", "/")
-
-	// Debug logging removed - enable in C bridge (g_debugLogging=1) for troubleshooting
-
-	// Get reader from data provider
-	ctx := context.Background()
-	reader, err := provider.GetFileReader(ctx, relativePath, offset)
-	if err != nil {
-		logger.Error("handleSharedFetchRequest: failed to get file reader",
-			zap.String("path", relativePath),
-			zap.Error(err),
-		)
-		sharedReq.errorCode = -2
-		sharedReq.dataLength = 0
-		C.CfapiBridgeSignalDataReady()
-		return
+// acquireTransferBuffer returns a bridge-owned, page-aligned chunk buffer
+// (CFAPI_BRIDGE_MAX_CHUNK_SIZE bytes) and the func that returns it to the pool.
+// The memory lives outside the Go heap, so data read into it is handed to
+// CfExecute as is. It never blocks: ok is false when the pool is exhausted
+// or the bridge is not initialized.
+func acquireTransferBuffer() (buf []byte, release func(), ok bool) {
+	ptr := C.CfapiBridgeAcquireTransferBuffer(0)
+	if ptr == nil {
+		return nil, nil, false
 	}
-	defer reader.Close()
-
-	// Read data into shared buffer
-	bufferPtr := (*[C.CFAPI_BRIDGE_MAX_CHUNK_SIZE]byte)(unsafe.Pointer(&sharedReq.data[0]))
-	toRead := maxLength
-	if toRead > C.CFAPI_BRIDGE_MAX_CHUNK_SIZE {
-		toRead = C.CFAPI_BRIDGE_MAX_CHUNK_SIZE
+	buf = unsafe.Slice((*byte)(unsafe.Pointer(ptr)), C.CFAPI_BRIDGE_MAX_CHUNK_SIZE)
+	var once sync.Once
+	release = func() {
+		once.Do(func() { C.CfapiBridgeReleaseTransferBuffer(ptr) })
 	}
-
-	n, err := io.ReadFull(reader, bufferPtr[:toRead])
-	if err != nil && err != io.EOF && err != io.ErrUnexpectedEOF {
-		logger.Error("handleSharedFetchRequest: failed to read data",
-			zap.String("path", relativePath),
-			zap.Error(err),
-		)
-		sharedReq.errorCode = -3
-		sharedReq.dataLength = 0
-		C.CfapiBridgeSignalDataReady()
-		return
-	}
-
-	sharedReq.errorCode = 0
-	sharedReq.dataLength = C.int64_t(n)
-
-	// Read complete - debug logging removed
-
-	// Signal that data is ready for C to read
-	C.CfapiBridgeSignalDataReady()
+	return buf, release, true
 }
 
-// GetRequestReadyEvent returns the event handle for the request ready event.
-// Used by processLoop to wait for fetch requests.
-func GetRequestReadyEvent() uintptr {
-	sharedReq := C.CfapiBridgeGetPendingRequest()
-	if sharedReq == nil {
-		return 0
-	}
-	return uintptr(sharedReq.requestReadyEvent)
+// GetTransferBufferCount returns the number of buffers in the transfer buffer pool.
+func GetTransferBufferCount() int {
+	return int(C.CfapiBridgeGetTransferBufferCount())
 }
 
 // ============================================================================
@@ -181,7 +97,8 @@ func GetRequestReadyEvent() uintptr {
 //export GoFetchDataChunk
 func GoFetchDataChunk(normalizedPath *C.wchar_t, offset C.int64_t, maxLength C.int64_t, response *C.CfapiBridgeFetchResponse) C.int32_t {
 	// This function is no longer called directly by C callbacks.
-	// Kept for API compatibility. The new architecture uses shared memory.
+	// Kept for API compatibility. FETCH_DATA goes through the connection
+	// request queue and is served by the hydration workers.
 	response.errorCode = -99 // Should not be called
 	return -99
 }
@@ -199,14 +116,54 @@ func GoReportHydrationProgress(normalizedPath *C.wchar_t, total C.int64_t, compl
 	}
 }
 
+// DefaultBridgeWorkers is the default number of consumer threads per sync root.
+const DefaultBridgeWorkers = 4
+
+// notifyLane is the ordered, unbounded queue between the pollers and
+// notifyLoop. Put never blocks: a bulk delete or rename storm only grows the
+// queue while the handlers run, instead of stalling every poller and with
+// them the hydrations they serve.
+type notifyLane struct {
+	mu    sync.Mutex
+	queue []bridgeRequest
+	ready chan struct{} // Holds a token while queue is not empty
+}
+
+func newNotifyLane() *notifyLane {
+	return &notifyLane{ready: make(chan struct{}, 1)}
+}
+
+// Put appends a notification and wakes notifyLoop.
+func (l *notifyLane) Put(req bridgeRequest) {
+	l.mu.Lock()
+	l.queue = append(l.queue, req)
+	l.mu.Unlock()
+	select {
+	case l.ready <- struct{}{}:
+	default:
+	}
+}
+
+// Take removes and returns the queued notifications, oldest first.
+func (l *notifyLane) Take() []bridgeRequest {
+	l.mu.Lock()
+	defer l.mu.Unlock()
+	queue := l.queue
+	l.queue = nil
+	return queue
+}
+
 // BridgeManager manages the CGO bridge for Cloud Files callbacks.
-// It processes callbacks from a dedicated OS thread to avoid Go scheduler issues.
+// It processes callbacks from a pool of dedicated OS threads to avoid Go
+// scheduler issues, so hydrations of different files run in parallel.
 type BridgeManager struct {
 	mu sync.RWMutex
 
 	// Configuration
 	syncRootPath string
 	logger       *zap.Logger
+	workers      int
+	partial      bool // Partial population: FETCH_PLACEHOLDERS is registered
 
 	// Connection state
 	connectionKey C.int64_t
@@ -215,10 +172,24 @@ type BridgeManager struct {
 	// Handlers
 	handlers BridgeHandlers
 
-	// Worker goroutine
+	// Worker pool
 	stopChan chan struct{}
 	doneChan chan struct{}
 	running  bool
+
+	// pollMu keeps notifications in dequeue order when several workers poll
+	pollMu sync.Mutex
+	notify *notifyLane
+
+	// In-flight FETCH_PLACEHOLDERS handlers
+	fetchWG sync.WaitGroup
+
+	// FETCH_DATA requests waiting for a hydration worker, by priority
+	prioritizer *fetchPrioritizer
+	scheduler   *fetchScheduler
+
+	// Queued and running fetches by transfer key, for CANCEL_FETCH_DATA
+	cancels *fetchCancels
 }
 
 // BridgeHandlers contains callback handlers for Cloud Files events.
@@ -237,6 +208,29 @@ type BridgeHandlers struct {
 	// OnNotifyRename is called when a file is being renamed.
 	// Return true to allow the rename, false to block it.
 	OnNotifyRename func(sourcePath, targetPath string, isDirectory bool) bool
+
+	// OnNotifyBatch receives delete and rename notifications coalesced by
+	// parent directory. When set, OnNotifyDelete and OnNotifyRename are not called.
+	OnNotifyBatch func(batch *NotifyBatch)
+
+	// OnFetchPlaceholders is called when Windows enumerates a directory that
+	// is not populated yet (partial population only). It returns the entries
+	// of the directory, which the bridge transfers to Windows in batches.
+	OnFetchPlaceholders func(req *BridgeFetchPlaceholdersRequest) ([]RemoteFileInfo, error)
+
+	// OnNotifyDehydrated is called after Windows dehydrated a file (user
+	// "Free up space", storage sense or CfDehydratePlaceholder).
+	OnNotifyDehydrated func(filePath string)
+}
+
+// BridgeFetchPlaceholdersRequest contains information about a directory population request.
+type BridgeFetchPlaceholdersRequest struct {
+	ConnectionKey int64
+	TransferKey   int64
+	RequestKey    int64
+	DirectoryPath string // Full normalized path of the directory
+	Pattern       string // Windows search pattern ("*" = everything)
+	PriorityHint  int    // Windows priority hint, 0 (lowest) to 15
 }
 
 // BridgeFetchDataRequest contains information about a hydration request.
@@ -248,13 +242,48 @@ type BridgeFetchDataRequest struct {
 	FileSize        int64
 	RequiredOffset  int64
 	RequiredLength  int64
+	OptionalOffset  int64   // Range Windows would also accept (prefetch hint)
+	OptionalLength  int64   // 0 = no optional range
+	PriorityHint    int     // Windows priority hint, 0 (lowest) to 15
+	ProcessID       uint32  // Process that triggered the hydration (0 = unknown)
+	ProcessImage    string  // Image path of that process ("" = unknown)
 	CompletionEvent uintptr // Event handle to signal when transfer is complete
+
+	// Context is cancelled when Windows cancels the fetch
+	Context context.Context
 }
 
 // BridgeConfig contains configuration for the bridge manager.
 type BridgeConfig struct {
 	SyncRootPath string
 	Logger       *zap.Logger
+
+	// Workers is the number of consumer threads draining this sync root's
+	// request queue (0 = DefaultBridgeWorkers). As many hydration workers
+	// serve queued FETCH_DATA requests in priority order.
+	Workers int
+
+	// Priority orders queued hydrations (foreground opens first, scanners last).
+	Priority FetchPriorityPolicy
+
+	// TransferBuffers is the number of bridge-owned hydration buffers
+	// (concurrent zero-copy chunk transfers). Only honored by the first
+	// bridge initialized in the process; 0 = default.
+	TransferBuffers int
+
+	// QueueLimit caps how far each connection's request queue may grow
+	// (0 = default). Only honored by the first bridge initialized in the process.
+	QueueLimit int
+
+	// QueueWaitBudget is how long a callback thread waits for room in a
+	// full queue before the request is dropped (0 = default, negative = never wait).
+	// Only honored by the first bridge initialized in the process.
+	QueueWaitBudget time.Duration
+
+	// PartialPopulation registers FETCH_PLACEHOLDERS, answered by
+	// BridgeHandlers.OnFetchPlaceholders. The sync root must be registered
+	// with the PARTIAL population policy.
+	PartialPopulation bool
 }
 
 // bridgeInitialized tracks global bridge initialization
@@ -264,7 +293,8 @@ var (
 )
 
 // initBridge initializes the C bridge (call once per process).
-func initBridge() error {
+// Transfer buffer and queue sizes are taken from the first config (0 = defaults).
+func initBridge(config BridgeConfig) error {
 	bridgeInitMu.Lock()
 	defer bridgeInitMu.Unlock()
 
@@ -272,6 +302,16 @@ func initBridge() error {
 		return nil
 	}
 
+	C.CfapiBridgeSetTransferBufferCount(C.int32_t(config.TransferBuffers))
+
+	waitMs := int32(-1) // C default
+	if config.QueueWaitBudget < 0 {
+		waitMs = 0
+	} else if config.QueueWaitBudget > 0 {
+		waitMs = int32(config.QueueWaitBudget / time.Millisecond)
+	}
+	C.CfapiBridgeSetQueueLimits(C.int32_t(config.QueueLimit), C.int32_t(waitMs))
+
 	result := C.CfapiBridgeInit()
 	if result != C.CFAPI_BRIDGE_OK {
 		return fmt.Errorf("failed to initialize CFAPI bridge: error %d", result)
@@ -295,15 +335,22 @@ func NewBridgeManager(config BridgeConfig) (*BridgeManager, error) {
 	if config.Logger == nil {
 		config.Logger = zap.NewNop()
 	}
+	if config.Workers <= 0 {
+		config.Workers = DefaultBridgeWorkers
+	}
 
 	// Initialize the bridge if not done
-	if err := initBridge(); err != nil {
+	if err := initBridge(config); err != nil {
 		return nil, err
 	}
 
 	return &BridgeManager{
 		syncRootPath: absPath,
 		logger:       config.Logger,
+		workers:      config.Workers,
+		partial:      config.PartialPopulation,
+		prioritizer:  newFetchPrioritizer(config.Priority),
+		cancels:      newFetchCancels(),
 		stopChan:     make(chan struct{}),
 		doneChan:     make(chan struct{}),
 	}, nil
@@ -316,6 +363,14 @@ func (b *BridgeManager) SetHandlers(handlers BridgeHandlers) {
 	b.handlers = handlers
 }
 
+// SetNotifyBatchHandler sets or removes (nil) the OnNotifyBatch handler.
+// Notifications pending when it is removed are delivered one by one.
+func (b *BridgeManager) SetNotifyBatchHandler(handler func(batch *NotifyBatch)) {
+	b.mu.Lock()
+	defer b.mu.Unlock()
+	b.handlers.OnNotifyBatch = handler
+}
+
 // Connect connects to the sync root.
 func (b *BridgeManager) Connect() error {
 	b.mu.Lock()
@@ -331,10 +386,16 @@ func (b *BridgeManager) Connect() error {
 		return fmt.Errorf("invalid sync root path: %w", err)
 	}
 
+	flags := C.int32_t(C.CFAPI_BRIDGE_CONNECT_DEFAULT)
+	if b.partial {
+		flags = C.CFAPI_BRIDGE_CONNECT_PARTIAL_POPULATION
+	}
+
 	var connKey C.int64_t
 	result := C.CfapiBridgeConnect(
 		(*C.wchar_t)(unsafe.Pointer(pathPtr)),
 		nil, // callback context not used
+		flags,
 		&connKey,
 	)
 
@@ -348,6 +409,7 @@ func (b *BridgeManager) Connect() error {
 	b.logger.Info("connected to sync root via CGO bridge",
 		zap.String("path", b.syncRootPath),
 		zap.Int64("connection_key", int64(connKey)),
+		zap.Bool("partial_population", b.partial),
 	)
 
 	return nil
@@ -375,7 +437,7 @@ func (b *BridgeManager) Disconnect() error {
 	return nil
 }
 
-// Start starts the worker goroutine that processes callbacks.
+// Start starts the worker pool that processes callbacks.
 func (b *BridgeManager) Start(ctx context.Context) error {
 	b.mu.Lock()
 	if b.running {
@@ -395,36 +457,97 @@ func (b *BridgeManager) Start(ctx context.Context) error {
 	b.running = true
 	b.stopChan = make(chan struct{})
 	b.doneChan = make(chan struct{})
+	b.notify = newNotifyLane()
+	b.scheduler = newFetchScheduler(0)
+	scheduler := b.scheduler
+	connKey := b.connectionKey
+	workers := b.workers
+	stopChan := b.stopChan
+	doneChan := b.doneChan
 	b.mu.Unlock()
 
-	// Start worker goroutine
-	go b.processLoop(ctx)
+	// Re-arm the stop event workers block on (left signaled by a previous Stop)
+	C.CfapiBridgeResetStop(connKey)
+
+	// Workers sleep in C and cannot see ctx, so wake them when it is cancelled
+	go func() {
+		select {
+		case <-ctx.Done():
+			C.CfapiBridgeSignalStop(connKey)
+			scheduler.Close()
+		case <-stopChan:
+		}
+	}()
+
+	// Start worker pool plus the ordered notification and cancellation lanes
+	var wg sync.WaitGroup
+	for i := 0; i < workers; i++ {
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			b.processLoop(ctx, connKey, stopChan)
+		}()
+	}
+	wg.Add(2)
+	go func() {
+		defer wg.Done()
+		b.notifyLoop(ctx, stopChan)
+	}()
+	go func() {
+		defer wg.Done()
+		b.cancelLoop(ctx, connKey, stopChan)
+	}()
+
+	// Hydration workers serve FETCH_DATA in priority order
+	var fetchWorkers sync.WaitGroup
+	for i := 0; i < workers; i++ {
+		fetchWorkers.Add(1)
+		go func() {
+			defer fetchWorkers.Done()
+			scheduler.Run()
+		}()
+	}
+
+	go func() {
+		wg.Wait()
+		// Pollers are gone: fail what is still queued and let the hydration
+		// workers and in-flight placeholder handlers finish before reporting done
+		scheduler.Close()
+		fetchWorkers.Wait()
+		b.fetchWG.Wait()
+		close(doneChan)
+	}()
 
-	b.logger.Info("bridge worker started")
+	b.logger.Info("bridge workers started", zap.Int("workers", workers))
 
 	return nil
 }
 
-// Stop stops the worker goroutine.
+// Stop stops the worker pool.
 func (b *BridgeManager) Stop() {
 	b.mu.Lock()
 	if !b.running {
 		b.mu.Unlock()
 		return
 	}
+	connKey := b.connectionKey
+	scheduler := b.scheduler
 	b.mu.Unlock()
 
-	// Signal stop
+	// Signal stop, waking workers blocked in CfapiBridgeWaitForWork or
+	// CfapiBridgeWaitForCancel and hydration workers in the fetch scheduler
 	close(b.stopChan)
+	C.CfapiBridgeSignalStop(connKey)
+	scheduler.Close()
 
-	// Wait for worker to finish
+	// Wait for workers to finish
 	<-b.doneChan
 
 	b.mu.Lock()
 	b.running = false
 	b.mu.Unlock()
 
-	b.logger.Info("bridge worker stopped")
+	b.logger.Info("bridge workers stopped")
 }
 
 // IsConnected returns whether the bridge is connected.
@@ -434,94 +557,481 @@ func (b *BridgeManager) IsConnected() bool {
 	return b.connected
 }
 
-// IsRunning returns whether the worker is running.
+// IsRunning returns whether the worker pool is running.
 func (b *BridgeManager) IsRunning() bool {
 	b.mu.RLock()
 	defer b.mu.RUnlock()
 	return b.running
 }
 
-// GetQueueCount returns the number of pending requests.
+// GetQueueCount returns the number of pending requests for this sync root.
 func (b *BridgeManager) GetQueueCount() int {
-	return int(C.CfapiBridgeGetQueueCount())
+	b.mu.RLock()
+	connKey := b.connectionKey
+	b.mu.RUnlock()
+	return int(C.CfapiBridgeGetConnectionQueueCount(connKey))
+}
+
+// QueueStats describes a sync root's request queue depth and backpressure.
+type QueueStats struct {
+	Queued              int   // Requests waiting for a worker
+	Capacity            int   // Currently allocated slots (grows in chunks)
+	Limit               int   // Maximum capacity
+	HighWater           int   // Deepest the queue has been
+	ProducerWaits       int64 // Callbacks that had to wait for room
+	DroppedFetchData    int64 // Hydrations failed because the queue was full
+	DroppedCancelFetch  int64 // Cancellations lost because the queue was full
+	DroppedNotifyDelete int64 // Delete notifications lost because the queue was full
+	DroppedNotifyRename int64 // Rename notifications lost because the queue was full
+}
+
+// GetQueueStats returns depth, growth and drop counters for this sync root's queue.
+func (b *BridgeManager) GetQueueStats() QueueStats {
+	b.mu.RLock()
+	connKey := b.connectionKey
+	b.mu.RUnlock()
+
+	var cs C.CfapiBridgeQueueStats
+	if C.CfapiBridgeGetQueueStats(connKey, &cs) != C.CFAPI_BRIDGE_OK {
+		return QueueStats{}
+	}
+	return QueueStats{
+		Queued:              int(cs.queued),
+		Capacity:            int(cs.capacity),
+		Limit:               int(cs.limit),
+		HighWater:           int(cs.highWater),
+		ProducerWaits:       int64(cs.producerWaits),
+		DroppedFetchData:    int64(cs.droppedFetchData),
+		DroppedCancelFetch:  int64(cs.droppedCancelFetch),
+		DroppedNotifyDelete: int64(cs.droppedNotifyDelete),
+		DroppedNotifyRename: int64(cs.droppedNotifyRename),
+	}
 }
 
-// processLoop is the main worker loop that processes callbacks.
-// It runs on a dedicated OS thread to avoid Go scheduler issues.
-// It handles BOTH:
-// 1. Shared fetch requests (C signals requestReadyEvent, Go fills buffer)
-// 2. Queue-based requests (CANCEL_FETCH_DATA, NOTIFY_DELETE, NOTIFY_RENAME)
-func (b *BridgeManager) processLoop(ctx context.Context) {
+// GetQueueProducerRetries returns how many times a callback thread lost the
+// compare-exchange race on the lock-free request queues (all connections).
+// A steadily growing value indicates heavy contention between filter threads.
+func (b *BridgeManager) GetQueueProducerRetries() int64 {
+	return int64(C.CfapiBridgeGetQueueProducerRetries())
+}
+
+// GetStats returns the bridge hot-path latency histograms and counters.
+// They are process-wide, so every bridge reports the same snapshot.
+func (b *BridgeManager) GetStats() BridgeStats {
+	return GetBridgeStats()
+}
+
+// GetBridgeStats returns a snapshot of the bridge hot-path statistics.
+func GetBridgeStats() BridgeStats {
+	var cs C.CfapiBridgeStats
+	if C.CfapiBridgeGetStats(&cs) != C.CFAPI_BRIDGE_OK {
+		return BridgeStats{}
+	}
+
+	hist := func(stage int) LatencyHistogram {
+		ch := &cs.stages[stage]
+		h := LatencyHistogram{
+			Count: int64(ch.count),
+			Sum:   time.Duration(ch.sumMicros) * time.Microsecond,
+			Max:   time.Duration(ch.maxMicros) * time.Microsecond,
+		}
+		for i := range h.Buckets {
+			h.Buckets[i] = int64(ch.buckets[i])
+		}
+		return h
+	}
+	counters := func(c *[C.CFAPI_BRIDGE_DROP_TYPE_COUNT]C.int64_t) CallbackCounters {
+		return CallbackCounters{
+			FetchData:    int64(c[C.CFAPI_BRIDGE_DROP_FETCH_DATA]),
+			CancelFetch:  int64(c[C.CFAPI_BRIDGE_DROP_CANCEL_FETCH_DATA]),
+			NotifyDelete: int64(c[C.CFAPI_BRIDGE_DROP_NOTIFY_DELETE]),
+			NotifyRename: int64(c[C.CFAPI_BRIDGE_DROP_NOTIFY_RENAME]),
+		}
+	}
+
+	return BridgeStats{
+		CallbackEnqueue:  hist(int(C.CFAPI_BRIDGE_STAGE_CALLBACK_ENQUEUE)),
+		QueueWait:        hist(int(C.CFAPI_BRIDGE_STAGE_QUEUE_WAIT)),
+		Dispatch:         hist(int(C.CFAPI_BRIDGE_STAGE_DISPATCH)),
+		FirstByte:        hist(int(C.CFAPI_BRIDGE_STAGE_FIRST_BYTE)),
+		CfExecute:        hist(int(C.CFAPI_BRIDGE_STAGE_CFEXECUTE)),
+		Hydration:        hist(int(C.CFAPI_BRIDGE_STAGE_HYDRATION)),
+		Callbacks:        counters(&cs.callbacks),
+		TransferredBytes: int64(cs.transferredBytes),
+	}
+}
+
+// ResetBridgeStats zeroes the bridge hot-path statistics.
+func ResetBridgeStats() {
+	C.CfapiBridgeResetStats()
+}
+
+// recordBridgeStage adds a Go-side duration to a bridge stage histogram.
+func recordBridgeStage(stage bridgeStage, d time.Duration) {
+	C.CfapiBridgeRecordStage(C.int32_t(stage), C.int64_t(d/time.Microsecond))
+}
+
+// GetBridgeTrace returns the most recent bridge trace events, oldest first
+// (at most CFAPI_BRIDGE_TRACE_SIZE, process-wide).
+func GetBridgeTrace() []BridgeTraceEvent {
+	raw := make([]C.CfapiBridgeTraceEvent, C.CFAPI_BRIDGE_TRACE_SIZE)
+	n := int(C.CfapiBridgeReadTrace(&raw[0], C.int32_t(len(raw))))
+
+	events := make([]BridgeTraceEvent, n)
+	for i := range events {
+		e := &raw[i]
+		events[i] = BridgeTraceEvent{
+			Time:          time.Duration(e.micros) * time.Microsecond,
+			Kind:          BridgeTraceKind(e.event),
+			CallbackType:  int32(e.callbackType),
+			ConnectionKey: int64(e.connectionKey),
+			TransferKey:   int64(e.transferKey),
+			Arg1:          int64(e.arg1),
+			Arg2:          int64(e.arg2),
+			Result:        int32(e.result),
+			ThreadID:      uint32(e.threadId),
+		}
+	}
+	return events
+}
+
+// SetBridgeTraceEnabled turns the bridge trace ring on or off (on by default).
+func SetBridgeTraceEnabled(enabled bool) {
+	var v C.int32_t
+	if enabled {
+		v = 1
+	}
+	C.CfapiBridgeSetTraceEnabled(v)
+}
+
+// SetBridgeLogLevel sets the bridge text log level. The text log only
+// exists in debug builds (build tag cfapi_debug); see BridgeHasDebugLog.
+func SetBridgeLogLevel(level BridgeLogLevel) {
+	C.CfapiBridgeSetLogLevel(C.int32_t(level))
+}
+
+// BridgeHasDebugLog reports whether the bridge text log is compiled in.
+func BridgeHasDebugLog() bool {
+	return C.CfapiBridgeHasDebugLog() != 0
+}
+
+// processLoop is the loop run by each worker of the pool.
+// Each worker runs on a dedicated OS thread to avoid Go scheduler issues.
+// It sleeps in CfapiBridgeWaitForWork until one of these is signaled:
+// 1. The stop event (Stop or ctx cancellation)
+// 2. Queue-based requests from this sync root's connection queue
+// Cancellations are served by cancelLoop.
+// FETCH_DATA requests are handed to the fetch scheduler; the rest are
+// dispatched inline.
+func (b *BridgeManager) processLoop(ctx context.Context, connKey C.int64_t, stopChan chan struct{}) {
 	// Lock this goroutine to a specific OS thread
 	runtime.LockOSThread()
 	defer runtime.UnlockOSThread()
 
-	defer close(b.doneChan)
-
-	// Get the request ready event handle for shared fetch
-	requestReadyEvent := GetRequestReadyEvent()
-
 	for {
 		select {
 		case <-ctx.Done():
 			return
-		case <-b.stopChan:
+		case <-stopChan:
 			return
 		default:
 		}
 
-		// Check for shared fetch request first (this is the priority for hydration)
-		if requestReadyEvent != 0 {
-			// Quick check if request is ready (0ms timeout)
-			waitResult, _, _ := procWaitForSingleObject.Call(
-				requestReadyEvent,
-				0, // No wait - just check
-			)
-			if waitResult == 0 { // WAIT_OBJECT_0 = 0
-				handleSharedFetchRequest(b.logger)
-				continue // Check for more requests immediately
+		result := C.CfapiBridgeWaitForWork(connKey, waitInfinite)
+		switch result {
+		case C.CFAPI_BRIDGE_WAKE_STOP:
+			return
+
+		case C.CFAPI_BRIDGE_WAKE_REQUEST:
+			var req bridgeRequest
+			if !b.nextRequest(connKey, &req) {
+				continue
+			}
+			if req.hdr._type == C.CFAPI_CALLBACK_FETCH_DATA {
+				b.scheduleFetch(&req)
+				continue
+			}
+			// Dispatch based on type
+			b.dispatchRequest(&req)
+
+		case C.CFAPI_BRIDGE_ERROR_TIMEOUT:
+			continue
+
+		default:
+			b.logger.Error("error waiting for work", zap.Int("result", int(result)))
+			// Avoid spinning if the connection's handles are gone
+			select {
+			case <-stopChan:
+				return
+			case <-ctx.Done():
+				return
+			case <-time.After(100 * time.Millisecond):
 			}
 		}
+	}
+}
+
+// cancelLoop drains the connection's cancellation lane on its own thread,
+// so cancellations get through while every worker is busy with a request.
+func (b *BridgeManager) cancelLoop(ctx context.Context, connKey C.int64_t, stopChan chan struct{}) {
+	runtime.LockOSThread()
+	defer runtime.UnlockOSThread()
 
-		// Wait for a queue request with short timeout (allows checking other events)
-		result := C.CfapiBridgeWaitForRequest(50) // 50ms timeout
-		if result == C.CFAPI_BRIDGE_ERROR_TIMEOUT {
-			continue // Check stop channel and shared fetch again
+	for {
+		select {
+		case <-ctx.Done():
+			return
+		case <-stopChan:
+			return
+		default:
 		}
-		if result != C.CFAPI_BRIDGE_OK {
-			b.logger.Error("error waiting for request", zap.Int("result", int(result)))
+
+		switch result := C.CfapiBridgeWaitForCancel(connKey, waitInfinite); result {
+		case C.CFAPI_BRIDGE_WAKE_STOP:
+			return
+
+		case C.CFAPI_BRIDGE_WAKE_CANCEL:
+			var cancel C.CfapiBridgeCancel
+			if C.CfapiBridgePollCancel(connKey, &cancel) == C.CFAPI_BRIDGE_OK {
+				b.cancelFetch(int64(cancel.transferKey), int64(cancel.offset), int64(cancel.length))
+			}
+
+		case C.CFAPI_BRIDGE_ERROR_TIMEOUT:
 			continue
+
+		default:
+			b.logger.Error("error waiting for cancellations", zap.Int("result", int(result)))
+			select {
+			case <-stopChan:
+				return
+			case <-ctx.Done():
+				return
+			case <-time.After(100 * time.Millisecond):
+			}
+		}
+	}
+}
+
+// bridgeRequest is a polled request with its paths copied out as Go strings.
+type bridgeRequest struct {
+	hdr        C.CfapiBridgeRequest
+	filePath   string
+	targetPath string
+	ctx        context.Context // FETCH_DATA: cancelled with the fetch (nil = never)
+	polled     time.Time       // When a worker took it from the C queue
+}
+
+// pathFromBuffer converts one path written by CfapiBridgePollRequest.
+func pathFromBuffer(buf []uint16, offset, length C.int32_t) string {
+	if length <= 0 || offset < 0 || int(offset+length) > len(buf) {
+		return ""
+	}
+	return syscall.UTF16ToString(buf[offset : offset+length])
+}
+
+// nextRequest polls one request from the connection queue.
+// Notifications are handed to the notification lane while pollMu is held,
+// so they reach the handlers in the order Windows raised them even though
+// several workers poll concurrently; the lane never blocks, so pollMu is
+// only held for the poll itself. Returns true if the caller should
+// dispatch req itself.
+func (b *BridgeManager) nextRequest(connKey C.int64_t, req *bridgeRequest) bool {
+	var pathBuf [C.CFAPI_BRIDGE_REQUEST_PATH_CHARS]uint16
+
+	b.pollMu.Lock()
+	defer b.pollMu.Unlock()
+
+	result := C.CfapiBridgePollRequest(connKey, &req.hdr,
+		(*C.wchar_t)(unsafe.Pointer(&pathBuf[0])), C.CFAPI_BRIDGE_REQUEST_PATH_CHARS)
+	if result == C.CFAPI_BRIDGE_ERROR_QUEUE_EMPTY {
+		return false // Race condition, queue became empty
+	}
+	if result != C.CFAPI_BRIDGE_OK {
+		b.logger.Error("error polling request", zap.Int("result", int(result)))
+		return false
+	}
+
+	req.polled = time.Now()
+	req.filePath = pathFromBuffer(pathBuf[:], req.hdr.filePathOffset, req.hdr.filePathLength)
+	req.targetPath = pathFromBuffer(pathBuf[:], req.hdr.targetPathOffset, req.hdr.targetPathLength)
+
+	switch req.hdr._type {
+	case C.CFAPI_CALLBACK_NOTIFY_DELETE, C.CFAPI_CALLBACK_NOTIFY_RENAME:
+		b.notify.Put(*req)
+		return false
+	default:
+		return true
+	}
+}
+
+// scheduleFetch queues a FETCH_DATA request for the hydration workers.
+// When the scheduler is full the fetch is failed with a retryable status
+// right away: blocking here would also stop the poller from serving the
+// other requests of the queue.
+// A fetch cancelled while queued is failed without being dispatched.
+func (b *BridgeManager) scheduleFetch(req *bridgeRequest) {
+	r := *req
+	ticket := b.cancels.Begin(int64(r.hdr.transferKey), int64(r.hdr.requiredOffset), int64(r.hdr.requiredLength))
+	r.ctx = ticket.ctx
+
+	priority := b.prioritizer.Priority(int(r.hdr.priorityHint), uint32(r.hdr.processId), r.targetPath)
+	queued := b.scheduler.Push(priority,
+		func() {
+			defer b.cancels.End(ticket)
+			if ticket.ctx.Err() != nil {
+				b.logger.Debug("skipping cancelled fetch", zap.String("path", r.filePath))
+				b.abortFetch(&r, E_FAIL)
+				return
+			}
+			b.dispatchRequest(&r)
+		},
+		func() {
+			defer b.cancels.End(ticket)
+			b.abortFetch(&r, E_FAIL)
+		},
+	)
+	if !queued {
+		b.cancels.End(ticket)
+		b.logger.Warn("fetch scheduler full, fetch refused", zap.String("path", r.filePath))
+		b.abortFetch(&r, E_RETRY)
+	}
+}
+
+// cancelFetch cancels the fetches of a transfer range (length 0: the whole
+// transfer): queued ones are skipped and running ones see their context
+// cancelled, which aborts their remote reads.
+func (b *BridgeManager) cancelFetch(transferKey, offset, length int64) {
+	if b.cancels.Cancel(transferKey, offset, length) {
+		b.logger.Debug("fetch cancelled",
+			zap.Int64("transfer_key", transferKey),
+			zap.Int64("offset", offset),
+			zap.Int64("length", length))
+	}
+}
+
+// abortFetch fails a FETCH_DATA request that was never dispatched.
+func (b *BridgeManager) abortFetch(r *bridgeRequest, status int32) {
+	req := &r.hdr
+	C.CfapiBridgeTransferError(req.connectionKey, req.transferKey, req.requestKey, C.int32_t(status))
+	if completionEvent := uintptr(req.completionEvent); completionEvent != 0 {
+		C.CfapiBridgeSignalTransferComplete(unsafe.Pointer(completionEvent))
+	}
+}
+
+// notifyLoop dispatches delete/rename notifications in queue order. With a
+// batch handler they are coalesced while they keep arriving (a folder
+// delete or move) and delivered as batches; pending ones are delivered on stop.
+func (b *BridgeManager) notifyLoop(ctx context.Context, stopChan chan struct{}) {
+	lane := b.notify
+	var pending notifyCoalescer
+	var first time.Time // Arrival of the oldest pending notification
+	timer := time.NewTimer(notifyBatchWindow)
+	timer.Stop()
+	defer timer.Stop()
+
+	flush := func() {
+		b.deliverNotifyBatches(pending.Flush())
+	}
+
+	// handle dispatches the notifications taken from the lane, or adds them
+	// to the pending batches
+	handle := func(reqs []bridgeRequest) {
+		b.mu.RLock()
+		batched := b.handlers.OnNotifyBatch != nil
+		b.mu.RUnlock()
+
+		for i := range reqs {
+			if !batched {
+				flush()
+				b.dispatchRequest(&reqs[i])
+				continue
+			}
+
+			kind, entry := notifyEntryFromRequest(&reqs[i])
+			b.deliverNotifyBatches(pending.Add(kind, entry))
+			if pending.Len() >= notifyBatchMaxEntries {
+				flush()
+			}
+			if pending.Len() == 1 {
+				first = time.Now()
+			}
 		}
+	}
+
+	for {
+		select {
+		case <-ctx.Done():
+			handle(lane.Take())
+			flush()
+			return
+		case <-stopChan:
+			handle(lane.Take())
+			flush()
+			return
+		case <-timer.C:
+			flush()
+		case <-lane.ready:
+			handle(lane.Take())
+			if pending.Len() == 0 {
+				continue
+			}
 
-		// Poll for request
-		var req C.CfapiBridgeRequest
-		result = C.CfapiBridgePollRequest(&req)
-		if result == C.CFAPI_BRIDGE_ERROR_QUEUE_EMPTY {
-			continue // Race condition, queue became empty
+			// Wait for a quiet window, but never hold the oldest one too long
+			wait := notifyBatchWindow
+			if left := notifyBatchMaxDelay - time.Since(first); left < wait {
+				wait = left
+			}
+			if !timer.Stop() {
+				select {
+				case <-timer.C:
+				default:
+				}
+			}
+			timer.Reset(wait)
 		}
-		if result != C.CFAPI_BRIDGE_OK {
-			b.logger.Error("error polling request", zap.Int("result", int(result)))
+	}
+}
+
+// notifyEntryFromRequest converts a NOTIFY_DELETE/NOTIFY_RENAME request.
+func notifyEntryFromRequest(req *bridgeRequest) (NotifyKind, NotifyEntry) {
+	entry := NotifyEntry{Path: req.filePath, IsDirectory: req.hdr.isDirectory != 0}
+	if req.hdr._type == C.CFAPI_CALLBACK_NOTIFY_RENAME {
+		entry.TargetPath = req.targetPath
+		return NotifyRename, entry
+	}
+	return NotifyDelete, entry
+}
+
+// deliverNotifyBatches hands batches to the batch handler, or replays them
+// entry by entry if it was removed while they were pending.
+func (b *BridgeManager) deliverNotifyBatches(batches []NotifyBatch) {
+	if len(batches) == 0 {
+		return
+	}
+	b.mu.RLock()
+	handlers := b.handlers
+	b.mu.RUnlock()
+
+	for i := range batches {
+		batch := &batches[i]
+		if handlers.OnNotifyBatch != nil {
+			handlers.OnNotifyBatch(batch)
 			continue
 		}
-
-		// Dispatch based on type
-		b.dispatchRequest(&req)
+		batch.replay(handlers.OnNotifyDelete, handlers.OnNotifyRename)
 	}
 }
 
-// WaitForSingleObject Windows API
-var (
-	kernel32                 = syscall.NewLazyDLL("kernel32.dll")
-	procWaitForSingleObject  = kernel32.NewProc("WaitForSingleObject")
-)
+// waitInfinite is the Win32 INFINITE timeout for CfapiBridgeWaitForWork and CfapiBridgeWaitForCancel.
+const waitInfinite = 0xFFFFFFFF
 
 // dispatchRequest handles a single callback request.
-func (b *BridgeManager) dispatchRequest(req *C.CfapiBridgeRequest) {
+func (b *BridgeManager) dispatchRequest(req *bridgeRequest) {
 	b.mu.RLock()
 	handlers := b.handlers
 	b.mu.RUnlock()
 
-	switch req._type {
+	switch req.hdr._type {
 	case C.CFAPI_CALLBACK_FETCH_DATA:
 		b.handleFetchData(req, handlers.OnFetchData)
 
@@ -534,16 +1044,25 @@ func (b *BridgeManager) dispatchRequest(req *C.CfapiBridgeRequest) {
 	case C.CFAPI_CALLBACK_NOTIFY_RENAME:
 		b.handleNotifyRename(req, handlers.OnNotifyRename)
 
+	case C.CFAPI_CALLBACK_FETCH_PLACEHOLDERS:
+		b.handleFetchPlaceholders(req, handlers.OnFetchPlaceholders)
+
+	case C.CFAPI_CALLBACK_NOTIFY_DEHYDRATE_COMPLETION:
+		if handlers.OnNotifyDehydrated != nil {
+			handlers.OnNotifyDehydrated(req.filePath)
+		}
+
 	default:
-		b.logger.Warn("unknown callback type", zap.Int32("type", int32(req._type)))
+		b.logger.Warn("unknown callback type", zap.Int32("type", int32(req.hdr._type)))
 	}
 }
 
 // handleFetchData handles a FETCH_DATA callback.
 // The C callback enqueues the request and returns immediately.
 // We process it here and call CfExecute(TransferData) to send data to Windows.
-func (b *BridgeManager) handleFetchData(req *C.CfapiBridgeRequest, handler func(*BridgeFetchDataRequest) error) {
-	filePath := wcharToString((*uint16)(unsafe.Pointer(&req.filePath[0])))
+func (b *BridgeManager) handleFetchData(r *bridgeRequest, handler func(*BridgeFetchDataRequest) error) {
+	req := &r.hdr
+	filePath := r.filePath
 	// CRITICAL: Use uintptr instead of unsafe.Pointer for Windows HANDLE.
 	// The GC would try to interpret unsafe.Pointer as a Go pointer and crash
 	// with "invalid pointer found on stack" because HANDLEs are small integers.
@@ -570,14 +1089,28 @@ func (b *BridgeManager) handleFetchData(req *C.CfapiBridgeRequest, handler func(
 		FileSize:        int64(req.fileSize),
 		RequiredOffset:  int64(req.requiredOffset),
 		RequiredLength:  int64(req.requiredLength),
+		OptionalOffset:  int64(req.optionalOffset),
+		OptionalLength:  int64(req.optionalLength),
+		PriorityHint:    int(req.priorityHint),
+		ProcessID:       uint32(req.processId),
+		ProcessImage:    r.targetPath,    // Image path for FETCH_DATA
 		CompletionEvent: completionEvent, // Already uintptr
+		Context:         r.ctx,
 	}
 
-	if err := handler(fetchReq); err != nil {
-		b.logger.Error("FETCH_DATA handler failed",
-			zap.String("path", filePath),
-			zap.Error(err),
-		)
+	start := time.Now()
+	recordBridgeStage(stageDispatch, start.Sub(r.polled))
+	err := handler(fetchReq)
+	recordBridgeStage(stageHydration, time.Since(start))
+	if err != nil {
+		if r.ctx != nil && r.ctx.Err() != nil {
+			b.logger.Debug("FETCH_DATA cancelled", zap.String("path", filePath))
+		} else {
+			b.logger.Error("FETCH_DATA handler failed",
+				zap.String("path", filePath),
+				zap.Error(err),
+			)
+		}
 		C.CfapiBridgeTransferError(req.connectionKey, req.transferKey, req.requestKey, C.int32_t(E_FAIL))
 	}
 	// No ACK_DATA needed after FETCH_DATA: TransferData with MARK_IN_SYNC
@@ -585,35 +1118,103 @@ func (b *BridgeManager) handleFetchData(req *C.CfapiBridgeRequest, handler func(
 	// ACK_DATA (CF_OPERATION_TYPE_ACK_DATA) is only for VALIDATE_DATA callbacks.
 }
 
-// handleCancelFetch handles a CANCEL_FETCH_DATA callback.
-func (b *BridgeManager) handleCancelFetch(req *C.CfapiBridgeRequest, handler func(string)) {
-	filePath := wcharToString((*uint16)(unsafe.Pointer(&req.filePath[0])))
+// handleCancelFetch handles a CANCEL_FETCH_DATA callback that went through
+// the request queue because the cancellation lane was full.
+func (b *BridgeManager) handleCancelFetch(req *bridgeRequest, handler func(string)) {
+	b.cancelFetch(int64(req.hdr.transferKey), int64(req.hdr.requiredOffset), int64(req.hdr.requiredLength))
 	if handler != nil {
-		handler(filePath)
+		handler(req.filePath)
 	}
 }
 
 // handleNotifyDelete handles a NOTIFY_DELETE callback.
-func (b *BridgeManager) handleNotifyDelete(req *C.CfapiBridgeRequest, handler func(string, bool) bool) {
-	filePath := wcharToString((*uint16)(unsafe.Pointer(&req.filePath[0])))
-	isDir := req.isDirectory != 0
+func (b *BridgeManager) handleNotifyDelete(req *bridgeRequest, handler func(string, bool) bool) {
+	isDir := req.hdr.isDirectory != 0
 	// For notifications, we just inform the handler - can't block the operation
 	if handler != nil {
-		handler(filePath, isDir)
+		handler(req.filePath, isDir)
 	}
 }
 
 // handleNotifyRename handles a NOTIFY_RENAME callback.
-func (b *BridgeManager) handleNotifyRename(req *C.CfapiBridgeRequest, handler func(string, string, bool) bool) {
-	sourcePath := wcharToString((*uint16)(unsafe.Pointer(&req.filePath[0])))
-	targetPath := wcharToString((*uint16)(unsafe.Pointer(&req.targetPath[0])))
-	isDir := req.isDirectory != 0
+func (b *BridgeManager) handleNotifyRename(req *bridgeRequest, handler func(string, string, bool) bool) {
+	isDir := req.hdr.isDirectory != 0
 	// For notifications, we just inform the handler - can't block the operation
 	if handler != nil {
-		handler(sourcePath, targetPath, isDir)
+		handler(req.filePath, req.targetPath, isDir)
 	}
 }
 
+// handleFetchPlaceholders handles a FETCH_PLACEHOLDERS callback.
+// Listing a remote directory can take a while, so it runs off the polling
+// thread; the enumeration is answered with TRANSFER_PLACEHOLDERS batches of
+// populationBatchSize entries, or failed if the listing fails.
+func (b *BridgeManager) handleFetchPlaceholders(r *bridgeRequest, handler func(*BridgeFetchPlaceholdersRequest) ([]RemoteFileInfo, error)) {
+	req := BridgeFetchPlaceholdersRequest{
+		ConnectionKey: int64(r.hdr.connectionKey),
+		TransferKey:   int64(r.hdr.transferKey),
+		RequestKey:    int64(r.hdr.requestKey),
+		DirectoryPath: r.filePath,
+		Pattern:       r.targetPath,
+		PriorityHint:  int(r.hdr.priorityHint),
+	}
+	connKey := CF_CONNECTION_KEY(req.ConnectionKey)
+	transferKey := CF_TRANSFER_KEY(req.TransferKey)
+
+	b.fetchWG.Add(1)
+	go func() {
+		defer b.fetchWG.Done()
+
+		var files []RemoteFileInfo
+		err := fmt.Errorf("no fetch placeholders handler registered")
+		if handler != nil {
+			files, err = handler(&req)
+		}
+		if err != nil {
+			b.logger.Warn("directory population failed",
+				zap.String("path", req.DirectoryPath),
+				zap.Error(err),
+			)
+			TransferPlaceholders(connKey, transferKey, req.RequestKey, nil, 0, 0, int32(E_FAIL))
+			return
+		}
+
+		placeholders := make([]CF_PLACEHOLDER_CREATE_INFO, 0, len(files))
+		for _, f := range files {
+			info, err := newPlaceholderCreateInfo(f)
+			if err != nil {
+				b.logger.Warn("skipping invalid placeholder", zap.String("path", f.Path), zap.Error(err))
+				continue
+			}
+			placeholders = append(placeholders, info)
+		}
+
+		// An empty directory still needs one (empty) transfer to complete.
+		// Entries that already exist (from an earlier population) are
+		// reported per entry and do not fail the batch.
+		total := int64(len(placeholders))
+		for start := 0; start == 0 || start < len(placeholders); start += populationBatchSize {
+			end := start + populationBatchSize
+			if end > len(placeholders) {
+				end = len(placeholders)
+			}
+			if _, err := TransferPlaceholders(connKey, transferKey, req.RequestKey, placeholders[start:end], total, 0, S_OK); err != nil {
+				b.logger.Warn("failed to transfer placeholders",
+					zap.String("path", req.DirectoryPath),
+					zap.Int("batch_start", start),
+					zap.Error(err),
+				)
+				return
+			}
+		}
+
+		b.logger.Debug("directory populated",
+			zap.String("path", req.DirectoryPath),
+			zap.Int64("entries", total),
+		)
+	}()
+}
+
 // wcharToString converts a null-terminated wide string to a Go string.
 func wcharToString(ptr *uint16) string {
 	if ptr == nil {
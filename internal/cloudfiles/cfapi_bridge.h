@@ -7,38 +7,90 @@
 #include <windows.h>
 #include <stdint.h>
 
-// Maximum queue size for callback requests
+// Size of the lock-free request ring (per connection, must be a power of two)
 #define CFAPI_BRIDGE_MAX_QUEUE_SIZE 64
 
+// Overflow chunk size: the queue grows by this many requests when the ring is full
+#define CFAPI_BRIDGE_QUEUE_CHUNK_SIZE 64
+
+// Default and maximum total requests per connection (ring + overflow chunks)
+#define CFAPI_BRIDGE_DEFAULT_QUEUE_LIMIT 4096
+#define CFAPI_BRIDGE_MAX_QUEUE_LIMIT 65536
+
+// Default time a callback thread waits for room in a full queue before dropping
+#define CFAPI_BRIDGE_DEFAULT_PRODUCER_WAIT_MS 100
+
+// Cancellation lane size (per connection): CANCEL_FETCH_DATA transfer keys
+// waiting for the cancellation thread, served before queued requests. When full, cancels
+// fall back to the request queue.
+#define CFAPI_BRIDGE_CANCEL_LANE_SIZE 256
+
+// Maximum number of simultaneously connected sync roots (one request queue each)
+#define CFAPI_BRIDGE_MAX_CONNECTIONS 16
+
 // Maximum path length
 #define CFAPI_BRIDGE_MAX_PATH 520
 
 // Maximum chunk size for data transfer (1 MB)
 #define CFAPI_BRIDGE_MAX_CHUNK_SIZE (1024 * 1024)
 
+// Runs of a transfer batch shorter than this are copied together into one
+// TRANSFER_DATA (64 KB); longer ones are sent from their own buffers
+#define CFAPI_BRIDGE_MAX_BATCH_STAGING (64 * 1024)
+
 // Callback types matching CF_CALLBACK_TYPE
 typedef enum {
     CFAPI_CALLBACK_FETCH_DATA = 0,
     CFAPI_CALLBACK_CANCEL_FETCH_DATA = 2,
+    CFAPI_CALLBACK_FETCH_PLACEHOLDERS = 3,
+    CFAPI_CALLBACK_NOTIFY_DEHYDRATE_COMPLETION = 8,
     CFAPI_CALLBACK_NOTIFY_DELETE = 9,
     CFAPI_CALLBACK_NOTIFY_RENAME = 11,
 } CfapiBridgeCallbackType;
 
-// Request structure passed from C to Go (for non-FETCH_DATA callbacks)
+// Path slab geometry: each block holds CFAPI_BRIDGE_PATH_BLOCK_CHARS characters
+// plus a link (128 bytes), segments of blocks are added on demand per queue.
+#define CFAPI_BRIDGE_PATH_BLOCK_CHARS 62
+#define CFAPI_BRIDGE_PATH_SEGMENT_BLOCKS 256
+#define CFAPI_BRIDGE_MAX_PATH_SEGMENTS 512
+
+// Minimum path buffer size for CfapiBridgePollRequest (file path + target path, NUL-terminated)
+#define CFAPI_BRIDGE_REQUEST_PATH_CHARS (2 * CFAPI_BRIDGE_MAX_PATH)
+
+// Request structure passed from C to Go.
+// Paths are not embedded: while queued they live in the queue's path slab;
+// CfapiBridgePollRequest copies them into the caller's path buffer and sets
+// the offsets (in characters) to their position there. Lengths exclude the NUL.
 typedef struct {
     int32_t type;                           // CfapiBridgeCallbackType
+    int32_t isDirectory;                    // Is this a directory operation
     int64_t connectionKey;                  // CF_CONNECTION_KEY
     int64_t transferKey;                    // CF_TRANSFER_KEY
     int64_t requestKey;                     // CF_REQUEST_KEY (required for CfExecute)
-    wchar_t filePath[CFAPI_BRIDGE_MAX_PATH]; // Normalized file path
     int64_t fileSize;                       // File size (for FETCH_DATA)
-    int64_t requiredOffset;                 // Required offset (for FETCH_DATA)
-    int64_t requiredLength;                 // Required length (for FETCH_DATA)
-    wchar_t targetPath[CFAPI_BRIDGE_MAX_PATH]; // Target path (for NOTIFY_RENAME)
-    int32_t isDirectory;                    // Is this a directory operation
+    int64_t requiredOffset;                 // Required offset (for FETCH_DATA), cancelled range (CANCEL_FETCH_DATA)
+    int64_t requiredLength;                 // Required length (for FETCH_DATA), 0 = unknown (CANCEL_FETCH_DATA)
+    int64_t optionalOffset;                 // Optional (prefetchable) range offset (for FETCH_DATA)
+    int64_t optionalLength;                 // Optional range length, 0 = none (for FETCH_DATA)
+    int32_t priorityHint;                   // CF_CALLBACK_INFO.PriorityHint, 0 (lowest) to 15 (highest)
+    int32_t processId;                      // Requesting process, 0 = unknown
+    int64_t timestamp;                      // QPC ticks when queued (stats)
     void* completionEvent;                  // Event to signal when transfer is done (for sync callbacks)
+    int32_t filePathOffset;                 // Normalized file path
+    int32_t filePathLength;
+    int32_t targetPathOffset;               // Target path (NOTIFY_RENAME), process image path (FETCH_DATA) or pattern (FETCH_PLACEHOLDERS)
+    int32_t targetPathLength;
 } CfapiBridgeRequest;
 
+// Cancellation taken from the cancellation lane by CfapiBridgePollCancel.
+// Windows reuses a transfer key for the successive fetches of an open file,
+// so the range tells which FETCH_DATA is cancelled.
+typedef struct {
+    int64_t transferKey;                    // CF_TRANSFER_KEY of the cancelled FETCH_DATA
+    int64_t offset;                         // Cancelled range offset
+    int64_t length;                         // Cancelled range length, 0 = unknown (whole transfer)
+} CfapiBridgeCancel;
+
 // Response from Go for FETCH_DATA - contains a chunk of data
 typedef struct {
     int32_t errorCode;                      // 0 = success, negative = error
@@ -46,41 +98,29 @@ typedef struct {
     uint8_t data[CFAPI_BRIDGE_MAX_CHUNK_SIZE]; // Data buffer
 } CfapiBridgeFetchResponse;
 
-// Shared data request structure for thread-safe data fetching
-// C posts a request, Go fills in the data, C reads the data.
-// This avoids calling Go from the Windows callback thread.
-typedef struct {
-    // Request fields (written by C, read by Go)
-    wchar_t filePath[CFAPI_BRIDGE_MAX_PATH];
-    int64_t offset;
-    int64_t maxLength;
-
-    // Synchronization (created by C, used by both)
-    void* requestReadyEvent;    // C sets this when request is ready
-    void* dataReadyEvent;       // Go sets this when data is ready
+// Default and maximum number of buffers in the transfer buffer pool
+#define CFAPI_BRIDGE_DEFAULT_TRANSFER_BUFFERS 8
+#define CFAPI_BRIDGE_MAX_TRANSFER_BUFFERS 64
 
-    // Response fields (written by Go, read by C)
-    int32_t errorCode;
-    int64_t dataLength;
-    uint8_t data[CFAPI_BRIDGE_MAX_CHUNK_SIZE];
-} CfapiBridgeSharedFetchRequest;
+// Transfer buffer pool: bridge-owned, page-aligned buffers of
+// CFAPI_BRIDGE_MAX_CHUNK_SIZE bytes. Go reads remote data straight into one
+// and hands the same memory to CfapiBridgeTransferData, so each hydrated byte
+// is copied once by the SMB client and once by CfExecute, with no Go heap
+// buffer or cgo pointer checks in between. The memory never moves.
 
-// Initialize the shared fetch request (call once)
-int32_t CfapiBridgeInitSharedFetch(void);
+// Set the number of pool buffers used by CfapiBridgeInit
+// Must be called before CfapiBridgeInit; returns CFAPI_BRIDGE_ERROR_INVALID_PARAM afterwards
+int32_t CfapiBridgeSetTransferBufferCount(int32_t count);
 
-// Cleanup the shared fetch request
-void CfapiBridgeCleanupSharedFetch(void);
+// Get the number of buffers in the pool (0 if not initialized)
+int32_t CfapiBridgeGetTransferBufferCount(void);
 
-// C-side: Wait for Go to fill the shared buffer (called from callback thread)
-// Returns 0 on success, negative on error/timeout
-int32_t CfapiBridgeWaitForData(uint32_t timeoutMs);
+// Acquire a pool buffer, waiting up to timeoutMs (0 = try only)
+// Returns the buffer, or NULL if none became free or the pool is not initialized
+uint8_t* CfapiBridgeAcquireTransferBuffer(uint32_t timeoutMs);
 
-// Go-side: Get the current pending request
-// Returns pointer to shared request, or NULL if no request pending
-CfapiBridgeSharedFetchRequest* CfapiBridgeGetPendingRequest(void);
-
-// Go-side: Signal that data is ready
-void CfapiBridgeSignalDataReady(void);
+// Return a buffer obtained from CfapiBridgeAcquireTransferBuffer
+void CfapiBridgeReleaseTransferBuffer(uint8_t* buffer);
 
 // Result codes
 typedef enum {
@@ -100,14 +140,25 @@ int32_t CfapiBridgeInit(void);
 // Cleanup the bridge (call at shutdown)
 void CfapiBridgeCleanup(void);
 
+// Connection flags for CfapiBridgeConnect
+typedef enum {
+    CFAPI_BRIDGE_CONNECT_DEFAULT = 0,
+    // Register FETCH_PLACEHOLDERS and queue it for Go, which answers with
+    // CfapiBridgeTransferPlaceholders (sync roots with the PARTIAL population
+    // policy). Without it the namespace must be fully created by the provider.
+    CFAPI_BRIDGE_CONNECT_PARTIAL_POPULATION = 0x1,
+} CfapiBridgeConnectFlags;
+
 // Connect to a sync root with C callbacks
 // syncRootPath: path to the sync root (wide string)
 // callbackContext: opaque pointer passed back in requests
+// flags: CfapiBridgeConnectFlags
 // connectionKey: output - connection key for later operations
 // Returns CFAPI_BRIDGE_OK on success
 int32_t CfapiBridgeConnect(
     const wchar_t* syncRootPath,
     void* callbackContext,
+    int32_t flags,
     int64_t* connectionKey
 );
 
@@ -116,15 +167,60 @@ int32_t CfapiBridgeConnect(
 // Returns CFAPI_BRIDGE_OK on success
 int32_t CfapiBridgeDisconnect(int64_t connectionKey);
 
-// Wait for a request to be available
+// Wait for a request to be available on a connection's queue
+// connectionKey: the connection key from CfapiBridgeConnect
 // timeoutMs: timeout in milliseconds (0 = no wait, INFINITE = forever)
+// Each successful wait reserves one request for a following CfapiBridgePollRequest,
+// so several consumers can wait on the same connection.
 // Returns CFAPI_BRIDGE_OK if a request is available, CFAPI_BRIDGE_ERROR_TIMEOUT otherwise
-int32_t CfapiBridgeWaitForRequest(uint32_t timeoutMs);
+int32_t CfapiBridgeWaitForRequest(int64_t connectionKey, uint32_t timeoutMs);
+
+// Wake reasons returned by CfapiBridgeWaitForWork (positive, unlike error codes)
+typedef enum {
+    CFAPI_BRIDGE_WAKE_STOP = 1,     // CfapiBridgeSignalStop was called
+    CFAPI_BRIDGE_WAKE_REQUEST = 3,  // A request was reserved for CfapiBridgePollRequest
+    CFAPI_BRIDGE_WAKE_CANCEL = 4,   // A cancellation was reserved for CfapiBridgePollCancel (CfapiBridgeWaitForCancel)
+} CfapiBridgeWakeReason;
+
+// Block until there is work for a connection's worker: a stop signal or a
+// queued request, whichever comes first (checked in that priority order).
+// Cancellations are served by
+// CfapiBridgeWaitForCancel instead, so busy workers cannot hold them up.
+// connectionKey: the connection key from CfapiBridgeConnect
+// timeoutMs: timeout in milliseconds (INFINITE = forever)
+// Returns a CfapiBridgeWakeReason, CFAPI_BRIDGE_ERROR_TIMEOUT, or an error code
+int32_t CfapiBridgeWaitForWork(int64_t connectionKey, uint32_t timeoutMs);
+
+// Wake every worker blocked in CfapiBridgeWaitForWork or CfapiBridgeWaitForCancel on this connection.
+// The stop event stays signaled until CfapiBridgeResetStop.
+// Returns CFAPI_BRIDGE_OK on success
+int32_t CfapiBridgeSignalStop(int64_t connectionKey);
+
+// Re-arm the stop event before starting workers again
+// Returns CFAPI_BRIDGE_OK on success
+int32_t CfapiBridgeResetStop(int64_t connectionKey);
 
-// Poll for a request (non-blocking)
+// Poll for a request on a connection's queue (non-blocking)
+// connectionKey: the connection key from CfapiBridgeConnect
 // request: output - the request data
+// pathBuffer: output - receives the request's paths (see CfapiBridgeRequest)
+// pathBufferChars: size of pathBuffer, at least CFAPI_BRIDGE_REQUEST_PATH_CHARS
 // Returns CFAPI_BRIDGE_OK if a request was retrieved, CFAPI_BRIDGE_ERROR_QUEUE_EMPTY if none
-int32_t CfapiBridgePollRequest(CfapiBridgeRequest* request);
+int32_t CfapiBridgePollRequest(int64_t connectionKey, CfapiBridgeRequest* request,
+                               wchar_t* pathBuffer, int32_t pathBufferChars);
+
+// Block until a stop signal or a cancellation on the connection's
+// cancellation lane, for the thread dedicated to cancellations.
+// connectionKey: the connection key from CfapiBridgeConnect
+// timeoutMs: timeout in milliseconds (INFINITE = forever)
+// Returns CFAPI_BRIDGE_WAKE_STOP, CFAPI_BRIDGE_WAKE_CANCEL, CFAPI_BRIDGE_ERROR_TIMEOUT, or an error code
+int32_t CfapiBridgeWaitForCancel(int64_t connectionKey, uint32_t timeoutMs);
+
+// Take a cancellation reserved by CFAPI_BRIDGE_WAKE_CANCEL (non-blocking)
+// connectionKey: the connection key from CfapiBridgeConnect
+// cancel: output - transfer key and range of the cancelled FETCH_DATA
+// Returns CFAPI_BRIDGE_OK if a cancellation was retrieved, CFAPI_BRIDGE_ERROR_QUEUE_EMPTY if none
+int32_t CfapiBridgePollCancel(int64_t connectionKey, CfapiBridgeCancel* cancel);
 
 // Transfer data flags
 #define CF_OPERATION_TRANSFER_DATA_FLAG_MARK_IN_SYNC 0x00000001
@@ -148,6 +244,33 @@ int32_t CfapiBridgeTransferData(
     int32_t flags
 );
 
+// One buffer of a batched transfer
+typedef struct {
+    const void* buffer;
+    int64_t length;
+} CfapiBridgeTransferSegment;
+
+// Transfer several buffers covering contiguous file ranges in one call
+// segments: buffers in file order, the first one at offset
+// segmentCount: number of segments
+// flags: applied to the last CfExecute only (e.g. MARK_IN_SYNC on the final batch)
+// progressTotal/progressCompleted: reported after the transfer; progressCompleted < 0 skips it
+// Each run of buffers adjacent in memory is sent with one CfExecute, without
+// copying; runs shorter than CFAPI_BRIDGE_MAX_BATCH_STAGING are copied
+// together so small reads share a CfExecute.
+// Returns CFAPI_BRIDGE_OK on success
+int32_t CfapiBridgeTransferBatch(
+    int64_t connectionKey,
+    int64_t transferKey,
+    int64_t requestKey,
+    const CfapiBridgeTransferSegment* segments,
+    int32_t segmentCount,
+    int64_t offset,
+    int32_t flags,
+    int64_t progressTotal,
+    int64_t progressCompleted
+);
+
 // Complete a hydration request successfully
 // connectionKey: the connection key
 // transferKey: the transfer key from the request
@@ -189,9 +312,146 @@ int32_t CfapiBridgeReportProgress(
 // Returns 1 if initialized, 0 otherwise
 int32_t CfapiBridgeIsInitialized(void);
 
-// Get the number of pending requests in the queue
+// Get the number of pending requests across all connection queues
 int32_t CfapiBridgeGetQueueCount(void);
 
+// Get the number of pending requests in one connection's queue
+int32_t CfapiBridgeGetConnectionQueueCount(int64_t connectionKey);
+
+// Indexes of per-callback-type drop counters
+typedef enum {
+    CFAPI_BRIDGE_DROP_FETCH_DATA = 0,
+    CFAPI_BRIDGE_DROP_CANCEL_FETCH_DATA = 1,
+    CFAPI_BRIDGE_DROP_NOTIFY_DELETE = 2,
+    CFAPI_BRIDGE_DROP_NOTIFY_RENAME = 3,
+    CFAPI_BRIDGE_DROP_TYPE_COUNT = 4,
+} CfapiBridgeDropType;
+
+// Queue depth and backpressure statistics for one connection
+typedef struct {
+    int32_t queued;                 // Requests waiting to be consumed
+    int32_t capacity;               // Currently allocated slots (ring + overflow chunks)
+    int32_t limit;                  // Maximum capacity the queue may grow to
+    int32_t highWater;              // Deepest the queue has been
+    int64_t producerWaits;          // Enqueues that had to wait for room
+    int64_t droppedFetchData;       // FETCH_DATA failed back to Windows (queue full)
+    int64_t droppedCancelFetch;     // CANCEL_FETCH_DATA lost (queue full)
+    int64_t droppedNotifyDelete;    // NOTIFY_DELETE lost (queue full)
+    int64_t droppedNotifyRename;    // NOTIFY_RENAME lost (queue full)
+} CfapiBridgeQueueStats;
+
+// Get queue statistics for one connection (successor of CfapiBridgeGetQueueCount)
+// Returns CFAPI_BRIDGE_OK on success, CFAPI_BRIDGE_ERROR_INVALID_PARAM for an unknown connection
+int32_t CfapiBridgeGetQueueStats(int64_t connectionKey, CfapiBridgeQueueStats* stats);
+
+// Hydration hot-path stages timed by the bridge (CfapiBridgeStats.stages)
+typedef enum {
+    CFAPI_BRIDGE_STAGE_CALLBACK_ENQUEUE = 0, // Callback entry until the request is queued
+    CFAPI_BRIDGE_STAGE_QUEUE_WAIT = 1,       // Queued until polled by a worker
+    CFAPI_BRIDGE_STAGE_DISPATCH = 2,         // Polled until the Go handler starts (recorded by Go)
+    CFAPI_BRIDGE_STAGE_FIRST_BYTE = 3,       // Remote open until its first byte (recorded by Go)
+    CFAPI_BRIDGE_STAGE_CFEXECUTE = 4,        // One CfExecute(TRANSFER_DATA) call
+    CFAPI_BRIDGE_STAGE_HYDRATION = 5,        // Whole Go FETCH_DATA handler (recorded by Go)
+    CFAPI_BRIDGE_STAGE_COUNT = 6,
+} CfapiBridgeStage;
+
+// Log2 latency histogram buckets: bucket 0 counts durations under 1 us,
+// bucket i durations in [2^(i-1), 2^i) us, the last bucket everything longer
+#define CFAPI_BRIDGE_HISTOGRAM_BUCKETS 32
+
+typedef struct {
+    int64_t count;
+    int64_t sumMicros;
+    int64_t maxMicros;
+    int64_t buckets[CFAPI_BRIDGE_HISTOGRAM_BUCKETS];
+} CfapiBridgeHistogram;
+
+// Process-wide hot-path statistics. Callback counters are indexed like the
+// drop counters (CfapiBridgeDropType).
+typedef struct {
+    CfapiBridgeHistogram stages[CFAPI_BRIDGE_STAGE_COUNT];
+    int64_t callbacks[CFAPI_BRIDGE_DROP_TYPE_COUNT];    // Callbacks received
+    int64_t transferredBytes;                           // Bytes handed to Windows by TRANSFER_DATA
+} CfapiBridgeStats;
+
+// Copy a snapshot of the statistics (lock-free, counters may be mid-update)
+// Returns CFAPI_BRIDGE_OK, CFAPI_BRIDGE_ERROR_INVALID_PARAM if stats is NULL
+int32_t CfapiBridgeGetStats(CfapiBridgeStats* stats);
+
+// Record a duration measured outside the bridge (Go-side stages)
+void CfapiBridgeRecordStage(int32_t stage, int64_t micros);
+
+// Zero all statistics
+void CfapiBridgeResetStats(void);
+
+// Log levels of the text trace. Text logging to stderr is only compiled into
+// debug builds (CFAPI_BRIDGE_DEBUG, Go build tag cfapi_debug); release builds
+// keep the binary trace ring below.
+typedef enum {
+    CFAPI_BRIDGE_LOG_OFF = 0,
+    CFAPI_BRIDGE_LOG_ERROR = 1,
+    CFAPI_BRIDGE_LOG_WARN = 2,
+    CFAPI_BRIDGE_LOG_INFO = 3,
+    CFAPI_BRIDGE_LOG_DEBUG = 4,
+} CfapiBridgeLogLevel;
+
+// Set the text log level (no effect in release builds)
+void CfapiBridgeSetLogLevel(int32_t level);
+
+// Returns 1 if text logging is compiled in (debug build), 0 otherwise
+int32_t CfapiBridgeHasDebugLog(void);
+
+// Field trace: a fixed-size ring of binary events recorded in every build.
+// Recording is a few stores and one interlocked increment, no formatting.
+// Must be a power of two.
+#define CFAPI_BRIDGE_TRACE_SIZE 1024
+
+typedef enum {
+    CFAPI_BRIDGE_TRACE_CALLBACK = 1,        // Callback received (arg1 = offset, arg2 = length for FETCH_DATA)
+    CFAPI_BRIDGE_TRACE_ENQUEUE_FAILED = 2,  // Request dropped (result = bridge error)
+    CFAPI_BRIDGE_TRACE_DEQUEUE = 3,         // Request polled by a worker
+    CFAPI_BRIDGE_TRACE_CANCEL = 4,          // Cancellation posted on the lane (result = bridge error)
+    CFAPI_BRIDGE_TRACE_TRANSFER = 5,        // CfExecute(TRANSFER_DATA) (arg1 = offset, arg2 = length, result = HRESULT)
+    CFAPI_BRIDGE_TRACE_COMPLETE = 6,        // CfExecute(ACK_DATA) (result = HRESULT)
+    CFAPI_BRIDGE_TRACE_ERROR = 7,           // Transfer failed (arg1 = reported HRESULT, result = CfExecute HRESULT)
+    CFAPI_BRIDGE_TRACE_CONNECT = 8,         // Sync root connected (result = HRESULT)
+    CFAPI_BRIDGE_TRACE_DISCONNECT = 9,      // Sync root disconnected (result = HRESULT)
+    CFAPI_BRIDGE_TRACE_PLACEHOLDERS = 10,   // CfExecute(TRANSFER_PLACEHOLDERS) (arg1 = count, arg2 = total, result = HRESULT)
+} CfapiBridgeTraceEventType;
+
+typedef struct {
+    int64_t micros;                         // Microseconds since CfapiBridgeInit
+    int64_t connectionKey;
+    int64_t transferKey;
+    int64_t arg1;
+    int64_t arg2;
+    int32_t event;                          // CfapiBridgeTraceEventType
+    int32_t callbackType;                   // CfapiBridgeCallbackType, -1 = none
+    int32_t result;
+    uint32_t threadId;
+} CfapiBridgeTraceEvent;
+
+// Enable or disable the trace ring (enabled by default)
+void CfapiBridgeSetTraceEnabled(int32_t enabled);
+
+// Copy up to maxEvents of the most recent trace events, oldest first.
+// Events being overwritten while copying are skipped.
+// Returns the number of events copied
+int32_t CfapiBridgeReadTrace(CfapiBridgeTraceEvent* events, int32_t maxEvents);
+
+// Set queue growth limits (process-wide)
+// maxRequests: total requests per connection (0 = default, clamped to
+//              [CFAPI_BRIDGE_MAX_QUEUE_SIZE, CFAPI_BRIDGE_MAX_QUEUE_LIMIT]); applies to
+//              connections made afterwards
+// producerWaitMs: how long a callback thread waits for room before dropping
+//                 (0 = never wait, negative = default); applies immediately
+// Returns CFAPI_BRIDGE_OK
+int32_t CfapiBridgeSetQueueLimits(int32_t maxRequests, int32_t producerWaitMs);
+
+// Get the total number of producer retries on the lock-free request queues
+// (a compare-exchange lost to another filter thread). Grows with contention.
+int64_t CfapiBridgeGetQueueProducerRetries(void);
+
 // Acknowledge FETCH_PLACEHOLDERS callback (tell Windows we're done populating)
 // connectionKey: the connection key
 // transferKey: the transfer key from the callback
@@ -201,6 +461,34 @@ int32_t CfapiBridgeAckFetchPlaceholders(
     int64_t transferKey
 );
 
+// Transfer flags for CfapiBridgeTransferPlaceholders (CF_OPERATION_TRANSFER_PLACEHOLDERS_FLAGS)
+#define CF_OPERATION_TRANSFER_PLACEHOLDERS_FLAG_DISABLE_ON_DEMAND_POPULATION 0x00000001
+#define CF_OPERATION_TRANSFER_PLACEHOLDERS_FLAG_STOP_ON_ERROR 0x00000002
+
+// Answer a FETCH_PLACEHOLDERS request with one batch of directory entries.
+// A directory may be answered with several batches: each carries the total
+// count of the listing, Windows completes the enumeration once it has been
+// sent. An empty batch with a failure status fails the enumeration.
+// connectionKey, transferKey, requestKey: from the request
+// placeholders: CF_PLACEHOLDER_CREATE_INFO array (names relative to the directory), may be NULL if count is 0
+// count: entries in this batch
+// totalCount: entries in the whole listing
+// flags: CF_OPERATION_TRANSFER_PLACEHOLDERS_FLAG_*
+// completionStatus: S_OK, or the HRESULT that failed the listing
+// entriesProcessed: output (optional) - entries Windows processed
+// Returns CFAPI_BRIDGE_OK on success
+int32_t CfapiBridgeTransferPlaceholders(
+    int64_t connectionKey,
+    int64_t transferKey,
+    int64_t requestKey,
+    void* placeholders,
+    int32_t count,
+    int64_t totalCount,
+    int32_t flags,
+    int32_t completionStatus,
+    int32_t* entriesProcessed
+);
+
 // Signal that a FETCH_DATA transfer is complete
 // This must be called after all data has been transferred to unblock the callback
 // completionEvent: the event handle from CfapiBridgeRequest
@@ -0,0 +1,11 @@
+//go:build windows && cfapi_debug
+// +build windows,cfapi_debug
+
+package cloudfiles
+
+// Debug builds (go build -tags cfapi_debug) compile the bridge text log in:
+// leveled stderr logging and callback dumps, see SetBridgeLogLevel. Release
+// builds compile it out and keep only the binary trace ring.
+
+// #cgo CFLAGS: -DCFAPI_BRIDGE_DEBUG
+import "C"
@@ -11,6 +11,7 @@ package cloudfiles
 import "C"
 import (
 	"fmt"
+	"runtime"
 	"unsafe"
 
 	"golang.org/x/sys/windows"
@@ -129,6 +130,55 @@ func TransferData(connectionKey CF_CONNECTION_KEY, transferKey CF_TRANSFER_KEY,
 	return nil
 }
 
+// TransferDataBatch transfers buffers covering contiguous file ranges,
+// starting at offset, in a single bridge call. Buffers adjacent in memory are
+// sent with one CfExecute, without copying; short ones are copied together
+// by the bridge. isLastBatch marks the file in-sync after the final buffer.
+// When progressCompleted >= 0, progress is reported in the same call.
+func TransferDataBatch(connectionKey CF_CONNECTION_KEY, transferKey CF_TRANSFER_KEY, requestKey int64, buffers [][]byte, offset int64, isLastBatch bool, progressTotal, progressCompleted int64) error {
+	segments := make([]C.CfapiBridgeTransferSegment, 0, len(buffers))
+
+	// The segment array holds pointers to the buffers, which may be Go memory
+	var pinner runtime.Pinner
+	defer pinner.Unpin()
+	for _, buf := range buffers {
+		if len(buf) == 0 {
+			continue
+		}
+		pinner.Pin(&buf[0])
+		segments = append(segments, C.CfapiBridgeTransferSegment{
+			buffer: unsafe.Pointer(&buf[0]),
+			length: C.int64_t(len(buf)),
+		})
+	}
+	if len(segments) == 0 {
+		return nil
+	}
+
+	flags := int32(0)
+	if isLastBatch {
+		flags = CF_OPERATION_TRANSFER_DATA_FLAG_MARK_IN_SYNC
+	}
+
+	result := C.CfapiBridgeTransferBatch(
+		C.int64_t(connectionKey),
+		C.int64_t(transferKey),
+		C.int64_t(requestKey),
+		&segments[0],
+		C.int32_t(len(segments)),
+		C.int64_t(offset),
+		C.int32_t(flags),
+		C.int64_t(progressTotal),
+		C.int64_t(progressCompleted),
+	)
+
+	if result != C.CFAPI_BRIDGE_OK {
+		return fmt.Errorf("CfExecute(TRANSFER_DATA) failed: error %d", result)
+	}
+
+	return nil
+}
+
 // CF_OPERATION_ACK_DATA_PARAMS for ACK_DATA operation.
 // IMPORTANT: Field alignment must match Windows x64 ABI.
 type CF_OPERATION_ACK_DATA_PARAMS struct {
@@ -164,6 +214,48 @@ func AckData(connectionKey CF_CONNECTION_KEY, transferKey CF_TRANSFER_KEY, compl
 	return Execute(opInfo, opParams)
 }
 
+// TransferPlaceholders answers a FETCH_PLACEHOLDERS callback with one batch
+// of directory entries. total is the size of the whole listing; Windows
+// completes the enumeration once that many entries were transferred. An
+// empty batch with a failure status fails the enumeration.
+// Returns the number of entries Windows processed.
+func TransferPlaceholders(connectionKey CF_CONNECTION_KEY, transferKey CF_TRANSFER_KEY, requestKey int64, placeholders []CF_PLACEHOLDER_CREATE_INFO, total int64, flags uint32, completionStatus int32) (int, error) {
+	// The entries point to names and identities in Go memory
+	var pinner runtime.Pinner
+	defer pinner.Unpin()
+	var array unsafe.Pointer
+	for i := range placeholders {
+		if placeholders[i].RelativeFileName != nil {
+			pinner.Pin(placeholders[i].RelativeFileName)
+		}
+		if placeholders[i].FileIdentity != nil {
+			pinner.Pin(placeholders[i].FileIdentity)
+		}
+	}
+	if len(placeholders) > 0 {
+		array = unsafe.Pointer(&placeholders[0])
+	}
+
+	var processed C.int32_t
+	result := C.CfapiBridgeTransferPlaceholders(
+		C.int64_t(connectionKey),
+		C.int64_t(transferKey),
+		C.int64_t(requestKey),
+		array,
+		C.int32_t(len(placeholders)),
+		C.int64_t(total),
+		C.int32_t(flags),
+		C.int32_t(completionStatus),
+		&processed,
+	)
+
+	if result != C.CFAPI_BRIDGE_OK {
+		return int(processed), fmt.Errorf("CfExecute(TRANSFER_PLACEHOLDERS) failed: error %d (processed %d/%d)", result, processed, len(placeholders))
+	}
+
+	return int(processed), nil
+}
+
 // ReportProviderProgress reports progress during hydration.
 // This makes the progress visible in Windows Explorer's progress indicator.
 func ReportProviderProgress(connectionKey CF_CONNECTION_KEY, transferKey CF_TRANSFER_KEY, total, completed int64) error {
@@ -226,7 +318,7 @@ func OpenFileWithOplock(filePath string, flags CF_OPEN_FILE_FLAGS) (windows.Hand
 	)
 
 	if hr != S_OK {
-		return 0, fmt.Errorf("CfOpenFileWithOplock failed: HRESULT 0x%08X (%s)", hr, decodeHRESULT(uint32(hr)))
+		return 0, fmt.Errorf("CfOpenFileWithOplock failed: %w", NewHRESULTError(hr, decodeHRESULT(uint32(hr))))
 	}
 
 	return handle, nil
@@ -342,7 +434,7 @@ func UpdatePlaceholder(fileHandle windows.Handle, flags CF_UPDATE_FLAGS) error {
 	)
 
 	if hr != S_OK {
-		return fmt.Errorf("CfUpdatePlaceholder failed: HRESULT 0x%08X (%s)", hr, decodeHRESULT(uint32(hr)))
+		return fmt.Errorf("CfUpdatePlaceholder failed: %w", NewHRESULTError(hr, decodeHRESULT(uint32(hr))))
 	}
 
 	return nil
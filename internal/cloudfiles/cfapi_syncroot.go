@@ -44,6 +44,12 @@ func decodeHRESULT(hr uint32) string {
 	switch hr {
 	case 0x80070005:
 		return "ERROR_ACCESS_DENIED"
+	case 0x80070020:
+		return "ERROR_SHARING_VIOLATION"
+	case 0x8007012C:
+		return "ERROR_OPLOCK_NOT_GRANTED"
+	case 0x8007017C:
+		return "ERROR_CLOUD_FILE_IN_USE"
 	case 0x800700B7:
 		return "ERROR_ALREADY_EXISTS"
 	case 0x8007018A:
@@ -22,12 +22,17 @@ type DehydrationManager struct {
 	policy      DehydrationPolicy
 	logger      *zap.Logger
 
+	// Hydrated files kept up to date between scans while running
+	index *hydrationIndex
+
 	// Statistics
 	stats DehydrationStats
 
 	// Control
-	running bool
-	cancel  context.CancelFunc
+	running    bool
+	cancel     context.CancelFunc
+	passMu     sync.Mutex         // Serializes dehydration passes
+	passCancel context.CancelFunc // Cancels the pass in progress
 }
 
 // DehydrationPolicy defines when files should be dehydrated.
@@ -53,6 +58,15 @@ type DehydrationPolicy struct {
 
 	// ScanInterval is how often to scan for files to dehydrate.
 	ScanInterval time.Duration
+
+	// Workers is the number of files dehydrated concurrently.
+	// Set to 0 for DefaultDehydrationWorkers.
+	Workers int
+
+	// MaxFilesPerSecond caps how many dehydrations start per second, so a
+	// large pass does not starve foreground I/O on the volume.
+	// Set to 0 for unlimited.
+	MaxFilesPerSecond int
 }
 
 // DefaultDehydrationPolicy returns a reasonable default policy.
@@ -64,6 +78,8 @@ func DefaultDehydrationPolicy() DehydrationPolicy {
 		ExcludePatterns:     []string{},
 		MaxFilesToDehydrate: 100,
 		ScanInterval:        time.Hour,
+		Workers:             DefaultDehydrationWorkers,
+		MaxFilesPerSecond:   50,
 	}
 }
 
@@ -74,6 +90,12 @@ type DehydrationStats struct {
 	FilesDehydrated   int64
 	BytesFreed        int64
 	Errors            int64
+	FilesSkipped      int64 // Files left hydrated because they were in use
+
+	// Progress of the dehydration pass in progress (or the last one)
+	PassRunning bool
+	PassTotal   int64 // Files to dehydrate in the pass
+	PassDone    int64 // Files processed so far (dehydrated, skipped or failed)
 }
 
 // HydratedFileInfo contains information about a hydrated file.
@@ -95,6 +117,7 @@ func NewDehydrationManager(syncRoot *SyncRootManager, policy DehydrationPolicy,
 		syncRoot: syncRoot,
 		policy:   policy,
 		logger:   logger,
+		index:    newHydrationIndex(),
 	}
 }
 
@@ -132,6 +155,7 @@ func (dm *DehydrationManager) Start(ctx context.Context) error {
 	dm.running = true
 	dm.mu.Unlock()
 
+	go dm.watchLoop(ctx)
 	go dm.scanLoop(ctx)
 
 	dm.logger.Info("dehydration manager started",
@@ -194,8 +218,8 @@ func (dm *DehydrationManager) runScan(ctx context.Context) {
 	policy := dm.policy
 	dm.mu.Unlock()
 
-	// Find hydrated files
-	hydratedFiles, err := dm.ScanHydratedFiles(ctx)
+	// Find hydrated files (only the changes since the last scan once indexed)
+	hydratedFiles, err := dm.hydratedFiles(ctx)
 	if err != nil {
 		dm.logger.Error("failed to scan hydrated files", zap.Error(err))
 		dm.mu.Lock()
@@ -217,38 +241,12 @@ func (dm *DehydrationManager) runScan(ctx context.Context) {
 	)
 
 	// Dehydrate eligible files
-	count := 0
-	for _, file := range eligible {
-		if ctx.Err() != nil {
-			break
-		}
-
-		if policy.MaxFilesToDehydrate > 0 && count >= policy.MaxFilesToDehydrate {
-			break
-		}
-
-		if err := dm.DehydrateFile(ctx, file.Path); err != nil {
-			dm.logger.Warn("failed to dehydrate file",
-				zap.String("path", file.Path),
-				zap.Error(err),
-			)
-			dm.mu.Lock()
-			dm.stats.Errors++
-			dm.mu.Unlock()
-			continue
-		}
-
-		dm.mu.Lock()
-		dm.stats.FilesDehydrated++
-		dm.stats.BytesFreed += file.Size
-		dm.mu.Unlock()
-
-		count++
-	}
+	result := dm.dehydratePass(ctx, eligible, policy.MaxFilesToDehydrate)
 
-	if count > 0 {
+	if result.Dehydrated > 0 {
 		dm.logger.Info("dehydrated files",
-			zap.Int("count", count),
+			zap.Int("count", result.Dehydrated),
+			zap.Int64("bytes_freed", result.BytesFreed),
 		)
 	}
 }
@@ -0,0 +1,175 @@
+//go:build windows
+// +build windows
+
+package cloudfiles
+
+import (
+	"sort"
+	"strings"
+	"sync"
+	"time"
+)
+
+// hydrationIndex keeps the hydrated files of a sync root between dehydration
+// scans, so a scan only re-checks the paths that changed since the previous
+// one instead of walking the whole tree. It is seeded by one full walk and
+// then fed by the directory watcher and the bridge callbacks.
+type hydrationIndex struct {
+	mu       sync.Mutex
+	tracking bool                        // Changes are being collected
+	watch    int                         // Incremented by Track, so a stale Reset is ignored
+	seeded   bool                        // files reflects a full walk plus the changes since
+	files    map[string]HydratedFileInfo // By indexKey of the relative path
+	dirty    map[string]dirtyPath        // Paths to re-check, by indexKey
+}
+
+// dirtyPath is a path to re-check at the next scan.
+type dirtyPath struct {
+	path    string // Relative path from sync root
+	subtree bool   // Walk it if it is a directory (created or moved in)
+}
+
+func newHydrationIndex() *hydrationIndex {
+	return &hydrationIndex{
+		files: make(map[string]HydratedFileInfo),
+		dirty: make(map[string]dirtyPath),
+	}
+}
+
+// Track starts collecting changes and returns the id to pass to Reset. The
+// index must be seeded before use.
+func (x *hydrationIndex) Track() int {
+	x.mu.Lock()
+	defer x.mu.Unlock()
+	x.watch++
+	x.tracking = true
+	return x.watch
+}
+
+// Reset stops collecting changes and drops the index, unless a newer
+// watcher started tracking meanwhile.
+func (x *hydrationIndex) Reset(watch int) {
+	x.mu.Lock()
+	defer x.mu.Unlock()
+	if watch != x.watch {
+		return
+	}
+	x.tracking = false
+	x.seeded = false
+	x.files = make(map[string]HydratedFileInfo)
+	x.dirty = make(map[string]dirtyPath)
+}
+
+// Invalidate forces a full walk at the next scan, e.g. after the watcher
+// lost notifications.
+func (x *hydrationIndex) Invalidate() {
+	x.mu.Lock()
+	defer x.mu.Unlock()
+	x.seeded = false
+}
+
+// Tracking reports whether changes are being collected.
+func (x *hydrationIndex) Tracking() bool {
+	x.mu.Lock()
+	defer x.mu.Unlock()
+	return x.tracking
+}
+
+// Seeded reports whether the index can answer a scan without a full walk.
+func (x *hydrationIndex) Seeded() bool {
+	x.mu.Lock()
+	defer x.mu.Unlock()
+	return x.tracking && x.seeded
+}
+
+// Seed replaces the index with the result of a full walk. Changes marked
+// while the walk ran stay dirty and are re-checked by the next scan.
+func (x *hydrationIndex) Seed(files []HydratedFileInfo) {
+	x.mu.Lock()
+	defer x.mu.Unlock()
+	x.files = make(map[string]HydratedFileInfo, len(files))
+	for _, f := range files {
+		x.files[indexKey(f.Path)] = f
+	}
+	x.seeded = x.tracking
+}
+
+// MarkDirty records a changed path to re-check at the next scan.
+func (x *hydrationIndex) MarkDirty(relativePath string, subtree bool) {
+	x.mu.Lock()
+	defer x.mu.Unlock()
+	if !x.tracking || relativePath == "" {
+		return
+	}
+	key := indexKey(relativePath)
+	if d, ok := x.dirty[key]; ok && d.subtree {
+		subtree = true
+	}
+	x.dirty[key] = dirtyPath{path: relativePath, subtree: subtree}
+}
+
+// TakeDirty returns the paths marked since the previous call, parents first.
+func (x *hydrationIndex) TakeDirty() []dirtyPath {
+	x.mu.Lock()
+	defer x.mu.Unlock()
+	paths := make([]dirtyPath, 0, len(x.dirty))
+	for _, d := range x.dirty {
+		paths = append(paths, d)
+	}
+	x.dirty = make(map[string]dirtyPath)
+
+	sort.Slice(paths, func(i, j int) bool { return paths[i].path < paths[j].path })
+	return paths
+}
+
+// Put records a hydrated file.
+func (x *hydrationIndex) Put(file HydratedFileInfo) {
+	x.mu.Lock()
+	defer x.mu.Unlock()
+	x.files[indexKey(file.Path)] = file
+}
+
+// Remove drops a file that is no longer hydrated.
+func (x *hydrationIndex) Remove(relativePath string) {
+	x.mu.Lock()
+	defer x.mu.Unlock()
+	delete(x.files, indexKey(relativePath))
+}
+
+// RemoveTree drops a path and everything below it (deleted or moved away).
+func (x *hydrationIndex) RemoveTree(relativePath string) {
+	x.mu.Lock()
+	defer x.mu.Unlock()
+	key := indexKey(relativePath)
+	delete(x.files, key)
+	prefix := key + "/"
+	for k := range x.files {
+		if strings.HasPrefix(k, prefix) {
+			delete(x.files, k)
+		}
+	}
+}
+
+// Snapshot returns the indexed files with their age computed at now.
+func (x *hydrationIndex) Snapshot(now time.Time) []HydratedFileInfo {
+	x.mu.Lock()
+	defer x.mu.Unlock()
+	files := make([]HydratedFileInfo, 0, len(x.files))
+	for _, f := range x.files {
+		f.DaysSinceAccess = int(now.Sub(f.LastAccessTime).Hours() / 24)
+		files = append(files, f)
+	}
+	return files
+}
+
+// Len returns the number of indexed files.
+func (x *hydrationIndex) Len() int {
+	x.mu.Lock()
+	defer x.mu.Unlock()
+	return len(x.files)
+}
+
+// indexKey normalizes a relative path for the index (NTFS is case-insensitive).
+func indexKey(relativePath string) string {
+	return strings.ToLower(strings.Trim(normalizePath(relativePath), "/"))
+}
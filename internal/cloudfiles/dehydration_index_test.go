@@ -0,0 +1,90 @@
+//go:build windows
+// +build windows
+
+package cloudfiles
+
+import (
+	"testing"
+	"time"
+)
+
+func TestHydrationIndexIgnoresChangesUntilTracked(t *testing.T) {
+	x := newHydrationIndex()
+	x.MarkDirty(`docs\a.txt`, false)
+	if len(x.TakeDirty()) != 0 {
+		t.Error("Expected changes to be ignored while not tracking")
+	}
+
+	watch := x.Track()
+	if x.Seeded() {
+		t.Error("Expected a new index to need a full walk")
+	}
+	x.MarkDirty(`docs\a.txt`, false)
+	x.Seed(nil)
+	if !x.Seeded() {
+		t.Error("Expected the index to be seeded")
+	}
+	if len(x.TakeDirty()) != 1 {
+		t.Error("Expected changes marked during the walk to stay dirty")
+	}
+
+	x.Reset(watch)
+	if x.Tracking() || x.Seeded() {
+		t.Error("Expected Reset to stop tracking")
+	}
+}
+
+func TestHydrationIndexStaleResetIsIgnored(t *testing.T) {
+	x := newHydrationIndex()
+	old := x.Track()
+	x.Track() // Restarted before the previous watcher exited
+	x.Reset(old)
+	if !x.Tracking() {
+		t.Error("Expected the newer watcher to keep tracking")
+	}
+}
+
+func TestHydrationIndexMergesDirtyPaths(t *testing.T) {
+	x := newHydrationIndex()
+	x.Track()
+	x.MarkDirty(`Photos`, true)
+	x.MarkDirty(`photos`, false) // Same directory, modified afterwards
+	x.MarkDirty(`photos\a.jpg`, false)
+
+	dirty := x.TakeDirty()
+	if len(dirty) != 2 {
+		t.Fatalf("Expected 2 dirty paths, got %+v", dirty)
+	}
+	if !dirty[0].subtree {
+		t.Errorf("Expected the created directory to still be walked, got %+v", dirty[0])
+	}
+	if len(x.TakeDirty()) != 0 {
+		t.Error("Expected TakeDirty to clear the dirty paths")
+	}
+}
+
+func TestHydrationIndexRemoveTree(t *testing.T) {
+	x := newHydrationIndex()
+	x.Track()
+	x.Seed([]HydratedFileInfo{
+		{Path: `a\1.txt`},
+		{Path: `a\b\2.txt`},
+		{Path: `ab\3.txt`},
+	})
+
+	x.RemoveTree(`A`)
+	if x.Len() != 1 {
+		t.Errorf("Expected only ab\\3.txt to remain, got %d files", x.Len())
+	}
+}
+
+func TestHydrationIndexSnapshotAges(t *testing.T) {
+	x := newHydrationIndex()
+	now := time.Now()
+	x.Put(HydratedFileInfo{Path: "old.bin", LastAccessTime: now.Add(-72 * time.Hour)})
+
+	files := x.Snapshot(now)
+	if len(files) != 1 || files[0].DaysSinceAccess != 3 {
+		t.Errorf("Expected an age of 3 days, got %+v", files)
+	}
+}
@@ -0,0 +1,222 @@
+//go:build windows
+// +build windows
+
+package cloudfiles
+
+import (
+	"context"
+	"errors"
+	"sync"
+	"sync/atomic"
+	"time"
+
+	"go.uber.org/zap"
+)
+
+// DefaultDehydrationWorkers is the number of files dehydrated concurrently.
+const DefaultDehydrationWorkers = 4
+
+// ErrFileInUse is returned by DehydrateFile when another process has the
+// file open. Such files are skipped rather than counted as errors.
+var ErrFileInUse = errors.New("file in use")
+
+// HRESULTs of a file another process has open.
+const (
+	hrSharingViolation = 0x80070020 // HRESULT_FROM_WIN32(ERROR_SHARING_VIOLATION)
+	hrOplockNotGranted = 0x8007012C // HRESULT_FROM_WIN32(ERROR_OPLOCK_NOT_GRANTED)
+	hrCloudFileInUse   = 0x8007017C // HRESULT_FROM_WIN32(ERROR_CLOUD_FILE_IN_USE)
+)
+
+// isFileInUseError checks if the error indicates the file is open elsewhere.
+func isFileInUseError(err error) bool {
+	var hErr *HRESULTError
+	if !errors.As(err, &hErr) {
+		return false
+	}
+	switch hErr.Code {
+	case hrSharingViolation, hrOplockNotGranted, hrCloudFileInUse:
+		return true
+	}
+	return false
+}
+
+// DehydrationResult summarizes one dehydration pass.
+type DehydrationResult struct {
+	Dehydrated int   // Files converted back to placeholders
+	Skipped    int   // Files in use, left hydrated
+	Failed     int   // Files that could not be dehydrated
+	BytesFreed int64 // Size of the dehydrated files
+	LastError  error // Last failure, if any
+}
+
+// passConfig bounds a dehydration pass.
+type passConfig struct {
+	workers      int // Concurrent dehydrations (0 = DefaultDehydrationWorkers)
+	filesPerSec  int // Dehydrations started per second (0 = unlimited)
+	maxDehydrate int // Stop after this many successes (0 = unlimited)
+}
+
+// runDehydrationPass dehydrates files with a bounded number of workers,
+// starting at most filesPerSec dehydrations per second so foreground I/O on
+// the volume keeps its share. Each result is reported to done as it
+// completes. Cancelling ctx stops the pass after the files in progress.
+func runDehydrationPass(ctx context.Context, files []HydratedFileInfo, config passConfig,
+	dehydrate func(ctx context.Context, file HydratedFileInfo) error,
+	done func(file HydratedFileInfo, err error)) DehydrationResult {
+	workers := config.workers
+	if workers <= 0 {
+		workers = DefaultDehydrationWorkers
+	}
+
+	var tick <-chan time.Time
+	if config.filesPerSec > 0 {
+		ticker := time.NewTicker(time.Second / time.Duration(config.filesPerSec))
+		defer ticker.Stop()
+		tick = ticker.C
+	}
+
+	var (
+		mu       sync.Mutex
+		result   DehydrationResult
+		reserved atomic.Int64 // Successes plus dehydrations in progress
+		wg       sync.WaitGroup
+	)
+	next := make(chan HydratedFileInfo)
+
+	for i := 0; i < workers && i < len(files); i++ {
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			for file := range next {
+				limited := config.maxDehydrate > 0
+				if limited && reserved.Add(1) > int64(config.maxDehydrate) {
+					reserved.Add(-1)
+					continue // Enough files freed, drain
+				}
+
+				err := dehydrate(ctx, file)
+
+				mu.Lock()
+				switch {
+				case err == nil:
+					result.Dehydrated++
+					result.BytesFreed += file.Size
+				case errors.Is(err, ErrFileInUse):
+					result.Skipped++
+				default:
+					result.Failed++
+					result.LastError = err
+				}
+				mu.Unlock()
+				if err != nil && limited {
+					reserved.Add(-1)
+				}
+
+				if done != nil {
+					done(file, err)
+				}
+			}
+		}()
+	}
+
+feed:
+	for _, file := range files {
+		if config.maxDehydrate > 0 && reserved.Load() >= int64(config.maxDehydrate) {
+			break
+		}
+		if tick != nil {
+			select {
+			case <-tick:
+			case <-ctx.Done():
+				break feed
+			}
+		}
+		select {
+		case next <- file:
+		case <-ctx.Done():
+			break feed
+		}
+	}
+	close(next)
+	wg.Wait()
+
+	return result
+}
+
+// DehydrateFiles dehydrates files in parallel within the policy's worker
+// and rate limits, skipping files in use. Progress is published in the
+// statistics; CancelDehydration stops the pass.
+func (dm *DehydrationManager) DehydrateFiles(ctx context.Context, files []HydratedFileInfo) DehydrationResult {
+	return dm.dehydratePass(ctx, files, 0)
+}
+
+// CancelDehydration stops the dehydration pass in progress, if any. Files
+// being dehydrated complete; the others are left hydrated.
+func (dm *DehydrationManager) CancelDehydration() {
+	dm.mu.Lock()
+	defer dm.mu.Unlock()
+	if dm.passCancel != nil {
+		dm.passCancel()
+	}
+}
+
+// dehydratePass runs one pass at a time over files, stopping after
+// maxDehydrate successes (0 = all).
+func (dm *DehydrationManager) dehydratePass(ctx context.Context, files []HydratedFileInfo, maxDehydrate int) DehydrationResult {
+	dm.passMu.Lock()
+	defer dm.passMu.Unlock()
+
+	ctx, cancel := context.WithCancel(ctx)
+	defer cancel()
+
+	dm.mu.Lock()
+	policy := dm.policy
+	dm.passCancel = cancel
+	dm.stats.PassRunning = true
+	dm.stats.PassTotal = int64(len(files))
+	dm.stats.PassDone = 0
+	dm.mu.Unlock()
+
+	defer func() {
+		dm.mu.Lock()
+		dm.passCancel = nil
+		dm.stats.PassRunning = false
+		dm.mu.Unlock()
+	}()
+
+	config := passConfig{
+		workers:      policy.Workers,
+		filesPerSec:  policy.MaxFilesPerSecond,
+		maxDehydrate: maxDehydrate,
+	}
+	result := runDehydrationPass(ctx, files, config, func(ctx context.Context, file HydratedFileInfo) error {
+		return dm.DehydrateFile(ctx, file.Path)
+	}, func(file HydratedFileInfo, err error) {
+		dm.mu.Lock()
+		dm.stats.PassDone++
+		switch {
+		case err == nil:
+			dm.stats.FilesDehydrated++
+			dm.stats.BytesFreed += file.Size
+		case errors.Is(err, ErrFileInUse):
+			dm.stats.FilesSkipped++
+		default:
+			dm.stats.Errors++
+		}
+		dm.mu.Unlock()
+
+		if err != nil && !errors.Is(err, ErrFileInUse) {
+			dm.logger.Warn("failed to dehydrate file",
+				zap.String("path", file.Path),
+				zap.Error(err),
+			)
+		}
+	})
+
+	if result.Skipped > 0 {
+		dm.logger.Info("skipped files in use",
+			zap.Int("count", result.Skipped),
+		)
+	}
+	return result
+}
@@ -0,0 +1,111 @@
+//go:build windows
+// +build windows
+
+package cloudfiles
+
+import (
+	"context"
+	"errors"
+	"fmt"
+	"sync/atomic"
+	"testing"
+	"time"
+)
+
+func testHydratedFiles(n int) []HydratedFileInfo {
+	files := make([]HydratedFileInfo, n)
+	for i := range files {
+		files[i] = HydratedFileInfo{Path: fmt.Sprintf("file%d.bin", i), Size: 1000}
+	}
+	return files
+}
+
+func TestDehydrationPassBoundsWorkers(t *testing.T) {
+	var running, peak atomic.Int32
+	dehydrate := func(ctx context.Context, file HydratedFileInfo) error {
+		n := running.Add(1)
+		for {
+			p := peak.Load()
+			if n <= p || peak.CompareAndSwap(p, n) {
+				break
+			}
+		}
+		time.Sleep(time.Millisecond)
+		running.Add(-1)
+		return nil
+	}
+
+	var reported atomic.Int32
+	result := runDehydrationPass(context.Background(), testHydratedFiles(50), passConfig{workers: 3}, dehydrate,
+		func(HydratedFileInfo, error) { reported.Add(1) })
+
+	if result.Dehydrated != 50 || result.BytesFreed != 50000 {
+		t.Errorf("Expected 50 files and 50000 bytes freed, got %+v", result)
+	}
+	if p := peak.Load(); p > 3 {
+		t.Errorf("Expected at most 3 concurrent dehydrations, got %d", p)
+	}
+	if reported.Load() != 50 {
+		t.Errorf("Expected every file to be reported, got %d", reported.Load())
+	}
+}
+
+func TestDehydrationPassSkipsFilesInUse(t *testing.T) {
+	dehydrate := func(ctx context.Context, file HydratedFileInfo) error {
+		switch file.Path {
+		case "file0.bin":
+			return fmt.Errorf("%w: sharing violation", ErrFileInUse)
+		case "file1.bin":
+			return errors.New("access denied")
+		}
+		return nil
+	}
+
+	result := runDehydrationPass(context.Background(), testHydratedFiles(5), passConfig{workers: 2}, dehydrate, nil)
+	if result.Dehydrated != 3 || result.Skipped != 1 || result.Failed != 1 {
+		t.Errorf("Expected 3 dehydrated, 1 skipped, 1 failed, got %+v", result)
+	}
+	if result.LastError == nil {
+		t.Error("Expected the failure to be reported")
+	}
+}
+
+func TestDehydrationPassStopsAtLimit(t *testing.T) {
+	var calls atomic.Int32
+	dehydrate := func(ctx context.Context, file HydratedFileInfo) error {
+		calls.Add(1)
+		if file.Path == "file2.bin" {
+			return errors.New("locked")
+		}
+		return nil
+	}
+
+	result := runDehydrationPass(context.Background(), testHydratedFiles(100),
+		passConfig{workers: 4, maxDehydrate: 10}, dehydrate, nil)
+	if result.Dehydrated != 10 {
+		t.Errorf("Expected exactly 10 files dehydrated, got %+v", result)
+	}
+	if n := calls.Load(); n > 15 {
+		t.Errorf("Expected the pass to stop near the limit, got %d calls", n)
+	}
+}
+
+func TestDehydrationPassRateLimitAndCancel(t *testing.T) {
+	ctx, cancel := context.WithCancel(context.Background())
+	var calls atomic.Int32
+	dehydrate := func(ctx context.Context, file HydratedFileInfo) error {
+		if calls.Add(1) == 3 {
+			cancel()
+		}
+		return nil
+	}
+
+	start := time.Now()
+	result := runDehydrationPass(ctx, testHydratedFiles(100), passConfig{workers: 4, filesPerSec: 100}, dehydrate, nil)
+	if elapsed := time.Since(start); elapsed < 20*time.Millisecond {
+		t.Errorf("Expected dehydrations to be paced, 3 took %v", elapsed)
+	}
+	if result.Dehydrated >= 100 {
+		t.Errorf("Expected cancellation to stop the pass, got %+v", result)
+	}
+}
@@ -17,11 +17,16 @@ import (
 
 // ScanHydratedFiles scans the sync root for hydrated files.
 func (dm *DehydrationManager) ScanHydratedFiles(ctx context.Context) ([]HydratedFileInfo, error) {
+	return dm.scanTree(ctx, dm.syncRoot.Path())
+}
+
+// scanTree walks a directory of the sync root for hydrated files.
+func (dm *DehydrationManager) scanTree(ctx context.Context, dir string) ([]HydratedFileInfo, error) {
 	var files []HydratedFileInfo
 	rootPath := dm.syncRoot.Path()
 	now := time.Now()
 
-	err := filepath.Walk(rootPath, func(path string, info os.FileInfo, err error) error {
+	err := filepath.Walk(dir, func(path string, info os.FileInfo, err error) error {
 		if err != nil {
 			return nil // Skip errors
 		}
@@ -153,6 +158,9 @@ func (dm *DehydrationManager) DehydrateFile(ctx context.Context, relativePath st
 	// Use EXCLUSIVE + WRITE_ACCESS flags for safe dehydration
 	protectedHandle, err := OpenFileWithOplock(fullPath, CF_OPEN_FILE_FLAG_EXCLUSIVE|CF_OPEN_FILE_FLAG_WRITE_ACCESS)
 	if err != nil {
+		if isFileInUseError(err) {
+			return fmt.Errorf("%w: %v", ErrFileInUse, err)
+		}
 		return fmt.Errorf("failed to open file with oplock: %w", err)
 	}
 	defer CloseHandle(protectedHandle)
@@ -188,8 +196,12 @@ func (dm *DehydrationManager) DehydrateFile(ctx context.Context, relativePath st
 	// Use CfUpdatePlaceholder with DEHYDRATE + MARK_IN_SYNC flags
 	// Using the protected handle from CfOpenFileWithOplock (exclusive access required)
 	if err := UpdatePlaceholder(protectedHandle, CF_UPDATE_FLAG_DEHYDRATE|CF_UPDATE_FLAG_MARK_IN_SYNC); err != nil {
+		if isFileInUseError(err) {
+			return fmt.Errorf("%w: %v", ErrFileInUse, err)
+		}
 		return fmt.Errorf("failed to dehydrate via CfUpdatePlaceholder: %w", err)
 	}
+	dm.index.Remove(relativePath)
 
 	dm.logger.Info("file dehydrated",
 		zap.String("path", relativePath),
@@ -206,7 +218,7 @@ func (dm *DehydrationManager) DehydrateAll(ctx context.Context) (int, int64, err
 	policy := dm.GetPolicy()
 
 	// Find hydrated files
-	hydratedFiles, err := dm.ScanHydratedFiles(ctx)
+	hydratedFiles, err := dm.hydratedFiles(ctx)
 	if err != nil {
 		return 0, 0, fmt.Errorf("failed to scan: %w", err)
 	}
@@ -214,37 +226,21 @@ func (dm *DehydrationManager) DehydrateAll(ctx context.Context) (int, int64, err
 	// Filter eligible files (but ignore MaxFilesToDehydrate)
 	eligible := dm.filterEligibleFiles(hydratedFiles, policy)
 
-	count := 0
-	var bytesFreed int64
-
-	for _, file := range eligible {
-		if ctx.Err() != nil {
-			break
-		}
-
-		if err := dm.DehydrateFile(ctx, file.Path); err != nil {
-			dm.logger.Warn("failed to dehydrate file",
-				zap.String("path", file.Path),
-				zap.Error(err),
-			)
-			continue
-		}
-
-		count++
-		bytesFreed += file.Size
-	}
+	result := dm.dehydratePass(ctx, eligible, 0)
 
 	dm.logger.Info("dehydration complete",
-		zap.Int("files", count),
-		zap.Int64("bytes_freed", bytesFreed),
+		zap.Int("files", result.Dehydrated),
+		zap.Int("skipped_in_use", result.Skipped),
+		zap.Int("failed", result.Failed),
+		zap.Int64("bytes_freed", result.BytesFreed),
 	)
 
-	return count, bytesFreed, nil
+	return result.Dehydrated, result.BytesFreed, nil
 }
 
 // GetSpaceUsage returns the current space usage by hydrated files.
 func (dm *DehydrationManager) GetSpaceUsage(ctx context.Context) (SpaceUsage, error) {
-	hydratedFiles, err := dm.ScanHydratedFiles(ctx)
+	hydratedFiles, err := dm.hydratedFiles(ctx)
 	if err != nil {
 		return SpaceUsage{}, err
 	}
@@ -0,0 +1,224 @@
+//go:build windows
+// +build windows
+
+package cloudfiles
+
+import (
+	"context"
+	"errors"
+	"fmt"
+	"os"
+	"path/filepath"
+	"time"
+	"unsafe"
+
+	"go.uber.org/zap"
+	"golang.org/x/sys/windows"
+)
+
+// watchBufferSize is the ReadDirectoryChangesW buffer. When more changes
+// happen between two reads, Windows drops them and the index is rebuilt.
+const watchBufferSize = 64 * 1024
+
+// watchPollMillis is how often the watcher checks whether it must stop.
+const watchPollMillis = 1000
+
+// watchFilter selects the changes that can alter hydration state or age:
+// files appearing or moving, content writes and reads.
+const watchFilter = windows.FILE_NOTIFY_CHANGE_FILE_NAME |
+	windows.FILE_NOTIFY_CHANGE_DIR_NAME |
+	windows.FILE_NOTIFY_CHANGE_SIZE |
+	windows.FILE_NOTIFY_CHANGE_LAST_WRITE |
+	windows.FILE_NOTIFY_CHANGE_LAST_ACCESS
+
+// hydratedFiles returns the hydrated files of the sync root. While the
+// watcher runs, this costs a full walk only the first time (or after lost
+// notifications); afterwards only the paths changed since the previous
+// call are checked.
+func (dm *DehydrationManager) hydratedFiles(ctx context.Context) ([]HydratedFileInfo, error) {
+	if !dm.index.Tracking() {
+		return dm.ScanHydratedFiles(ctx)
+	}
+
+	if !dm.index.Seeded() {
+		files, err := dm.ScanHydratedFiles(ctx)
+		if err != nil {
+			return nil, err
+		}
+		dm.index.Seed(files)
+		dm.logger.Debug("hydration index seeded", zap.Int("files", len(files)))
+	}
+
+	dirty := dm.index.TakeDirty()
+	for i, d := range dirty {
+		if ctx.Err() != nil {
+			// Keep what was not checked for the next scan
+			for _, rest := range dirty[i:] {
+				dm.index.MarkDirty(rest.path, rest.subtree)
+			}
+			return nil, ctx.Err()
+		}
+		dm.refreshPath(ctx, d)
+	}
+	if len(dirty) > 0 {
+		dm.logger.Debug("hydration index updated",
+			zap.Int("changed", len(dirty)),
+			zap.Int("files", dm.index.Len()),
+		)
+	}
+
+	return dm.index.Snapshot(time.Now()), nil
+}
+
+// refreshPath re-checks one changed path against the index.
+func (dm *DehydrationManager) refreshPath(ctx context.Context, d dirtyPath) {
+	rootPath := dm.syncRoot.Path()
+	fullPath := filepath.Join(rootPath, d.path)
+
+	info, err := os.Stat(fullPath)
+	if err != nil {
+		// Deleted or moved away
+		dm.index.RemoveTree(d.path)
+		return
+	}
+
+	if info.IsDir() {
+		// Modified directories only had a child change, which is reported
+		// on its own; created or moved-in ones are walked
+		if d.subtree {
+			files, err := dm.scanTree(ctx, fullPath)
+			if err != nil {
+				dm.index.Invalidate()
+				return
+			}
+			for _, f := range files {
+				dm.index.Put(f)
+			}
+		}
+		return
+	}
+
+	isHydrated, lastAccess, err := dm.getFileHydrationStatus(fullPath)
+	if err != nil || !isHydrated {
+		dm.index.Remove(d.path)
+		return
+	}
+	dm.index.Put(HydratedFileInfo{
+		Path:           d.path,
+		FullPath:       fullPath,
+		Size:           info.Size(),
+		LastAccessTime: lastAccess,
+		ModTime:        info.ModTime(),
+	})
+}
+
+// NoteHydrationChange marks a file whose hydration state changed (reported
+// by the bridge) to be re-checked at the next scan. relativePath uses
+// forward slashes.
+func (dm *DehydrationManager) NoteHydrationChange(relativePath string) {
+	dm.index.MarkDirty(filepath.FromSlash(relativePath), false)
+}
+
+// watchLoop feeds the index from ReadDirectoryChangesW on the sync root
+// until ctx is cancelled.
+func (dm *DehydrationManager) watchLoop(ctx context.Context) {
+	rootPath := dm.syncRoot.Path()
+	handle, err := windows.CreateFile(
+		windows.StringToUTF16Ptr(rootPath),
+		windows.FILE_LIST_DIRECTORY,
+		windows.FILE_SHARE_READ|windows.FILE_SHARE_WRITE|windows.FILE_SHARE_DELETE,
+		nil,
+		windows.OPEN_EXISTING,
+		windows.FILE_FLAG_BACKUP_SEMANTICS|windows.FILE_FLAG_OVERLAPPED,
+		0,
+	)
+	if err != nil {
+		dm.logger.Warn("cannot watch sync root, dehydration scans walk the whole tree",
+			zap.String("path", rootPath),
+			zap.Error(err),
+		)
+		return
+	}
+	defer windows.CloseHandle(handle)
+
+	event, err := windows.CreateEvent(nil, 1, 0, nil)
+	if err != nil {
+		dm.logger.Warn("cannot watch sync root", zap.Error(err))
+		return
+	}
+	defer windows.CloseHandle(event)
+
+	watch := dm.index.Track()
+	defer dm.index.Reset(watch)
+
+	buf := make([]byte, watchBufferSize)
+	for ctx.Err() == nil {
+		overlapped := windows.Overlapped{HEvent: event}
+		windows.ResetEvent(event)
+		err := windows.ReadDirectoryChanges(handle, &buf[0], uint32(len(buf)), true, watchFilter, nil, &overlapped, 0)
+		if err != nil {
+			dm.logger.Warn("sync root watch failed", zap.Error(err))
+			return
+		}
+
+		// Wake up regularly to notice when the manager stops
+		for {
+			result, err := windows.WaitForSingleObject(event, watchPollMillis)
+			if err != nil || result != uint32(windows.WAIT_TIMEOUT) || ctx.Err() != nil {
+				break
+			}
+		}
+		if ctx.Err() != nil {
+			windows.CancelIoEx(handle, &overlapped)
+		}
+
+		var n uint32
+		if err := windows.GetOverlappedResult(handle, &overlapped, &n, true); err != nil {
+			if !errors.Is(err, windows.ERROR_OPERATION_ABORTED) {
+				dm.logger.Warn("sync root watch failed", zap.Error(err))
+			}
+			return
+		}
+		if ctx.Err() != nil {
+			return
+		}
+
+		if n == 0 {
+			// Buffer overflow: changes were lost
+			dm.logger.Debug("sync root watch overflowed, rebuilding hydration index")
+			dm.index.Invalidate()
+			continue
+		}
+		if err := dm.applyNotifications(buf[:n]); err != nil {
+			dm.logger.Warn("invalid change notification", zap.Error(err))
+			dm.index.Invalidate()
+		}
+	}
+}
+
+// applyNotifications marks the paths of a FILE_NOTIFY_INFORMATION list dirty.
+func (dm *DehydrationManager) applyNotifications(buf []byte) error {
+	const headerSize = int(unsafe.Offsetof(windows.FileNotifyInformation{}.FileName))
+
+	for offset := 0; ; {
+		if offset+headerSize > len(buf) {
+			return fmt.Errorf("truncated notification at %d", offset)
+		}
+		info := (*windows.FileNotifyInformation)(unsafe.Pointer(&buf[offset]))
+		nameLen := int(info.FileNameLength) / 2
+		if offset+headerSize+nameLen*2 > len(buf) {
+			return fmt.Errorf("truncated file name at %d", offset)
+		}
+		name := windows.UTF16ToString(unsafe.Slice(&info.FileName, nameLen))
+
+		// Created and moved-in directories must be walked, other changes
+		// concern the path itself
+		subtree := info.Action == windows.FILE_ACTION_ADDED || info.Action == windows.FILE_ACTION_RENAMED_NEW_NAME
+		dm.index.MarkDirty(name, subtree)
+
+		if info.NextEntryOffset == 0 {
+			return nil
+		}
+		offset += int(info.NextEntryOffset)
+	}
+}
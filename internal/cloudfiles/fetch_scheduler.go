@@ -0,0 +1,362 @@
+//go:build windows
+// +build windows
+
+// Package cloudfiles provides Go bindings for the Windows Cloud Files API.
+package cloudfiles
+
+import (
+	"container/heap"
+	"context"
+	"strings"
+	"sync"
+	"time"
+	"unsafe"
+
+	"golang.org/x/sys/windows"
+)
+
+var (
+	user32 = windows.NewLazySystemDLL("user32.dll")
+
+	procGetForegroundWindow      = user32.NewProc("GetForegroundWindow")
+	procGetWindowThreadProcessId = user32.NewProc("GetWindowThreadProcessId")
+)
+
+// Fetch priority scale. PriorityHint from Windows is 0 (lowest) to 15
+// (highest); the policy shifts it by a class offset so that a foreground
+// open always beats a normal one, which always beats a scanner.
+const (
+	maxPriorityHint          = 15
+	fetchPriorityClassOffset = maxPriorityHint + 1
+)
+
+// fetchQueueLimit is the number of FETCH_DATA requests the scheduler holds.
+// Past it, new fetches are failed with a retryable status rather than
+// blocking the bridge pollers.
+const fetchQueueLimit = 1024
+
+// fetchAgingStep is how long a queued fetch waits to gain one priority
+// level, so low-priority fetches are not starved past the CfAPI timeout:
+// a scanner fetch overtakes new normal ones after 8s, foreground ones after 16s.
+const fetchAgingStep = 500 * time.Millisecond
+
+// DefaultScannerProcesses are image names whose hydrations are served last
+// (antivirus and indexer scanners). Generic hosts such as dllhost.exe are left
+// out: the image name alone cannot tell a thumbnailer from any other COM server.
+var DefaultScannerProcesses = []string{
+	"MsMpEng.exe",
+	"MpDefenderCoreService.exe",
+	"MsSense.exe",
+	"NisSrv.exe",
+	"SearchIndexer.exe",
+	"SearchProtocolHost.exe",
+	"SearchFilterHost.exe",
+}
+
+// FetchPriorityPolicy controls the order in which queued hydrations run.
+type FetchPriorityPolicy struct {
+	// DisableForegroundBoost stops favouring the process owning the foreground window.
+	DisableForegroundBoost bool
+
+	// ScannerProcesses are image names (case-insensitive) served after
+	// everything else. nil = DefaultScannerProcesses.
+	ScannerProcesses []string
+}
+
+// foregroundProcessID returns the process owning the foreground window.
+// Replaced in tests.
+var foregroundProcessID = func() uint32 {
+	if procGetForegroundWindow.Find() != nil || procGetWindowThreadProcessId.Find() != nil {
+		return 0
+	}
+	hwnd, _, _ := procGetForegroundWindow.Call()
+	if hwnd == 0 {
+		return 0
+	}
+	var pid uint32
+	procGetWindowThreadProcessId.Call(hwnd, uintptr(unsafe.Pointer(&pid)))
+	return pid
+}
+
+// fetchPrioritizer scores FETCH_DATA requests according to a policy.
+type fetchPrioritizer struct {
+	foregroundBoost bool
+	scanners        map[string]bool
+}
+
+func newFetchPrioritizer(policy FetchPriorityPolicy) *fetchPrioritizer {
+	names := policy.ScannerProcesses
+	if names == nil {
+		names = DefaultScannerProcesses
+	}
+	p := &fetchPrioritizer{
+		foregroundBoost: !policy.DisableForegroundBoost,
+		scanners:        make(map[string]bool, len(names)),
+	}
+	for _, name := range names {
+		p.scanners[strings.ToLower(name)] = true
+	}
+	return p
+}
+
+// Priority returns the scheduling priority of a fetch (higher runs first).
+func (p *fetchPrioritizer) Priority(hint int, processID uint32, imagePath string) int {
+	if hint < 0 {
+		hint = 0
+	} else if hint > maxPriorityHint {
+		hint = maxPriorityHint
+	}
+
+	// Image paths come from the kernel as NT or DOS paths
+	image := imagePath[strings.LastIndexAny(imagePath, `\/`)+1:]
+	if image != "" && p.scanners[strings.ToLower(image)] {
+		return hint
+	}
+	if p.foregroundBoost && processID != 0 && processID == foregroundProcessID() {
+		return hint + 2*fetchPriorityClassOffset
+	}
+	return hint + fetchPriorityClassOffset
+}
+
+// scheduledFetch is one queued fetch.
+type scheduledFetch struct {
+	rank  int64 // Arrival time minus the priority in aging steps (lower runs first)
+	seq   uint64
+	run   func()
+	abort func() // Fails the fetch if the scheduler closes first
+}
+
+// fetchHeap orders fetches by rank, then arrival. With aging the effective
+// priority of a fetch is its priority plus its wait in aging steps; all
+// fetches age at the same pace, so ordering by arrival time minus priority
+// gives the same order at any time and the heap never needs reordering.
+type fetchHeap []*scheduledFetch
+
+func (h fetchHeap) Len() int { return len(h) }
+func (h fetchHeap) Less(i, j int) bool {
+	if h[i].rank != h[j].rank {
+		return h[i].rank < h[j].rank
+	}
+	return h[i].seq < h[j].seq
+}
+func (h fetchHeap) Swap(i, j int)       { h[i], h[j] = h[j], h[i] }
+func (h *fetchHeap) Push(x interface{}) { *h = append(*h, x.(*scheduledFetch)) }
+func (h *fetchHeap) Pop() interface{} {
+	old := *h
+	item := old[len(old)-1]
+	old[len(old)-1] = nil
+	*h = old[:len(old)-1]
+	return item
+}
+
+// fetchScheduler sits between the bridge pollers and the hydration workers:
+// pollers Push fetches as they drain the C queue, workers Pop the highest
+// priority one, queued fetches gaining priority as they wait. Push never
+// blocks: past limit queued fetches it refuses new ones.
+type fetchScheduler struct {
+	mu       sync.Mutex
+	notEmpty *sync.Cond
+	queue    fetchHeap
+	limit    int
+	seq      uint64
+	closed   bool
+	now      func() time.Time
+}
+
+func newFetchScheduler(limit int) *fetchScheduler {
+	if limit <= 0 {
+		limit = fetchQueueLimit
+	}
+	s := &fetchScheduler{limit: limit, now: time.Now}
+	s.notEmpty = sync.NewCond(&s.mu)
+	return s
+}
+
+// Push queues a fetch. If the scheduler is closed, abort runs instead.
+// Returns false, running neither, if limit fetches are already queued.
+func (s *fetchScheduler) Push(priority int, run, abort func()) bool {
+	s.mu.Lock()
+	if s.closed {
+		s.mu.Unlock()
+		abort()
+		return true
+	}
+	if len(s.queue) >= s.limit {
+		s.mu.Unlock()
+		return false
+	}
+	s.seq++
+	rank := s.now().UnixNano() - int64(priority)*int64(fetchAgingStep)
+	heap.Push(&s.queue, &scheduledFetch{rank: rank, seq: s.seq, run: run, abort: abort})
+	s.mu.Unlock()
+	s.notEmpty.Signal()
+	return true
+}
+
+// Run executes fetches in priority order until the scheduler is closed.
+// Fetches still queued at close are aborted by whichever worker sees them.
+func (s *fetchScheduler) Run() {
+	for {
+		s.mu.Lock()
+		for len(s.queue) == 0 && !s.closed {
+			s.notEmpty.Wait()
+		}
+		if len(s.queue) == 0 {
+			s.mu.Unlock()
+			return
+		}
+		item := heap.Pop(&s.queue).(*scheduledFetch)
+		closed := s.closed
+		s.mu.Unlock()
+
+		if closed {
+			item.abort()
+		} else {
+			item.run()
+		}
+	}
+}
+
+// Len returns the number of queued fetches.
+func (s *fetchScheduler) Len() int {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	return len(s.queue)
+}
+
+// Close wakes all workers; queued fetches are aborted.
+func (s *fetchScheduler) Close() {
+	s.mu.Lock()
+	s.closed = true
+	s.mu.Unlock()
+	s.notEmpty.Broadcast()
+}
+
+// earlyCancelTTL is how long a cancellation that found no fetch is kept: it
+// overtook its FETCH_DATA, still in the C queue behind it.
+const earlyCancelTTL = 5 * time.Second
+
+// maxEarlyCancels bounds the cancellations kept for fetches not yet polled.
+const maxEarlyCancels = 256
+
+// fetchRange identifies one FETCH_DATA request. Windows reuses a transfer
+// key for the successive fetches of an open file, and a CANCEL_FETCH_DATA
+// only aborts the range it names.
+type fetchRange struct {
+	key    int64
+	offset int64
+	length int64 // <= 0 in a cancellation: every fetch of the transfer
+}
+
+// matches checks if a cancellation of c applies to the fetch r: same
+// transfer, overlapping ranges. Windows may cancel part of a fetch, and the
+// bridge rewrites an open-ended fetch to end at the file size.
+func (c fetchRange) matches(r fetchRange) bool {
+	if c.key != r.key {
+		return false
+	}
+	if c.length <= 0 || r.length <= 0 {
+		return true
+	}
+	return c.offset < r.offset+r.length && r.offset < c.offset+c.length
+}
+
+// fetchCancels tracks queued and running fetches by transfer key and range,
+// so a CANCEL_FETCH_DATA reaches the fetch wherever it is: still queued in
+// the scheduler, hydrating, or not yet polled from the C queue.
+type fetchCancels struct {
+	mu     sync.Mutex
+	active map[int64][]*fetchTicket
+	early  map[fetchRange]time.Time
+	now    func() time.Time
+}
+
+// fetchTicket is one tracked fetch. ctx is cancelled with the fetch.
+type fetchTicket struct {
+	fetchRange
+	ctx    context.Context
+	cancel context.CancelFunc
+}
+
+func newFetchCancels() *fetchCancels {
+	return &fetchCancels{
+		active: make(map[int64][]*fetchTicket),
+		early:  make(map[fetchRange]time.Time),
+		now:    time.Now,
+	}
+}
+
+// Begin tracks a fetch of a transfer range. Its context is already
+// cancelled if the cancellation of that range arrived first.
+func (c *fetchCancels) Begin(key, offset, length int64) *fetchTicket {
+	ctx, cancel := context.WithCancel(context.Background())
+	t := &fetchTicket{fetchRange: fetchRange{key: key, offset: offset, length: length}, ctx: ctx, cancel: cancel}
+
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	for r, at := range c.early {
+		if r.matches(t.fetchRange) {
+			delete(c.early, r)
+			if c.now().Sub(at) < earlyCancelTTL {
+				cancel()
+			}
+		}
+	}
+	c.active[key] = append(c.active[key], t)
+	return t
+}
+
+// End stops tracking a fetch.
+func (c *fetchCancels) End(t *fetchTicket) {
+	t.cancel()
+
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	tickets := c.active[t.key]
+	for i, other := range tickets {
+		if other == t {
+			tickets = append(tickets[:i], tickets[i+1:]...)
+			break
+		}
+	}
+	if len(tickets) == 0 {
+		delete(c.active, t.key)
+	} else {
+		c.active[t.key] = tickets
+	}
+}
+
+// Cancel cancels the fetches of a transfer range (length <= 0: of the whole
+// transfer). Returns false if none is tracked; a cancellation of a range is
+// then kept for the fetch of that range arriving later.
+func (c *fetchCancels) Cancel(key, offset, length int64) bool {
+	cancelled := fetchRange{key: key, offset: offset, length: length}
+
+	c.mu.Lock()
+	defer c.mu.Unlock()
+
+	found := false
+	for _, t := range c.active[key] {
+		if cancelled.matches(t.fetchRange) {
+			t.cancel()
+			found = true
+		}
+	}
+	if found || length <= 0 {
+		return found
+	}
+
+	now := c.now()
+	if len(c.early) >= maxEarlyCancels {
+		for r, at := range c.early {
+			if now.Sub(at) >= earlyCancelTTL {
+				delete(c.early, r)
+			}
+		}
+		if len(c.early) >= maxEarlyCancels {
+			return false
+		}
+	}
+	c.early[cancelled] = now
+	return false
+}
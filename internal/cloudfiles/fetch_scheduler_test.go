@@ -0,0 +1,253 @@
+//go:build windows
+// +build windows
+
+package cloudfiles
+
+import (
+	"sync"
+	"testing"
+	"time"
+)
+
+func TestFetchPrioritizer(t *testing.T) {
+	saved := foregroundProcessID
+	foregroundProcessID = func() uint32 { return 42 }
+	defer func() { foregroundProcessID = saved }()
+
+	p := newFetchPrioritizer(FetchPriorityPolicy{})
+
+	foreground := p.Priority(0, 42, `C:\Program Files\App\app.exe`)
+	normal := p.Priority(15, 7, `C:\Windows\explorer.exe`)
+	scanner := p.Priority(15, 42, `C:\ProgramData\Microsoft\Windows Defender\MsMpEng.EXE`)
+
+	if !(foreground > normal && normal > scanner) {
+		t.Errorf("Expected foreground > normal > scanner, got %d, %d, %d", foreground, normal, scanner)
+	}
+	if p.Priority(9, 7, "") <= p.Priority(3, 7, "") {
+		t.Error("Expected a higher hint to rank higher within a class")
+	}
+	if p.Priority(99, 7, "") != p.Priority(maxPriorityHint, 7, "") {
+		t.Error("Expected out-of-range hints to be clamped")
+	}
+
+	flat := newFetchPrioritizer(FetchPriorityPolicy{DisableForegroundBoost: true, ScannerProcesses: []string{}})
+	if flat.Priority(5, 42, `C:\x\MsMpEng.exe`) != flat.Priority(5, 7, "") {
+		t.Error("Expected no boost and no scanner list to rank by hint only")
+	}
+}
+
+func TestFetchSchedulerOrder(t *testing.T) {
+	s := newFetchScheduler(16)
+	clock := time.Unix(1000, 0)
+	s.now = func() time.Time { return clock }
+
+	var order []int
+	push := func(priority, id int) {
+		s.Push(priority, func() { order = append(order, id) }, func() { t.Errorf("Fetch %d aborted", id) })
+	}
+	push(1, 1)
+	push(5, 2)
+	push(1, 3)
+	push(9, 4)
+	push(5, 5)
+
+	// Queue everything before the worker starts, then drain it
+	done := make(chan struct{})
+	s.Push(-1, func() { close(done) }, func() {})
+	go s.Run()
+	<-done
+	s.Close()
+
+	want := []int{4, 2, 5, 1, 3}
+	if len(order) != len(want) {
+		t.Fatalf("Expected %d fetches, got %v", len(want), order)
+	}
+	for i := range want {
+		if order[i] != want[i] {
+			t.Fatalf("Expected order %v, got %v", want, order)
+		}
+	}
+}
+
+func TestFetchSchedulerAging(t *testing.T) {
+	s := newFetchScheduler(16)
+	clock := time.Unix(1000, 0)
+	s.now = func() time.Time { return clock }
+
+	var order []string
+	push := func(priority int, id string) {
+		s.Push(priority, func() { order = append(order, id) }, func() {})
+	}
+	scanner := 0
+	normal := fetchPriorityClassOffset
+	push(scanner, "old scanner")
+	clock = clock.Add(time.Duration(fetchPriorityClassOffset+1) * fetchAgingStep)
+	push(normal, "new normal")
+	push(scanner, "new scanner")
+
+	done := make(chan struct{})
+	s.Push(-1000, func() { close(done) }, func() {})
+	go s.Run()
+	<-done
+	s.Close()
+
+	want := []string{"old scanner", "new normal", "new scanner"}
+	for i := range want {
+		if i >= len(order) || order[i] != want[i] {
+			t.Fatalf("Expected order %v, got %v", want, order)
+		}
+	}
+}
+
+func TestFetchSchedulerFullAndClose(t *testing.T) {
+	s := newFetchScheduler(2)
+
+	var mu sync.Mutex
+	ran, aborted := 0, 0
+	run := func() { mu.Lock(); ran++; mu.Unlock() }
+	abort := func() { mu.Lock(); aborted++; mu.Unlock() }
+
+	s.Push(0, run, abort)
+	s.Push(0, run, abort)
+
+	// Scheduler is full: the fetch is refused without blocking
+	if s.Push(0, run, abort) {
+		t.Error("Expected a full scheduler to refuse the fetch")
+	}
+
+	s.Close()
+	if !s.Push(0, run, abort) {
+		t.Error("Expected a closed scheduler to abort the fetch")
+	}
+	s.Run() // Returns once the queue is drained
+
+	if ran != 0 || aborted != 3 {
+		t.Errorf("Expected 3 aborted fetches, got ran=%d aborted=%d", ran, aborted)
+	}
+	if s.Len() != 0 {
+		t.Errorf("Expected empty scheduler, got %d", s.Len())
+	}
+}
+
+func TestFetchSchedulerConcurrent(t *testing.T) {
+	s := newFetchScheduler(32)
+
+	var workers sync.WaitGroup
+	for i := 0; i < 3; i++ {
+		workers.Add(1)
+		go func() {
+			defer workers.Done()
+			s.Run()
+		}()
+	}
+
+	var mu sync.Mutex
+	ran, refused := 0, 0
+	var pushers sync.WaitGroup
+	for i := 0; i < 4; i++ {
+		pushers.Add(1)
+		go func(i int) {
+			defer pushers.Done()
+			for j := 0; j < 50; j++ {
+				if !s.Push(i, func() { mu.Lock(); ran++; mu.Unlock() }, func() { t.Error("Unexpected abort") }) {
+					mu.Lock()
+					refused++
+					mu.Unlock()
+				}
+			}
+		}(i)
+	}
+	pushers.Wait()
+
+	// Wait for the queue to drain before closing so nothing is aborted
+	drained := make(chan struct{})
+	for !s.Push(-1, func() { close(drained) }, func() {}) {
+		time.Sleep(time.Millisecond)
+	}
+	<-drained
+	s.Close()
+	workers.Wait()
+
+	if ran+refused != 200 {
+		t.Errorf("Expected 200 fetches run or refused, got %d run and %d refused", ran, refused)
+	}
+}
+
+func TestFetchCancelsRunning(t *testing.T) {
+	c := newFetchCancels()
+
+	ticket := c.Begin(7, 0, 4096)
+	sibling := c.Begin(7, 4096, 4096) // Another range of the same transfer
+	other := c.Begin(8, 0, 4096)
+	if !c.Cancel(7, 0, 4096) {
+		t.Fatal("Expected a tracked fetch to be cancelled")
+	}
+	if ticket.ctx.Err() == nil {
+		t.Error("Expected the cancelled fetch context to be done")
+	}
+	if sibling.ctx.Err() != nil || other.ctx.Err() != nil {
+		t.Error("Expected other ranges and transfers to be unaffected")
+	}
+
+	// Part of a range cancels the fetch of the whole range
+	partial := c.Begin(7, 8192, 4096)
+	if !c.Cancel(7, 9000, 100) || partial.ctx.Err() == nil {
+		t.Error("Expected a cancellation of part of the range to cancel the fetch")
+	}
+	if sibling.ctx.Err() != nil {
+		t.Error("Expected a non-overlapping range to be unaffected")
+	}
+	c.End(partial)
+
+	// A cancellation without a range covers the whole transfer
+	if !c.Cancel(7, 0, 0) || sibling.ctx.Err() == nil {
+		t.Error("Expected every fetch of the transfer to be cancelled")
+	}
+
+	c.End(ticket)
+	c.End(sibling)
+	c.End(other)
+	if len(c.active) != 0 {
+		t.Errorf("Expected no tracked fetches, got %d", len(c.active))
+	}
+}
+
+func TestFetchCancelsEarlyCancel(t *testing.T) {
+	c := newFetchCancels()
+	clock := time.Unix(1000, 0)
+	c.now = func() time.Time { return clock }
+
+	// Cancellation overtakes its fetch
+	if c.Cancel(7, 0, 4096) {
+		t.Error("Expected no tracked fetch")
+	}
+	if ticket := c.Begin(7, 4096, 4096); ticket.ctx.Err() != nil {
+		t.Error("Expected a fetch of another range to run")
+	}
+	if ticket := c.Begin(7, 0, 4096); ticket.ctx.Err() == nil {
+		t.Error("Expected a fetch cancelled before it arrived to start cancelled")
+	}
+	// The early cancel is consumed by that fetch
+	if ticket := c.Begin(7, 0, 4096); ticket.ctx.Err() != nil {
+		t.Error("Expected a later fetch of the range to run")
+	}
+
+	// A cancellation of part of the range applies to the fetch arriving later
+	c.Cancel(10, 100, 10)
+	if ticket := c.Begin(10, 0, 4096); ticket.ctx.Err() == nil {
+		t.Error("Expected an overlapping early cancellation to apply")
+	}
+
+	// A cancellation without a range is not kept
+	c.Cancel(8, 0, 0)
+	if ticket := c.Begin(8, 0, 4096); ticket.ctx.Err() != nil {
+		t.Error("Expected a whole-transfer cancellation not to poison later fetches")
+	}
+
+	// A stale early cancel is ignored
+	c.Cancel(9, 0, 4096)
+	clock = clock.Add(earlyCancelTTL)
+	if ticket := c.Begin(9, 0, 4096); ticket.ctx.Err() != nil {
+		t.Error("Expected an expired cancellation to be ignored")
+	}
+}
@@ -6,29 +6,84 @@ package cloudfiles
 
 import (
 	"context"
+	"errors"
 	"fmt"
 	"io"
+	"os"
 	"path/filepath"
+	"strconv"
 	"strings"
 	"sync"
+	"time"
 
 	"go.uber.org/zap"
 	"golang.org/x/sys/windows"
 )
 
+// DefaultHydrationReadAhead is the default number of chunk buffers in the
+// hydration pipeline (2 = read chunk N+1 while chunk N is transferred).
+const DefaultHydrationReadAhead = 2
+
+// Parallel fetch defaults.
+const (
+	DefaultParallelRangeSize = 8 * 1024 * 1024  // 8MB per range
+	DefaultParallelThreshold = 64 * 1024 * 1024 // Split hydrations of 64MB or more
+)
+
+// ParallelFetchConfig controls multi-range hydration of large files: the
+// requested span is split into ranges fetched over separate readers at the
+// same time, then transferred to Windows in offset order.
+type ParallelFetchConfig struct {
+	Ranges    int   // Concurrent range fetches (<= 1 disables parallel fetch)
+	RangeSize int64 // Bytes per range (0 = DefaultParallelRangeSize)
+	Threshold int64 // Minimum hydration length before splitting (0 = DefaultParallelThreshold)
+}
+
+// Prefetch defaults.
+const (
+	DefaultPrefetchMaxBytes  = 16 * 1024 * 1024 // Cap on bytes prefetched past the required range
+	DefaultPrefetchMaxActive = 1                // Idle = no hydration other than this one
+)
+
+// prefetchAlignment is the CfExecute transfer alignment: transfers that do
+// not end at EOF must end on a 4KB boundary.
+const prefetchAlignment = 4096
+
+// PrefetchPolicy controls speculative transfer of the optional range Windows
+// offers with FETCH_DATA, so sequential readers need fewer round-trips.
+type PrefetchPolicy struct {
+	Enabled   bool
+	MaxBytes  int64 // Max bytes transferred past the required range (0 = DefaultPrefetchMaxBytes)
+	MaxActive int   // Prefetch only while at most this many hydrations run (0 = DefaultPrefetchMaxActive)
+}
+
 // HydrationHandler manages the hydration (download) of placeholder files.
 type HydrationHandler struct {
 	syncRoot     *SyncRootManager
 	dataProvider DataProvider
 	chunkSize    int64
+	readAhead    int
+	parallel     ParallelFetchConfig
+	prefetch     PrefetchPolicy
+	blockCache   *BlockCache
+	batch        TransferBatchConfig
 	logger       *zap.Logger
 
 	mu               sync.RWMutex
-	activeHydrations map[CF_TRANSFER_KEY]*activeHydration
+	activeHydrations map[hydrationKey]*activeHydration
+}
+
+// hydrationKey identifies one FETCH_DATA request. Windows sends several for
+// the same transfer key when a file is read in ranges, possibly at once.
+type hydrationKey struct {
+	transferKey CF_TRANSFER_KEY
+	requestKey  int64
+	offset      int64
 }
 
 // activeHydration tracks an in-progress hydration operation.
 type activeHydration struct {
+	transferKey  CF_TRANSFER_KEY
 	cancel       context.CancelFunc
 	filePath     string
 	totalBytes   int64
@@ -42,6 +97,102 @@ type DataProvider interface {
 	GetFileReader(ctx context.Context, relativePath string, offset int64) (io.ReadCloser, error)
 }
 
+// RemoteFile is a remote file opened for positional reads.
+type RemoteFile interface {
+	io.ReaderAt
+	io.Closer
+}
+
+// RangeDataProvider is implemented by data providers that can open a file
+// for positional reads, so reading a range costs O(range) instead of O(offset).
+type RangeDataProvider interface {
+	// GetFileReaderAt opens the file at the given relative path for ReadAt.
+	// Returns ErrReaderAtUnsupported when the underlying source cannot seek.
+	GetFileReaderAt(ctx context.Context, relativePath string) (RemoteFile, error)
+}
+
+// FileVersionProvider is implemented by data providers that know the remote
+// version of a file (hash, else mtime), used to key the block cache.
+type FileVersionProvider interface {
+	FileVersion(relativePath string) (string, bool)
+}
+
+// ErrReaderAtUnsupported is returned by GetFileReaderAt when positional reads
+// are not available; callers fall back to GetFileReader.
+var ErrReaderAtUnsupported = errors.New("positional reads not supported")
+
+// openRemoteRange returns a reader over [offset, offset+length) of a remote
+// file, using ReadAt when the provider supports it. The reader is closed as
+// soon as ctx is cancelled, so a cancelled hydration stops pulling data.
+func openRemoteRange(ctx context.Context, provider DataProvider, relativePath string, offset, length int64) (io.ReadCloser, error) {
+	opened := time.Now()
+	if rp, ok := provider.(RangeDataProvider); ok {
+		file, err := rp.GetFileReaderAt(ctx, relativePath)
+		if err == nil {
+			return newRemoteReader(ctx, &sectionReadCloser{
+				SectionReader: io.NewSectionReader(file, offset, length),
+				file:          file,
+			}, opened), nil
+		}
+		if !errors.Is(err, ErrReaderAtUnsupported) {
+			return nil, err
+		}
+	}
+	reader, err := provider.GetFileReader(ctx, relativePath, offset)
+	if err != nil {
+		return nil, err
+	}
+	return newRemoteReader(ctx, reader, opened), nil
+}
+
+// remoteReader wraps a remote reader for hydration. It closes the reader
+// when its context is cancelled, unblocking a read stuck on the network
+// (providers that watch ctx themselves abort sooner), and records the
+// time to the first byte in the bridge statistics.
+type remoteReader struct {
+	io.ReadCloser
+	opened    time.Time
+	firstByte bool
+	stop      func() bool
+	once      sync.Once
+	err       error
+}
+
+func newRemoteReader(ctx context.Context, r io.ReadCloser, opened time.Time) *remoteReader {
+	rr := &remoteReader{ReadCloser: r, opened: opened}
+	rr.stop = context.AfterFunc(ctx, func() { rr.closeOnce() })
+	return rr
+}
+
+func (r *remoteReader) Read(p []byte) (int, error) {
+	n, err := r.ReadCloser.Read(p)
+	if n > 0 && !r.firstByte {
+		r.firstByte = true
+		recordBridgeStage(stageFirstByte, time.Since(r.opened))
+	}
+	return n, err
+}
+
+func (r *remoteReader) closeOnce() error {
+	r.once.Do(func() { r.err = r.ReadCloser.Close() })
+	return r.err
+}
+
+func (r *remoteReader) Close() error {
+	r.stop()
+	return r.closeOnce()
+}
+
+// sectionReadCloser reads one section of a RemoteFile and closes the file.
+type sectionReadCloser struct {
+	*io.SectionReader
+	file RemoteFile
+}
+
+func (r *sectionReadCloser) Close() error {
+	return r.file.Close()
+}
+
 // NewHydrationHandler creates a new hydration handler.
 func NewHydrationHandler(syncRoot *SyncRootManager, provider DataProvider, logger *zap.Logger) *HydrationHandler {
 	if logger == nil {
@@ -51,8 +202,10 @@ func NewHydrationHandler(syncRoot *SyncRootManager, provider DataProvider, logge
 		syncRoot:         syncRoot,
 		dataProvider:     provider,
 		chunkSize:        1024 * 1024, // 1MB chunks
+		readAhead:        DefaultHydrationReadAhead,
+		batch:            TransferBatchConfig{}.withDefaults(),
 		logger:           logger,
-		activeHydrations: make(map[CF_TRANSFER_KEY]*activeHydration),
+		activeHydrations: make(map[hydrationKey]*activeHydration),
 	}
 }
 
@@ -63,10 +216,155 @@ func (h *HydrationHandler) SetChunkSize(size int64) {
 	}
 }
 
+// SetReadAhead sets how many chunk buffers the hydration pipeline uses.
+// 1 disables overlap (read, then transfer); higher values let the remote
+// read run further ahead of CfExecute.
+func (h *HydrationHandler) SetReadAhead(depth int) {
+	if depth > 0 {
+		h.readAhead = depth
+	}
+}
+
+// SetParallelFetch configures multi-range hydration for large files.
+func (h *HydrationHandler) SetParallelFetch(config ParallelFetchConfig) {
+	if config.RangeSize <= 0 {
+		config.RangeSize = DefaultParallelRangeSize
+	}
+	if config.Threshold <= 0 {
+		config.Threshold = DefaultParallelThreshold
+	}
+	h.parallel = config
+}
+
+// SetPrefetchPolicy configures speculative transfer of the optional range.
+func (h *HydrationHandler) SetPrefetchPolicy(policy PrefetchPolicy) {
+	if policy.MaxBytes <= 0 {
+		policy.MaxBytes = DefaultPrefetchMaxBytes
+	}
+	if policy.MaxActive <= 0 {
+		policy.MaxActive = DefaultPrefetchMaxActive
+	}
+	h.prefetch = policy
+}
+
+// SetTransferBatch configures how chunks are grouped into bridge transfer
+// calls and how often progress is reported.
+func (h *HydrationHandler) SetTransferBatch(config TransferBatchConfig) {
+	h.batch = config.withDefaults()
+}
+
+// batchSegments returns how many full chunks one transfer batch holds.
+func (h *HydrationHandler) batchSegments() int {
+	segments := h.batch.Segments
+	if byBytes := h.batch.MaxBytes / h.chunkSize; byBytes < int64(segments) {
+		segments = int(byBytes)
+	}
+	if segments < 1 {
+		segments = 1
+	}
+	return segments
+}
+
+// SetBlockCache sets the local block cache used to serve and store hydrated
+// ranges (nil disables it).
+func (h *HydrationHandler) SetBlockCache(cache *BlockCache) {
+	h.blockCache = cache
+}
+
+// blockCacheKey returns the cache key of the current remote version of a
+// file. The version comes from the data provider when it knows it, else
+// from the placeholder's last write time, which mirrors the remote mtime.
+func (h *HydrationHandler) blockCacheKey(relativePath string, fileSize int64) (BlockCacheKey, bool) {
+	key := BlockCacheKey{Path: relativePath, Size: fileSize}
+	if vp, ok := h.dataProvider.(FileVersionProvider); ok {
+		if version, ok := vp.FileVersion(relativePath); ok {
+			key.Version = version
+			return key, true
+		}
+	}
+	info, err := os.Stat(filepath.Join(h.syncRoot.Path(), filepath.FromSlash(relativePath)))
+	if err != nil {
+		return key, false
+	}
+	key.Version = "m" + strconv.FormatInt(info.ModTime().Unix(), 10)
+	return key, true
+}
+
+// serveCachedBlocks delivers the cached blocks that continue at offset, in
+// chunkSize pieces, stopping at the first miss. Returns the bytes delivered.
+func (h *HydrationHandler) serveCachedBlocks(cache *BlockCache, key BlockCacheKey, offset, length int64, sink transferSink) (int64, error) {
+	bs := cache.BlockSize()
+	buf := make([]byte, bs)
+	served := int64(0)
+	for served < length {
+		pos := offset + served
+		index := pos / bs
+		data, ok := cache.Get(key, index, buf)
+		if !ok {
+			break
+		}
+		data = data[pos-index*bs:]
+		if rem := length - served; int64(len(data)) > rem {
+			data = data[:rem]
+		}
+		for len(data) > 0 {
+			n := int64(len(data))
+			if n > h.chunkSize {
+				n = h.chunkSize
+			}
+			if err := sink.Deliver(data[:n]); err != nil {
+				return served, err
+			}
+			data = data[n:]
+			served += n
+		}
+		// The block buffer is reused for the next block
+		if err := sink.Flush(); err != nil {
+			return served, err
+		}
+	}
+	return served, nil
+}
+
+// prefetchLength returns the number of bytes to transfer from offset: the
+// required length, extended over the optional range when the policy allows
+// it and at most active hydrations are running (the link is idle).
+func (h *HydrationHandler) prefetchLength(info *FetchDataInfo, offset, length int64, active int) int64 {
+	p := h.prefetch
+	if !p.Enabled || info.OptionalLength <= 0 || active > p.MaxActive {
+		return length
+	}
+
+	requiredEnd := offset + length
+	optionalEnd := info.OptionalOffset + info.OptionalLength
+	// Only a window that continues the required range can share its reader
+	if info.OptionalOffset > requiredEnd || optionalEnd <= requiredEnd {
+		return length
+	}
+
+	end := optionalEnd
+	if end > requiredEnd+p.MaxBytes {
+		end = requiredEnd + p.MaxBytes
+	}
+	if end >= info.FileSize {
+		end = info.FileSize
+	} else {
+		end -= end % prefetchAlignment
+	}
+	if end <= requiredEnd {
+		return length
+	}
+	return end - offset
+}
+
 // handleFetchDataCallback is the callback function for SyncRootManager.
 // It converts FetchDataCallback signature to HandleFetchData call.
 func (h *HydrationHandler) handleFetchDataCallback(info *FetchDataInfo) error {
-	return h.HandleFetchData(context.Background(), info)
+	ctx := info.Context
+	if ctx == nil {
+		ctx = context.Background()
+	}
+	return h.HandleFetchData(ctx, info)
 }
 
 // HandleFetchData handles a fetch data callback from Windows.
@@ -75,51 +373,25 @@ func (h *HydrationHandler) HandleFetchData(ctx context.Context, info *FetchDataI
 	// Create cancellable context
 	ctx, cancel := context.WithCancel(ctx)
 
-	// Get relative path from NormalizedPath
-	// NormalizedPath format: \<path_from_volume_root>\<relative_path>
-	// e.g., for sync root D:\Anemone\backup:
-	//   \Anemone\backup\subdir\file.txt -> subdir/file.txt
-	// e.g., for sync root D:\test_anemone:
-	//   \test_anemone\subdir\file.txt -> subdir/file.txt
-	relativePath := info.FilePath
-
-	// Strip leading backslash
-	relativePath = strings.TrimPrefix(relativePath, "\\")
-	relativePath = strings.TrimPrefix(relativePath, "/")
-
-	// Strip the sync root path (from volume root) from the beginning
-	// For D:\Anemone\backup, we need to strip "Anemone\backup\" (not just "backup\")
-	syncRootPath := h.syncRoot.Path()
-	volName := filepath.VolumeName(syncRootPath)
-	syncRootRelative := strings.TrimPrefix(syncRootPath, volName)
-	syncRootRelative = strings.TrimPrefix(syncRootRelative, "\\")
-	syncRootRelative = strings.TrimPrefix(syncRootRelative, "/")
-
-	if syncRootRelative != "" {
-		if strings.HasPrefix(relativePath, syncRootRelative+"\\") {
-			relativePath = relativePath[len(syncRootRelative)+1:]
-		} else if strings.HasPrefix(relativePath, syncRootRelative+"/") {
-			relativePath = relativePath[len(syncRootRelative)+1:]
-		}
-	}
-
-	// Normalize to forward slashes
-	relativePath = strings.ReplaceAll(relativePath, "\\", "/")
+	relativePath := syncRootRelativePath(h.syncRoot.Path(), info.FilePath)
 
 	// Track this hydration
+	key := hydrationKey{transferKey: info.TransferKey, requestKey: info.RequestKey, offset: info.RequiredOffset}
 	hydration := &activeHydration{
-		cancel:     cancel,
-		filePath:   relativePath,
-		totalBytes: info.FileSize,
+		transferKey: info.TransferKey,
+		cancel:      cancel,
+		filePath:    relativePath,
+		totalBytes:  info.FileSize,
 	}
 	h.mu.Lock()
-	h.activeHydrations[info.TransferKey] = hydration
+	h.activeHydrations[key] = hydration
+	active := len(h.activeHydrations)
 	h.mu.Unlock()
 
 	// Cleanup on exit
 	defer func() {
 		h.mu.Lock()
-		delete(h.activeHydrations, info.TransferKey)
+		delete(h.activeHydrations, key)
 		h.mu.Unlock()
 		cancel()
 	}()
@@ -130,17 +402,6 @@ func (h *HydrationHandler) HandleFetchData(ctx context.Context, info *FetchDataI
 		zap.Int64("size", info.FileSize),
 	)
 
-	// Get reader from data provider
-	reader, err := h.dataProvider.GetFileReader(ctx, relativePath, info.RequiredOffset)
-	if err != nil {
-		h.logger.Error("failed to get file reader",
-			zap.String("file", relativePath),
-			zap.Error(err),
-		)
-		return fmt.Errorf("failed to get file reader: %w", err)
-	}
-	defer reader.Close()
-
 	// Transfer data in chunks
 	offset := info.RequiredOffset
 	remaining := info.RequiredLength
@@ -148,64 +409,72 @@ func (h *HydrationHandler) HandleFetchData(ctx context.Context, info *FetchDataI
 		remaining = info.FileSize - offset
 	}
 
-	buffer := make([]byte, h.chunkSize)
-	transferred := int64(0)
+	// Prefetch the optional window over the same reader when idle
+	if total := h.prefetchLength(info, offset, remaining, active); total > remaining {
+		h.logger.Debug("prefetching optional range",
+			zap.String("file", relativePath),
+			zap.Int64("required", remaining),
+			zap.Int64("prefetch", total-remaining),
+		)
+		remaining = total
+	}
 
-	for remaining > 0 {
-		select {
-		case <-ctx.Done():
-			h.logger.Info("hydration cancelled",
-				zap.String("file", relativePath),
-				zap.Int64("transferred", transferred),
-			)
-			return ctx.Err()
-		default:
-		}
+	// batch hands the next bytes (in file order) to Windows, several
+	// chunks per bridge call, and reports progress at a bounded rate
+	batch := newTransferBatch(h.batch, offset, remaining, info.FileSize,
+		func(buffers [][]byte, at int64, isLast bool, total, completed int64) error {
+			// Mark in-sync with the last batch
+			if err := TransferDataBatch(info.ConnectionKey, info.TransferKey, info.RequestKey, buffers, at, isLast, total, completed); err != nil {
+				h.logger.Error("failed to transfer data",
+					zap.String("file", relativePath),
+					zap.Error(err),
+				)
+				return fmt.Errorf("failed to transfer data: %w", err)
+			}
+			return nil
+		})
+	batch.onFlush = func(transferred int64) {
+		h.mu.Lock()
+		hydration.bytesTransferred = transferred
+		h.mu.Unlock()
+	}
 
-		// Determine chunk size
-		toRead := h.chunkSize
-		if toRead > remaining {
-			toRead = remaining
+	// Serve what the block cache holds, then store what is fetched
+	var err error
+	var sink transferSink = batch
+	if cache := h.blockCache; cache != nil {
+		if key, ok := h.blockCacheKey(relativePath, info.FileSize); ok {
+			var cached int64
+			cached, err = h.serveCachedBlocks(cache, key, offset, remaining, batch)
+			if cached > 0 {
+				h.logger.Debug("served hydration from block cache",
+					zap.String("file", relativePath),
+					zap.Int64("bytes", cached),
+				)
+			}
+			offset += cached
+			remaining -= cached
+			sink = &cachingSink{transferSink: batch, writer: newBlockCacheWriter(cache, key, offset)}
 		}
+	}
 
-		// Read data
-		n, err := io.ReadFull(reader, buffer[:toRead])
-		if err != nil && err != io.EOF && err != io.ErrUnexpectedEOF {
-			h.logger.Error("failed to read data",
-				zap.String("file", relativePath),
-				zap.Error(err),
-			)
-			return fmt.Errorf("failed to read data: %w", err)
-		}
-		if n == 0 {
-			break
+	if err == nil && remaining > 0 {
+		if h.useParallelFetch(remaining) {
+			err = h.fetchParallel(ctx, relativePath, offset, remaining, sink)
+		} else {
+			err = h.fetchSequential(ctx, relativePath, offset, remaining, sink)
 		}
-
-		// Check if this is the last chunk
-		isLastChunk := (remaining - int64(n)) <= 0
-
-		// Transfer to Windows (mark in-sync on last chunk)
-		if err := TransferData(info.ConnectionKey, info.TransferKey, info.RequestKey, buffer[:n], offset, isLastChunk); err != nil {
-			h.logger.Error("failed to transfer data",
+	}
+	transferred := batch.Transferred()
+	if err != nil {
+		if ctx.Err() != nil {
+			h.logger.Info("hydration cancelled",
 				zap.String("file", relativePath),
-				zap.Error(err),
+				zap.Int64("transferred", transferred),
 			)
-			return fmt.Errorf("failed to transfer data: %w", err)
-		}
-
-		offset += int64(n)
-		remaining -= int64(n)
-		transferred += int64(n)
-
-		// Update tracking
-		h.mu.Lock()
-		if active, ok := h.activeHydrations[info.TransferKey]; ok {
-			active.bytesTransferred = transferred
+			return ctx.Err()
 		}
-		h.mu.Unlock()
-
-		// Report progress to Windows (shows in Explorer)
-		h.reportProgress(info.ConnectionKey, info.TransferKey, info.FileSize, offset)
+		return err
 	}
 
 	h.logger.Info("hydration complete",
@@ -247,22 +516,340 @@ func (h *HydrationHandler) HandleFetchData(ctx context.Context, info *FetchDataI
 	return nil
 }
 
-// CancelHydration cancels an active hydration.
+// fetchSequential streams [offset, offset+length) through a single reader,
+// reading ahead of the sink with the chunk pipeline.
+func (h *HydrationHandler) fetchSequential(ctx context.Context, relativePath string, offset, length int64, sink transferSink) error {
+	// Get reader from data provider
+	reader, err := openRemoteRange(ctx, h.dataProvider, relativePath, offset, length)
+	if err != nil {
+		h.logger.Error("failed to get file reader",
+			zap.String("file", relativePath),
+			zap.Error(err),
+		)
+		return fmt.Errorf("failed to get file reader: %w", err)
+	}
+	defer reader.Close()
+
+	// Pipeline: the chunk reader fills up to readAhead buffers from the
+	// remote file while this loop transfers the ones already read. Chunks
+	// queued in a batch are held until it is transferred, so the reader
+	// gets extra buffers for them. Only a share of them come from the
+	// bridge pool, which concurrent hydrations need too.
+	buffers := make([][]byte, h.readAhead+h.batchSegments()-1)
+	share := h.pooledBufferShare()
+	for i := range buffers {
+		buf, release := h.chunkBuffer(i < share)
+		defer release()
+		buffers[i] = buf
+	}
+	chunks := startChunkReader(ctx, reader, length, buffers)
+	defer chunks.Close() // Runs first: stop the reader before buffers are released
+
+	held := make([][]byte, 0, len(buffers))
+	for {
+		chunk, ok := chunks.Next()
+		if err := ctx.Err(); err != nil {
+			return err
+		}
+		if !ok {
+			// Transfer the tail before the buffers are released
+			return sink.Flush()
+		}
+		if chunk.err != nil {
+			h.logger.Error("failed to read data",
+				zap.String("file", relativePath),
+				zap.Error(chunk.err),
+			)
+			return fmt.Errorf("failed to read data: %w", chunk.err)
+		}
+
+		if err := sink.Deliver(chunk.data); err != nil {
+			return err
+		}
+		held = append(held, chunk.buf)
+		if sink.Pending() == 0 {
+			for _, buf := range held {
+				chunks.Recycle(buf)
+			}
+			held = held[:0]
+		}
+	}
+}
+
+// useParallelFetch reports whether a hydration of length bytes is split into ranges.
+func (h *HydrationHandler) useParallelFetch(length int64) bool {
+	p := h.parallel
+	return p.Ranges > 1 && p.RangeSize > 0 && length >= p.Threshold && length > p.RangeSize
+}
+
+// rangeResult is one range fetched by fetchParallel.
+type rangeResult struct {
+	buf  []byte // Whole range buffer, reused for a later range
+	data []byte // Bytes read into buf
+	err  error
+}
+
+// fetchParallel splits [offset, offset+length) into ranges that up to
+// parallel.Ranges goroutines fetch, each over its own reader, and delivers
+// them in offset order in chunkSize pieces. Only parallel.Ranges range
+// buffers exist, so a slow early range holds back the later ones instead
+// of letting memory grow.
+func (h *HydrationHandler) fetchParallel(ctx context.Context, relativePath string, offset, length int64, sink transferSink) error {
+	ctx, cancel := context.WithCancel(ctx)
+
+	rangeSize := h.parallel.RangeSize
+	count := int((length + rangeSize - 1) / rangeSize)
+	workers := h.parallel.Ranges
+	if workers > count {
+		workers = count
+	}
+
+	h.logger.Debug("parallel hydration",
+		zap.String("file", relativePath),
+		zap.Int("ranges", count),
+		zap.Int("parallel", workers),
+	)
+
+	free := make(chan []byte, workers)
+	for i := 0; i < workers; i++ {
+		free <- make([]byte, rangeSize)
+	}
+	results := make([]chan rangeResult, count)
+	for i := range results {
+		results[i] = make(chan rangeResult, 1)
+	}
+
+	var wg sync.WaitGroup
+	defer func() {
+		cancel()
+		wg.Wait()
+	}()
+
+	// Dispatcher: start the next range whenever a range buffer frees up
+	wg.Add(1)
+	go func() {
+		defer wg.Done()
+		for i := 0; i < count; i++ {
+			var buf []byte
+			select {
+			case <-ctx.Done():
+				return
+			case buf = <-free:
+			}
+
+			start := offset + int64(i)*rangeSize
+			size := rangeSize
+			if end := offset + length; start+size > end {
+				size = end - start
+			}
+
+			wg.Add(1)
+			go func(i int, start int64, buf []byte) {
+				defer wg.Done()
+				data, err := h.fetchRange(ctx, relativePath, start, buf)
+				results[i] <- rangeResult{buf: buf[:cap(buf)], data: data, err: err}
+			}(i, start, buf[:size])
+		}
+	}()
+
+	for i := 0; i < count; i++ {
+		var r rangeResult
+		select {
+		case <-ctx.Done():
+			return ctx.Err()
+		case r = <-results[i]:
+		}
+		if r.err != nil {
+			h.logger.Error("failed to read data",
+				zap.String("file", relativePath),
+				zap.Int("range", i),
+				zap.Error(r.err),
+			)
+			return fmt.Errorf("failed to read data: %w", r.err)
+		}
+
+		for data := r.data; len(data) > 0; {
+			n := int64(len(data))
+			if n > h.chunkSize {
+				n = h.chunkSize
+			}
+			if err := sink.Deliver(data[:n]); err != nil {
+				return err
+			}
+			data = data[n:]
+		}
+		// Transfer the range before its buffer is reused
+		if err := sink.Flush(); err != nil {
+			return err
+		}
+
+		// A short range means the remote file ended early
+		if int64(len(r.data)) < rangeSize && i < count-1 {
+			return nil
+		}
+		free <- r.buf
+	}
+
+	return nil
+}
+
+// fetchRange reads len(buf) bytes at offset over a dedicated reader.
+// Returns the bytes read; a remote file that ends early is not an error.
+func (h *HydrationHandler) fetchRange(ctx context.Context, relativePath string, offset int64, buf []byte) ([]byte, error) {
+	reader, err := openRemoteRange(ctx, h.dataProvider, relativePath, offset, int64(len(buf)))
+	if err != nil {
+		return nil, fmt.Errorf("failed to get file reader: %w", err)
+	}
+	defer reader.Close()
+
+	n, err := io.ReadFull(reader, buf)
+	if err == io.EOF || err == io.ErrUnexpectedEOF {
+		err = nil
+	}
+	return buf[:n], err
+}
+
+// hydrationChunk is one chunk produced by the read stage of the pipeline.
+type hydrationChunk struct {
+	buf  []byte // Whole buffer, handed back with Recycle
+	data []byte // Bytes read into buf
+	err  error
+}
+
+// chunkReader is the read stage of the hydration pipeline. It reads up to
+// remaining bytes, in order, into whichever of its buffers are free, so the
+// remote read of chunk N+1 overlaps the transfer of chunk N.
+type chunkReader struct {
+	chunks chan hydrationChunk
+	free   chan []byte
+	stop   context.CancelFunc
+	done   chan struct{}
+}
+
+// startChunkReader starts reading from r into buffers. All buffers must
+// have the same length, which is the chunk size.
+func startChunkReader(ctx context.Context, r io.Reader, remaining int64, buffers [][]byte) *chunkReader {
+	ctx, stop := context.WithCancel(ctx)
+	c := &chunkReader{
+		chunks: make(chan hydrationChunk, len(buffers)),
+		free:   make(chan []byte, len(buffers)),
+		stop:   stop,
+		done:   make(chan struct{}),
+	}
+	for _, buf := range buffers {
+		c.free <- buf
+	}
+
+	go func() {
+		defer close(c.done)
+		defer close(c.chunks)
+
+		for remaining > 0 {
+			var buf []byte
+			select {
+			case <-ctx.Done():
+				return
+			case buf = <-c.free:
+			}
+
+			toRead := int64(len(buf))
+			if toRead > remaining {
+				toRead = remaining
+			}
+
+			n, err := io.ReadFull(r, buf[:toRead])
+			eof := err == io.EOF || err == io.ErrUnexpectedEOF
+			if eof {
+				err = nil
+			}
+			if n == 0 && err == nil {
+				return
+			}
+
+			select {
+			case c.chunks <- hydrationChunk{buf: buf, data: buf[:n], err: err}:
+			case <-ctx.Done():
+				return
+			}
+			if err != nil || eof {
+				return
+			}
+			remaining -= int64(n)
+		}
+	}()
+
+	return c
+}
+
+// Next returns the next chunk in file order; ok is false once the reader
+// has stopped (end of data, read error already delivered, or cancellation).
+func (c *chunkReader) Next() (hydrationChunk, bool) {
+	chunk, ok := <-c.chunks
+	return chunk, ok
+}
+
+// Recycle hands a chunk's buffer back to the reader once it has been transferred.
+func (c *chunkReader) Recycle(buf []byte) {
+	c.free <- buf // Never blocks: free holds every buffer at most once
+}
+
+// Close stops the reader and waits until it no longer touches any buffer.
+func (c *chunkReader) Close() {
+	c.stop()
+	<-c.done
+}
+
+// chunkBuffer returns the buffer one hydration streams through.
+// With pooled, a bridge-owned transfer buffer is preferred: the data
+// provider reads into it and CfExecute consumes the same memory. It falls
+// back to a Go buffer when the pool is busy or chunkSize is larger than a
+// pool buffer.
+func (h *HydrationHandler) chunkBuffer(pooled bool) ([]byte, func()) {
+	if !pooled {
+		return make([]byte, h.chunkSize), func() {}
+	}
+	if buf, release, ok := acquireTransferBuffer(); ok {
+		if int64(len(buf)) >= h.chunkSize {
+			return buf[:h.chunkSize], release
+		}
+		release()
+	}
+	return make([]byte, h.chunkSize), func() {}
+}
+
+// pooledBufferShare returns how many bridge-owned buffers one hydration may
+// take: the pool split between the hydrations the bridge workers run at
+// once, so a sequential fetch holding a whole pipeline does not leave the
+// others with Go buffers only.
+func (h *HydrationHandler) pooledBufferShare() int {
+	workers := DefaultBridgeWorkers
+	if h.syncRoot != nil && h.syncRoot.bridgeWorkers > 0 {
+		workers = h.syncRoot.bridgeWorkers
+	}
+	share := GetTransferBufferCount() / workers
+	if share < 1 {
+		share = 1
+	}
+	return share
+}
+
+// CancelHydration cancels the active hydrations of a transfer.
 func (h *HydrationHandler) CancelHydration(transferKey CF_TRANSFER_KEY) {
 	h.mu.RLock()
-	active, ok := h.activeHydrations[transferKey]
-	h.mu.RUnlock()
+	defer h.mu.RUnlock()
 
-	if ok && active != nil {
-		h.logger.Info("cancelling hydration",
-			zap.String("file", active.filePath),
-			zap.Int64("transferred", active.bytesTransferred),
-		)
-		active.cancel()
+	for _, active := range h.activeHydrations {
+		if active.transferKey == transferKey {
+			h.logger.Info("cancelling hydration",
+				zap.String("file", active.filePath),
+				zap.Int64("transferred", active.bytesTransferred),
+			)
+			active.cancel()
+		}
 	}
 }
 
-// CancelHydrationByPath cancels an active hydration by file path.
+// CancelHydrationByPath cancels the active hydrations of a file path.
 func (h *HydrationHandler) CancelHydrationByPath(filePath string) {
 	h.mu.RLock()
 	defer h.mu.RUnlock()
@@ -273,7 +860,6 @@ func (h *HydrationHandler) CancelHydrationByPath(filePath string) {
 				zap.String("file", filePath),
 			)
 			active.cancel()
-			return
 		}
 	}
 }
@@ -301,12 +887,6 @@ type HydrationStatus struct {
 	BytesTransferred int64
 }
 
-// reportProgress reports hydration progress to Windows.
-func (h *HydrationHandler) reportProgress(connectionKey CF_CONNECTION_KEY, transferKey CF_TRANSFER_KEY, total, completed int64) {
-	// Use ReportProviderProgress if available
-	_ = ReportProviderProgress(connectionKey, transferKey, total, completed)
-}
-
 // HydrateFile manually hydrates a placeholder file (downloads content).
 func (h *HydrationHandler) HydrateFile(ctx context.Context, relativePath string) error {
 	fullPath := h.syncRoot.Path() + "\\" + relativePath
@@ -395,3 +975,40 @@ func (h *HydrationHandler) SetPinned(relativePath string, pinned bool) error {
 
 	return SetPinState(handle, pinState, 0)
 }
+
+// syncRootRelativePath converts a NormalizedPath from a callback to a path
+// relative to the sync root, with forward slashes ("" for the root itself).
+// NormalizedPath format: \<path_from_volume_root>\<relative_path>
+// e.g., for sync root D:\Anemone\backup:
+//
+//	\Anemone\backup\subdir\file.txt -> subdir/file.txt
+//
+// e.g., for sync root D:\test_anemone:
+//
+//	\test_anemone\subdir\file.txt -> subdir/file.txt
+func syncRootRelativePath(syncRootPath, normalizedPath string) string {
+	// Strip leading backslash
+	relativePath := strings.TrimPrefix(normalizedPath, "\\")
+	relativePath = strings.TrimPrefix(relativePath, "/")
+
+	// Strip the sync root path (from volume root) from the beginning
+	// For D:\Anemone\backup, we need to strip "Anemone\backup\" (not just "backup\")
+	volName := filepath.VolumeName(syncRootPath)
+	syncRootRelative := strings.TrimPrefix(syncRootPath, volName)
+	syncRootRelative = strings.TrimPrefix(syncRootRelative, "\\")
+	syncRootRelative = strings.TrimPrefix(syncRootRelative, "/")
+
+	if syncRootRelative != "" {
+		if relativePath == syncRootRelative {
+			return ""
+		}
+		if strings.HasPrefix(relativePath, syncRootRelative+"\\") {
+			relativePath = relativePath[len(syncRootRelative)+1:]
+		} else if strings.HasPrefix(relativePath, syncRootRelative+"/") {
+			relativePath = relativePath[len(syncRootRelative)+1:]
+		}
+	}
+
+	// Normalize to forward slashes
+	return strings.ReplaceAll(relativePath, "\\", "/")
+}
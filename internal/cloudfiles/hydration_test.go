@@ -8,6 +8,7 @@ import (
 	"context"
 	"io"
 	"sync"
+	"sync/atomic"
 	"testing"
 	"time"
 )
@@ -93,6 +94,36 @@ func (r *delayedReader) Close() error {
 	return nil
 }
 
+// rangeDataProvider adds positional reads to mockDataProvider and counts
+// how data was opened.
+type rangeDataProvider struct {
+	*mockDataProvider
+	streamOpens int32
+	rangeOpens  int32
+}
+
+func (m *rangeDataProvider) GetFileReader(ctx context.Context, relativePath string, offset int64) (io.ReadCloser, error) {
+	atomic.AddInt32(&m.streamOpens, 1)
+	return m.mockDataProvider.GetFileReader(ctx, relativePath, offset)
+}
+
+func (m *rangeDataProvider) GetFileReaderAt(ctx context.Context, relativePath string) (RemoteFile, error) {
+	m.mu.RLock()
+	content, ok := m.files[relativePath]
+	m.mu.RUnlock()
+	if !ok {
+		return nil, io.EOF
+	}
+	atomic.AddInt32(&m.rangeOpens, 1)
+	return nopReaderAtCloser{bytes.NewReader(content)}, nil
+}
+
+type nopReaderAtCloser struct {
+	*bytes.Reader
+}
+
+func (nopReaderAtCloser) Close() error { return nil }
+
 func TestNewHydrationHandler(t *testing.T) {
 	provider := newMockDataProvider()
 
@@ -242,3 +273,430 @@ func TestActiveHydrationTracking(t *testing.T) {
 		t.Errorf("Expected 0 active hydrations after cancel, got %d", len(active))
 	}
 }
+
+func TestActiveHydrationTrackingSameTransfer(t *testing.T) {
+	provider := newMockDataProvider()
+	provider.AddFile("test.txt", make([]byte, 1024*1024*4))
+	provider.SetReadDelay(100 * time.Millisecond)
+
+	config := SyncRootConfig{
+		Path:         t.TempDir(),
+		ProviderName: "TestProvider",
+	}
+	syncRoot, _ := NewSyncRootManager(config)
+	handler := NewHydrationHandler(syncRoot, provider, nil)
+	handler.SetChunkSize(64 * 1024)
+
+	// Windows fetches two ranges of the same open file at once
+	var wg sync.WaitGroup
+	for i := int64(0); i < 2; i++ {
+		wg.Add(1)
+		go func(offset int64) {
+			defer wg.Done()
+			info := &FetchDataInfo{
+				ConnectionKey:  1,
+				TransferKey:    100,
+				RequestKey:     offset + 1,
+				FilePath:       syncRoot.Path() + "\\test.txt",
+				FileSize:       4 * 1024 * 1024,
+				RequiredOffset: offset,
+				RequiredLength: 2 * 1024 * 1024,
+			}
+			_ = handler.HandleFetchData(context.Background(), info)
+		}(i * 2 * 1024 * 1024)
+	}
+
+	time.Sleep(50 * time.Millisecond)
+	if active := handler.GetActiveHydrations(); len(active) != 2 {
+		t.Errorf("Expected both fetches to be tracked, got %d", len(active))
+	}
+
+	// Cancelling the transfer reaches both
+	handler.CancelHydration(CF_TRANSFER_KEY(100))
+	wg.Wait()
+	if active := handler.GetActiveHydrations(); len(active) != 0 {
+		t.Errorf("Expected 0 active hydrations after cancel, got %d", len(active))
+	}
+}
+
+func TestHydrationHandlerSetReadAhead(t *testing.T) {
+	provider := newMockDataProvider()
+	config := SyncRootConfig{
+		Path:         t.TempDir(),
+		ProviderName: "TestProvider",
+	}
+	syncRoot, _ := NewSyncRootManager(config)
+	handler := NewHydrationHandler(syncRoot, provider, nil)
+
+	if handler.readAhead != DefaultHydrationReadAhead {
+		t.Errorf("Expected default read-ahead %d, got %d", DefaultHydrationReadAhead, handler.readAhead)
+	}
+
+	handler.SetReadAhead(4)
+	if handler.readAhead != 4 {
+		t.Errorf("Expected read-ahead 4, got %d", handler.readAhead)
+	}
+
+	// Invalid depth should be ignored
+	handler.SetReadAhead(0)
+	if handler.readAhead != 4 {
+		t.Error("Read-ahead should not change for invalid value")
+	}
+}
+
+func TestChunkReaderOrder(t *testing.T) {
+	content := make([]byte, 10*1024+123)
+	for i := range content {
+		content[i] = byte(i % 251)
+	}
+
+	buffers := [][]byte{make([]byte, 1024), make([]byte, 1024), make([]byte, 1024)}
+	chunks := startChunkReader(context.Background(), bytes.NewReader(content), int64(len(content)), buffers)
+	defer chunks.Close()
+
+	var got []byte
+	for {
+		chunk, ok := chunks.Next()
+		if !ok {
+			break
+		}
+		if chunk.err != nil {
+			t.Fatalf("Unexpected read error: %v", chunk.err)
+		}
+		got = append(got, chunk.data...)
+		chunks.Recycle(chunk.buf)
+	}
+
+	if !bytes.Equal(got, content) {
+		t.Errorf("Pipelined data mismatch: got %d bytes, want %d", len(got), len(content))
+	}
+}
+
+func TestChunkReaderStopsAtRemaining(t *testing.T) {
+	content := make([]byte, 4096)
+	buffers := [][]byte{make([]byte, 1000), make([]byte, 1000)}
+	chunks := startChunkReader(context.Background(), bytes.NewReader(content), 2500, buffers)
+	defer chunks.Close()
+
+	total := 0
+	for {
+		chunk, ok := chunks.Next()
+		if !ok {
+			break
+		}
+		total += len(chunk.data)
+		chunks.Recycle(chunk.buf)
+	}
+
+	if total != 2500 {
+		t.Errorf("Expected 2500 bytes, got %d", total)
+	}
+}
+
+func TestChunkReaderCancel(t *testing.T) {
+	ctx, cancel := context.WithCancel(context.Background())
+	buffers := [][]byte{make([]byte, 1024), make([]byte, 1024)}
+	chunks := startChunkReader(ctx, bytes.NewReader(make([]byte, 1024*1024)), 1024*1024, buffers)
+
+	// Take one chunk without recycling, then cancel: the reader must stop
+	// even though it never gets its buffers back
+	if _, ok := chunks.Next(); !ok {
+		t.Fatal("Expected at least one chunk")
+	}
+	cancel()
+
+	done := make(chan struct{})
+	go func() {
+		chunks.Close()
+		close(done)
+	}()
+
+	select {
+	case <-done:
+	case <-time.After(2 * time.Second):
+		t.Fatal("chunkReader did not stop after cancellation")
+	}
+}
+
+func TestHydrationHandlerSetParallelFetch(t *testing.T) {
+	provider := newMockDataProvider()
+	config := SyncRootConfig{
+		Path:         t.TempDir(),
+		ProviderName: "TestProvider",
+	}
+	syncRoot, _ := NewSyncRootManager(config)
+	handler := NewHydrationHandler(syncRoot, provider, nil)
+
+	// Disabled by default
+	if handler.useParallelFetch(1024 * 1024 * 1024) {
+		t.Error("Parallel fetch should be disabled by default")
+	}
+
+	handler.SetParallelFetch(ParallelFetchConfig{Ranges: 4})
+	if handler.parallel.RangeSize != DefaultParallelRangeSize {
+		t.Errorf("Expected default range size, got %d", handler.parallel.RangeSize)
+	}
+	if handler.parallel.Threshold != DefaultParallelThreshold {
+		t.Errorf("Expected default threshold, got %d", handler.parallel.Threshold)
+	}
+
+	if handler.useParallelFetch(DefaultParallelThreshold - 1) {
+		t.Error("Hydrations below the threshold should stay sequential")
+	}
+	if !handler.useParallelFetch(DefaultParallelThreshold) {
+		t.Error("Hydrations at the threshold should be split")
+	}
+}
+
+func TestFetchParallelOrder(t *testing.T) {
+	content := make([]byte, 100*1024+77)
+	for i := range content {
+		content[i] = byte(i % 253)
+	}
+
+	provider := newMockDataProvider()
+	provider.AddFile("big.bin", content)
+
+	config := SyncRootConfig{
+		Path:         t.TempDir(),
+		ProviderName: "TestProvider",
+	}
+	syncRoot, _ := NewSyncRootManager(config)
+	handler := NewHydrationHandler(syncRoot, provider, nil)
+	handler.SetChunkSize(4 * 1024)
+	handler.SetParallelFetch(ParallelFetchConfig{Ranges: 3, RangeSize: 16 * 1024, Threshold: 1})
+
+	const start = 1000
+	var got []byte
+	err := handler.fetchParallel(context.Background(), "big.bin", start, int64(len(content)-start), deliverFunc(func(data []byte) error {
+		if int64(len(data)) > handler.chunkSize {
+			t.Errorf("Delivered %d bytes, larger than chunk size", len(data))
+		}
+		got = append(got, data...)
+		return nil
+	}))
+	if err != nil {
+		t.Fatalf("fetchParallel failed: %v", err)
+	}
+
+	if !bytes.Equal(got, content[start:]) {
+		t.Errorf("Parallel data mismatch: got %d bytes, want %d", len(got), len(content)-start)
+	}
+}
+
+func TestFetchParallelShortFile(t *testing.T) {
+	provider := newMockDataProvider()
+	provider.AddFile("short.bin", make([]byte, 20*1024))
+
+	config := SyncRootConfig{
+		Path:         t.TempDir(),
+		ProviderName: "TestProvider",
+	}
+	syncRoot, _ := NewSyncRootManager(config)
+	handler := NewHydrationHandler(syncRoot, provider, nil)
+	handler.SetParallelFetch(ParallelFetchConfig{Ranges: 2, RangeSize: 8 * 1024, Threshold: 1})
+
+	// Ask for more than the remote file holds
+	total := 0
+	err := handler.fetchParallel(context.Background(), "short.bin", 0, 64*1024, deliverFunc(func(data []byte) error {
+		total += len(data)
+		return nil
+	}))
+	if err != nil {
+		t.Fatalf("fetchParallel failed: %v", err)
+	}
+	if total != 20*1024 {
+		t.Errorf("Expected 20KB delivered, got %d", total)
+	}
+}
+
+func TestOpenRemoteRangeUsesReadAt(t *testing.T) {
+	content := []byte("0123456789abcdefghij")
+	provider := &rangeDataProvider{mockDataProvider: newMockDataProvider()}
+	provider.AddFile("file.txt", content)
+
+	reader, err := openRemoteRange(context.Background(), provider, "file.txt", 5, 8)
+	if err != nil {
+		t.Fatalf("openRemoteRange failed: %v", err)
+	}
+	defer reader.Close()
+
+	got, err := io.ReadAll(reader)
+	if err != nil {
+		t.Fatalf("ReadAll failed: %v", err)
+	}
+	if string(got) != "56789abc" {
+		t.Errorf("Expected range \"56789abc\", got %q", got)
+	}
+	if provider.rangeOpens != 1 || provider.streamOpens != 0 {
+		t.Errorf("Expected 1 range open and 0 stream opens, got %d and %d", provider.rangeOpens, provider.streamOpens)
+	}
+}
+
+func TestOpenRemoteRangeFallback(t *testing.T) {
+	provider := newMockDataProvider()
+	provider.AddFile("file.txt", []byte("0123456789"))
+
+	// dataSourceAdapter over a source without positional reads falls back
+	adapter := &dataSourceAdapter{source: &streamOnlySource{provider}}
+	reader, err := openRemoteRange(context.Background(), adapter, "file.txt", 4, 3)
+	if err != nil {
+		t.Fatalf("openRemoteRange failed: %v", err)
+	}
+	defer reader.Close()
+
+	got := make([]byte, 3)
+	if _, err := io.ReadFull(reader, got); err != nil {
+		t.Fatalf("ReadFull failed: %v", err)
+	}
+	if string(got) != "456" {
+		t.Errorf("Expected \"456\", got %q", got)
+	}
+}
+
+// blockingProvider serves readers whose reads block until they are closed,
+// like a network read stalled on the server.
+type blockingProvider struct {
+	*mockDataProvider
+}
+
+func (p *blockingProvider) GetFileReader(ctx context.Context, relativePath string, offset int64) (io.ReadCloser, error) {
+	return &blockingReader{closed: make(chan struct{})}, nil
+}
+
+type blockingReader struct {
+	once   sync.Once
+	closed chan struct{}
+}
+
+func (r *blockingReader) Read(p []byte) (int, error) {
+	<-r.closed
+	return 0, io.ErrClosedPipe
+}
+
+func (r *blockingReader) Close() error {
+	r.once.Do(func() { close(r.closed) })
+	return nil
+}
+
+func TestOpenRemoteRangeAbortsOnCancel(t *testing.T) {
+	ctx, cancel := context.WithCancel(context.Background())
+	reader, err := openRemoteRange(ctx, &blockingProvider{newMockDataProvider()}, "file.bin", 0, 1024)
+	if err != nil {
+		t.Fatalf("openRemoteRange failed: %v", err)
+	}
+	defer reader.Close()
+
+	done := make(chan error, 1)
+	go func() {
+		_, err := reader.Read(make([]byte, 1024))
+		done <- err
+	}()
+
+	cancel()
+	select {
+	case err := <-done:
+		if err == nil {
+			t.Error("Expected the aborted read to fail")
+		}
+	case <-time.After(5 * time.Second):
+		t.Fatal("Read still blocked after cancellation")
+	}
+}
+
+// streamOnlySource is a DataSource without GetFileReaderAt.
+type streamOnlySource struct {
+	provider *mockDataProvider
+}
+
+func (s *streamOnlySource) GetFileReader(ctx context.Context, remotePath string, offset int64) (io.ReadCloser, error) {
+	return s.provider.GetFileReader(ctx, remotePath, offset)
+}
+
+func (s *streamOnlySource) ListFiles(ctx context.Context) ([]RemoteFileInfo, error) {
+	return nil, nil
+}
+
+func TestFetchParallelReadAt(t *testing.T) {
+	content := make([]byte, 64*1024+13)
+	for i := range content {
+		content[i] = byte(i % 251)
+	}
+
+	provider := &rangeDataProvider{mockDataProvider: newMockDataProvider()}
+	provider.AddFile("big.bin", content)
+
+	config := SyncRootConfig{
+		Path:         t.TempDir(),
+		ProviderName: "TestProvider",
+	}
+	syncRoot, _ := NewSyncRootManager(config)
+	handler := NewHydrationHandler(syncRoot, provider, nil)
+	handler.SetChunkSize(4 * 1024)
+	handler.SetParallelFetch(ParallelFetchConfig{Ranges: 4, RangeSize: 8 * 1024, Threshold: 1})
+
+	var got []byte
+	err := handler.fetchParallel(context.Background(), "big.bin", 0, int64(len(content)), deliverFunc(func(data []byte) error {
+		got = append(got, data...)
+		return nil
+	}))
+	if err != nil {
+		t.Fatalf("fetchParallel failed: %v", err)
+	}
+	if !bytes.Equal(got, content) {
+		t.Errorf("Parallel data mismatch: got %d bytes, want %d", len(got), len(content))
+	}
+	if atomic.LoadInt32(&provider.streamOpens) != 0 {
+		t.Errorf("Expected no streaming opens, got %d", provider.streamOpens)
+	}
+}
+
+func TestHydrationHandlerPrefetchLength(t *testing.T) {
+	config := SyncRootConfig{
+		Path:         t.TempDir(),
+		ProviderName: "TestProvider",
+	}
+	syncRoot, _ := NewSyncRootManager(config)
+	handler := NewHydrationHandler(syncRoot, newMockDataProvider(), nil)
+
+	info := &FetchDataInfo{
+		FileSize:       1024 * 1024,
+		RequiredOffset: 0,
+		RequiredLength: 64 * 1024,
+		OptionalOffset: 0,
+		OptionalLength: 512 * 1024,
+	}
+
+	// Disabled by default
+	if got := handler.prefetchLength(info, 0, info.RequiredLength, 1); got != info.RequiredLength {
+		t.Errorf("Expected no prefetch when disabled, got %d", got)
+	}
+
+	handler.SetPrefetchPolicy(PrefetchPolicy{Enabled: true, MaxBytes: 100 * 1024})
+	if handler.prefetch.MaxActive != DefaultPrefetchMaxActive {
+		t.Errorf("Expected default MaxActive, got %d", handler.prefetch.MaxActive)
+	}
+
+	// Capped by MaxBytes and rounded down to the transfer alignment
+	if got := handler.prefetchLength(info, 0, info.RequiredLength, 1); got != 164*1024-(164*1024)%4096 {
+		t.Errorf("Expected capped prefetch, got %d", got)
+	}
+
+	// Busy link: required range only
+	if got := handler.prefetchLength(info, 0, info.RequiredLength, 2); got != info.RequiredLength {
+		t.Errorf("Expected no prefetch while busy, got %d", got)
+	}
+
+	// Window reaching EOF is transferred to the exact file size
+	handler.SetPrefetchPolicy(PrefetchPolicy{Enabled: true})
+	info.FileSize = 300*1024 + 5
+	if got := handler.prefetchLength(info, 0, info.RequiredLength, 1); got != info.FileSize {
+		t.Errorf("Expected prefetch to EOF (%d), got %d", info.FileSize, got)
+	}
+
+	// Detached window is ignored
+	info.OptionalOffset = 128 * 1024
+	if got := handler.prefetchLength(info, 0, info.RequiredLength, 1); got != info.RequiredLength {
+		t.Errorf("Expected no prefetch for detached window, got %d", got)
+	}
+}
@@ -0,0 +1,406 @@
+//go:build windows
+// +build windows
+
+package cloudfiles
+
+import (
+	"bufio"
+	"bytes"
+	"encoding/binary"
+	"encoding/hex"
+	"errors"
+	"fmt"
+	"io"
+	"os"
+	"path/filepath"
+	"sort"
+)
+
+// ManifestIndex is a read-only, sorted view of a manifest in a compact binary
+// form, usually memory-mapped from a file written by WriteManifestIndex.
+// Entries are decoded on access, so a large manifest is not held on the heap.
+//
+// Layout (little endian):
+//
+//	header:   magic "AMNX", version u32, count u32, restart count u32, restarts offset u64
+//	entries:  sorted by path; each is uvarint shared prefix length with the
+//	          previous path, uvarint suffix length, suffix, uvarint size,
+//	          varint mtime, hash (see appendManifestHash)
+//	restarts: u64 offset of every manifestRestartInterval-th entry, whose
+//	          path is stored in full, for binary search
+type ManifestIndex struct {
+	data     []byte
+	count    int
+	restarts []byte // restart count x u64, inside data
+	unmap    func() error
+}
+
+const (
+	manifestIndexMagic   = "AMNX"
+	manifestIndexVersion = 1
+	manifestHeaderSize   = 24
+
+	// Entries per restart point: a lookup decodes at most this many paths
+	manifestRestartInterval = 16
+)
+
+// Hash encodings: SHA256 hex hashes (the manifest's usual form) take 32 bytes
+const (
+	manifestHashNone      = 0 // No hash
+	manifestHashSHA256    = 1 // "sha256:" + 64 hex digits, stored as 32 bytes
+	manifestHashHex256    = 2 // 64 hex digits, stored as 32 bytes
+	manifestHashRawOffset = 3 // Other: tag is 3 + length, raw bytes follow
+)
+
+// errManifestIndexCorrupt is returned for index data that cannot be decoded.
+var errManifestIndexCorrupt = errors.New("corrupt manifest index")
+
+// EncodeManifestIndex encodes manifest entries into the ManifestIndex format.
+// The entries are sorted by path (files is left untouched); for duplicate
+// paths the last entry wins.
+func EncodeManifestIndex(files []ManifestFileEntry) []byte {
+	var buf bytes.Buffer
+	header, _ := encodeManifestIndex(&buf, files) // bytes.Buffer does not fail
+	data := buf.Bytes()
+	copy(data, header)
+	return data
+}
+
+// WriteManifestIndex encodes manifest entries into a new file at path,
+// streaming the entries instead of building the index in memory. Callers
+// pick a path per index: a mapped index cannot be replaced on Windows.
+func WriteManifestIndex(path string, files []ManifestFileEntry) error {
+	if err := os.MkdirAll(filepath.Dir(path), 0700); err != nil {
+		return fmt.Errorf("failed to create manifest index directory: %w", err)
+	}
+
+	file, err := os.OpenFile(path, os.O_RDWR|os.O_CREATE|os.O_EXCL, 0600)
+	if err != nil {
+		return fmt.Errorf("failed to create manifest index: %w", err)
+	}
+
+	w := bufio.NewWriterSize(file, 256*1024)
+	header, err := encodeManifestIndex(w, files)
+	if err == nil {
+		err = w.Flush()
+	}
+	if err == nil {
+		_, err = file.WriteAt(header, 0) // Written last: a torn file has no valid header
+	}
+	if closeErr := file.Close(); err == nil {
+		err = closeErr
+	}
+	if err != nil {
+		os.Remove(path)
+		return fmt.Errorf("failed to write manifest index: %w", err)
+	}
+	return nil
+}
+
+// encodeManifestIndex writes the index to w, starting with a zeroed header,
+// and returns the header to write over it.
+func encodeManifestIndex(w io.Writer, files []ManifestFileEntry) ([]byte, error) {
+	// Sort positions rather than a copy of the entries
+	order := make([]int, len(files))
+	for i := range order {
+		order[i] = i
+	}
+	sort.SliceStable(order, func(i, j int) bool { return files[order[i]].Path < files[order[j]].Path })
+
+	// Drop duplicates, keeping the last one
+	unique := order[:0]
+	for i, pos := range order {
+		if i+1 < len(order) && files[order[i+1]].Path == files[pos].Path {
+			continue
+		}
+		unique = append(unique, pos)
+	}
+
+	header := make([]byte, manifestHeaderSize)
+	if _, err := w.Write(header); err != nil {
+		return nil, err
+	}
+
+	offset := uint64(manifestHeaderSize)
+	var restarts []uint64
+	var entry []byte
+	previous := ""
+	for i, pos := range unique {
+		f := files[pos]
+		shared := 0
+		if i%manifestRestartInterval == 0 {
+			restarts = append(restarts, offset)
+		} else {
+			shared = sharedPrefixLen(previous, f.Path)
+		}
+		entry = binary.AppendUvarint(entry[:0], uint64(shared))
+		entry = binary.AppendUvarint(entry, uint64(len(f.Path)-shared))
+		entry = append(entry, f.Path[shared:]...)
+		entry = binary.AppendUvarint(entry, uint64(f.Size))
+		entry = binary.AppendVarint(entry, f.MTime)
+		entry = appendManifestHash(entry, f.Hash)
+		if _, err := w.Write(entry); err != nil {
+			return nil, err
+		}
+		offset += uint64(len(entry))
+		previous = f.Path
+	}
+
+	table := make([]byte, 0, len(restarts)*8)
+	for _, restart := range restarts {
+		table = binary.LittleEndian.AppendUint64(table, restart)
+	}
+	if _, err := w.Write(table); err != nil {
+		return nil, err
+	}
+
+	copy(header, manifestIndexMagic)
+	binary.LittleEndian.PutUint32(header[4:], manifestIndexVersion)
+	binary.LittleEndian.PutUint32(header[8:], uint32(len(unique)))
+	binary.LittleEndian.PutUint32(header[12:], uint32(len(restarts)))
+	binary.LittleEndian.PutUint64(header[16:], offset)
+	return header, nil
+}
+
+// OpenManifestIndex memory-maps a manifest index written by WriteManifestIndex.
+// The index must be closed to unmap it.
+func OpenManifestIndex(path string) (*ManifestIndex, error) {
+	data, unmap, err := mapManifestFile(path)
+	if err != nil {
+		return nil, fmt.Errorf("failed to map manifest index: %w", err)
+	}
+
+	index, err := NewManifestIndex(data)
+	if err != nil {
+		unmap()
+		return nil, err
+	}
+	index.unmap = unmap
+	return index, nil
+}
+
+// NewManifestIndex reads an index from data produced by EncodeManifestIndex.
+// data must not be modified while the index is in use.
+func NewManifestIndex(data []byte) (*ManifestIndex, error) {
+	if len(data) < manifestHeaderSize || string(data[:4]) != manifestIndexMagic {
+		return nil, fmt.Errorf("%w: bad header", errManifestIndexCorrupt)
+	}
+	if version := binary.LittleEndian.Uint32(data[4:]); version != manifestIndexVersion {
+		return nil, fmt.Errorf("unsupported manifest index version %d", version)
+	}
+
+	count := int(binary.LittleEndian.Uint32(data[8:]))
+	restartCount := uint64(binary.LittleEndian.Uint32(data[12:]))
+	restartsOffset := binary.LittleEndian.Uint64(data[16:])
+	if restartsOffset < manifestHeaderSize || restartsOffset+restartCount*8 != uint64(len(data)) ||
+		restartCount != uint64((count+manifestRestartInterval-1)/manifestRestartInterval) {
+		return nil, fmt.Errorf("%w: bad restart table", errManifestIndexCorrupt)
+	}
+	for i := uint64(0); i < restartCount; i++ {
+		offset := binary.LittleEndian.Uint64(data[restartsOffset+i*8:])
+		if offset < manifestHeaderSize || offset >= restartsOffset {
+			return nil, fmt.Errorf("%w: bad restart offset", errManifestIndexCorrupt)
+		}
+	}
+
+	return &ManifestIndex{
+		data:     data[:restartsOffset],
+		count:    count,
+		restarts: data[restartsOffset:],
+	}, nil
+}
+
+// Close unmaps the index file. The index must not be used afterwards.
+func (x *ManifestIndex) Close() error {
+	if x.unmap == nil {
+		return nil
+	}
+	unmap := x.unmap
+	x.unmap = nil
+	x.data, x.restarts, x.count = nil, nil, 0
+	return unmap()
+}
+
+// Len returns the number of entries.
+func (x *ManifestIndex) Len() int {
+	return x.count
+}
+
+// Lookup returns the entry of a path.
+func (x *ManifestIndex) Lookup(path string) (ManifestFileEntry, bool) {
+	restartCount := len(x.restarts) / 8
+	if restartCount == 0 {
+		return ManifestFileEntry{}, false
+	}
+
+	// Last restart whose (full) path is <= path
+	key := []byte(path)
+	block := sort.Search(restartCount, func(i int) bool {
+		first, ok := x.restartPath(i)
+		return !ok || bytes.Compare(first, key) > 0
+	}) - 1
+	if block < 0 {
+		return ManifestFileEntry{}, false
+	}
+
+	d := manifestDecoder{data: x.data, pos: x.restartOffset(block)}
+	n := manifestRestartInterval
+	if rest := x.count - block*manifestRestartInterval; rest < n {
+		n = rest
+	}
+	for i := 0; i < n; i++ {
+		if !d.next() {
+			return ManifestFileEntry{}, false
+		}
+		switch bytes.Compare(d.path, key) {
+		case 0:
+			return d.entry(), true
+		case 1:
+			return ManifestFileEntry{}, false // Sorted: passed it
+		}
+	}
+	return ManifestFileEntry{}, false
+}
+
+// Range calls fn for every entry in path order until fn returns false.
+// It returns an error if the index is corrupt.
+func (x *ManifestIndex) Range(fn func(ManifestFileEntry) bool) error {
+	d := manifestDecoder{data: x.data, pos: manifestHeaderSize}
+	for i := 0; i < x.count; i++ {
+		if !d.next() {
+			return errManifestIndexCorrupt
+		}
+		if !fn(d.entry()) {
+			return nil
+		}
+	}
+	return nil
+}
+
+// restartOffset returns the data offset of restart point i.
+func (x *ManifestIndex) restartOffset(i int) int {
+	return int(binary.LittleEndian.Uint64(x.restarts[i*8:]))
+}
+
+// restartPath returns the path of the entry at restart point i, without copy.
+func (x *ManifestIndex) restartPath(i int) ([]byte, bool) {
+	d := manifestDecoder{data: x.data, pos: x.restartOffset(i)}
+	shared, ok1 := d.uvarint()
+	length, ok2 := d.uvarint()
+	if !ok1 || !ok2 || shared != 0 || uint64(len(d.data)-d.pos) < length {
+		return nil, false
+	}
+	return d.data[d.pos : d.pos+int(length)], true
+}
+
+// manifestDecoder decodes consecutive entries, rebuilding prefix-compressed
+// paths. Every read is bounds-checked, so corrupt data only stops decoding.
+type manifestDecoder struct {
+	data []byte
+	pos  int
+
+	// Current entry
+	path  []byte
+	size  int64
+	mtime int64
+	hash  string
+}
+
+// next decodes the next entry; it returns false on corrupt data.
+func (d *manifestDecoder) next() bool {
+	shared, ok1 := d.uvarint()
+	length, ok2 := d.uvarint()
+	if !ok1 || !ok2 || shared > uint64(len(d.path)) || uint64(len(d.data)-d.pos) < length {
+		return false
+	}
+	d.path = append(d.path[:shared], d.data[d.pos:d.pos+int(length)]...)
+	d.pos += int(length)
+
+	size, ok1 := d.uvarint()
+	mtime, n := binary.Varint(d.data[d.pos:])
+	if !ok1 || n <= 0 {
+		return false
+	}
+	d.pos += n
+	d.size, d.mtime = int64(size), mtime
+
+	hash, ok := d.readHash()
+	d.hash = hash
+	return ok
+}
+
+// entry returns the current entry.
+func (d *manifestDecoder) entry() ManifestFileEntry {
+	return ManifestFileEntry{Path: string(d.path), Size: d.size, MTime: d.mtime, Hash: d.hash}
+}
+
+func (d *manifestDecoder) uvarint() (uint64, bool) {
+	v, n := binary.Uvarint(d.data[d.pos:])
+	if n <= 0 {
+		return 0, false
+	}
+	d.pos += n
+	return v, true
+}
+
+func (d *manifestDecoder) readHash() (string, bool) {
+	tag, ok := d.uvarint()
+	if !ok {
+		return "", false
+	}
+	length := uint64(32)
+	if tag == manifestHashNone {
+		return "", true
+	}
+	if tag >= manifestHashRawOffset {
+		length = tag - manifestHashRawOffset
+	}
+	if uint64(len(d.data)-d.pos) < length {
+		return "", false
+	}
+	raw := d.data[d.pos : d.pos+int(length)]
+	d.pos += int(length)
+
+	switch tag {
+	case manifestHashSHA256:
+		return "sha256:" + hex.EncodeToString(raw), true
+	case manifestHashHex256:
+		return hex.EncodeToString(raw), true
+	}
+	return string(raw), true
+}
+
+// appendManifestHash encodes a hash, packing SHA256 hex digests into bytes
+// when they decode back to the same string (lowercase hex).
+func appendManifestHash(data []byte, hash string) []byte {
+	if hash == "" {
+		return binary.AppendUvarint(data, manifestHashNone)
+	}
+
+	tag, digest := uint64(manifestHashHex256), hash
+	if len(hash) == len("sha256:")+64 && hash[:len("sha256:")] == "sha256:" {
+		tag, digest = manifestHashSHA256, hash[len("sha256:"):]
+	}
+	if len(digest) == 64 {
+		if raw, err := hex.DecodeString(digest); err == nil && hex.EncodeToString(raw) == digest {
+			data = binary.AppendUvarint(data, tag)
+			return append(data, raw...)
+		}
+	}
+
+	data = binary.AppendUvarint(data, manifestHashRawOffset+uint64(len(hash)))
+	return append(data, hash...)
+}
+
+// sharedPrefixLen returns the length of the common prefix of a and b.
+func sharedPrefixLen(a, b string) int {
+	n := len(a)
+	if len(b) < n {
+		n = len(b)
+	}
+	i := 0
+	for i < n && a[i] == b[i] {
+		i++
+	}
+	return i
+}
@@ -0,0 +1,148 @@
+//go:build windows
+// +build windows
+
+package cloudfiles
+
+import (
+	"bytes"
+	"context"
+	"fmt"
+	"os"
+	"path/filepath"
+	"testing"
+)
+
+func testManifestEntries(n int) []ManifestFileEntry {
+	files := make([]ManifestFileEntry, 0, n)
+	for i := n - 1; i >= 0; i-- { // Unsorted on purpose
+		files = append(files, ManifestFileEntry{
+			Path:  fmt.Sprintf("docs/project-%d/report-%05d.pdf", i%7, i),
+			Size:  int64(i * 1000),
+			MTime: 1700000000 + int64(i),
+			Hash:  fmt.Sprintf("sha256:%064x", i),
+		})
+	}
+	return files
+}
+
+func TestManifestIndexLookup(t *testing.T) {
+	files := testManifestEntries(1000)
+	index, err := NewManifestIndex(EncodeManifestIndex(files))
+	if err != nil {
+		t.Fatalf("NewManifestIndex failed: %v", err)
+	}
+
+	if index.Len() != len(files) {
+		t.Errorf("Expected %d entries, got %d", len(files), index.Len())
+	}
+	for _, f := range files {
+		got, ok := index.Lookup(f.Path)
+		if !ok || got != f {
+			t.Fatalf("Lookup(%s) = %+v, %v; want %+v", f.Path, got, ok, f)
+		}
+	}
+	for _, path := range []string{"", "a", "docs/project-0", "docs/project-9/x", "zzz"} {
+		if _, ok := index.Lookup(path); ok {
+			t.Errorf("Expected %q not to be found", path)
+		}
+	}
+}
+
+func TestManifestIndexRangeSorted(t *testing.T) {
+	files := testManifestEntries(100)
+	files = append(files, ManifestFileEntry{Path: files[0].Path, Size: 42}) // Duplicate: last wins
+	index, _ := NewManifestIndex(EncodeManifestIndex(files))
+
+	previous := ""
+	count := 0
+	err := index.Range(func(f ManifestFileEntry) bool {
+		if f.Path <= previous {
+			t.Errorf("Expected sorted unique paths, got %s after %s", f.Path, previous)
+		}
+		if f.Path == files[0].Path && f.Size != 42 {
+			t.Errorf("Expected the last duplicate to win, got size %d", f.Size)
+		}
+		previous = f.Path
+		count++
+		return true
+	})
+	if err != nil || count != 100 {
+		t.Errorf("Expected 100 entries, got %d (%v)", count, err)
+	}
+}
+
+func TestManifestIndexHashForms(t *testing.T) {
+	hashes := []string{
+		"",
+		"sha256:b94d27b9934d3e08a52e52d7da7dabfac484efe37a5380ee9088f7ace2efcde9",
+		"b94d27b9934d3e08a52e52d7da7dabfac484efe37a5380ee9088f7ace2efcde9",
+		"sha256:B94D27B9934D3E08A52E52D7DA7DABFAC484EFE37A5380EE9088F7ACE2EFCDE9", // Kept as is
+		"md5:5eb63bbbe01eeed093cb22bb8f5acdc3",
+	}
+	var files []ManifestFileEntry
+	for i, hash := range hashes {
+		files = append(files, ManifestFileEntry{Path: fmt.Sprintf("f%d", i), Hash: hash})
+	}
+
+	index, _ := NewManifestIndex(EncodeManifestIndex(files))
+	for _, f := range files {
+		if got, _ := index.Lookup(f.Path); got.Hash != f.Hash {
+			t.Errorf("Expected hash %q, got %q", f.Hash, got.Hash)
+		}
+	}
+}
+
+func TestManifestIndexRejectsCorruptData(t *testing.T) {
+	data := EncodeManifestIndex(testManifestEntries(50))
+
+	if _, err := NewManifestIndex(data[:len(data)-3]); err == nil {
+		t.Error("Expected truncated data to be rejected")
+	}
+	if _, err := NewManifestIndex([]byte("not an index at all......")); err == nil {
+		t.Error("Expected bad magic to be rejected")
+	}
+
+	// Garbage entries fail to decode instead of panicking
+	corrupt := append([]byte(nil), data...)
+	for i := manifestHeaderSize; i < manifestHeaderSize+200; i++ {
+		corrupt[i] = 0xff
+	}
+	index, err := NewManifestIndex(corrupt)
+	if err != nil {
+		t.Fatalf("Expected the header to be valid, got %v", err)
+	}
+	if err := index.Range(func(ManifestFileEntry) bool { return true }); err == nil {
+		t.Error("Expected Range to report corrupt entries")
+	}
+	index.Lookup("docs/project-0/report-00000.pdf")
+}
+
+func TestManifestIndexFile(t *testing.T) {
+	path := filepath.Join(t.TempDir(), "manifests", "job_1.idx")
+	files := testManifestEntries(200)
+	if err := WriteManifestIndex(path, files); err != nil {
+		t.Fatalf("WriteManifestIndex failed: %v", err)
+	}
+
+	if data, _ := os.ReadFile(path); !bytes.Equal(data, EncodeManifestIndex(files)) {
+		t.Error("Expected the streamed file to match the in-memory encoding")
+	}
+	if err := WriteManifestIndex(path, files); err == nil {
+		t.Error("Expected an existing index not to be overwritten")
+	}
+
+	index, err := OpenManifestIndex(path)
+	if err != nil {
+		t.Fatalf("OpenManifestIndex failed: %v", err)
+	}
+	defer index.Close()
+
+	source := NewManifestIndexDataSource(index, nil)
+	if version, ok := source.FileVersion(files[3].Path); !ok || version != "h"+files[3].Hash {
+		t.Errorf("Expected version from the hash, got %q (%v)", version, ok)
+	}
+	listed, err := source.ListFiles(context.Background())
+	if err != nil || len(listed) != len(files) {
+		t.Errorf("Expected %d files, got %d (%v)", len(files), len(listed), err)
+	}
+}
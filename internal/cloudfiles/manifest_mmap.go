@@ -0,0 +1,50 @@
+//go:build windows
+// +build windows
+
+package cloudfiles
+
+import (
+	"fmt"
+	"os"
+	"unsafe"
+
+	"golang.org/x/sys/windows"
+)
+
+// mapManifestFile maps a file read-only into memory. Pages are loaded by
+// the OS on access and can be dropped under memory pressure, so they do not
+// count against the process heap.
+func mapManifestFile(path string) ([]byte, func() error, error) {
+	file, err := os.Open(path)
+	if err != nil {
+		return nil, nil, err
+	}
+	defer file.Close() // The view keeps the file open
+
+	info, err := file.Stat()
+	if err != nil {
+		return nil, nil, err
+	}
+	size := info.Size()
+	if size == 0 {
+		return nil, nil, fmt.Errorf("empty file %s", path)
+	}
+	if size != int64(int(size)) {
+		return nil, nil, fmt.Errorf("file %s too large to map", path)
+	}
+
+	mapping, err := windows.CreateFileMapping(windows.Handle(file.Fd()), nil,
+		windows.PAGE_READONLY, uint32(size>>32), uint32(size), nil)
+	if err != nil {
+		return nil, nil, fmt.Errorf("CreateFileMapping: %w", err)
+	}
+	defer windows.CloseHandle(mapping) // The view keeps the mapping alive
+
+	addr, err := windows.MapViewOfFile(mapping, windows.FILE_MAP_READ, 0, 0, uintptr(size))
+	if err != nil {
+		return nil, nil, fmt.Errorf("MapViewOfFile: %w", err)
+	}
+
+	data := unsafe.Slice((*byte)(unsafe.Pointer(addr)), int(size))
+	return data, func() error { return windows.UnmapViewOfFile(addr) }, nil
+}
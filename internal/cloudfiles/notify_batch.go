@@ -0,0 +1,196 @@
+//go:build windows
+// +build windows
+
+package cloudfiles
+
+import (
+	"strings"
+	"time"
+)
+
+// Notification coalescing. Deleting or moving a folder sends one
+// notification per placeholder; the notify lane collects them while they
+// keep coming and delivers them grouped by parent directory, so the engine
+// can issue one recursive remote operation instead of one per file.
+const (
+	notifyBatchWindow     = 50 * time.Millisecond // Quiet time that ends a batch
+	notifyBatchMaxDelay   = time.Second           // Longest a notification is held
+	notifyBatchMaxEntries = 4096                  // Notifications held before delivering anyway
+)
+
+// NotifyKind is the kind of notifications in a NotifyBatch.
+type NotifyKind int
+
+const (
+	NotifyDelete NotifyKind = iota
+	NotifyRename
+)
+
+// NotifyEntry is one delete or rename notification.
+type NotifyEntry struct {
+	Path        string
+	TargetPath  string // NotifyRename only
+	IsDirectory bool
+
+	// Covered are deletes of descendants of this directory received in the
+	// same window, in arrival order. Deleting the directory remotely
+	// (recursively) also handles them.
+	Covered []NotifyEntry
+}
+
+// NotifyBatch is a group of notifications of one kind sharing a parent
+// directory (and, for renames, a target parent directory).
+type NotifyBatch struct {
+	Kind         NotifyKind
+	Parent       string
+	TargetParent string // NotifyRename only
+	Entries      []NotifyEntry
+}
+
+// Expand returns every notification of the batch, covered descendants
+// before their directory, for handlers that work one entry at a time.
+func (b *NotifyBatch) Expand() []NotifyEntry {
+	var all []NotifyEntry
+	for _, e := range b.Entries {
+		all = append(all, e.Covered...)
+		e.Covered = nil
+		all = append(all, e)
+	}
+	return all
+}
+
+// replay calls the per-entry handlers for every notification of the batch.
+func (b *NotifyBatch) replay(onDelete func(string, bool) bool, onRename func(string, string, bool) bool) {
+	for _, e := range b.Expand() {
+		if b.Kind == NotifyRename && onRename != nil {
+			onRename(e.Path, e.TargetPath, e.IsDirectory)
+		} else if b.Kind == NotifyDelete && onDelete != nil {
+			onDelete(e.Path, e.IsDirectory)
+		}
+	}
+}
+
+// notifyCoalescer collects notifications until they are flushed as batches.
+// A window only holds one kind: a rename after deletes (or the reverse)
+// flushes the deletes first, so batches keep the order Windows reported.
+type notifyCoalescer struct {
+	kind    NotifyKind
+	pending []NotifyEntry
+}
+
+// Add appends a notification. Returns the batches flushed because the kind changed.
+func (c *notifyCoalescer) Add(kind NotifyKind, entry NotifyEntry) []NotifyBatch {
+	var flushed []NotifyBatch
+	if len(c.pending) > 0 && kind != c.kind {
+		flushed = c.Flush()
+	}
+	c.kind = kind
+	c.pending = append(c.pending, entry)
+	return flushed
+}
+
+// Len returns the number of pending notifications.
+func (c *notifyCoalescer) Len() int {
+	return len(c.pending)
+}
+
+// Flush groups the pending notifications into batches and clears them.
+func (c *notifyCoalescer) Flush() []NotifyBatch {
+	if len(c.pending) == 0 {
+		return nil
+	}
+	pending := c.pending
+	c.pending = nil
+
+	if c.kind == NotifyRename {
+		return groupRenames(pending)
+	}
+	return groupDeletes(pending)
+}
+
+// groupDeletes folds deletes under a deleted directory into that directory's
+// entry, then groups the remaining entries by parent. Deletes of distinct
+// paths commute, so groups may merge entries that were not adjacent.
+func groupDeletes(entries []NotifyEntry) []NotifyBatch {
+	dirs := make(map[string]int) // Directory key -> index in entries
+	for i, e := range entries {
+		if e.IsDirectory {
+			dirs[pathKey(e.Path)] = i
+		}
+	}
+
+	// Topmost deleted ancestor of each entry, if any
+	covering := make([]int, len(entries))
+	for i, e := range entries {
+		covering[i] = -1
+		for parent := parentPath(e.Path); parent != ""; parent = parentPath(parent) {
+			if j, ok := dirs[pathKey(parent)]; ok {
+				covering[i] = j
+			}
+		}
+	}
+
+	roots := make([]NotifyEntry, len(entries))
+	copy(roots, entries)
+	for i, j := range covering {
+		if j >= 0 {
+			roots[j].Covered = append(roots[j].Covered, entries[i])
+		}
+	}
+
+	var batches []NotifyBatch
+	index := make(map[string]int) // Parent key -> index in batches
+	for i, e := range roots {
+		if covering[i] >= 0 {
+			continue
+		}
+		parent := parentPath(e.Path)
+		key := pathKey(parent)
+		bi, ok := index[key]
+		if !ok {
+			bi = len(batches)
+			index[key] = bi
+			batches = append(batches, NotifyBatch{Kind: NotifyDelete, Parent: parent})
+		}
+		batches[bi].Entries = append(batches[bi].Entries, e)
+	}
+	return batches
+}
+
+// groupRenames groups consecutive renames with the same source and target
+// parents. Renames can depend on each other (a->b then b->c), so only
+// adjacent entries are merged and the original order is kept.
+func groupRenames(entries []NotifyEntry) []NotifyBatch {
+	var batches []NotifyBatch
+	for _, e := range entries {
+		parent, target := parentPath(e.Path), parentPath(e.TargetPath)
+		if n := len(batches); n > 0 &&
+			pathKey(batches[n-1].Parent) == pathKey(parent) &&
+			pathKey(batches[n-1].TargetParent) == pathKey(target) {
+			batches[n-1].Entries = append(batches[n-1].Entries, e)
+			continue
+		}
+		batches = append(batches, NotifyBatch{
+			Kind:         NotifyRename,
+			Parent:       parent,
+			TargetParent: target,
+			Entries:      []NotifyEntry{e},
+		})
+	}
+	return batches
+}
+
+// parentPath returns the directory part of a Windows path ("" at the top).
+func parentPath(path string) string {
+	path = strings.TrimRight(path, `\/`)
+	i := strings.LastIndexAny(path, `\/`)
+	if i <= 0 {
+		return ""
+	}
+	return path[:i]
+}
+
+// pathKey normalizes a path for comparisons (NTFS names are case-insensitive).
+func pathKey(path string) string {
+	return strings.ToLower(strings.ReplaceAll(strings.TrimRight(path, `\/`), "/", `\`))
+}
@@ -0,0 +1,122 @@
+//go:build windows
+// +build windows
+
+package cloudfiles
+
+import (
+	"testing"
+)
+
+func TestNotifyCoalescerFoldsFolderDelete(t *testing.T) {
+	var c notifyCoalescer
+
+	// Explorer deletes the children first, then the folder itself
+	c.Add(NotifyDelete, NotifyEntry{Path: `\Sync\Photos\2024\a.jpg`})
+	c.Add(NotifyDelete, NotifyEntry{Path: `\Sync\Photos\2024\b.jpg`})
+	c.Add(NotifyDelete, NotifyEntry{Path: `\Sync\Photos\2024`, IsDirectory: true})
+	c.Add(NotifyDelete, NotifyEntry{Path: `\Sync\Photos\c.jpg`})
+	c.Add(NotifyDelete, NotifyEntry{Path: `\Sync\photos`, IsDirectory: true})
+	c.Add(NotifyDelete, NotifyEntry{Path: `\Sync\notes.txt`})
+	c.Add(NotifyDelete, NotifyEntry{Path: `\Sync\todo.txt`})
+
+	batches := c.Flush()
+	if c.Len() != 0 {
+		t.Errorf("Expected nothing pending after flush, got %d", c.Len())
+	}
+	if len(batches) != 1 {
+		t.Fatalf("Expected a single batch for the sync root, got %d", len(batches))
+	}
+
+	b := batches[0]
+	if b.Kind != NotifyDelete || b.Parent != `\Sync` || len(b.Entries) != 3 {
+		t.Fatalf("Unexpected batch %+v", b)
+	}
+	folder := b.Entries[0]
+	if folder.Path != `\Sync\photos` || len(folder.Covered) != 4 {
+		t.Errorf("Expected the folder to cover its 4 descendants, got %+v", folder)
+	}
+	if len(b.Expand()) != 7 {
+		t.Errorf("Expected Expand to return all 7 notifications, got %d", len(b.Expand()))
+	}
+}
+
+func TestNotifyCoalescerGroupsByParent(t *testing.T) {
+	var c notifyCoalescer
+	c.Add(NotifyDelete, NotifyEntry{Path: `\Sync\a\1.txt`})
+	c.Add(NotifyDelete, NotifyEntry{Path: `\Sync\b\1.txt`})
+	c.Add(NotifyDelete, NotifyEntry{Path: `\Sync\a\2.txt`})
+
+	batches := c.Flush()
+	if len(batches) != 2 {
+		t.Fatalf("Expected 2 batches, got %d", len(batches))
+	}
+	if batches[0].Parent != `\Sync\a` || len(batches[0].Entries) != 2 {
+		t.Errorf("Expected both files of a in the first batch, got %+v", batches[0])
+	}
+	if batches[1].Parent != `\Sync\b` || len(batches[1].Entries) != 1 {
+		t.Errorf("Expected the file of b in the second batch, got %+v", batches[1])
+	}
+}
+
+func TestNotifyCoalescerKeepsRenameOrder(t *testing.T) {
+	var c notifyCoalescer
+
+	// A folder moved file by file, then a chained rename elsewhere
+	c.Add(NotifyRename, NotifyEntry{Path: `\Sync\in\1.txt`, TargetPath: `\Sync\out\1.txt`})
+	c.Add(NotifyRename, NotifyEntry{Path: `\Sync\in\2.txt`, TargetPath: `\Sync\out\2.txt`})
+	c.Add(NotifyRename, NotifyEntry{Path: `\Sync\out\2.txt`, TargetPath: `\Sync\done\2.txt`})
+	c.Add(NotifyRename, NotifyEntry{Path: `\Sync\in\3.txt`, TargetPath: `\Sync\out\3.txt`})
+
+	batches := c.Flush()
+	if len(batches) != 3 {
+		t.Fatalf("Expected only adjacent renames to merge into 3 batches, got %d", len(batches))
+	}
+	if len(batches[0].Entries) != 2 || batches[0].TargetParent != `\Sync\out` {
+		t.Errorf("Expected the first move run in one batch, got %+v", batches[0])
+	}
+	if batches[1].Parent != `\Sync\out` || batches[2].Entries[0].Path != `\Sync\in\3.txt` {
+		t.Errorf("Expected renames to stay in arrival order, got %+v", batches)
+	}
+}
+
+func TestNotifyCoalescerFlushesOnKindChange(t *testing.T) {
+	var c notifyCoalescer
+	if flushed := c.Add(NotifyDelete, NotifyEntry{Path: `\Sync\a.txt`}); flushed != nil {
+		t.Errorf("Expected no flush, got %+v", flushed)
+	}
+
+	flushed := c.Add(NotifyRename, NotifyEntry{Path: `\Sync\b.txt`, TargetPath: `\Sync\c.txt`})
+	if len(flushed) != 1 || flushed[0].Kind != NotifyDelete {
+		t.Fatalf("Expected the pending delete to be flushed first, got %+v", flushed)
+	}
+	if c.Len() != 1 {
+		t.Errorf("Expected the rename to stay pending, got %d", c.Len())
+	}
+}
+
+func TestNotifyLaneNeverBlocks(t *testing.T) {
+	lane := newNotifyLane()
+
+	// Far more than any buffer, with nobody taking
+	for i := 0; i < 10000; i++ {
+		lane.Put(bridgeRequest{filePath: string(rune('a' + i%26))})
+	}
+
+	select {
+	case <-lane.ready:
+	default:
+		t.Fatal("Expected the lane to signal pending notifications")
+	}
+	reqs := lane.Take()
+	if len(reqs) != 10000 {
+		t.Fatalf("Expected 10000 notifications, got %d", len(reqs))
+	}
+	for i, req := range reqs {
+		if req.filePath != string(rune('a'+i%26)) {
+			t.Fatalf("Notification %d out of order: %q", i, req.filePath)
+		}
+	}
+	if reqs := lane.Take(); len(reqs) != 0 {
+		t.Errorf("Expected an empty lane after take, got %d", len(reqs))
+	}
+}
@@ -0,0 +1,310 @@
+//go:build windows
+// +build windows
+
+package cloudfiles
+
+import (
+	"context"
+	"fmt"
+	"path/filepath"
+	"sync"
+	"sync/atomic"
+	"time"
+)
+
+// Bulk placeholder creation defaults.
+const (
+	DefaultPlaceholderWorkers   = 4   // Concurrent CfCreatePlaceholders calls
+	DefaultPlaceholderBatchSize = 512 // Placeholders per CfCreatePlaceholders call
+
+	// placeholderFlushInterval bounds how long a partial batch waits for more
+	// files of its directory, so placeholders show up while listing goes on.
+	placeholderFlushInterval = 250 * time.Millisecond
+)
+
+// PlaceholderConfig tunes bulk placeholder creation.
+type PlaceholderConfig struct {
+	Workers   int // Concurrent CfCreatePlaceholders calls (0 = DefaultPlaceholderWorkers)
+	BatchSize int // Placeholders per call (0 = DefaultPlaceholderBatchSize)
+}
+
+// placeholderBatch is the files of one parent directory created in one call.
+type placeholderBatch struct {
+	parentDir string
+	files     []RemoteFileInfo
+}
+
+// BulkPlaceholderCreator creates placeholders from a stream of remote files.
+// A dispatcher goroutine creates each directory the first time a path
+// needs it (parents first) and groups files by parent directory; full
+// batches, and partial ones every placeholderFlushInterval, go to a pool of
+// workers calling CfCreatePlaceholders. Add blocks while the workers are
+// behind, so a lister feeding it never runs far ahead.
+type BulkPlaceholderCreator struct {
+	batchSize int
+	mkdir     func(relativePath string) error
+	create    func(parentDir string, files []RemoteFileInfo) error
+
+	ctx    context.Context
+	cancel context.CancelFunc
+
+	input   chan RemoteFileInfo
+	batches chan placeholderBatch
+	done    chan struct{}
+	workers sync.WaitGroup
+
+	dirs map[string]bool // Directories known to exist (dispatcher only)
+
+	errOnce   sync.Once
+	err       error
+	created   atomic.Int64
+	closeOnce sync.Once
+}
+
+// NewBulkCreator starts a bulk creator for this manager's sync root.
+// Cancelling ctx stops it; Close returns ctx's error.
+func (pm *PlaceholderManager) NewBulkCreator(ctx context.Context) *BulkPlaceholderCreator {
+	return newBulkPlaceholderCreator(ctx, pm.bulk, pm.ensureDirectoryPlaceholder, pm.createFilePlaceholders, nil)
+}
+
+func newBulkPlaceholderCreator(ctx context.Context, config PlaceholderConfig,
+	mkdir func(string) error, create func(string, []RemoteFileInfo) error,
+	existingDirs map[string]bool) *BulkPlaceholderCreator {
+	workers := config.Workers
+	if workers <= 0 {
+		workers = DefaultPlaceholderWorkers
+	}
+	batchSize := config.BatchSize
+	if batchSize <= 0 {
+		batchSize = DefaultPlaceholderBatchSize
+	}
+
+	ctx, cancel := context.WithCancel(ctx)
+	b := &BulkPlaceholderCreator{
+		batchSize: batchSize,
+		mkdir:     mkdir,
+		create:    create,
+		ctx:       ctx,
+		cancel:    cancel,
+		input:     make(chan RemoteFileInfo, batchSize),
+		batches:   make(chan placeholderBatch, workers),
+		done:      make(chan struct{}),
+		dirs:      make(map[string]bool, len(existingDirs)),
+	}
+	for dir := range existingDirs {
+		b.dirs[dir] = true
+	}
+
+	for i := 0; i < workers; i++ {
+		b.workers.Add(1)
+		go b.worker()
+	}
+	go b.dispatch()
+	return b
+}
+
+// Add queues a remote file or directory. Returns an error once creation
+// failed or was cancelled. Must not be called after Close.
+func (b *BulkPlaceholderCreator) Add(file RemoteFileInfo) error {
+	select {
+	case b.input <- file:
+		return nil
+	case <-b.ctx.Done():
+		return b.failure()
+	}
+}
+
+// Close creates what is still pending, waits for the workers and returns
+// the number of file placeholders created with the first error, if any.
+func (b *BulkPlaceholderCreator) Close() (int, error) {
+	b.closeOnce.Do(func() { close(b.input) })
+	<-b.done
+	b.cancel()
+	return int(b.created.Load()), b.err
+}
+
+// fail records the first error and stops the creator.
+func (b *BulkPlaceholderCreator) fail(err error) {
+	b.errOnce.Do(func() { b.err = err })
+	b.cancel()
+}
+
+// failure returns the recorded error, or the cancellation cause.
+func (b *BulkPlaceholderCreator) failure() error {
+	b.fail(b.ctx.Err())
+	return b.err
+}
+
+// dispatch groups incoming files into per-directory batches until Close.
+func (b *BulkPlaceholderCreator) dispatch() {
+	pending := make(map[string][]RemoteFileInfo)
+	ticker := time.NewTicker(placeholderFlushInterval)
+	defer ticker.Stop()
+
+	send := func(parent string, files []RemoteFileInfo) {
+		select {
+		case b.batches <- placeholderBatch{parentDir: parent, files: files}:
+		case <-b.ctx.Done():
+		}
+	}
+	flushAll := func() {
+		for parent, files := range pending {
+			send(parent, files)
+			delete(pending, parent)
+		}
+	}
+
+	defer func() {
+		flushAll()
+		close(b.batches)
+		b.workers.Wait()
+		close(b.done)
+	}()
+
+	for {
+		select {
+		case file, ok := <-b.input:
+			if !ok {
+				return
+			}
+			if b.ctx.Err() != nil {
+				continue // Drain input until Close
+			}
+
+			file.Path = normalizePath(file.Path)
+			if file.IsDirectory {
+				b.ensureDir(filepath.FromSlash(file.Path))
+				continue
+			}
+			parent := filepath.Dir(filepath.FromSlash(file.Path))
+			if parent == "." {
+				parent = ""
+			}
+			b.ensureDir(parent)
+
+			pending[parent] = append(pending[parent], file)
+			if len(pending[parent]) >= b.batchSize {
+				send(parent, pending[parent])
+				delete(pending, parent)
+			}
+
+		case <-ticker.C:
+			flushAll()
+		}
+	}
+}
+
+// ensureDir creates a directory and its missing parents, shallowest first.
+// dir uses the OS separator, as returned by filepath.Dir.
+func (b *BulkPlaceholderCreator) ensureDir(dir string) {
+	if dir == "" || dir == "." || b.dirs[dir] || b.ctx.Err() != nil {
+		return
+	}
+
+	missing := []string{dir}
+	for parent := filepath.Dir(dir); parent != "." && parent != "" && parent != "/" && !b.dirs[parent]; parent = filepath.Dir(parent) {
+		missing = append(missing, parent)
+	}
+	for i := len(missing) - 1; i >= 0; i-- {
+		if err := b.mkdir(missing[i]); err != nil {
+			b.fail(fmt.Errorf("failed to create directory placeholder %s: %w", missing[i], err))
+			return
+		}
+		b.dirs[missing[i]] = true
+	}
+}
+
+// worker creates batches until the dispatcher closes the batch channel.
+func (b *BulkPlaceholderCreator) worker() {
+	defer b.workers.Done()
+	for batch := range b.batches {
+		if b.ctx.Err() != nil {
+			continue // Drain without creating
+		}
+		if err := b.create(batch.parentDir, batch.files); err != nil {
+			b.fail(fmt.Errorf("failed to create placeholders in %s: %w", batch.parentDir, err))
+			continue
+		}
+		b.created.Add(int64(len(batch.files)))
+	}
+}
+
+// createDirectoryLevels creates directories level by level: the directories
+// of one depth are created concurrently, after all their parents exist.
+func createDirectoryLevels(ctx context.Context, dirs map[string]bool, workers int, mkdir func(string) error) error {
+	if workers <= 0 {
+		workers = DefaultPlaceholderWorkers
+	}
+	sorted := sortDirectoriesByDepth(dirs)
+
+	for start := 0; start < len(sorted); {
+		depth := countPathSeparators(sorted[start])
+		end := start
+		for end < len(sorted) && countPathSeparators(sorted[end]) == depth {
+			end++
+		}
+		if err := runParallel(ctx, sorted[start:end], workers, mkdir); err != nil {
+			return err
+		}
+		start = end
+	}
+	return nil
+}
+
+// runParallel calls fn for every directory using up to workers goroutines
+// and returns the first error.
+func runParallel(ctx context.Context, dirs []string, workers int, fn func(string) error) error {
+	next := make(chan string)
+	var (
+		wg       sync.WaitGroup
+		errOnce  sync.Once
+		firstErr error
+	)
+	ctx, cancel := context.WithCancel(ctx)
+	defer cancel()
+
+	for i := 0; i < workers && i < len(dirs); i++ {
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			for dir := range next {
+				if err := fn(dir); err != nil {
+					errOnce.Do(func() {
+						firstErr = fmt.Errorf("failed to create directory placeholder %s: %w", dir, err)
+					})
+					cancel()
+				}
+			}
+		}()
+	}
+
+feed:
+	for _, dir := range dirs {
+		if dir == "" || dir == "." {
+			continue
+		}
+		select {
+		case next <- dir:
+		case <-ctx.Done():
+			break feed
+		}
+	}
+	close(next)
+	wg.Wait()
+
+	if firstErr != nil {
+		return firstErr
+	}
+	return ctx.Err()
+}
+
+// countPathSeparators returns the depth of a relative path.
+func countPathSeparators(path string) int {
+	depth := 0
+	for i := 0; i < len(path); i++ {
+		if path[i] == '/' || path[i] == '\\' {
+			depth++
+		}
+	}
+	return depth
+}
@@ -0,0 +1,131 @@
+//go:build windows
+// +build windows
+
+package cloudfiles
+
+import (
+	"context"
+	"errors"
+	"fmt"
+	"path/filepath"
+	"sync"
+	"testing"
+)
+
+// fakePlaceholderRoot records the calls made by a BulkPlaceholderCreator.
+type fakePlaceholderRoot struct {
+	mu      sync.Mutex
+	dirs    map[string]bool
+	files   map[string]int
+	batches []int
+	failOn  string
+	orphans []string // Files created before their parent directory
+}
+
+func newFakePlaceholderRoot() *fakePlaceholderRoot {
+	return &fakePlaceholderRoot{dirs: make(map[string]bool), files: make(map[string]int)}
+}
+
+func (f *fakePlaceholderRoot) mkdir(dir string) error {
+	f.mu.Lock()
+	defer f.mu.Unlock()
+	if parent := filepath.Dir(dir); parent != "." && !f.dirs[parent] {
+		f.orphans = append(f.orphans, dir)
+	}
+	f.dirs[dir] = true
+	return nil
+}
+
+func (f *fakePlaceholderRoot) create(parent string, files []RemoteFileInfo) error {
+	f.mu.Lock()
+	defer f.mu.Unlock()
+	if f.failOn != "" && parent == f.failOn {
+		return errors.New("access denied")
+	}
+	if parent != "" && !f.dirs[parent] {
+		f.orphans = append(f.orphans, parent)
+	}
+	for _, file := range files {
+		f.files[file.Path]++
+	}
+	f.batches = append(f.batches, len(files))
+	return nil
+}
+
+func TestBulkPlaceholderCreatorStreams(t *testing.T) {
+	root := newFakePlaceholderRoot()
+	b := newBulkPlaceholderCreator(context.Background(), PlaceholderConfig{Workers: 3, BatchSize: 8},
+		root.mkdir, root.create, nil)
+
+	// Directories come before their files, as listRecursive emits them
+	if err := b.Add(RemoteFileInfo{Path: "docs", IsDirectory: true}); err != nil {
+		t.Fatalf("Add failed: %v", err)
+	}
+	for i := 0; i < 20; i++ {
+		b.Add(RemoteFileInfo{Path: fmt.Sprintf("docs/%d.txt", i)})
+	}
+	// A file whose parents were never listed
+	b.Add(RemoteFileInfo{Path: `photos\2024\a.jpg`})
+	b.Add(RemoteFileInfo{Path: "readme.md"})
+
+	count, err := b.Close()
+	if err != nil {
+		t.Fatalf("Close failed: %v", err)
+	}
+	if count != 22 || len(root.files) != 22 {
+		t.Errorf("Expected 22 placeholders, got count=%d created=%d", count, len(root.files))
+	}
+	for path, n := range root.files {
+		if n != 1 {
+			t.Errorf("Expected %s to be created once, got %d", path, n)
+		}
+	}
+	for _, n := range root.batches {
+		if n > 8 {
+			t.Errorf("Expected batches of at most 8 placeholders, got %d", n)
+		}
+	}
+	if !root.dirs[filepath.FromSlash("photos/2024")] || !root.dirs["photos"] {
+		t.Errorf("Expected missing parents to be created, got %v", root.dirs)
+	}
+	if len(root.orphans) != 0 {
+		t.Errorf("Expected parents to exist before their children, got %v", root.orphans)
+	}
+}
+
+func TestBulkPlaceholderCreatorStopsOnError(t *testing.T) {
+	root := newFakePlaceholderRoot()
+	root.failOn = "locked"
+	b := newBulkPlaceholderCreator(context.Background(), PlaceholderConfig{Workers: 2, BatchSize: 1},
+		root.mkdir, root.create, nil)
+
+	b.Add(RemoteFileInfo{Path: "locked/a.txt"})
+	for i := 0; i < 1000; i++ {
+		if err := b.Add(RemoteFileInfo{Path: fmt.Sprintf("open/%d.txt", i)}); err != nil {
+			break // Add reports the failure once it is known
+		}
+	}
+
+	_, err := b.Close()
+	if err == nil {
+		t.Fatal("Expected the creation error to be returned")
+	}
+}
+
+func TestCreateDirectoryLevels(t *testing.T) {
+	root := newFakePlaceholderRoot()
+	dirs := make(map[string]bool)
+	for _, path := range []string{"a/b/c/1.txt", "a/d/2.txt", "e/f/3.txt"} {
+		collectParentDirs(filepath.FromSlash(path), dirs)
+	}
+
+	if err := createDirectoryLevels(context.Background(), dirs, 4, root.mkdir); err != nil {
+		t.Fatalf("createDirectoryLevels failed: %v", err)
+	}
+	if len(root.dirs) != len(dirs) {
+		t.Errorf("Expected %d directories, got %d", len(dirs), len(root.dirs))
+	}
+	if len(root.orphans) != 0 {
+		t.Errorf("Expected each level to be created after its parents, got %v", root.orphans)
+	}
+}
@@ -5,6 +5,7 @@
 package cloudfiles
 
 import (
+	"context"
 	"fmt"
 	"os"
 	"path/filepath"
@@ -18,6 +19,7 @@ import (
 // PlaceholderManager manages placeholder files within a sync root.
 type PlaceholderManager struct {
 	syncRoot *SyncRootManager
+	bulk     PlaceholderConfig
 }
 
 // NewPlaceholderManager creates a new placeholder manager for a sync root.
@@ -38,53 +40,40 @@ type RemoteFileInfo struct {
 }
 
 // CreatePlaceholders creates placeholder files for the given remote files.
-// It creates any necessary parent directories as placeholder directories.
+// It creates any necessary parent directories first, level by level, then
+// creates the files in large per-directory batches across a worker pool.
 func (pm *PlaceholderManager) CreatePlaceholders(files []RemoteFileInfo) error {
 	if len(files) == 0 {
 		return nil
 	}
 
-	// Group files by parent directory for batch creation
-	dirFiles := make(map[string][]RemoteFileInfo)
+	// Collect all directories that need to be created
 	directories := make(map[string]bool)
-
 	for _, f := range files {
-		// Normalize path
-		f.Path = normalizePath(f.Path)
-
+		path := filepath.FromSlash(normalizePath(f.Path))
 		if f.IsDirectory {
-			directories[f.Path] = true
-		} else {
-			parent := filepath.Dir(f.Path)
-			if parent == "." {
-				parent = ""
-			}
-			dirFiles[parent] = append(dirFiles[parent], f)
+			directories[path] = true
 		}
-
-		// Collect all parent directories that need to be created
-		collectParentDirs(f.Path, directories)
+		collectParentDirs(path, directories)
 	}
 
-	// Create directories first (sorted by depth)
-	sortedDirs := sortDirectoriesByDepth(directories)
-	for _, dir := range sortedDirs {
-		if dir == "" || dir == "." {
-			continue
-		}
-		if err := pm.ensureDirectoryPlaceholder(dir); err != nil {
-			return fmt.Errorf("failed to create directory placeholder %s: %w", dir, err)
-		}
+	ctx := context.Background()
+	if err := createDirectoryLevels(ctx, directories, pm.bulk.Workers, pm.ensureDirectoryPlaceholder); err != nil {
+		return err
 	}
 
 	// Create file placeholders by directory
-	for parentDir, dirFileList := range dirFiles {
-		if err := pm.createFilePlaceholders(parentDir, dirFileList); err != nil {
-			return fmt.Errorf("failed to create placeholders in %s: %w", parentDir, err)
+	bulk := newBulkPlaceholderCreator(ctx, pm.bulk, pm.ensureDirectoryPlaceholder, pm.createFilePlaceholders, directories)
+	for _, f := range files {
+		if f.IsDirectory {
+			continue
+		}
+		if err := bulk.Add(f); err != nil {
+			break
 		}
 	}
-
-	return nil
+	_, err := bulk.Close()
+	return err
 }
 
 // CreateSinglePlaceholder creates a single placeholder file or directory.
@@ -242,56 +231,72 @@ func (pm *PlaceholderManager) createFilePlaceholders(parentDir string, files []R
 
 	// Convert to CF_PLACEHOLDER_CREATE_INFO
 	placeholders := make([]CF_PLACEHOLDER_CREATE_INFO, len(files))
-
-	// Keep file identity strings alive during the API call
-	fileIdentities := make([][]uint16, len(files))
-
 	for i, f := range files {
-		// Get just the filename for the placeholder
-		fileName := filepath.Base(f.Path)
-		fileNamePtr, err := windows.UTF16PtrFromString(fileName)
+		info, err := newPlaceholderCreateInfo(f)
 		if err != nil {
-			return fmt.Errorf("invalid filename %s: %w", fileName, err)
-		}
-
-		// FileIdentity is REQUIRED for files - use the relative path as identity
-		// (this is what CloudMirror sample does)
-		var fileIdentityPtr unsafe.Pointer
-		var fileIdentityLen uint32
-
-		if len(f.FileIdentity) > 0 {
-			// Use provided identity
-			fileIdentityPtr = unsafe.Pointer(&f.FileIdentity[0])
-			fileIdentityLen = uint32(len(f.FileIdentity))
-		} else {
-			// Use relative path as identity (include null terminator)
-			fileIdentities[i], _ = windows.UTF16FromString(f.Path)
-			fileIdentityPtr = unsafe.Pointer(&fileIdentities[i][0])
-			fileIdentityLen = uint32(len(fileIdentities[i]) * 2) // Size in bytes
-		}
-
-		placeholders[i] = CF_PLACEHOLDER_CREATE_INFO{
-			RelativeFileName:   fileNamePtr,
-			FileIdentity:       fileIdentityPtr,
-			FileIdentityLength: fileIdentityLen,
-			FsMetadata: CF_FS_METADATA{
-				BasicInfo: FILE_BASIC_INFO{
-					CreationTime:   timeToFiletime(f.ModTime),
-					LastAccessTime: timeToFiletime(f.ModTime),
-					LastWriteTime:  timeToFiletime(f.ModTime),
-					ChangeTime:     timeToFiletime(f.ModTime),
-					FileAttributes: windows.FILE_ATTRIBUTE_NORMAL,
-				},
-				FileSize: f.Size,
-			},
-			Flags: CF_PLACEHOLDER_CREATE_FLAG_MARK_IN_SYNC,
+			return err
 		}
+		placeholders[i] = info
 	}
 
 	// Create the placeholders
 	return CreatePlaceholders(basePath, placeholders)
 }
 
+// newPlaceholderCreateInfo converts a remote entry into the creation info
+// of a placeholder named after its last path element. Directories get no
+// DISABLE_ON_DEMAND_POPULATION flag, so a partially populated sync root
+// raises FETCH_PLACEHOLDERS for them. The strings it points to are Go memory
+// kept alive by the returned struct.
+func newPlaceholderCreateInfo(f RemoteFileInfo) (CF_PLACEHOLDER_CREATE_INFO, error) {
+	// Get just the filename for the placeholder
+	fileName := filepath.Base(f.Path)
+	fileNamePtr, err := windows.UTF16PtrFromString(fileName)
+	if err != nil {
+		return CF_PLACEHOLDER_CREATE_INFO{}, fmt.Errorf("invalid filename %s: %w", fileName, err)
+	}
+
+	// FileIdentity is REQUIRED for files - use the relative path as identity
+	// (this is what CloudMirror sample does)
+	var fileIdentityPtr unsafe.Pointer
+	var fileIdentityLen uint32
+
+	if len(f.FileIdentity) > 0 {
+		// Use provided identity
+		fileIdentityPtr = unsafe.Pointer(&f.FileIdentity[0])
+		fileIdentityLen = uint32(len(f.FileIdentity))
+	} else {
+		// Use relative path as identity (include null terminator)
+		fileIdentity, _ := windows.UTF16FromString(f.Path)
+		fileIdentityPtr = unsafe.Pointer(&fileIdentity[0])
+		fileIdentityLen = uint32(len(fileIdentity) * 2) // Size in bytes
+	}
+
+	attributes := uint32(windows.FILE_ATTRIBUTE_NORMAL)
+	size := f.Size
+	if f.IsDirectory {
+		attributes = windows.FILE_ATTRIBUTE_DIRECTORY
+		size = 0
+	}
+
+	return CF_PLACEHOLDER_CREATE_INFO{
+		RelativeFileName:   fileNamePtr,
+		FileIdentity:       fileIdentityPtr,
+		FileIdentityLength: fileIdentityLen,
+		FsMetadata: CF_FS_METADATA{
+			BasicInfo: FILE_BASIC_INFO{
+				CreationTime:   timeToFiletime(f.ModTime),
+				LastAccessTime: timeToFiletime(f.ModTime),
+				LastWriteTime:  timeToFiletime(f.ModTime),
+				ChangeTime:     timeToFiletime(f.ModTime),
+				FileAttributes: attributes,
+			},
+			FileSize: size,
+		},
+		Flags: CF_PLACEHOLDER_CREATE_FLAG_MARK_IN_SYNC,
+	}, nil
+}
+
 // Helpers
 
 // normalizePath normalizes a file path (forward slashes, no leading slash).
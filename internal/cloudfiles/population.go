@@ -0,0 +1,175 @@
+//go:build windows
+// +build windows
+
+package cloudfiles
+
+import (
+	"context"
+	"strings"
+	"sync"
+	"time"
+)
+
+// Partial population. Instead of creating the whole namespace upfront, the
+// sync root uses CF_POPULATION_POLICY_PARTIAL and Windows raises
+// FETCH_PLACEHOLDERS the first time a directory is enumerated. The provider
+// lists that single remote directory and answers with TRANSFER_PLACEHOLDERS
+// batches, so startup cost no longer grows with the size of the share.
+const (
+	DefaultPopulationCacheTTL = 5 * time.Minute // How long a directory listing is reused
+
+	// populationBatchSize is the number of entries per TRANSFER_PLACEHOLDERS call.
+	populationBatchSize = DefaultPlaceholderBatchSize
+
+	// populationListTimeout bounds one remote directory listing; Windows
+	// fails the enumeration itself after about a minute.
+	populationListTimeout = 30 * time.Second
+
+	// populationCacheMaxDirs caps the number of cached listings.
+	populationCacheMaxDirs = 4096
+)
+
+// PopulationConfig selects how the placeholder namespace is created.
+type PopulationConfig struct {
+	// Partial populates directories on first enumeration (FETCH_PLACEHOLDERS)
+	// instead of creating every placeholder at startup. Directories created
+	// this way are placeholders too, so they can only be browsed while the
+	// provider is running.
+	Partial bool
+
+	// CacheTTL is how long a directory listing answers repeated enumerations
+	// without listing the remote again (0 = DefaultPopulationCacheTTL,
+	// negative = never cache).
+	CacheTTL time.Duration
+}
+
+// DirectoryDataSource is a DataSource that can list one remote directory,
+// as needed by partial population.
+type DirectoryDataSource interface {
+	DataSource
+	// ListDirectory returns the direct children of a directory relative to
+	// the remote root ("" for the root), with paths relative to the root.
+	ListDirectory(ctx context.Context, relativeDir string) ([]RemoteFileInfo, error)
+}
+
+// directoryListing is a cached directory listing.
+type directoryListing struct {
+	files  []RemoteFileInfo
+	listed time.Time
+}
+
+// directoryLoad is a listing in progress, shared by concurrent enumerations.
+type directoryLoad struct {
+	done  chan struct{}
+	files []RemoteFileInfo
+	err   error
+}
+
+// directoryCache caches remote directory listings by directory. Windows
+// raises FETCH_PLACEHOLDERS each time a partially populated directory is
+// opened, so repeated enumerations are served from memory.
+type directoryCache struct {
+	mu       sync.Mutex
+	ttl      time.Duration
+	maxDirs  int
+	listings map[string]directoryListing
+	loading  map[string]*directoryLoad
+	now      func() time.Time
+}
+
+func newDirectoryCache(ttl time.Duration) *directoryCache {
+	if ttl == 0 {
+		ttl = DefaultPopulationCacheTTL
+	}
+	return &directoryCache{
+		ttl:      ttl,
+		maxDirs:  populationCacheMaxDirs,
+		listings: make(map[string]directoryListing),
+		loading:  make(map[string]*directoryLoad),
+		now:      time.Now,
+	}
+}
+
+// Load returns the listing of dir, calling list when it is not cached.
+// Concurrent loads of the same directory share one call to list.
+func (c *directoryCache) Load(ctx context.Context, dir string, list func(ctx context.Context) ([]RemoteFileInfo, error)) ([]RemoteFileInfo, error) {
+	key := directoryKey(dir)
+
+	c.mu.Lock()
+	if l, ok := c.listings[key]; ok && c.now().Sub(l.listed) < c.ttl {
+		c.mu.Unlock()
+		return l.files, nil
+	}
+	if load, ok := c.loading[key]; ok {
+		c.mu.Unlock()
+		select {
+		case <-load.done:
+			return load.files, load.err
+		case <-ctx.Done():
+			return nil, ctx.Err()
+		}
+	}
+	load := &directoryLoad{done: make(chan struct{})}
+	c.loading[key] = load
+	c.mu.Unlock()
+
+	load.files, load.err = list(ctx)
+
+	c.mu.Lock()
+	delete(c.loading, key)
+	if load.err == nil && c.ttl > 0 {
+		c.store(key, load.files)
+	}
+	c.mu.Unlock()
+	close(load.done)
+
+	return load.files, load.err
+}
+
+// store caches a listing, evicting expired ones (then the oldest) when full.
+// Must be called with mu held.
+func (c *directoryCache) store(key string, files []RemoteFileInfo) {
+	now := c.now()
+	if len(c.listings) >= c.maxDirs {
+		oldestKey, oldest := "", now
+		for k, l := range c.listings {
+			if now.Sub(l.listed) >= c.ttl {
+				delete(c.listings, k)
+				continue
+			}
+			if l.listed.Before(oldest) {
+				oldestKey, oldest = k, l.listed
+			}
+		}
+		if len(c.listings) >= c.maxDirs {
+			delete(c.listings, oldestKey)
+		}
+	}
+	c.listings[key] = directoryListing{files: files, listed: now}
+}
+
+// Invalidate drops the cached listing of dir, so the next enumeration lists
+// the remote again.
+func (c *directoryCache) Invalidate(dir string) {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	delete(c.listings, directoryKey(dir))
+}
+
+// Len returns the number of cached listings.
+func (c *directoryCache) Len() int {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	return len(c.listings)
+}
+
+// directoryKey normalizes a relative directory for cache lookups
+// (forward slashes, no leading or trailing slash, case-insensitive, "" for
+// the root).
+func directoryKey(dir string) string {
+	key := strings.ToLower(strings.Trim(normalizePath(dir), "/"))
+	if key == "." {
+		return ""
+	}
+	return key
+}
@@ -0,0 +1,132 @@
+//go:build windows
+// +build windows
+
+package cloudfiles
+
+import (
+	"context"
+	"errors"
+	"sync"
+	"sync/atomic"
+	"testing"
+	"time"
+)
+
+func TestDirectoryCacheReusesListing(t *testing.T) {
+	c := newDirectoryCache(time.Minute)
+	now := time.Now()
+	c.now = func() time.Time { return now }
+
+	var calls int
+	list := func(ctx context.Context) ([]RemoteFileInfo, error) {
+		calls++
+		return []RemoteFileInfo{{Path: "Docs/a.txt"}}, nil
+	}
+
+	c.Load(context.Background(), "Docs", list)
+	files, err := c.Load(context.Background(), `\docs\`, list)
+	if err != nil || len(files) != 1 {
+		t.Fatalf("Expected the cached listing, got %v, %v", files, err)
+	}
+	if calls != 1 {
+		t.Errorf("Expected one remote listing, got %d", calls)
+	}
+
+	// Expired listings are listed again
+	now = now.Add(2 * time.Minute)
+	c.Load(context.Background(), "Docs", list)
+	if calls != 2 {
+		t.Errorf("Expected the expired listing to be refreshed, got %d calls", calls)
+	}
+
+	c.Invalidate("docs")
+	c.Load(context.Background(), "Docs", list)
+	if calls != 3 {
+		t.Errorf("Expected an invalidated listing to be refreshed, got %d calls", calls)
+	}
+}
+
+func TestDirectoryCacheSharesConcurrentLoads(t *testing.T) {
+	c := newDirectoryCache(time.Minute)
+	release := make(chan struct{})
+	var calls atomic.Int32
+	list := func(ctx context.Context) ([]RemoteFileInfo, error) {
+		calls.Add(1)
+		<-release
+		return []RemoteFileInfo{{Path: "a.txt"}}, nil
+	}
+
+	var wg sync.WaitGroup
+	for i := 0; i < 8; i++ {
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			if files, err := c.Load(context.Background(), "", list); err != nil || len(files) != 1 {
+				t.Errorf("Expected the shared listing, got %v, %v", files, err)
+			}
+		}()
+	}
+	time.Sleep(10 * time.Millisecond)
+	close(release)
+	wg.Wait()
+
+	if n := calls.Load(); n != 1 {
+		t.Errorf("Expected concurrent enumerations to share one listing, got %d", n)
+	}
+}
+
+func TestDirectoryCacheDoesNotCacheErrors(t *testing.T) {
+	c := newDirectoryCache(time.Minute)
+	fail := true
+	list := func(ctx context.Context) ([]RemoteFileInfo, error) {
+		if fail {
+			return nil, errors.New("connection reset")
+		}
+		return nil, nil
+	}
+
+	if _, err := c.Load(context.Background(), "a", list); err == nil {
+		t.Fatal("Expected the listing error")
+	}
+	fail = false
+	if _, err := c.Load(context.Background(), "a", list); err != nil {
+		t.Errorf("Expected the failed listing to be retried, got %v", err)
+	}
+	if c.Len() != 1 {
+		t.Errorf("Expected only the successful listing to be cached, got %d", c.Len())
+	}
+}
+
+func TestDirectoryCacheEvictsOldest(t *testing.T) {
+	c := newDirectoryCache(time.Hour)
+	c.maxDirs = 2
+	now := time.Now()
+	c.now = func() time.Time { return now }
+	empty := func(ctx context.Context) ([]RemoteFileInfo, error) { return nil, nil }
+
+	for _, dir := range []string{"a", "b", "c"} {
+		c.Load(context.Background(), dir, empty)
+		now = now.Add(time.Second)
+	}
+	if c.Len() != 2 {
+		t.Fatalf("Expected the cache to stay at 2 listings, got %d", c.Len())
+	}
+	if _, ok := c.listings["a"]; ok {
+		t.Error("Expected the oldest listing to be evicted")
+	}
+}
+
+func TestSyncRootRelativePath(t *testing.T) {
+	tests := []struct {
+		root, path, want string
+	}{
+		{`D:\Anemone\backup`, `\Anemone\backup\subdir\file.txt`, "subdir/file.txt"},
+		{`D:\test_anemone`, `\test_anemone\file.txt`, "file.txt"},
+		{`D:\test_anemone`, `\test_anemone`, ""},
+	}
+	for _, tt := range tests {
+		if got := syncRootRelativePath(tt.root, tt.path); got != tt.want {
+			t.Errorf("syncRootRelativePath(%q, %q) = %q, want %q", tt.root, tt.path, got, tt.want)
+		}
+	}
+}
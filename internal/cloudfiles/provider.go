@@ -8,7 +8,10 @@ import (
 	"context"
 	"fmt"
 	"io"
+	"path/filepath"
+	"strings"
 	"sync"
+	"time"
 
 	"go.uber.org/zap"
 )
@@ -22,7 +25,15 @@ type CloudFilesProvider struct {
 	localPath    string // Local folder path (sync root)
 	remotePath   string // Remote SMB path (for hydration)
 	providerName string
-	useCGOBridge bool   // Use CGO bridge for callbacks
+	useCGOBridge bool // Use CGO bridge for callbacks
+	readAhead    int  // Hydration pipeline depth (0 = default)
+	chunkSize    int64
+	parallel     ParallelFetchConfig
+	prefetch     PrefetchPolicy
+	blockCache   *BlockCache
+	batch        TransferBatchConfig
+	population   PopulationConfig
+	directories  *directoryCache // Listings served to FETCH_PLACEHOLDERS (partial population)
 
 	// Components
 	syncRoot     *SyncRootManager
@@ -50,13 +61,35 @@ type DataSource interface {
 	ListFiles(ctx context.Context) ([]RemoteFileInfo, error)
 }
 
+// StreamingDataSource is a DataSource that can list incrementally, so
+// placeholders are created while the listing is still in progress.
+type StreamingDataSource interface {
+	DataSource
+	// ListFilesStream calls fn for every remote directory and file, each
+	// directory before its contents. An error from fn stops the listing.
+	ListFilesStream(ctx context.Context, fn func(RemoteFileInfo) error) error
+}
+
 // ProviderConfig contains configuration for CloudFilesProvider.
 type ProviderConfig struct {
-	LocalPath    string // Local folder to sync
-	RemotePath   string // Remote SMB path
-	ProviderName string // Provider name for Windows (default: "AnemoneSync")
-	Logger       *zap.Logger
-	UseCGOBridge bool // Use CGO bridge for callbacks (recommended for proper hydration)
+	LocalPath          string // Local folder to sync
+	RemotePath         string // Remote SMB path
+	ProviderName       string // Provider name for Windows (default: "AnemoneSync")
+	Logger             *zap.Logger
+	UseCGOBridge       bool                // Use CGO bridge for callbacks (recommended for proper hydration)
+	BridgeWorkers      int                 // Bridge consumer threads for this sync root (0 = default)
+	TransferBuffers    int                 // Bridge-owned hydration buffers (0 = default)
+	HydrationReadAhead int                 // Chunks read ahead of the transfer during hydration (0 = default)
+	HydrationChunkSize int64               // Bytes per CfExecute transfer (0 = default 1MB)
+	ParallelFetch      ParallelFetchConfig // Multi-range hydration of large files (disabled by default)
+	HydrationPrefetch  PrefetchPolicy      // Speculative transfer of the optional FETCH_DATA range (disabled by default)
+	BlockCache         BlockCacheConfig    // Local cache of hydrated blocks (disabled when Dir is empty)
+	TransferBatch      TransferBatchConfig // Chunks per bridge transfer call and progress rate (0 = defaults)
+	QueueLimit         int                 // Max queued callback requests per sync root (0 = default)
+	QueueWait          time.Duration       // Callback wait budget when the bridge queue is full (0 = default)
+	FetchPriority      FetchPriorityPolicy // Order of queued hydrations: foreground opens first, scanners last
+	Placeholders       PlaceholderConfig   // Workers and batch size of bulk placeholder creation (0 = defaults)
+	Population         PopulationConfig    // On-demand directory population instead of upfront placeholders (disabled by default)
 }
 
 // NewCloudFilesProvider creates a new CloudFilesProvider.
@@ -73,10 +106,16 @@ func NewCloudFilesProvider(config ProviderConfig) (*CloudFilesProvider, error) {
 
 	// Create sync root manager
 	syncRootConfig := SyncRootConfig{
-		Path:         config.LocalPath,
-		ProviderName: config.ProviderName,
-		ProviderID:   DefaultProviderID(),
-		UseCGOBridge: config.UseCGOBridge,
+		Path:            config.LocalPath,
+		ProviderName:    config.ProviderName,
+		ProviderID:      DefaultProviderID(),
+		UseCGOBridge:    config.UseCGOBridge,
+		BridgeWorkers:   config.BridgeWorkers,
+		TransferBuffers: config.TransferBuffers,
+		QueueLimit:      config.QueueLimit,
+		QueueWait:       config.QueueWait,
+		FetchPriority:   config.FetchPriority,
+		Population:      config.Population,
 	}
 
 	syncRoot, err := NewSyncRootManager(syncRootConfig)
@@ -84,19 +123,47 @@ func NewCloudFilesProvider(config ProviderConfig) (*CloudFilesProvider, error) {
 		return nil, fmt.Errorf("failed to create sync root manager: %w", err)
 	}
 
+	// Open the block cache of hydrated ranges
+	var blockCache *BlockCache
+	if config.BlockCache.Dir != "" {
+		blockCache, err = NewBlockCache(config.BlockCache, config.Logger.Named("block_cache"))
+		if err != nil {
+			return nil, fmt.Errorf("failed to open block cache: %w", err)
+		}
+	}
+
 	provider := &CloudFilesProvider{
 		localPath:    config.LocalPath,
 		remotePath:   config.RemotePath,
 		providerName: config.ProviderName,
 		useCGOBridge: config.UseCGOBridge,
+		readAhead:    config.HydrationReadAhead,
+		chunkSize:    config.HydrationChunkSize,
+		parallel:     config.ParallelFetch,
+		prefetch:     config.HydrationPrefetch,
+		blockCache:   blockCache,
+		batch:        config.TransferBatch,
+		population:   config.Population,
 		syncRoot:     syncRoot,
 		placeholders: NewPlaceholderManager(syncRoot),
 		logger:       config.Logger,
 	}
+	provider.placeholders.bulk = config.Placeholders
+	if config.Population.Partial {
+		provider.directories = newDirectoryCache(config.Population.CacheTTL)
+	}
+	syncRoot.SetHydrationChangeCallback(provider.noteHydrationChange)
 
 	return provider, nil
 }
 
+// GetDataSource returns the data source for hydration (nil if not set).
+func (p *CloudFilesProvider) GetDataSource() DataSource {
+	p.mu.RLock()
+	defer p.mu.RUnlock()
+	return p.dataSource
+}
+
 // SetDataSource sets the data source for hydration.
 func (p *CloudFilesProvider) SetDataSource(source DataSource) {
 	p.mu.Lock()
@@ -107,6 +174,12 @@ func (p *CloudFilesProvider) SetDataSource(source DataSource) {
 	if source != nil {
 		adapter := &dataSourceAdapter{source: source, remotePath: p.remotePath}
 		p.hydration = NewHydrationHandler(p.syncRoot, adapter, p.logger)
+		p.hydration.SetReadAhead(p.readAhead)
+		p.hydration.SetChunkSize(p.chunkSize)
+		p.hydration.SetParallelFetch(p.parallel)
+		p.hydration.SetPrefetchPolicy(p.prefetch)
+		p.hydration.SetBlockCache(p.blockCache)
+		p.hydration.SetTransferBatch(p.batch)
 
 		// IMPORTANT: Set up global data provider for CGO callbacks
 		// The new architecture calls Go directly from C, so we need a global provider
@@ -153,6 +226,9 @@ func (p *CloudFilesProvider) Initialize(ctx context.Context) error {
 		if p.hydration != nil {
 			p.syncRoot.SetFetchDataCallback(p.hydration.handleFetchDataCallback)
 		}
+		if p.population.Partial {
+			p.syncRoot.SetFetchPlaceholdersCallback(p.handleFetchPlaceholders)
+		}
 
 		if err := p.syncRoot.ConnectWithBridge(p.ctx, p.logger); err != nil {
 			p.logger.Error("failed to connect with CGO bridge, falling back to passive mode",
@@ -204,6 +280,107 @@ func (p *CloudFilesProvider) SyncPlaceholders(ctx context.Context, remoteFiles [
 	return nil
 }
 
+// SyncPlaceholdersStream creates placeholders while source lists the remote
+// tree, so Explorer shows the first folders long before a large share is
+// fully listed. Returns the number of file placeholders created.
+func (p *CloudFilesProvider) SyncPlaceholdersStream(ctx context.Context, source StreamingDataSource) (int, error) {
+	p.mu.RLock()
+	if !p.initialized {
+		p.mu.RUnlock()
+		return 0, fmt.Errorf("provider not initialized")
+	}
+	p.mu.RUnlock()
+
+	p.logger.Info("syncing placeholders from streaming listing")
+
+	bulk := p.placeholders.NewBulkCreator(ctx)
+	listErr := source.ListFilesStream(ctx, bulk.Add)
+	created, err := bulk.Close()
+	if err != nil {
+		return created, fmt.Errorf("failed to create placeholders: %w", err)
+	}
+	if listErr != nil {
+		return created, fmt.Errorf("failed to list remote files: %w", listErr)
+	}
+
+	p.logger.Info("placeholders synced successfully",
+		zap.Int("placeholder_count", created),
+	)
+
+	return created, nil
+}
+
+// PartialPopulation reports whether directories are populated on first
+// enumeration instead of by SyncPlaceholders.
+func (p *CloudFilesProvider) PartialPopulation() bool {
+	return p.population.Partial
+}
+
+// InvalidateDirectory drops the cached listing of a directory (relative to
+// the sync root), so the next FETCH_PLACEHOLDERS lists the remote again.
+func (p *CloudFilesProvider) InvalidateDirectory(relativeDir string) {
+	if p.directories != nil {
+		p.directories.Invalidate(relativeDir)
+	}
+}
+
+// SetNotifyBatchCallback sets the callback receiving the deletes and renames
+// made in the sync root, coalesced by parent directory (bridge only).
+func (p *CloudFilesProvider) SetNotifyBatchCallback(cb NotifyBatchCallback) {
+	p.syncRoot.SetNotifyBatchCallback(cb)
+}
+
+// RelativePath converts a full normalized path (as in notifications) to a
+// path relative to the sync root, with forward slashes ("" for the root
+// itself). It returns false if the path is outside the sync root.
+func (p *CloudFilesProvider) RelativePath(normalizedPath string) (string, bool) {
+	root := strings.Trim(strings.TrimPrefix(p.localPath, filepath.VolumeName(p.localPath)), `\/`)
+	path := strings.TrimLeft(normalizedPath, `\/`)
+
+	if root != "" {
+		if len(path) < len(root) || !strings.EqualFold(path[:len(root)], root) {
+			return "", false
+		}
+		path = path[len(root):]
+		if path != "" && path[0] != '\\' && path[0] != '/' {
+			return "", false // Sibling sharing the root's name as a prefix
+		}
+	}
+	return strings.ReplaceAll(strings.Trim(path, `\/`), "\\", "/"), true
+}
+
+// handleFetchPlaceholders lists one remote directory for FETCH_PLACEHOLDERS.
+func (p *CloudFilesProvider) handleFetchPlaceholders(directoryPath string) ([]RemoteFileInfo, error) {
+	p.mu.RLock()
+	source, ctx := p.dataSource, p.ctx
+	p.mu.RUnlock()
+
+	lister, ok := source.(DirectoryDataSource)
+	if !ok {
+		return nil, fmt.Errorf("data source cannot list directories")
+	}
+	if ctx == nil {
+		ctx = context.Background()
+	}
+
+	relativeDir := syncRootRelativePath(p.localPath, directoryPath)
+	ctx, cancel := context.WithTimeout(ctx, populationListTimeout)
+	defer cancel()
+
+	files, err := p.directories.Load(ctx, relativeDir, func(ctx context.Context) ([]RemoteFileInfo, error) {
+		return lister.ListDirectory(ctx, relativeDir)
+	})
+	if err != nil {
+		return nil, fmt.Errorf("failed to list %s: %w", relativeDir, err)
+	}
+
+	p.logger.Debug("populated directory",
+		zap.String("dir", relativeDir),
+		zap.Int("entries", len(files)),
+	)
+	return files, nil
+}
+
 // SyncFromManifest syncs placeholders using manifest file entries.
 func (p *CloudFilesProvider) SyncFromManifest(ctx context.Context, manifestFiles []ManifestFileEntry) error {
 	remoteFiles := FromManifestFiles(manifestFiles)
@@ -266,6 +443,7 @@ func (p *CloudFilesProvider) Close() error {
 		return err
 	}
 
+	p.closeDataSource()
 	p.initialized = false
 	return nil
 }
@@ -281,10 +459,21 @@ func (p *CloudFilesProvider) Unregister() error {
 		return err
 	}
 
+	p.closeDataSource()
 	p.initialized = false
 	return nil
 }
 
+// closeDataSource releases the data source's connections, if it holds any
+// (io.Closer). Caller must hold p.mu.
+func (p *CloudFilesProvider) closeDataSource() {
+	if closer, ok := p.dataSource.(io.Closer); ok {
+		if err := closer.Close(); err != nil {
+			p.logger.Warn("failed to close data source", zap.Error(err))
+		}
+	}
+}
+
 // IsInitialized returns whether the provider is initialized.
 func (p *CloudFilesProvider) IsInitialized() bool {
 	p.mu.RLock()
@@ -401,6 +590,18 @@ func (p *CloudFilesProvider) GetSpaceUsage(ctx context.Context) (SpaceUsage, err
 	return dehydration.GetSpaceUsage(ctx)
 }
 
+// noteHydrationChange tells the dehydration manager about a file the bridge
+// hydrated or Windows dehydrated, keeping its index current without a walk.
+func (p *CloudFilesProvider) noteHydrationChange(filePath string) {
+	p.mu.RLock()
+	dehydration := p.dehydration
+	p.mu.RUnlock()
+
+	if dehydration != nil {
+		dehydration.NoteHydrationChange(syncRootRelativePath(p.localPath, filePath))
+	}
+}
+
 // GetDehydrationStats returns dehydration statistics.
 func (p *CloudFilesProvider) GetDehydrationStats() DehydrationStats {
 	p.mu.RLock()
@@ -423,4 +624,3 @@ func (p *CloudFilesProvider) GetDehydrationManager() *DehydrationManager {
 	}
 	return p.dehydration
 }
-
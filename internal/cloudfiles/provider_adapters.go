@@ -27,7 +27,10 @@ func (p *CloudFilesProvider) handleFetchData(info *FetchDataInfo) error {
 		return fmt.Errorf("no data source configured")
 	}
 
-	ctx := context.Background() // TODO: Use cancellable context
+	ctx := info.Context
+	if ctx == nil {
+		ctx = context.Background()
+	}
 	return hydration.HandleFetchData(ctx, info)
 }
 
@@ -76,6 +79,22 @@ func (a *dataSourceAdapter) GetFileReader(ctx context.Context, relativePath stri
 	return a.source.GetFileReader(ctx, relativePath, offset)
 }
 
+// GetFileReaderAt implements RangeDataProvider when the source supports it.
+func (a *dataSourceAdapter) GetFileReaderAt(ctx context.Context, relativePath string) (RemoteFile, error) {
+	if rp, ok := a.source.(RangeDataProvider); ok {
+		return rp.GetFileReaderAt(ctx, relativePath)
+	}
+	return nil, ErrReaderAtUnsupported
+}
+
+// FileVersion implements FileVersionProvider when the source supports it.
+func (a *dataSourceAdapter) FileVersion(relativePath string) (string, bool) {
+	if vp, ok := a.source.(FileVersionProvider); ok {
+		return vp.FileVersion(relativePath)
+	}
+	return "", false
+}
+
 // SMBDataSource implements DataSource for SMB shares.
 type SMBDataSource struct {
 	client         SMBClient
@@ -266,3 +266,25 @@ func TestSMBDataSource(t *testing.T) {
 		t.Errorf("sharePath mismatch: got %s", source.sharePath)
 	}
 }
+
+func TestCloudFilesProviderRelativePath(t *testing.T) {
+	p := &CloudFilesProvider{localPath: `D:\Anemone\backup`}
+
+	tests := []struct {
+		path string
+		want string
+		ok   bool
+	}{
+		{`\Anemone\backup\subdir\file.txt`, "subdir/file.txt", true},
+		{`\anemone\BACKUP\file.txt`, "file.txt", true},
+		{`\Anemone\backup`, "", true},
+		{`\Anemone\backup2\file.txt`, "", false},
+		{`\$Recycle.Bin\S-1-5-21\$R0K8X2D`, "", false},
+	}
+	for _, tt := range tests {
+		got, ok := p.RelativePath(tt.path)
+		if got != tt.want || ok != tt.ok {
+			t.Errorf("RelativePath(%q) = %q, %v, want %q, %v", tt.path, got, ok, tt.want, tt.ok)
+		}
+	}
+}
@@ -9,9 +9,12 @@ import (
 	"fmt"
 	"io"
 	"path/filepath"
+	"strconv"
 	"strings"
+	"sync"
 	"time"
 
+	"github.com/juste-un-gars/anemone_sync_windows/internal/smb"
 	"go.uber.org/zap"
 )
 
@@ -25,11 +28,14 @@ type SMBClientAdapter struct {
 // SMBFileClient defines the SMB operations needed for cloud files.
 type SMBFileClient interface {
 	// OpenFile opens a remote file for streaming reads.
-	OpenFile(remotePath string) (io.ReadCloser, error)
+	OpenFile(ctx context.Context, remotePath string) (io.ReadCloser, error)
+	// OpenFileAt opens a remote file for positional reads. Cancelling ctx
+	// aborts reads in flight on the file.
+	OpenFileAt(ctx context.Context, remotePath string) (RemoteFile, error)
 	// ReadFile reads the entire file content.
-	ReadFile(remotePath string) ([]byte, error)
+	ReadFile(ctx context.Context, remotePath string) ([]byte, error)
 	// ListRemote lists files in a directory.
-	ListRemote(remotePath string) ([]SMBRemoteFileInfo, error)
+	ListRemote(ctx context.Context, remotePath string) ([]SMBRemoteFileInfo, error)
 	// IsConnected returns true if connected to the SMB server.
 	IsConnected() bool
 }
@@ -55,18 +61,20 @@ func NewSMBClientAdapter(client SMBFileClient, sharePath string, logger *zap.Log
 	}
 }
 
-// GetFileReader implements DataSource.
-func (a *SMBClientAdapter) GetFileReader(ctx context.Context, relativePath string, offset int64) (io.ReadCloser, error) {
-	// Build full remote path
+// remotePath builds the full SMB path of a file relative to the share path.
+func (a *SMBClientAdapter) remotePath(relativePath string) string {
 	remotePath := relativePath
 	if a.sharePath != "" {
 		remotePath = filepath.Join(a.sharePath, relativePath)
 	}
 	// Normalize to forward slashes for SMB
-	remotePath = strings.ReplaceAll(remotePath, "\\", "/")
+	return strings.ReplaceAll(remotePath, "\\", "/")
+}
 
+// GetFileReader implements DataSource.
+func (a *SMBClientAdapter) GetFileReader(ctx context.Context, relativePath string, offset int64) (io.ReadCloser, error) {
 	// Open the file
-	reader, err := a.client.OpenFile(remotePath)
+	reader, err := a.client.OpenFile(ctx, a.remotePath(relativePath))
 	if err != nil {
 		return nil, fmt.Errorf("failed to open remote file: %w", err)
 	}
@@ -82,11 +90,27 @@ func (a *SMBClientAdapter) GetFileReader(ctx context.Context, relativePath strin
 	return reader, nil
 }
 
+// GetFileReaderAt implements RangeDataProvider. Reads go straight to the
+// requested offset over SMB instead of streaming through the file head,
+// and are aborted on the server when ctx is cancelled.
+func (a *SMBClientAdapter) GetFileReaderAt(ctx context.Context, relativePath string) (RemoteFile, error) {
+	file, err := a.client.OpenFileAt(ctx, a.remotePath(relativePath))
+	if err != nil {
+		return nil, fmt.Errorf("failed to open remote file: %w", err)
+	}
+	return file, nil
+}
+
 // ListFiles implements DataSource.
 func (a *SMBClientAdapter) ListFiles(ctx context.Context) ([]RemoteFileInfo, error) {
 	// List files recursively
 	var allFiles []RemoteFileInfo
-	err := a.listRecursive(ctx, a.sharePath, &allFiles)
+	err := a.listRecursive(ctx, a.sharePath, func(f RemoteFileInfo) error {
+		if !f.IsDirectory {
+			allFiles = append(allFiles, f)
+		}
+		return nil
+	})
 	if err != nil {
 		return nil, err
 	}
@@ -98,8 +122,54 @@ func (a *SMBClientAdapter) ListFiles(ctx context.Context) ([]RemoteFileInfo, err
 	return allFiles, nil
 }
 
-// listRecursive lists files recursively from the given path.
-func (a *SMBClientAdapter) listRecursive(ctx context.Context, path string, files *[]RemoteFileInfo) error {
+// ListFilesStream implements StreamingDataSource: directories and files are
+// passed to fn as they are listed, each directory before its contents.
+func (a *SMBClientAdapter) ListFilesStream(ctx context.Context, fn func(RemoteFileInfo) error) error {
+	return a.listRecursive(ctx, a.sharePath, fn)
+}
+
+// ListDirectory implements DirectoryDataSource: it lists the direct children
+// of one directory, for partial population.
+func (a *SMBClientAdapter) ListDirectory(ctx context.Context, relativeDir string) ([]RemoteFileInfo, error) {
+	var files []RemoteFileInfo
+	err := a.listDirectory(ctx, a.remotePath(relativeDir), func(f RemoteFileInfo, _ string) error {
+		files = append(files, f)
+		return nil
+	})
+	if err != nil {
+		return nil, err
+	}
+	return files, nil
+}
+
+// listRecursive lists files recursively from the given path, calling fn for
+// every entry. Directories are listed concurrently (see smb.WalkDirs), but fn
+// is called by one listing at a time, and each directory before its
+// contents. An error from fn stops the listing.
+func (a *SMBClientAdapter) listRecursive(ctx context.Context, path string, fn func(RemoteFileInfo) error) error {
+	var fnMu sync.Mutex
+	return smb.WalkDirs(ctx, path, smb.DefaultWalkWorkers, func(ctx context.Context, dir string) ([]string, error) {
+		var subdirs []string
+		err := a.listDirectory(ctx, dir, func(f RemoteFileInfo, fullPath string) error {
+			fnMu.Lock()
+			err := fn(f)
+			fnMu.Unlock()
+			if err != nil {
+				return err
+			}
+			if f.IsDirectory {
+				// Recurse into directory
+				subdirs = append(subdirs, fullPath)
+			}
+			return nil
+		})
+		return subdirs, err
+	})
+}
+
+// listDirectory lists one directory, calling fn for every entry with its
+// path relative to the share path and its full SMB path.
+func (a *SMBClientAdapter) listDirectory(ctx context.Context, path string, fn func(f RemoteFileInfo, fullPath string) error) error {
 	// Check context cancellation
 	select {
 	case <-ctx.Done():
@@ -108,7 +178,7 @@ func (a *SMBClientAdapter) listRecursive(ctx context.Context, path string, files
 	}
 
 	// List current directory
-	entries, err := a.client.ListRemote(path)
+	entries, err := a.client.ListRemote(ctx, path)
 	if err != nil {
 		return fmt.Errorf("failed to list %s: %w", path, err)
 	}
@@ -131,25 +201,19 @@ func (a *SMBClientAdapter) listRecursive(ctx context.Context, path string, files
 			fullPath = entry.Name
 		}
 
-		if entry.IsDir {
-			// Recurse into directory
-			if err := a.listRecursive(ctx, fullPath, files); err != nil {
-				return err
-			}
-		} else {
-			// Calculate relative path
-			relativePath := fullPath
-			if a.sharePath != "" && strings.HasPrefix(relativePath, a.sharePath) {
-				relativePath = strings.TrimPrefix(relativePath, a.sharePath)
-				relativePath = strings.TrimPrefix(relativePath, "/")
-			}
+		// Calculate relative path
+		relativePath := fullPath
+		if a.sharePath != "" && strings.HasPrefix(relativePath, a.sharePath) {
+			relativePath = strings.TrimPrefix(relativePath, a.sharePath)
+			relativePath = strings.TrimPrefix(relativePath, "/")
+		}
 
-			*files = append(*files, RemoteFileInfo{
-				Path:        relativePath,
-				Size:        entry.Size,
-				ModTime:     entry.ModTime,
-				IsDirectory: false,
-			})
+		info := RemoteFileInfo{Path: relativePath, ModTime: entry.ModTime, IsDirectory: entry.IsDir}
+		if !entry.IsDir {
+			info.Size = entry.Size
+		}
+		if err := fn(info, fullPath); err != nil {
+			return err
 		}
 	}
 
@@ -157,6 +221,7 @@ func (a *SMBClientAdapter) listRecursive(ctx context.Context, path string, files
 }
 
 // offsetReader wraps a reader and skips to the given offset.
+// Range reads use GetFileReaderAt; this serves plain streaming readers.
 type offsetReader struct {
 	reader       io.ReadCloser
 	offset       int64
@@ -164,7 +229,17 @@ type offsetReader struct {
 }
 
 func (r *offsetReader) Read(p []byte) (n int, err error) {
-	// Skip to offset on first read
+	// Seek directly when the remote file supports it (SMB files do)
+	if !r.offsetDone && r.offset > 0 {
+		if seeker, ok := r.reader.(io.Seeker); ok {
+			if _, err := seeker.Seek(r.offset, io.SeekStart); err != nil {
+				return 0, fmt.Errorf("failed to seek to offset: %w", err)
+			}
+			r.offsetDone = true
+		}
+	}
+
+	// Otherwise skip to offset on first read
 	if !r.offsetDone && r.offset > 0 {
 		buf := make([]byte, 8192)
 		remaining := r.offset
@@ -190,15 +265,24 @@ func (r *offsetReader) Close() error {
 }
 
 // ManifestDataSource wraps a manifest and provides file listing.
+// Entries are kept in a ManifestIndex, so lookups and listings decode them
+// on demand instead of holding one struct per file.
 type ManifestDataSource struct {
-	files       []ManifestFileEntry
-	smbAdapter  *SMBClientAdapter
+	index      *ManifestIndex
+	smbAdapter *SMBClientAdapter
 }
 
 // NewManifestDataSource creates a data source from manifest entries.
 func NewManifestDataSource(files []ManifestFileEntry, smbAdapter *SMBClientAdapter) *ManifestDataSource {
+	index, _ := NewManifestIndex(EncodeManifestIndex(files)) // Cannot fail on fresh data
+	return NewManifestIndexDataSource(index, smbAdapter)
+}
+
+// NewManifestIndexDataSource creates a data source from a manifest index,
+// typically memory-mapped by OpenManifestIndex. The caller closes the index.
+func NewManifestIndexDataSource(index *ManifestIndex, smbAdapter *SMBClientAdapter) *ManifestDataSource {
 	return &ManifestDataSource{
-		files:      files,
+		index:      index,
 		smbAdapter: smbAdapter,
 	}
 }
@@ -211,7 +295,59 @@ func (m *ManifestDataSource) GetFileReader(ctx context.Context, relativePath str
 	return m.smbAdapter.GetFileReader(ctx, relativePath, offset)
 }
 
+// GetFileReaderAt implements RangeDataProvider by delegating to SMB adapter.
+func (m *ManifestDataSource) GetFileReaderAt(ctx context.Context, relativePath string) (RemoteFile, error) {
+	if m.smbAdapter == nil {
+		return nil, fmt.Errorf("no SMB adapter configured")
+	}
+	return m.smbAdapter.GetFileReaderAt(ctx, relativePath)
+}
+
+// FileVersion implements FileVersionProvider from the manifest entry:
+// the content hash when known, else the mtime.
+func (m *ManifestDataSource) FileVersion(relativePath string) (string, bool) {
+	f, ok := m.index.Lookup(relativePath)
+	if !ok {
+		return "", false
+	}
+	if f.Hash != "" {
+		return "h" + f.Hash, true
+	}
+	return "m" + strconv.FormatInt(f.MTime, 10), true
+}
+
 // ListFiles implements DataSource by returning manifest files.
 func (m *ManifestDataSource) ListFiles(ctx context.Context) ([]RemoteFileInfo, error) {
-	return FromManifestFiles(m.files), nil
+	files := make([]RemoteFileInfo, 0, m.index.Len())
+	err := m.ListFilesStream(ctx, func(f RemoteFileInfo) error {
+		files = append(files, f)
+		return nil
+	})
+	if err != nil {
+		return nil, err
+	}
+	return files, nil
+}
+
+// ListFilesStream implements StreamingDataSource: manifest files are passed
+// to fn in path order, decoded one at a time. The manifest has no directory
+// entries; placeholder creation adds the parents of each file.
+func (m *ManifestDataSource) ListFilesStream(ctx context.Context, fn func(RemoteFileInfo) error) error {
+	var fnErr error
+	err := m.index.Range(func(f ManifestFileEntry) bool {
+		if fnErr = ctx.Err(); fnErr != nil {
+			return false
+		}
+		fnErr = fn(RemoteFileInfo{
+			Path:    f.Path,
+			Size:    f.Size,
+			ModTime: time.Unix(f.MTime, 0),
+			Hash:    f.Hash,
+		})
+		return fnErr == nil
+	})
+	if fnErr != nil {
+		return fnErr
+	}
+	return err
 }
@@ -10,6 +10,7 @@ import (
 	"os"
 	"path/filepath"
 	"sync"
+	"time"
 	"unsafe"
 
 	"go.uber.org/zap"
@@ -27,6 +28,12 @@ type SyncRootManager struct {
 	providerVersion string
 	providerID      GUID
 	useCGOBridge    bool
+	bridgeWorkers   int
+	transferBuffers int
+	queueLimit      int
+	queueWait       time.Duration
+	fetchPriority   FetchPriorityPolicy
+	population      PopulationConfig
 
 	// State
 	registered bool
@@ -40,6 +47,9 @@ type SyncRootManager struct {
 	cancelFetchCallback  CancelFetchCallback
 	notifyDeleteCallback NotifyDeleteCallback
 	notifyRenameCallback NotifyRenameCallback
+	notifyBatchCallback  NotifyBatchCallback
+	fetchPlaceholdersCb  FetchPlaceholdersCallback
+	hydrationChangeCb    HydrationChangeCallback
 }
 
 // FetchDataCallback is called when a placeholder needs to be hydrated.
@@ -49,11 +59,19 @@ type FetchDataCallback func(info *FetchDataInfo) error
 type FetchDataInfo struct {
 	ConnectionKey  CF_CONNECTION_KEY
 	TransferKey    CF_TRANSFER_KEY
-	RequestKey     int64 // Required for CfExecute in async operations
+	RequestKey     int64  // Required for CfExecute in async operations
 	FilePath       string // Full path to the file
 	FileSize       int64
 	RequiredOffset int64
 	RequiredLength int64
+	OptionalOffset int64  // Range Windows would also accept (prefetch hint)
+	OptionalLength int64  // 0 = no optional range
+	PriorityHint   int    // Windows priority hint, 0 (lowest) to 15 (bridge only)
+	ProcessID      uint32 // Process that triggered the hydration (0 = unknown)
+	ProcessImage   string // Image path of that process ("" = unknown)
+
+	// Context is cancelled when Windows cancels the fetch (bridge only, nil otherwise)
+	Context context.Context
 }
 
 // CancelFetchCallback is called when a fetch operation should be cancelled.
@@ -65,13 +83,33 @@ type NotifyDeleteCallback func(filePath string, isDirectory bool) bool
 // NotifyRenameCallback is called when a file is being renamed.
 type NotifyRenameCallback func(sourcePath, targetPath string, isDirectory bool) bool
 
+// NotifyBatchCallback receives delete/rename notifications coalesced by
+// parent directory (bridge only). When set, it replaces the delete and
+// rename callbacks.
+type NotifyBatchCallback func(batch *NotifyBatch)
+
+// FetchPlaceholdersCallback returns the entries of a directory Windows is
+// enumerating for the first time (partial population, bridge only).
+// directoryPath is the full normalized path of the directory.
+type FetchPlaceholdersCallback func(directoryPath string) ([]RemoteFileInfo, error)
+
+// HydrationChangeCallback is called with the full normalized path of a file
+// whose local content changed: data was served for it or it was dehydrated.
+type HydrationChangeCallback func(filePath string)
+
 // SyncRootConfig contains configuration for creating a sync root.
 type SyncRootConfig struct {
-	Path            string // Local folder path
-	ProviderName    string // e.g., "AnemoneSync"
-	ProviderVersion string // e.g., "1.0.0"
-	ProviderID      GUID   // Unique identifier for the provider
-	UseCGOBridge    bool   // Use CGO bridge for callbacks (recommended)
+	Path            string              // Local folder path
+	ProviderName    string              // e.g., "AnemoneSync"
+	ProviderVersion string              // e.g., "1.0.0"
+	ProviderID      GUID                // Unique identifier for the provider
+	UseCGOBridge    bool                // Use CGO bridge for callbacks (recommended)
+	BridgeWorkers   int                 // Bridge consumer threads for this sync root (0 = default)
+	TransferBuffers int                 // Bridge-owned hydration buffers (0 = default)
+	QueueLimit      int                 // Max queued callback requests per sync root (0 = default)
+	QueueWait       time.Duration       // Callback wait budget when the queue is full (0 = default)
+	FetchPriority   FetchPriorityPolicy // Order of queued hydrations (bridge only)
+	Population      PopulationConfig    // Upfront or on-demand (FETCH_PLACEHOLDERS) namespace creation
 }
 
 // DefaultProviderID returns a default GUID for AnemoneSync.
@@ -109,6 +147,12 @@ func NewSyncRootManager(config SyncRootConfig) (*SyncRootManager, error) {
 		providerVersion: config.ProviderVersion,
 		providerID:      config.ProviderID,
 		useCGOBridge:    config.UseCGOBridge,
+		bridgeWorkers:   config.BridgeWorkers,
+		transferBuffers: config.TransferBuffers,
+		queueLimit:      config.QueueLimit,
+		queueWait:       config.QueueWait,
+		fetchPriority:   config.FetchPriority,
+		population:      config.Population,
 	}, nil
 }
 
@@ -161,6 +205,13 @@ func (m *SyncRootManager) Register() error {
 	flags := CF_REGISTER_FLAG_UPDATE |
 		CF_REGISTER_FLAG_DISABLE_ON_DEMAND_POPULATION_ON_ROOT |
 		CF_REGISTER_FLAG_MARK_IN_SYNC_ON_ROOT
+
+	// Partial population: Windows asks for each directory, the root included,
+	// the first time it is enumerated
+	if m.population.Partial {
+		policies.Population.Primary = CF_POPULATION_POLICY_PARTIAL
+		flags &^= CF_REGISTER_FLAG_DISABLE_ON_DEMAND_POPULATION_ON_ROOT
+	}
 	if err := RegisterSyncRoot(m.path, registration, policies, flags); err != nil {
 		// Check if already registered (not an error)
 		if isAlreadyExistsError(err) {
@@ -263,15 +314,21 @@ func (m *SyncRootManager) ConnectWithBridge(ctx context.Context, logger *zap.Log
 
 	// Create bridge manager
 	bridge, err := NewBridgeManager(BridgeConfig{
-		SyncRootPath: m.path,
-		Logger:       logger,
+		SyncRootPath:      m.path,
+		Logger:            logger,
+		Workers:           m.bridgeWorkers,
+		TransferBuffers:   m.transferBuffers,
+		QueueLimit:        m.queueLimit,
+		QueueWaitBudget:   m.queueWait,
+		Priority:          m.fetchPriority,
+		PartialPopulation: m.population.Partial,
 	})
 	if err != nil {
 		return fmt.Errorf("failed to create bridge manager: %w", err)
 	}
 
 	// Set up handlers that forward to our callbacks
-	bridge.SetHandlers(BridgeHandlers{
+	handlers := BridgeHandlers{
 		OnFetchData: func(req *BridgeFetchDataRequest) error {
 			m.mu.RLock()
 			cb := m.fetchDataCallback
@@ -289,9 +346,19 @@ func (m *SyncRootManager) ConnectWithBridge(ctx context.Context, logger *zap.Log
 				FileSize:       req.FileSize,
 				RequiredOffset: req.RequiredOffset,
 				RequiredLength: req.RequiredLength,
+				OptionalOffset: req.OptionalOffset,
+				OptionalLength: req.OptionalLength,
+				PriorityHint:   req.PriorityHint,
+				ProcessID:      req.ProcessID,
+				ProcessImage:   req.ProcessImage,
+				Context:        req.Context,
 			}
 
-			return cb(info)
+			if err := cb(info); err != nil {
+				return err
+			}
+			m.notifyHydrationChange(req.FilePath)
+			return nil
 		},
 		OnCancelFetch: func(filePath string) {
 			m.mu.RLock()
@@ -322,7 +389,23 @@ func (m *SyncRootManager) ConnectWithBridge(ctx context.Context, logger *zap.Log
 			}
 			return true
 		},
-	})
+		OnFetchPlaceholders: func(req *BridgeFetchPlaceholdersRequest) ([]RemoteFileInfo, error) {
+			m.mu.RLock()
+			cb := m.fetchPlaceholdersCb
+			m.mu.RUnlock()
+
+			if cb == nil {
+				return nil, fmt.Errorf("no fetch placeholders callback registered")
+			}
+			return cb(req.DirectoryPath)
+		},
+		OnNotifyDehydrated: m.notifyHydrationChange,
+	}
+	// Notifications are only held for coalescing when batches are consumed
+	if m.notifyBatchCallback != nil {
+		handlers.OnNotifyBatch = m.onNotifyBatch
+	}
+	bridge.SetHandlers(handlers)
 
 	// Start the bridge
 	if err := bridge.Start(ctx); err != nil {
@@ -375,6 +458,65 @@ func (m *SyncRootManager) SetNotifyRenameCallback(cb NotifyRenameCallback) {
 	m.notifyRenameCallback = cb
 }
 
+// SetNotifyBatchCallback sets the callback for coalesced delete/rename
+// notifications. Without one, notifications are not coalesced.
+func (m *SyncRootManager) SetNotifyBatchCallback(cb NotifyBatchCallback) {
+	m.mu.Lock()
+	defer m.mu.Unlock()
+	m.notifyBatchCallback = cb
+
+	if m.bridgeManager != nil {
+		var handler func(*NotifyBatch)
+		if cb != nil {
+			handler = m.onNotifyBatch
+		}
+		m.bridgeManager.SetNotifyBatchHandler(handler)
+	}
+}
+
+// onNotifyBatch forwards a batch to the batch callback, or replays it to the
+// per-entry callbacks if the batch callback was removed meanwhile.
+func (m *SyncRootManager) onNotifyBatch(batch *NotifyBatch) {
+	m.mu.RLock()
+	cb := m.notifyBatchCallback
+	deleteCb := m.notifyDeleteCallback
+	renameCb := m.notifyRenameCallback
+	m.mu.RUnlock()
+
+	if cb != nil {
+		cb(batch)
+		return
+	}
+	batch.replay(deleteCb, renameCb)
+}
+
+// SetFetchPlaceholdersCallback sets the callback populating directories on
+// demand (partial population only).
+func (m *SyncRootManager) SetFetchPlaceholdersCallback(cb FetchPlaceholdersCallback) {
+	m.mu.Lock()
+	defer m.mu.Unlock()
+	m.fetchPlaceholdersCb = cb
+}
+
+// SetHydrationChangeCallback sets the callback told about hydrated and
+// dehydrated files (bridge only).
+func (m *SyncRootManager) SetHydrationChangeCallback(cb HydrationChangeCallback) {
+	m.mu.Lock()
+	defer m.mu.Unlock()
+	m.hydrationChangeCb = cb
+}
+
+// notifyHydrationChange forwards a hydration state change to the callback.
+func (m *SyncRootManager) notifyHydrationChange(filePath string) {
+	m.mu.RLock()
+	cb := m.hydrationChangeCb
+	m.mu.RUnlock()
+
+	if cb != nil {
+		cb(filePath)
+	}
+}
+
 // Close disconnects and unregisters the sync root.
 func (m *SyncRootManager) Close() error {
 	if err := m.Disconnect(); err != nil {
@@ -444,6 +586,8 @@ func (m *SyncRootManager) onFetchData(info *CF_CALLBACK_INFO, params *CF_CALLBAC
 		FileSize:       info.FileSize,
 		RequiredOffset: fetchParams.RequiredFileOffset,
 		RequiredLength: fetchParams.RequiredLength,
+		OptionalOffset: fetchParams.OptionalFileOffset,
+		OptionalLength: fetchParams.OptionalLength,
 	}
 
 	// Call user callback
@@ -549,7 +693,8 @@ type CF_CALLBACK_FETCH_DATA_PARAMS struct {
 
 // Error codes (HRESULT as int32)
 const (
-	E_FAIL int32 = -2147467259 // 0x80004005
+	E_FAIL  int32 = -2147467259 // 0x80004005
+	E_RETRY int32 = -2147023659 // 0x800704D5 HRESULT_FROM_WIN32(ERROR_RETRY)
 )
 
 // isAlreadyExistsError checks if the error indicates already exists.
@@ -0,0 +1,171 @@
+//go:build windows
+// +build windows
+
+// Package cloudfiles provides Go bindings for the Windows Cloud Files API.
+package cloudfiles
+
+import (
+	"time"
+)
+
+// Transfer batching defaults.
+const (
+	DefaultTransferBatchSegments = 16                     // Buffers per bridge transfer call
+	DefaultTransferBatchBytes    = 2 * 1024 * 1024        // Bytes per bridge transfer call
+	DefaultProgressInterval      = 250 * time.Millisecond // Min time between progress reports
+	DefaultProgressBytes         = 16 * 1024 * 1024       // Bytes that force a progress report
+)
+
+// TransferBatchConfig controls how hydrated chunks are grouped into bridge
+// transfer calls and how often progress is reported to Windows, so cgo and
+// kernel transitions stay flat whatever the chunk size.
+type TransferBatchConfig struct {
+	Segments         int           // Max buffers per transfer call (0 = DefaultTransferBatchSegments, 1 = no batching)
+	MaxBytes         int64         // Max bytes per transfer call (0 = DefaultTransferBatchBytes)
+	ProgressInterval time.Duration // Min time between progress reports (0 = DefaultProgressInterval)
+	ProgressBytes    int64         // Bytes after which progress is reported anyway (0 = DefaultProgressBytes)
+}
+
+// withDefaults returns the config with zero fields set to their defaults.
+func (c TransferBatchConfig) withDefaults() TransferBatchConfig {
+	if c.Segments <= 0 {
+		c.Segments = DefaultTransferBatchSegments
+	}
+	if c.MaxBytes <= 0 {
+		c.MaxBytes = DefaultTransferBatchBytes
+	}
+	if c.ProgressInterval <= 0 {
+		c.ProgressInterval = DefaultProgressInterval
+	}
+	if c.ProgressBytes <= 0 {
+		c.ProgressBytes = DefaultProgressBytes
+	}
+	return c
+}
+
+// transferSink receives hydrated data in file order. Data handed to Deliver
+// must stay valid until the sink has no pending data (Pending returns 0).
+type transferSink interface {
+	Deliver(data []byte) error
+	Flush() error
+	Pending() int
+}
+
+// deliverFunc adapts a function that consumes data immediately to a
+// transferSink.
+type deliverFunc func([]byte) error
+
+func (f deliverFunc) Deliver(data []byte) error { return f(data) }
+func (f deliverFunc) Flush() error              { return nil }
+func (f deliverFunc) Pending() int              { return 0 }
+
+// batchTransferFunc transfers buffers covering contiguous ranges at offset.
+// progressCompleted < 0 means no progress report.
+type batchTransferFunc func(buffers [][]byte, offset int64, isLast bool, progressTotal, progressCompleted int64) error
+
+// transferBatch groups delivered chunks into batched transfers and reports
+// progress at most every ProgressInterval or ProgressBytes.
+type transferBatch struct {
+	config   TransferBatchConfig
+	transfer batchTransferFunc
+	onFlush  func(transferred int64) // Called after each transfer with the running total
+
+	pending      [][]byte
+	pendingBytes int64
+	offset       int64 // File offset of the first pending byte
+	remaining    int64 // Bytes still to transfer, pending included
+	transferred  int64
+
+	progressTotal int64
+	lastReport    time.Time
+	lastReported  int64
+	now           func() time.Time
+}
+
+func newTransferBatch(config TransferBatchConfig, offset, length, progressTotal int64, transfer batchTransferFunc) *transferBatch {
+	config = config.withDefaults()
+	return &transferBatch{
+		config:        config,
+		transfer:      transfer,
+		pending:       make([][]byte, 0, config.Segments),
+		offset:        offset,
+		remaining:     length,
+		progressTotal: progressTotal,
+		now:           time.Now,
+	}
+}
+
+// Deliver queues data and transfers the batch once it is full.
+func (b *transferBatch) Deliver(data []byte) error {
+	if len(data) == 0 {
+		return nil
+	}
+	b.pending = append(b.pending, data)
+	b.pendingBytes += int64(len(data))
+	if len(b.pending) >= b.config.Segments || b.pendingBytes >= b.config.MaxBytes || b.pendingBytes >= b.remaining {
+		return b.Flush()
+	}
+	return nil
+}
+
+// Pending returns the number of queued buffers.
+func (b *transferBatch) Pending() int {
+	return len(b.pending)
+}
+
+// Flush transfers the queued buffers in one call.
+func (b *transferBatch) Flush() error {
+	if len(b.pending) == 0 {
+		return nil
+	}
+
+	n := b.pendingBytes
+	isLast := b.remaining-n <= 0
+	completed := b.offset + n
+
+	// Rate-limit progress by time and bytes; always report the end
+	progress := int64(-1)
+	now := b.now()
+	if isLast || now.Sub(b.lastReport) >= b.config.ProgressInterval || b.transferred+n-b.lastReported >= b.config.ProgressBytes {
+		progress = completed
+		b.lastReport = now
+		b.lastReported = b.transferred + n
+	}
+
+	err := b.transfer(b.pending, b.offset, isLast, b.progressTotal, progress)
+
+	for i := range b.pending {
+		b.pending[i] = nil
+	}
+	b.pending = b.pending[:0]
+	b.pendingBytes = 0
+	if err != nil {
+		return err
+	}
+
+	b.offset += n
+	b.remaining -= n
+	b.transferred += n
+	if b.onFlush != nil {
+		b.onFlush(b.transferred)
+	}
+	return nil
+}
+
+// Transferred returns the bytes transferred so far.
+func (b *transferBatch) Transferred() int64 {
+	return b.transferred
+}
+
+// cachingSink stores delivered data in the block cache on its way to the
+// underlying sink.
+type cachingSink struct {
+	transferSink
+	writer *blockCacheWriter
+}
+
+func (s *cachingSink) Deliver(data []byte) error {
+	// Copy into the cache before the sink may transfer and recycle data
+	s.writer.Write(data)
+	return s.transferSink.Deliver(data)
+}
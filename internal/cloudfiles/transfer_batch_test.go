@@ -0,0 +1,142 @@
+//go:build windows
+// +build windows
+
+package cloudfiles
+
+import (
+	"bytes"
+	"context"
+	"testing"
+	"time"
+)
+
+// recordedTransfer is one call made by a transferBatch.
+type recordedTransfer struct {
+	offset   int64
+	segments int
+	data     []byte
+	isLast   bool
+	progress int64
+}
+
+func newRecordingBatch(config TransferBatchConfig, offset, length int64) (*transferBatch, *[]recordedTransfer) {
+	var calls []recordedTransfer
+	batch := newTransferBatch(config, offset, length, offset+length, func(buffers [][]byte, at int64, isLast bool, total, completed int64) error {
+		call := recordedTransfer{offset: at, segments: len(buffers), isLast: isLast, progress: completed}
+		for _, buf := range buffers {
+			call.data = append(call.data, buf...)
+		}
+		calls = append(calls, call)
+		return nil
+	})
+	return batch, &calls
+}
+
+func TestTransferBatchDefaults(t *testing.T) {
+	config := TransferBatchConfig{}.withDefaults()
+	if config.Segments != DefaultTransferBatchSegments || config.MaxBytes != DefaultTransferBatchBytes {
+		t.Errorf("Unexpected batch defaults: %+v", config)
+	}
+	if config.ProgressInterval != DefaultProgressInterval || config.ProgressBytes != DefaultProgressBytes {
+		t.Errorf("Unexpected progress defaults: %+v", config)
+	}
+}
+
+func TestTransferBatchGroupsSegments(t *testing.T) {
+	batch, calls := newRecordingBatch(TransferBatchConfig{Segments: 3}, 100, 10*4)
+
+	for i := 0; i < 10; i++ {
+		if err := batch.Deliver(bytes.Repeat([]byte{byte(i)}, 4)); err != nil {
+			t.Fatalf("Deliver failed: %v", err)
+		}
+	}
+	if err := batch.Flush(); err != nil {
+		t.Fatalf("Flush failed: %v", err)
+	}
+
+	// 3 + 3 + 3, then the last one flushed as soon as it completes the range
+	if len(*calls) != 4 {
+		t.Fatalf("Expected 4 transfers, got %d", len(*calls))
+	}
+	for i, call := range *calls {
+		if call.offset != 100+int64(i)*12 {
+			t.Errorf("Transfer %d at offset %d", i, call.offset)
+		}
+		if call.isLast != (i == 3) {
+			t.Errorf("Transfer %d isLast = %v", i, call.isLast)
+		}
+	}
+	if last := (*calls)[3]; last.segments != 1 || last.progress != 140 {
+		t.Errorf("Unexpected final transfer: %+v", last)
+	}
+	if batch.Transferred() != 40 {
+		t.Errorf("Expected 40 bytes transferred, got %d", batch.Transferred())
+	}
+}
+
+func TestTransferBatchProgressRateLimit(t *testing.T) {
+	batch, calls := newRecordingBatch(TransferBatchConfig{Segments: 1, ProgressInterval: time.Second, ProgressBytes: 1 << 30}, 0, 100)
+	clock := time.Unix(1000, 0)
+	batch.now = func() time.Time { return clock }
+
+	for i := 0; i < 20; i++ {
+		clock = clock.Add(100 * time.Millisecond)
+		batch.Deliver(make([]byte, 5))
+	}
+
+	reports := 0
+	for _, call := range *calls {
+		if call.progress >= 0 {
+			reports++
+		}
+	}
+	// First transfer, once after a second, and the final one
+	if reports != 3 {
+		t.Errorf("Expected 3 progress reports for 20 transfers, got %d", reports)
+	}
+	if (*calls)[19].progress != 100 {
+		t.Errorf("Expected final progress 100, got %d", (*calls)[19].progress)
+	}
+}
+
+func TestFetchSequentialBatched(t *testing.T) {
+	content := make([]byte, 50*1024+123)
+	for i := range content {
+		content[i] = byte(i % 239)
+	}
+
+	provider := newMockDataProvider()
+	provider.AddFile("file.bin", content)
+
+	config := SyncRootConfig{
+		Path:         t.TempDir(),
+		ProviderName: "TestProvider",
+	}
+	syncRoot, _ := NewSyncRootManager(config)
+	handler := NewHydrationHandler(syncRoot, provider, nil)
+	handler.SetChunkSize(1024)
+	handler.SetTransferBatch(TransferBatchConfig{Segments: 4})
+
+	const start = 4096
+	batch, calls := newRecordingBatch(handler.batch, start, int64(len(content)-start))
+	if err := handler.fetchSequential(context.Background(), "file.bin", start, int64(len(content)-start), batch); err != nil {
+		t.Fatalf("fetchSequential failed: %v", err)
+	}
+
+	var got []byte
+	for _, call := range *calls {
+		if call.segments > 4 {
+			t.Errorf("Transfer of %d segments exceeds batch size", call.segments)
+		}
+		got = append(got, call.data...)
+	}
+	if !bytes.Equal(got, content[start:]) {
+		t.Errorf("Batched data mismatch: got %d bytes, want %d", len(got), len(content)-start)
+	}
+	if len(*calls) >= len(content)/1024 {
+		t.Errorf("Expected fewer transfers than chunks, got %d", len(*calls))
+	}
+	if !(*calls)[len(*calls)-1].isLast {
+		t.Error("Expected the last transfer to mark the file in-sync")
+	}
+}
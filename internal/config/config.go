@@ -71,6 +71,7 @@ type PerformanceConfig struct {
 	ParallelTransfers int    `mapstructure:"parallel_transfers"`
 	BufferSizeMB      int    `mapstructure:"buffer_size_mb"`
 	HashAlgorithm     string `mapstructure:"hash_algorithm"`
+	DeltaMinSizeMB    int    `mapstructure:"delta_min_size_mb"` // Delta uploads from this size (0 = off); rewrites remote files in place, not atomic
 }
 
 type NetworkConfig struct {
@@ -234,6 +235,7 @@ func setDefaults(v *viper.Viper) {
 	v.SetDefault("sync.performance.parallel_transfers", 4)
 	v.SetDefault("sync.performance.buffer_size_mb", 4)
 	v.SetDefault("sync.performance.hash_algorithm", "sha256")
+	v.SetDefault("sync.performance.delta_min_size_mb", 0)
 	v.SetDefault("sync.network.require_wifi", false)
 	v.SetDefault("sync.network.require_data", false)
 	v.SetDefault("sync.network.enable_offline_queue", true)
@@ -7,6 +7,7 @@ import (
 	"fmt"
 	"os"
 	"path/filepath"
+	"sync"
 
 	_ "github.com/mutecomm/go-sqlcipher/v4"
 )
@@ -18,6 +19,9 @@ var schemaSQL string
 type DB struct {
 	conn *sql.DB
 	path string
+
+	stmtsMu sync.Mutex
+	stmts   map[string]*sql.Stmt // Prepared once, reused by every call and transaction
 }
 
 // Config contains database configuration.
@@ -55,8 +59,16 @@ func Open(cfg Config) (*DB, error) {
 	}
 
 	db := &DB{
-		conn: conn,
-		path: cfg.Path,
+		conn:  conn,
+		path:  cfg.Path,
+		stmts: make(map[string]*sql.Stmt),
+	}
+
+	// WAL lets scans read while a sync phase flushes its cache updates, and
+	// makes large write transactions much cheaper. The mode is persistent.
+	if _, err := conn.Exec("PRAGMA journal_mode=WAL"); err != nil {
+		db.Close()
+		return nil, fmt.Errorf("failed to enable WAL mode: %w", err)
 	}
 
 	// Initialize schema if new database
@@ -67,6 +79,12 @@ func Open(cfg Config) (*DB, error) {
 		}
 	}
 
+	// Add columns introduced after the database was created
+	if err := db.migrateSchema(); err != nil {
+		db.Close()
+		return nil, fmt.Errorf("schema migration failed: %w", err)
+	}
+
 	// Check schema version
 	if err := db.checkSchemaVersion(); err != nil {
 		db.Close()
@@ -84,6 +102,13 @@ func Open(cfg Config) (*DB, error) {
 
 // Close closes the database connection.
 func (db *DB) Close() error {
+	db.stmtsMu.Lock()
+	for _, stmt := range db.stmts {
+		stmt.Close()
+	}
+	db.stmts = nil
+	db.stmtsMu.Unlock()
+
 	if db.conn != nil {
 		return db.conn.Close()
 	}
@@ -95,6 +120,26 @@ func (db *DB) Conn() *sql.DB {
 	return db.conn
 }
 
+// prepared returns the prepared statement for a query, preparing it on first use.
+// Inside a transaction, use tx.Stmt on the result.
+func (db *DB) prepared(query string) (*sql.Stmt, error) {
+	db.stmtsMu.Lock()
+	defer db.stmtsMu.Unlock()
+
+	if stmt, ok := db.stmts[query]; ok {
+		return stmt, nil
+	}
+	if db.stmts == nil {
+		return nil, fmt.Errorf("database is closed")
+	}
+	stmt, err := db.conn.Prepare(query)
+	if err != nil {
+		return nil, fmt.Errorf("prepare statement: %w", err)
+	}
+	db.stmts[query] = stmt
+	return stmt, nil
+}
+
 // initSchema initializes the database schema.
 func (db *DB) initSchema() error {
 	if _, err := db.conn.Exec(schemaSQL); err != nil {
@@ -119,6 +164,75 @@ func (db *DB) checkSchemaVersion() error {
 	return nil
 }
 
+// schemaColumns lists the columns added to existing tables after version 1,
+// as table -> column -> definition.
+var schemaColumns = map[string]map[string]string{
+	"files_state": {
+		"file_id":      "TEXT",
+		"usn":          "INTEGER",
+		"remote_mtime": "INTEGER",
+	},
+}
+
+// schemaTables lists the tables added after version 1.
+var schemaTables = []string{"chunk_signatures"}
+
+// migrateSchema creates the tables of schemaTables and adds the columns of
+// schemaColumns missing from an older database.
+func (db *DB) migrateSchema() error {
+	for _, table := range schemaTables {
+		var name string
+		err := db.conn.QueryRow("SELECT name FROM sqlite_master WHERE type = 'table' AND name = ?", table).Scan(&name)
+		if err == sql.ErrNoRows {
+			// The schema only creates what is missing
+			if err := db.initSchema(); err != nil {
+				return fmt.Errorf("failed to create table %s: %w", table, err)
+			}
+			break
+		}
+		if err != nil {
+			return fmt.Errorf("failed to look up table %s: %w", table, err)
+		}
+	}
+
+	for table, columns := range schemaColumns {
+		existing, err := db.tableColumns(table)
+		if err != nil {
+			return err
+		}
+		for column, definition := range columns {
+			if existing[column] {
+				continue
+			}
+			if _, err := db.conn.Exec(fmt.Sprintf("ALTER TABLE %s ADD COLUMN %s %s", table, column, definition)); err != nil {
+				return fmt.Errorf("failed to add column %s.%s: %w", table, column, err)
+			}
+		}
+	}
+	return nil
+}
+
+// tableColumns returns the column names of a table.
+func (db *DB) tableColumns(table string) (map[string]bool, error) {
+	rows, err := db.conn.Query(fmt.Sprintf("PRAGMA table_info(%s)", table))
+	if err != nil {
+		return nil, fmt.Errorf("failed to read columns of %s: %w", table, err)
+	}
+	defer rows.Close()
+
+	columns := make(map[string]bool)
+	for rows.Next() {
+		var cid, notNull, pk int
+		var name, colType string
+		var defaultValue sql.NullString
+		if err := rows.Scan(&cid, &name, &colType, &notNull, &defaultValue, &pk); err != nil {
+			return nil, fmt.Errorf("failed to scan columns of %s: %w", table, err)
+		}
+		columns[name] = true
+	}
+	return columns, rows.Err()
+}
+
 // cleanupCorruptedCacheEntries removes files_state entries with absolute Windows paths.
 // This fixes a bug where paths like "D:\data\file.txt" were stored instead of "data/file.txt".
 func (db *DB) cleanupCorruptedCacheEntries() error {
@@ -0,0 +1,68 @@
+package database
+
+import (
+	"database/sql"
+	"fmt"
+	"time"
+)
+
+// --- Chunk Signature Operations ---
+
+// GetChunkSignature retrieves the chunk signatures of a file.
+// Returns nil without error if the file has none.
+func (db *DB) GetChunkSignature(jobID int64, localPath string) (*ChunkSignature, error) {
+	sig := ChunkSignature{JobID: jobID, LocalPath: localPath}
+	err := db.conn.QueryRow(`
+		SELECT size, remote_size, remote_mtime, chunks, updated_at
+		FROM chunk_signatures
+		WHERE job_id = ? AND local_path = ?
+	`, jobID, localPath).Scan(
+		&sig.Size,
+		&sig.RemoteSize,
+		&sig.RemoteMTime,
+		&sig.Chunks,
+		&sig.UpdatedAt,
+	)
+
+	if err == sql.ErrNoRows {
+		return nil, nil
+	}
+	if err != nil {
+		return nil, fmt.Errorf("query chunk signature: %w", err)
+	}
+	return &sig, nil
+}
+
+// UpsertChunkSignature inserts or replaces the chunk signatures of a file
+func (db *DB) UpsertChunkSignature(sig *ChunkSignature) error {
+	now := time.Now().Unix()
+
+	_, err := db.conn.Exec(`
+		INSERT INTO chunk_signatures (job_id, local_path, size, remote_size, remote_mtime, chunks, updated_at)
+		VALUES (?, ?, ?, ?, ?, ?, ?)
+		ON CONFLICT(job_id, local_path)
+		DO UPDATE SET
+			size = excluded.size,
+			remote_size = excluded.remote_size,
+			remote_mtime = excluded.remote_mtime,
+			chunks = excluded.chunks,
+			updated_at = excluded.updated_at
+	`, sig.JobID, sig.LocalPath, sig.Size, sig.RemoteSize, sig.RemoteMTime, sig.Chunks, now)
+
+	if err != nil {
+		return fmt.Errorf("upsert chunk signature: %w", err)
+	}
+	return nil
+}
+
+// DeleteChunkSignature deletes the chunk signatures of a file
+func (db *DB) DeleteChunkSignature(jobID int64, localPath string) error {
+	_, err := db.conn.Exec(`
+		DELETE FROM chunk_signatures
+		WHERE job_id = ? AND local_path = ?
+	`, jobID, localPath)
+	if err != nil {
+		return fmt.Errorf("delete chunk signature: %w", err)
+	}
+	return nil
+}
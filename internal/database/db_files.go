@@ -8,18 +8,47 @@ import (
 
 // --- File State Operations ---
 
+// File state queries, prepared once and reused (see DB.prepared)
+const (
+	selectFileStateSQL = `
+		SELECT id, job_id, local_path, remote_path, size, mtime, hash, file_id, usn, remote_mtime,
+		       last_sync, sync_status, error_message, created_at, updated_at
+		FROM files_state
+		WHERE job_id = ? AND local_path = ?`
+
+	upsertFileStateSQL = `
+		INSERT INTO files_state (job_id, local_path, remote_path, size, mtime, hash, file_id, usn, remote_mtime, last_sync, sync_status, created_at, updated_at)
+		VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)
+		ON CONFLICT(job_id, local_path)
+		DO UPDATE SET
+			remote_path = excluded.remote_path,
+			size = excluded.size,
+			mtime = excluded.mtime,
+			hash = excluded.hash,
+			file_id = excluded.file_id,
+			usn = excluded.usn,
+			remote_mtime = excluded.remote_mtime,
+			last_sync = excluded.last_sync,
+			sync_status = excluded.sync_status,
+			updated_at = excluded.updated_at`
+
+	deleteFileStateSQL = `
+		DELETE FROM files_state
+		WHERE job_id = ? AND local_path = ?`
+)
+
 // GetFileState retrieves file state from database
 func (db *DB) GetFileState(jobID int64, localPath string) (*FileState, error) {
 	var state FileState
-	var hash, errorMsg sql.NullString
-	var lastSync sql.NullInt64
+	var hash, fileID, errorMsg sql.NullString
+	var usn, remoteMTime, lastSync sql.NullInt64
 
-	err := db.conn.QueryRow(`
-		SELECT id, job_id, local_path, remote_path, size, mtime, hash,
-		       last_sync, sync_status, error_message, created_at, updated_at
-		FROM files_state
-		WHERE job_id = ? AND local_path = ?
-	`, jobID, localPath).Scan(
+	stmt, err := db.prepared(selectFileStateSQL)
+	if err != nil {
+		return nil, err
+	}
+
+	err = stmt.QueryRow(jobID, localPath).Scan(
 		&state.ID,
 		&state.JobID,
 		&state.LocalPath,
@@ -27,6 +56,9 @@ func (db *DB) GetFileState(jobID int64, localPath string) (*FileState, error) {
 		&state.Size,
 		&state.MTime,
 		&hash,
+		&fileID,
+		&usn,
+		&remoteMTime,
 		&lastSync,
 		&state.SyncStatus,
 		&errorMsg,
@@ -43,6 +75,9 @@ func (db *DB) GetFileState(jobID int64, localPath string) (*FileState, error) {
 
 	// Convert sql.Null* types
 	state.Hash = hash.String // Empty string if NULL
+	state.FileID = fileID.String
+	state.USN = usn.Int64
+	state.RemoteMTime = remoteMTime.Int64
 	if lastSync.Valid {
 		state.LastSync = &lastSync.Int64
 	}
@@ -65,19 +100,12 @@ func (db *DB) UpsertFileState(state *FileState) error {
 		lastSync = nil
 	}
 
-	_, err := db.conn.Exec(`
-		INSERT INTO files_state (job_id, local_path, remote_path, size, mtime, hash, last_sync, sync_status, created_at, updated_at)
-		VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?)
-		ON CONFLICT(job_id, local_path)
-		DO UPDATE SET
-			remote_path = excluded.remote_path,
-			size = excluded.size,
-			mtime = excluded.mtime,
-			hash = excluded.hash,
-			last_sync = excluded.last_sync,
-			sync_status = excluded.sync_status,
-			updated_at = excluded.updated_at
-	`, state.JobID, state.LocalPath, state.RemotePath, state.Size, state.MTime, state.Hash, lastSync, state.SyncStatus, now, now)
+	stmt, err := db.prepared(upsertFileStateSQL)
+	if err != nil {
+		return err
+	}
+
+	_, err = stmt.Exec(state.JobID, state.LocalPath, state.RemotePath, state.Size, state.MTime, state.Hash, nullString(state.FileID), nullInt64(state.USN), nullInt64(state.RemoteMTime), lastSync, state.SyncStatus, now, now)
 
 	if err != nil {
 		return fmt.Errorf("upsert file state: %w", err)
@@ -85,30 +113,21 @@ func (db *DB) UpsertFileState(state *FileState) error {
 	return nil
 }
 
-// BulkUpdateFileStates updates multiple file states in a single transaction
+// BulkUpdateFileStates updates multiple file states in a single transaction,
+// so a whole sync phase is written at once through the reused prepared statement.
 func (db *DB) BulkUpdateFileStates(states []*FileState) error {
 	if len(states) == 0 {
 		return nil
 	}
 
+	upsert, err := db.prepared(upsertFileStateSQL)
+	if err != nil {
+		return err
+	}
+
 	return db.Transaction(func(tx *sql.Tx) error {
 		now := time.Now().Unix()
-		stmt, err := tx.Prepare(`
-			INSERT INTO files_state (job_id, local_path, remote_path, size, mtime, hash, last_sync, sync_status, created_at, updated_at)
-			VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?)
-			ON CONFLICT(job_id, local_path)
-			DO UPDATE SET
-				remote_path = excluded.remote_path,
-				size = excluded.size,
-				mtime = excluded.mtime,
-				hash = excluded.hash,
-				last_sync = excluded.last_sync,
-				sync_status = excluded.sync_status,
-				updated_at = excluded.updated_at
-		`)
-		if err != nil {
-			return fmt.Errorf("prepare statement: %w", err)
-		}
+		stmt := tx.Stmt(upsert)
 		defer stmt.Close()
 
 		for _, state := range states {
@@ -116,7 +135,7 @@ func (db *DB) BulkUpdateFileStates(states []*FileState) error {
 			if state.LastSync != nil {
 				lastSync = *state.LastSync
 			}
-			_, err := stmt.Exec(state.JobID, state.LocalPath, state.RemotePath, state.Size, state.MTime, state.Hash, lastSync, state.SyncStatus, now, now)
+			_, err := stmt.Exec(state.JobID, state.LocalPath, state.RemotePath, state.Size, state.MTime, state.Hash, nullString(state.FileID), nullInt64(state.USN), nullInt64(state.RemoteMTime), lastSync, state.SyncStatus, now, now)
 			if err != nil {
 				return fmt.Errorf("execute statement for %s: %w", state.LocalPath, err)
 			}
@@ -129,7 +148,7 @@ func (db *DB) BulkUpdateFileStates(states []*FileState) error {
 // GetAllFileStates retrieves all file states for a job
 func (db *DB) GetAllFileStates(jobID int64) ([]*FileState, error) {
 	rows, err := db.conn.Query(`
-		SELECT id, job_id, local_path, remote_path, size, mtime, hash,
+		SELECT id, job_id, local_path, remote_path, size, mtime, hash, file_id, usn, remote_mtime,
 		       last_sync, sync_status, error_message, created_at, updated_at
 		FROM files_state
 		WHERE job_id = ?
@@ -142,8 +161,8 @@ func (db *DB) GetAllFileStates(jobID int64) ([]*FileState, error) {
 	var states []*FileState
 	for rows.Next() {
 		var state FileState
-		var hash, errorMsg sql.NullString
-		var lastSync sql.NullInt64
+		var hash, fileID, errorMsg sql.NullString
+		var usn, remoteMTime, lastSync sql.NullInt64
 
 		err := rows.Scan(
 			&state.ID,
@@ -153,6 +172,9 @@ func (db *DB) GetAllFileStates(jobID int64) ([]*FileState, error) {
 			&state.Size,
 			&state.MTime,
 			&hash,
+			&fileID,
+			&usn,
+			&remoteMTime,
 			&lastSync,
 			&state.SyncStatus,
 			&errorMsg,
@@ -165,6 +187,9 @@ func (db *DB) GetAllFileStates(jobID int64) ([]*FileState, error) {
 
 		// Convert sql.Null* types
 		state.Hash = hash.String // Empty string if NULL
+		state.FileID = fileID.String
+		state.USN = usn.Int64
+		state.RemoteMTime = remoteMTime.Int64
 		if lastSync.Valid {
 			state.LastSync = &lastSync.Int64
 		}
@@ -182,13 +207,27 @@ func (db *DB) GetAllFileStates(jobID int64) ([]*FileState, error) {
 	return states, nil
 }
 
-// DeleteFileState deletes a file state (for deleted files)
-func (db *DB) DeleteFileState(jobID int64, localPath string) error {
+// UpdateFileIdentity refreshes the NTFS identity of a file state, e.g. when a
+// rename or attribute change moved its USN but the content is unchanged
+func (db *DB) UpdateFileIdentity(jobID int64, localPath, fileID string, usn int64) error {
 	_, err := db.conn.Exec(`
-		DELETE FROM files_state
+		UPDATE files_state SET file_id = ?, usn = ?
 		WHERE job_id = ? AND local_path = ?
-	`, jobID, localPath)
+	`, nullString(fileID), nullInt64(usn), jobID, localPath)
 	if err != nil {
+		return fmt.Errorf("update file identity: %w", err)
+	}
+	return nil
+}
+
+// DeleteFileState deletes a file state (for deleted files)
+func (db *DB) DeleteFileState(jobID int64, localPath string) error {
+	stmt, err := db.prepared(deleteFileStateSQL)
+	if err != nil {
+		return err
+	}
+
+	if _, err := stmt.Exec(jobID, localPath); err != nil {
 		return fmt.Errorf("delete file state: %w", err)
 	}
 	return nil
@@ -202,3 +241,19 @@ func (db *DB) ClearFilesState(jobID int64) error {
 	}
 	return nil
 }
+
+// nullString stores an empty string as NULL
+func nullString(s string) interface{} {
+	if s == "" {
+		return nil
+	}
+	return s
+}
+
+// nullInt64 stores 0 as NULL
+func nullInt64(n int64) interface{} {
+	if n == 0 {
+		return nil
+	}
+	return n
+}
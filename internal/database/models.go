@@ -30,6 +30,9 @@ type FileState struct {
 	Size         int64   `json:"size"`
 	MTime        int64   `json:"mtime"` // Unix timestamp de modification
 	Hash         string  `json:"hash,omitempty"` // SHA256 (empty if not computed)
+	FileID       string  `json:"file_id,omitempty"` // NTFS file identity (empty if unknown)
+	USN          int64   `json:"usn,omitempty"`     // NTFS USN at sync time (0 if unknown)
+	RemoteMTime  int64   `json:"remote_mtime,omitempty"` // Unix timestamp of the remote file at sync time (0 if unknown)
 	LastSync     *int64  `json:"last_sync,omitempty"` // Unix timestamp
 	SyncStatus   string  `json:"sync_status"` // idle, syncing, error, queued
 	ErrorMessage *string `json:"error_message,omitempty"`
@@ -37,6 +40,17 @@ type FileState struct {
 	UpdatedAt    int64   `json:"updated_at"` // Unix timestamp
 }
 
+// ChunkSignature représente les signatures de blocs d'un fichier uploadé
+type ChunkSignature struct {
+	JobID       int64  `json:"job_id"`
+	LocalPath   string `json:"local_path"`
+	Size        int64  `json:"size"`         // Taille du fichier découpé
+	RemoteSize  int64  `json:"remote_size"`  // Taille distante après l'upload
+	RemoteMTime int64  `json:"remote_mtime"` // Unix timestamp distant après l'upload
+	Chunks      []byte `json:"-"`            // Signatures encodées (scanner.EncodeChunks)
+	UpdatedAt   int64  `json:"updated_at"`   // Unix timestamp
+}
+
 // Exclusion représente une règle d'exclusion
 type Exclusion struct {
 	ID            int64     `json:"id"`
@@ -35,6 +35,9 @@ CREATE TABLE IF NOT EXISTS files_state (
     size INTEGER NOT NULL,
     mtime INTEGER NOT NULL, -- Unix timestamp de modification
     hash TEXT, -- SHA256 du contenu
+    file_id TEXT, -- Identifiant NTFS (volume + index), NULL si inconnu
+    usn INTEGER, -- USN du fichier au moment de la synchro, NULL si inconnu
+    remote_mtime INTEGER, -- Unix timestamp du fichier distant au moment de la synchro, NULL si inconnu
     last_sync INTEGER, -- Unix timestamp
     sync_status TEXT NOT NULL CHECK(sync_status IN ('idle', 'syncing', 'error', 'queued')),
     error_message TEXT,
@@ -49,6 +52,20 @@ CREATE INDEX IF NOT EXISTS idx_files_state_job_id ON files_state(job_id);
 CREATE INDEX IF NOT EXISTS idx_files_state_status ON files_state(sync_status);
 CREATE INDEX IF NOT EXISTS idx_files_state_hash ON files_state(hash);
 
+-- Table des signatures de blocs (upload différentiel des gros fichiers)
+CREATE TABLE IF NOT EXISTS chunk_signatures (
+    id INTEGER PRIMARY KEY AUTOINCREMENT,
+    job_id INTEGER NOT NULL,
+    local_path TEXT NOT NULL,
+    size INTEGER NOT NULL, -- Taille du fichier découpé
+    remote_size INTEGER NOT NULL, -- Taille distante après l'upload
+    remote_mtime INTEGER NOT NULL, -- Unix timestamp distant après l'upload
+    chunks BLOB NOT NULL, -- Tailles + SHA256 des blocs (scanner.EncodeChunks)
+    updated_at INTEGER NOT NULL,
+    FOREIGN KEY (job_id) REFERENCES sync_jobs(id) ON DELETE CASCADE,
+    UNIQUE(job_id, local_path)
+);
+
 -- Table des exclusions
 CREATE TABLE IF NOT EXISTS exclusions (
     id INTEGER PRIMARY KEY AUTOINCREMENT,
@@ -0,0 +1,182 @@
+package scanner
+
+import (
+	"crypto/sha256"
+	"encoding/binary"
+	"fmt"
+	"io"
+	"os"
+)
+
+// Content-defined chunking (FastCDC with normalized chunking).
+// Chunk boundaries are picked from the content with a gear rolling hash, so
+// an edit only changes the chunks around it: the chunks of unchanged regions
+// keep their signatures even when data is inserted before them.
+const (
+	ChunkMinSize = 64 * 1024   // No boundary before this many bytes
+	ChunkAvgSize = 256 * 1024  // Target average chunk size
+	ChunkMaxSize = 1024 * 1024 // Forced boundary
+)
+
+// Boundary masks: harder to match before the average size, easier after,
+// which keeps chunk sizes close to ChunkAvgSize (ChunkAvgSize = 2^18).
+const (
+	chunkMaskS = uint64(1<<20-1) << (64 - 20)
+	chunkMaskL = uint64(1<<16-1) << (64 - 16)
+)
+
+// chunkSignatureSize is the encoded size of one chunk (size + SHA256).
+const chunkSignatureSize = 4 + sha256.Size
+
+// gearTable maps each byte to a random 64-bit value for the rolling hash.
+// It is generated from a fixed seed: changing it would invalidate every
+// stored chunk signature.
+var gearTable = func() [256]uint64 {
+	var table [256]uint64
+	state := uint64(0x616e656d6f6e6521) // splitmix64
+	for i := range table {
+		state += 0x9e3779b97f4a7c15
+		z := state
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9
+		z = (z ^ (z >> 27)) * 0x94d049bb133111eb
+		table[i] = z ^ (z >> 31)
+	}
+	return table
+}()
+
+// Chunk describes one content-defined chunk of a file
+type Chunk struct {
+	Offset int64             // Offset of the chunk in the file
+	Size   int               // Chunk size in bytes
+	Sum    [sha256.Size]byte // SHA256 of the chunk content
+}
+
+// ChunkFunc receives each chunk with its content. data is only valid
+// during the call.
+type ChunkFunc func(chunk Chunk, data []byte) error
+
+// chunkBoundary returns the length of the next chunk at the start of buf.
+// buf holds at most ChunkMaxSize bytes; a shorter buf is the end of the data.
+func chunkBoundary(buf []byte) int {
+	n := len(buf)
+	if n <= ChunkMinSize {
+		return n
+	}
+	normal := ChunkAvgSize
+	if n < normal {
+		normal = n
+	}
+
+	var hash uint64
+	i := ChunkMinSize
+	for ; i < normal; i++ {
+		hash = (hash << 1) + gearTable[buf[i]]
+		if hash&chunkMaskS == 0 {
+			return i + 1
+		}
+	}
+	for ; i < n; i++ {
+		hash = (hash << 1) + gearTable[buf[i]]
+		if hash&chunkMaskL == 0 {
+			return i + 1
+		}
+	}
+	return n
+}
+
+// chunkReader splits the content of reader into chunks, calling fn (if not
+// nil) for each of them, and returns their signatures.
+func chunkReader(reader io.Reader, fn ChunkFunc) ([]Chunk, error) {
+	buf := make([]byte, 2*ChunkMaxSize)
+	var chunks []Chunk
+	var offset int64
+	start, end := 0, 0
+	eof := false
+
+	for {
+		// Keep at least one maximum chunk buffered until the end
+		if !eof && end-start < ChunkMaxSize {
+			if start > 0 {
+				end = copy(buf, buf[start:end])
+				start = 0
+			}
+			n, err := io.ReadFull(reader, buf[end:])
+			end += n
+			if err == io.EOF || err == io.ErrUnexpectedEOF {
+				eof = true
+			} else if err != nil {
+				return nil, err
+			}
+		}
+		if start == end {
+			return chunks, nil
+		}
+
+		window := buf[start:end]
+		if len(window) > ChunkMaxSize {
+			window = window[:ChunkMaxSize]
+		}
+		data := window[:chunkBoundary(window)]
+
+		chunk := Chunk{Offset: offset, Size: len(data), Sum: sha256.Sum256(data)}
+		if fn != nil {
+			if err := fn(chunk, data); err != nil {
+				return nil, err
+			}
+		}
+		chunks = append(chunks, chunk)
+		offset += int64(len(data))
+		start += len(data)
+	}
+}
+
+// ChunkFile splits a file into content-defined chunks, calling fn (if not
+// nil) with each chunk and its content, and returns the chunk signatures.
+// The file is read once, so the caller can compare and send chunks on the fly.
+func (h *Hasher) ChunkFile(path string, fn ChunkFunc) ([]Chunk, error) {
+	file, err := os.Open(path)
+	if err != nil {
+		if os.IsNotExist(err) {
+			return nil, WrapError(ErrFileNotFound, "open file for chunking %s", path)
+		}
+		if os.IsPermission(err) {
+			return nil, WrapError(ErrAccessDenied, "open file for chunking %s", path)
+		}
+		return nil, WrapError(ErrReadFailed, "open file for chunking %s", path)
+	}
+	defer file.Close()
+
+	chunks, err := chunkReader(file, fn)
+	if err != nil {
+		return nil, fmt.Errorf("chunk %s: %w", path, err)
+	}
+	return chunks, nil
+}
+
+// EncodeChunks serializes chunk signatures for storage. Offsets are not
+// stored: they are the running sum of the sizes.
+func EncodeChunks(chunks []Chunk) []byte {
+	data := make([]byte, 0, len(chunks)*chunkSignatureSize)
+	for _, c := range chunks {
+		data = binary.BigEndian.AppendUint32(data, uint32(c.Size))
+		data = append(data, c.Sum[:]...)
+	}
+	return data
+}
+
+// DecodeChunks parses chunk signatures produced by EncodeChunks
+func DecodeChunks(data []byte) ([]Chunk, error) {
+	if len(data)%chunkSignatureSize != 0 {
+		return nil, fmt.Errorf("invalid chunk signature length %d", len(data))
+	}
+	chunks := make([]Chunk, 0, len(data)/chunkSignatureSize)
+	var offset int64
+	for len(data) > 0 {
+		c := Chunk{Offset: offset, Size: int(binary.BigEndian.Uint32(data))}
+		copy(c.Sum[:], data[4:chunkSignatureSize])
+		chunks = append(chunks, c)
+		offset += int64(c.Size)
+		data = data[chunkSignatureSize:]
+	}
+	return chunks, nil
+}
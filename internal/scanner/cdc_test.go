@@ -0,0 +1,111 @@
+package scanner
+
+import (
+	"bytes"
+	"math/rand"
+	"testing"
+)
+
+func randomData(seed int64, size int) []byte {
+	data := make([]byte, size)
+	rand.New(rand.NewSource(seed)).Read(data)
+	return data
+}
+
+func TestChunker_Boundaries(t *testing.T) {
+	data := randomData(1, 8*1024*1024)
+
+	var rebuilt []byte
+	chunks, err := chunkReader(bytes.NewReader(data), func(c Chunk, chunk []byte) error {
+		rebuilt = append(rebuilt, chunk...)
+		return nil
+	})
+	if err != nil {
+		t.Fatalf("chunk data: %v", err)
+	}
+	if !bytes.Equal(rebuilt, data) {
+		t.Fatal("chunks do not cover the data")
+	}
+
+	var offset int64
+	for i, c := range chunks {
+		if c.Offset != offset {
+			t.Errorf("chunk %d: expected offset %d, got %d", i, offset, c.Offset)
+		}
+		if c.Size > ChunkMaxSize || (c.Size < ChunkMinSize && i != len(chunks)-1) {
+			t.Errorf("chunk %d: size %d out of bounds", i, c.Size)
+		}
+		offset += int64(c.Size)
+	}
+
+	// Sizes should average near ChunkAvgSize
+	avg := len(data) / len(chunks)
+	if avg < ChunkAvgSize/2 || avg > ChunkAvgSize*2 {
+		t.Errorf("expected average chunk size near %d, got %d", ChunkAvgSize, avg)
+	}
+}
+
+func TestChunker_EditKeepsOtherChunks(t *testing.T) {
+	data := randomData(2, 8*1024*1024)
+	before, err := chunkReader(bytes.NewReader(data), nil)
+	if err != nil {
+		t.Fatalf("chunk data: %v", err)
+	}
+
+	// Insert bytes in the middle: only the chunks around the edit change
+	edited := append(append(append([]byte{}, data[:4*1024*1024]...), []byte("inserted")...), data[4*1024*1024:]...)
+	after, err := chunkReader(bytes.NewReader(edited), nil)
+	if err != nil {
+		t.Fatalf("chunk edited data: %v", err)
+	}
+
+	known := make(map[[32]byte]bool, len(before))
+	for _, c := range before {
+		known[c.Sum] = true
+	}
+	changed := 0
+	for _, c := range after {
+		if !known[c.Sum] {
+			changed++
+		}
+	}
+	if changed == 0 || changed > 2 {
+		t.Errorf("expected 1-2 changed chunks out of %d, got %d", len(after), changed)
+	}
+}
+
+func TestChunker_SmallAndEmpty(t *testing.T) {
+	chunks, err := chunkReader(bytes.NewReader(nil), nil)
+	if err != nil || len(chunks) != 0 {
+		t.Errorf("expected no chunks for empty data, got %d (%v)", len(chunks), err)
+	}
+
+	chunks, err = chunkReader(bytes.NewReader([]byte("hello world")), nil)
+	if err != nil || len(chunks) != 1 || chunks[0].Size != 11 {
+		t.Errorf("expected a single chunk for small data, got %+v (%v)", chunks, err)
+	}
+}
+
+func TestChunker_EncodeDecode(t *testing.T) {
+	chunks, err := chunkReader(bytes.NewReader(randomData(3, 3*1024*1024)), nil)
+	if err != nil {
+		t.Fatalf("chunk data: %v", err)
+	}
+
+	decoded, err := DecodeChunks(EncodeChunks(chunks))
+	if err != nil {
+		t.Fatalf("decode chunks: %v", err)
+	}
+	if len(decoded) != len(chunks) {
+		t.Fatalf("expected %d chunks, got %d", len(chunks), len(decoded))
+	}
+	for i := range chunks {
+		if decoded[i] != chunks[i] {
+			t.Errorf("chunk %d: expected %+v, got %+v", i, chunks[i], decoded[i])
+		}
+	}
+
+	if _, err := DecodeChunks([]byte{1, 2, 3}); err == nil {
+		t.Error("expected an error for truncated signatures")
+	}
+}
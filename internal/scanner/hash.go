@@ -6,16 +6,36 @@ import (
 	"fmt"
 	"io"
 	"os"
+	"runtime"
+	"sync"
 	"time"
 
 	"go.uber.org/zap"
 )
 
+// Supported hash algorithms
+const (
+	// HashSHA256 is the SHA256 of the whole file, stored as plain hex
+	HashSHA256 = "sha256"
+
+	// HashSHA256Tree is the SHA256 of the concatenated SHA256 digests of the
+	// file's treeLeafSize leaves. Leaves are hashed in parallel, so one large
+	// file uses every core. Stored as "sha256-tree:<hex>".
+	HashSHA256Tree = "sha256-tree"
+)
+
+// treeLeafSize is the leaf size of HashSHA256Tree. Changing it changes
+// every tree hash.
+const treeLeafSize = 1024 * 1024
+
 // Hasher computes file hashes using chunked reading for memory efficiency
 type Hasher struct {
-	algorithm  string      // Hash algorithm (currently only "sha256")
+	algorithm  string      // Hash algorithm (HashSHA256 or HashSHA256Tree)
 	bufferSize int         // Buffer size for chunked reading (in bytes)
 	logger     *zap.Logger // Logger for progress and errors
+
+	leafSlots   chan struct{} // Bounds the tree leaves hashed at once, across files
+	leafBuffers sync.Pool     // treeLeafSize read buffers
 }
 
 // HashResult contains the result of a hash computation
@@ -30,7 +50,7 @@ type HashResult struct {
 // bufferSizeMB is the buffer size in megabytes (typically 4MB)
 func NewHasher(algorithm string, bufferSizeMB int, logger *zap.Logger) *Hasher {
 	if algorithm == "" {
-		algorithm = "sha256"
+		algorithm = HashSHA256
 	}
 	if bufferSizeMB <= 0 {
 		bufferSizeMB = 4 // Default 4MB
@@ -43,9 +63,19 @@ func NewHasher(algorithm string, bufferSizeMB int, logger *zap.Logger) *Hasher {
 		algorithm:  algorithm,
 		bufferSize: bufferSizeMB * 1024 * 1024, // Convert MB to bytes
 		logger:     logger.With(zap.String("component", "hasher")),
+		leafSlots:  make(chan struct{}, runtime.GOMAXPROCS(0)),
+		leafBuffers: sync.Pool{New: func() interface{} {
+			buf := make([]byte, treeLeafSize)
+			return &buf
+		}},
 	}
 }
 
+// Algorithm returns the hash algorithm of this hasher
+func (h *Hasher) Algorithm() string {
+	return h.algorithm
+}
+
 // ComputeHash computes the hash of a file at the given path
 // Uses chunked reading to handle large files efficiently without loading entire file into memory
 func (h *Hasher) ComputeHash(path string) (*HashResult, error) {
@@ -78,8 +108,10 @@ func (h *Hasher) ComputeHash(path string) (*HashResult, error) {
 	// Compute hash based on algorithm
 	var hashBytes []byte
 	switch h.algorithm {
-	case "sha256":
+	case HashSHA256:
 		hashBytes, err = h.computeSHA256(file)
+	case HashSHA256Tree:
+		hashBytes, err = h.computeSHA256Tree(file, result.Size)
 	default:
 		result.Err = fmt.Errorf("unsupported hash algorithm: %s", h.algorithm)
 		return result, result.Err
@@ -90,8 +122,11 @@ func (h *Hasher) ComputeHash(path string) (*HashResult, error) {
 		return result, result.Err
 	}
 
-	// Convert hash to hex string
+	// Convert hash to hex string, tagged with the algorithm unless SHA256
 	result.Hash = hex.EncodeToString(hashBytes)
+	if h.algorithm != HashSHA256 {
+		result.Hash = h.algorithm + ":" + result.Hash
+	}
 	result.Duration = time.Since(start)
 
 	h.logger.Debug("hash computed",
@@ -127,6 +162,66 @@ func (h *Hasher) computeSHA256(reader io.Reader) ([]byte, error) {
 	return hasher.Sum(nil), nil
 }
 
+// computeSHA256Tree computes the HashSHA256Tree of the first size bytes of
+// file. Leaves are read with ReadAt and hashed concurrently, using at most
+// GOMAXPROCS leaf buffers for the whole hasher.
+func (h *Hasher) computeSHA256Tree(file io.ReaderAt, size int64) ([]byte, error) {
+	leaves := int((size + treeLeafSize - 1) / treeLeafSize)
+	if leaves == 0 {
+		leaves = 1 // An empty file is one empty leaf
+	}
+	digests := make([]byte, leaves*sha256.Size)
+
+	var (
+		wg       sync.WaitGroup
+		errOnce  sync.Once
+		firstErr error
+	)
+	hashLeaf := func(i int) {
+		bufPtr := h.leafBuffers.Get().(*[]byte)
+		defer h.leafBuffers.Put(bufPtr)
+
+		offset := int64(i) * treeLeafSize
+		n := size - offset
+		if n > treeLeafSize {
+			n = treeLeafSize
+		}
+		buf := (*bufPtr)[:n]
+		if read, err := file.ReadAt(buf, offset); read < len(buf) {
+			if err == nil || err == io.EOF {
+				err = io.ErrUnexpectedEOF // File shrank while hashing
+			}
+			errOnce.Do(func() { firstErr = err })
+			return
+		}
+		sum := sha256.Sum256(buf)
+		copy(digests[i*sha256.Size:], sum[:])
+	}
+
+	if leaves == 1 {
+		hashLeaf(0)
+	} else {
+		for i := 0; i < leaves; i++ {
+			h.leafSlots <- struct{}{}
+			wg.Add(1)
+			go func(i int) {
+				defer func() {
+					<-h.leafSlots
+					wg.Done()
+				}()
+				hashLeaf(i)
+			}(i)
+		}
+		wg.Wait()
+	}
+	if firstErr != nil {
+		return nil, firstErr
+	}
+
+	root := sha256.Sum256(digests)
+	return root[:], nil
+}
+
 // ComputeHashHex is a convenience method that returns only the hex hash string
 func (h *Hasher) ComputeHashHex(path string) (string, error) {
 	result, err := h.ComputeHash(path)
@@ -0,0 +1,135 @@
+package scanner
+
+import (
+	"context"
+
+	"github.com/juste-un-gars/anemone_sync_windows/internal/cache"
+	"go.uber.org/zap"
+)
+
+// hashJob is a scanned file waiting for its hash
+type hashJob struct {
+	path   string    // Absolute path of the file
+	info   *FileInfo // Scan result to complete
+	dbHash string    // Hash from the last scan (modified files)
+	isNew  bool      // File not in DB yet
+	fileID string    // Identity to store if the hash matches dbHash
+	usn    int64
+
+	unchanged bool // Set by the hash worker: content matches dbHash
+}
+
+// hashFiles hashes the files found by the walk through a WorkerPool, one
+// file per worker, then records them in the result. Large files are also
+// split across cores when the algorithm supports it (HashSHA256Tree).
+func (s *Scanner) hashFiles(ctx context.Context, jobID int64, jobs []*hashJob, result *ScanResult) error {
+	if len(jobs) == 0 {
+		return nil
+	}
+
+	pool := NewWorkerPool(s.hashWorkers, s.hashWorkers*2, func(j interface{}) (interface{}, error) {
+		job := j.(*hashJob)
+		result, err := s.hasher.ComputeHash(job.path)
+		if err == nil && !job.isNew {
+			job.unchanged = s.sameContent(job.path, result.Hash, job.dbHash)
+		}
+		return result, err
+	}, s.logger)
+	if err := pool.Start(); err != nil {
+		return err
+	}
+
+	s.logger.Debug("hashing files",
+		zap.Int("count", len(jobs)),
+		zap.Int("workers", s.hashWorkers),
+		zap.String("algorithm", s.hasher.Algorithm()))
+
+	go func() {
+		defer pool.Close()
+		for _, job := range jobs {
+			if ctx.Err() != nil {
+				return
+			}
+			if err := pool.Submit(job); err != nil {
+				return
+			}
+		}
+	}()
+
+	cancelled := false
+	for r := range pool.Results() {
+		if ctx.Err() != nil && !cancelled {
+			pool.Cancel()
+			cancelled = true
+		}
+
+		job := r.Job.(*hashJob)
+		if r.Err != nil {
+			what := "compute hash for modified file"
+			if job.isNew {
+				what = "compute hash for new file"
+			}
+			result.Errors = append(result.Errors, NewScanError(job.path, "process", WrapError(r.Err, what)))
+			result.ErrorFiles++
+			continue
+		}
+
+		job.info.Hash = r.Result.(*HashResult).Hash
+		if !job.isNew {
+			if job.unchanged {
+				// Hash matches, content unchanged (only mtime/size changed)
+				job.info.Status = StatusUnchanged
+				if job.fileID != "" {
+					s.refreshIdentity(jobID, job)
+				}
+			} else {
+				// Hash differs, file modified
+				job.info.Status = StatusModified
+			}
+		}
+		s.recordFile(result, job.info)
+	}
+
+	if ctx.Err() != nil {
+		return WrapError(ErrScanAborted, "context canceled")
+	}
+	return nil
+}
+
+// sameContent checks if a file still has the content hashed as dbHash.
+// A dbHash of another algorithm (stored before a hash_algorithm switch)
+// says nothing about the new hash: the file is hashed again with the
+// algorithm of dbHash instead.
+func (s *Scanner) sameContent(path, hash, dbHash string) bool {
+	if cache.HashesComparable(hash, dbHash) {
+		return hash == dbHash
+	}
+	if dbHash == "" || dbHash == "placeholder" {
+		return false
+	}
+	algorithm := cache.HashAlgorithm(dbHash)
+	if algorithm != HashSHA256 && algorithm != HashSHA256Tree {
+		return false
+	}
+
+	previous, err := NewHasher(algorithm, s.hasher.bufferSize/(1024*1024), s.logger).ComputeHash(path)
+	if err != nil {
+		s.logger.Debug("failed to rehash with the previous algorithm",
+			zap.String("path", path),
+			zap.String("algorithm", algorithm),
+			zap.Error(err))
+		return false
+	}
+	return previous.Hash == dbHash
+}
+
+// refreshIdentity stores the new USN of a file whose content did not change,
+// so the next scans skip it again. Only the identity columns are written:
+// the rest of files_state still describes the last sync.
+func (s *Scanner) refreshIdentity(jobID int64, job *hashJob) {
+	if err := s.db.UpdateFileIdentity(jobID, job.info.LocalPath, job.fileID, job.usn); err != nil {
+		s.logger.Debug("failed to refresh file identity",
+			zap.String("path", job.info.LocalPath),
+			zap.Error(err))
+	}
+}
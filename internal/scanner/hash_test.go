@@ -1,7 +1,10 @@
 package scanner
 
 import (
+	"crypto/sha256"
+	"encoding/hex"
 	"fmt"
+	"os"
 	"testing"
 	"time"
 )
@@ -215,6 +218,54 @@ func TestHasher_ConcurrentHashing(t *testing.T) {
 	}
 }
 
+func TestHasher_TreeHash(t *testing.T) {
+	h := NewTestHelpers(t)
+	tempDir := h.CreateTempDir()
+
+	// 5.5 leaves, so the last leaf is partial
+	testFile := h.CreateTestFileWithSize(tempDir+"/tree.bin", 5*treeLeafSize+treeLeafSize/2)
+	content, err := os.ReadFile(testFile)
+	h.AssertNoError(err, "read test file")
+
+	// Expected: SHA256 over the SHA256 of each leaf
+	var digests []byte
+	for offset := 0; offset < len(content); offset += treeLeafSize {
+		end := offset + treeLeafSize
+		if end > len(content) {
+			end = len(content)
+		}
+		sum := sha256.Sum256(content[offset:end])
+		digests = append(digests, sum[:]...)
+	}
+	root := sha256.Sum256(digests)
+	expectedHash := HashSHA256Tree + ":" + hex.EncodeToString(root[:])
+
+	hasher := NewHasher(HashSHA256Tree, 4, h.GetTestLogger(false))
+	result, err := hasher.ComputeHash(testFile)
+	h.AssertNoError(err, "compute tree hash")
+	h.AssertEqual(expectedHash, result.Hash, "tree hash")
+
+	// Plain SHA256 of the same file differs and is untagged
+	plain, err := NewHasher(HashSHA256, 4, h.GetTestLogger(false)).ComputeHash(testFile)
+	h.AssertNoError(err, "compute sha256 hash")
+	h.AssertEqual(h.ComputeFileSHA256(testFile), plain.Hash, "sha256 hash")
+}
+
+func TestHasher_TreeHashEmptyFile(t *testing.T) {
+	h := NewTestHelpers(t)
+	tempDir := h.CreateTempDir()
+	emptyFile := h.CreateTestFile(tempDir+"/empty.txt", []byte{})
+
+	hasher := NewHasher(HashSHA256Tree, 4, h.GetTestLogger(false))
+	result, err := hasher.ComputeHash(emptyFile)
+	h.AssertNoError(err, "compute tree hash for empty file")
+
+	// One empty leaf
+	leaf := sha256.Sum256(nil)
+	root := sha256.Sum256(leaf[:])
+	h.AssertEqual(HashSHA256Tree+":"+hex.EncodeToString(root[:]), result.Hash, "tree hash of empty file")
+}
+
 // --- Benchmarks ---
 
 func BenchmarkHashSmallFile_1KB(b *testing.B) {
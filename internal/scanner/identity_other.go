@@ -0,0 +1,8 @@
+//go:build !windows
+
+package scanner
+
+// ReadFileIdentity always returns zero values on non-Windows platforms.
+func ReadFileIdentity(path string) (fileID string, usn int64) {
+	return "", 0
+}
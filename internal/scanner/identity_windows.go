@@ -0,0 +1,54 @@
+//go:build windows
+
+package scanner
+
+import (
+	"encoding/binary"
+	"fmt"
+
+	"golang.org/x/sys/windows"
+)
+
+// ReadFileIdentity returns the NTFS identity of a file (volume serial and
+// file index) and its current USN. Only attributes are opened, so reading a
+// placeholder does not hydrate it. Returns zero values when unavailable
+// (e.g. FAT volumes or a disabled change journal).
+func ReadFileIdentity(path string) (fileID string, usn int64) {
+	pathPtr, err := windows.UTF16PtrFromString(path)
+	if err != nil {
+		return "", 0
+	}
+	h, err := windows.CreateFile(pathPtr,
+		windows.FILE_READ_ATTRIBUTES,
+		windows.FILE_SHARE_READ|windows.FILE_SHARE_WRITE|windows.FILE_SHARE_DELETE,
+		nil,
+		windows.OPEN_EXISTING,
+		windows.FILE_FLAG_BACKUP_SEMANTICS|windows.FILE_FLAG_OPEN_REPARSE_POINT,
+		0)
+	if err != nil {
+		return "", 0
+	}
+	defer windows.CloseHandle(h)
+
+	var info windows.ByHandleFileInformation
+	if err := windows.GetFileInformationByHandle(h, &info); err != nil {
+		return "", 0
+	}
+	fileID = fmt.Sprintf("%08x-%08x%08x", info.VolumeSerialNumber, info.FileIndexHigh, info.FileIndexLow)
+
+	// USN_RECORD_V2 (NTFS) or V3 (ReFS, 128-bit file references)
+	var buf [512]byte
+	var returned uint32
+	err = windows.DeviceIoControl(h, windows.FSCTL_READ_FILE_USN_DATA, nil, 0, &buf[0], uint32(len(buf)), &returned, nil)
+	if err != nil || returned < 8 {
+		return fileID, 0
+	}
+	usnOffset := uint32(24)
+	if binary.LittleEndian.Uint16(buf[4:]) == 3 {
+		usnOffset = 40
+	}
+	if returned < usnOffset+8 {
+		return fileID, 0
+	}
+	return fileID, int64(binary.LittleEndian.Uint64(buf[usnOffset:]))
+}
@@ -16,6 +16,8 @@ type FileMetadata struct {
 	IsSymlink     bool        // Whether it's a symlink
 	IsPlaceholder bool        // Whether it's a Cloud Files placeholder (would trigger hydration)
 	Mode          os.FileMode // File mode/permissions
+	FileID        string      // NTFS file identity (empty if not read, see ReadFileIdentity)
+	USN           int64       // NTFS USN of the last change (0 if not read)
 }
 
 // ExtractMetadata extracts metadata from a file path using os.Stat
@@ -91,6 +93,23 @@ func SameMetadata(a, b *FileMetadata) bool {
 		a.MTime.Truncate(time.Second).Equal(b.MTime.Truncate(time.Second))
 }
 
+// SameIdentity checks that two FileMetadata describe the same NTFS file with
+// no change recorded in between. Unknown identities are not compared, so it
+// only adds to SameMetadata: a file replaced by a copy with the same size
+// and mtime, or rewritten without touching its mtime, is caught.
+func SameIdentity(a, b *FileMetadata) bool {
+	if a == nil || b == nil {
+		return false
+	}
+	if a.FileID == "" || b.FileID == "" {
+		return true
+	}
+	if a.FileID != b.FileID {
+		return false
+	}
+	return a.USN == 0 || b.USN == 0 || a.USN == b.USN
+}
+
 // MTimeDiffSeconds returns the absolute difference in modification time in seconds
 func MTimeDiffSeconds(a, b *FileMetadata) int64 {
 	if a == nil || b == nil {
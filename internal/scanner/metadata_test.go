@@ -152,6 +152,29 @@ func TestSameMetadata(t *testing.T) {
 	}
 }
 
+func TestSameIdentity(t *testing.T) {
+	h := NewTestHelpers(t)
+
+	tests := []struct {
+		name     string
+		a, b     *FileMetadata
+		expected bool
+	}{
+		{"unknown identity", &FileMetadata{}, &FileMetadata{FileID: "a", USN: 10}, true},
+		{"same file and USN", &FileMetadata{FileID: "a", USN: 10}, &FileMetadata{FileID: "a", USN: 10}, true},
+		{"same file, USN unknown", &FileMetadata{FileID: "a"}, &FileMetadata{FileID: "a", USN: 10}, true},
+		{"same file, changed since", &FileMetadata{FileID: "a", USN: 10}, &FileMetadata{FileID: "a", USN: 12}, false},
+		{"replaced file", &FileMetadata{FileID: "a", USN: 10}, &FileMetadata{FileID: "b", USN: 10}, false},
+		{"nil metadata", nil, &FileMetadata{}, false},
+	}
+
+	for _, tt := range tests {
+		t.Run(tt.name, func(t *testing.T) {
+			h.AssertEqual(tt.expected, SameIdentity(tt.a, tt.b), "SameIdentity result")
+		})
+	}
+}
+
 func TestMTimeDiffSeconds(t *testing.T) {
 	h := NewTestHelpers(t)
 
@@ -4,6 +4,7 @@ import (
 	"context"
 	"fmt"
 	"path/filepath"
+	"runtime"
 	"sync"
 	"time"
 
@@ -21,6 +22,8 @@ type Scanner struct {
 	hasher   *Hasher
 	walker   *Walker
 
+	hashWorkers int // Files hashed in parallel
+
 	mu           sync.Mutex
 	scanningJobs map[int64]bool // Track which jobs are currently scanning
 	batchSize    int            // Number of files to batch for DB updates
@@ -148,6 +151,7 @@ func NewScanner(cfg *config.Config, db *database.DB, logger *zap.Logger) (*Scann
 		excluder:     excluder,
 		hasher:       hasher,
 		walker:       walker,
+		hashWorkers:  runtime.NumCPU(),
 		scanningJobs: make(map[int64]bool),
 		batchSize:    100,             // Batch 100 files for DB updates
 		batchDelay:   5 * time.Second, // Or 5 seconds, whichever comes first
@@ -196,6 +200,7 @@ func (s *Scanner) Scan(ctx context.Context, req ScanRequest) (*ScanResult, error
 
 	// Track files found during scan
 	foundFiles := make(map[string]bool)
+	var hashJobs []*hashJob
 
 	// NOTE: We no longer update files_state during scan.
 	// The cache (files_state) should only be updated AFTER successful sync,
@@ -225,43 +230,28 @@ func (s *Scanner) Scan(ctx context.Context, req ScanRequest) (*ScanResult, error
 			foundFiles[path] = true
 		}
 
-		// Process file with 3-step algorithm
-		fileInfo, err := s.processFile(ctx, req, path, metadata)
+		// Process file with 3-step algorithm; files needing a hash are
+		// hashed in parallel once the walk is done
+		fileInfo, job, err := s.processFile(ctx, req, path, metadata)
 		if err != nil {
 			scanErr := NewScanError(path, "process", err)
 			result.Errors = append(result.Errors, scanErr)
 			result.ErrorFiles++
 			return nil // Continue despite errors
 		}
-
-		// Categorize result
-		switch fileInfo.Status {
-		case StatusNew:
-			result.NewFiles = append(result.NewFiles, fileInfo)
-		case StatusModified:
-			result.ModifiedFiles = append(result.ModifiedFiles, fileInfo)
-		case StatusUnchanged:
-			result.UnchangedFiles = append(result.UnchangedFiles, fileInfo)
-			result.SkippedFiles++
-		case StatusError:
-			result.ErrorFiles++
-		}
-
-		result.ProcessedFiles++
-
-		// Log progress every 1000 files
-		if result.ProcessedFiles%1000 == 0 {
-			s.logger.Info("scan progress",
-				zap.Int("processed", result.ProcessedFiles),
-				zap.Int("new", len(result.NewFiles)),
-				zap.Int("modified", len(result.ModifiedFiles)),
-				zap.Int("unchanged", len(result.UnchangedFiles)),
-				zap.Int("errors", len(result.Errors)))
+		if job != nil {
+			hashJobs = append(hashJobs, job)
+			return nil
 		}
 
+		s.recordFile(result, fileInfo)
 		return nil
 	})
 
+	if err == nil {
+		err = s.hashFiles(ctx, req.JobID, hashJobs, result)
+	}
+
 	if err != nil {
 		s.logger.Error("walk failed", zap.Error(err))
 		return result, err
@@ -292,12 +282,41 @@ func (s *Scanner) Scan(ctx context.Context, req ScanRequest) (*ScanResult, error
 	return result, nil
 }
 
-// processFile implements the 3-step change detection algorithm
-func (s *Scanner) processFile(ctx context.Context, req ScanRequest, path string, metadata *FileMetadata) (*FileInfo, error) {
+// recordFile categorizes a processed file into the scan result
+func (s *Scanner) recordFile(result *ScanResult, fileInfo *FileInfo) {
+	switch fileInfo.Status {
+	case StatusNew:
+		result.NewFiles = append(result.NewFiles, fileInfo)
+	case StatusModified:
+		result.ModifiedFiles = append(result.ModifiedFiles, fileInfo)
+	case StatusUnchanged:
+		result.UnchangedFiles = append(result.UnchangedFiles, fileInfo)
+		result.SkippedFiles++
+	case StatusError:
+		result.ErrorFiles++
+	}
+
+	result.ProcessedFiles++
+
+	// Log progress every 1000 files
+	if result.ProcessedFiles%1000 == 0 {
+		s.logger.Info("scan progress",
+			zap.Int("processed", result.ProcessedFiles),
+			zap.Int("new", len(result.NewFiles)),
+			zap.Int("modified", len(result.ModifiedFiles)),
+			zap.Int("unchanged", len(result.UnchangedFiles)),
+			zap.Int("errors", len(result.Errors)))
+	}
+}
+
+// processFile implements the 3-step change detection algorithm.
+// When the file must be hashed (step 3, or a new file), it returns a
+// hashJob and the file status is decided after hashing.
+func (s *Scanner) processFile(ctx context.Context, req ScanRequest, path string, metadata *FileMetadata) (*FileInfo, *hashJob, error) {
 	// Calculate relative path for storage (not absolute path)
 	relPath, err := filepath.Rel(req.BasePath, path)
 	if err != nil {
-		return nil, WrapError(err, "get relative path for %s", path)
+		return nil, nil, WrapError(err, "get relative path for %s", path)
 	}
 	relPath = filepath.ToSlash(relPath) // Normalize to forward slashes
 
@@ -316,54 +335,42 @@ func (s *Scanner) processFile(ctx context.Context, req ScanRequest, path string,
 	if metadata.IsPlaceholder {
 		fileInfo.Status = StatusUnchanged
 		fileInfo.Hash = "placeholder"
-		return fileInfo, nil
+		return fileInfo, nil, nil
 	}
 
 	// Step 1: Get existing file state from DB (using relative path)
 	dbState, err := s.getFileState(req.JobID, relPath)
 	if err != nil {
-		// File not in DB = NEW file
+		// File not in DB = NEW file, hash it
 		fileInfo.Status = StatusNew
-
-		// Compute hash for new file
-		hashResult, err := s.hasher.ComputeHash(path)
-		if err != nil {
-			return nil, WrapError(err, "compute hash for new file")
-		}
-		fileInfo.Hash = hashResult.Hash
-
-		return fileInfo, nil
+		return fileInfo, &hashJob{path: path, info: fileInfo, isNew: true}, nil
 	}
 
-	// Step 2: Quick comparison (size + mtime)
+	// Step 2: Quick comparison (size + mtime, plus the NTFS identity when
+	// the cached row has one), so unchanged files cost no read
 	dbMetadata := &FileMetadata{
-		Size:  dbState.Size,
-		MTime: time.Unix(dbState.MTime, 0),
+		Size:   dbState.Size,
+		MTime:  time.Unix(dbState.MTime, 0),
+		FileID: dbState.FileID,
+		USN:    dbState.USN,
 	}
-	if SameMetadata(metadata, dbMetadata) {
-		// Unchanged (same size + mtime)
+	if dbState.FileID != "" && SameMetadata(metadata, dbMetadata) {
+		metadata.FileID, metadata.USN = ReadFileIdentity(path)
+	}
+	if SameMetadata(metadata, dbMetadata) && SameIdentity(metadata, dbMetadata) {
+		// Unchanged (same size + mtime + identity)
 		fileInfo.Status = StatusUnchanged
 		fileInfo.Hash = dbState.Hash
-		return fileInfo, nil
+		return fileInfo, nil, nil
 	}
 
-	// Step 3: Size or mtime changed, compute hash to check if content changed
-	hashResult, err := s.hasher.ComputeHash(path)
-	if err != nil {
-		return nil, WrapError(err, "compute hash for modified file")
+	// Step 3: Metadata disagrees, hash to check if content changed
+	job := &hashJob{path: path, info: fileInfo, dbHash: dbState.Hash}
+	if metadata.FileID != "" && metadata.FileID == dbState.FileID {
+		// Only the USN moved (rename, attributes): refresh it if the content is the same
+		job.fileID, job.usn = metadata.FileID, metadata.USN
 	}
-	fileInfo.Hash = hashResult.Hash
-
-	// Compare hash
-	if fileInfo.Hash == dbState.Hash {
-		// Hash matches, content unchanged (only mtime/size changed)
-		fileInfo.Status = StatusUnchanged
-	} else {
-		// Hash differs, file modified
-		fileInfo.Status = StatusModified
-	}
-
-	return fileInfo, nil
+	return fileInfo, job, nil
 }
 
 // mapToRemotePath maps a local path to a remote SMB path
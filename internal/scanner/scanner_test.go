@@ -170,6 +170,52 @@ func TestScanner_ModifiedFiles(t *testing.T) {
 	h.AssertEqual(7, len(result.UnchangedFiles), "unchanged files")
 }
 
+func TestScanner_HashAlgorithmSwitch(t *testing.T) {
+	h := NewTestHelpers(t)
+	tempDir := h.CreateTempDir()
+	db := h.SetupTestDB()
+
+	files := h.CreateTestFiles(tempDir, 10, 1024)
+	jobID := h.CreateTestJob(db, tempDir, "\\\\server\\share")
+
+	cfg := &config.Config{
+		Paths: config.PathsConfig{ConfigDir: tempDir},
+		Sync: config.SyncConfig{
+			Performance: config.PerformanceConfig{
+				HashAlgorithm: "sha256",
+				BufferSizeMB:  4,
+			},
+		},
+	}
+	request := ScanRequest{JobID: jobID, BasePath: tempDir, RemoteBase: "\\\\server\\share"}
+
+	// First scan and sync with plain SHA256
+	scanner, err := NewScanner(cfg, db, h.GetTestLogger(false))
+	h.AssertNoError(err, "create scanner")
+	firstResult, err := scanner.Scan(context.Background(), request)
+	h.AssertNoError(err, "first scan")
+	h.SimulateSyncComplete(db, jobID, firstResult.NewFiles)
+	scanner.Close()
+
+	// Touch 3 files, modify 1
+	later := time.Now().Add(time.Hour)
+	for i := 0; i < 3; i++ {
+		os.Chtimes(files[i], later, later)
+	}
+	os.WriteFile(files[3], []byte("modified content"), 0644)
+
+	// Rescan with the tree hash: only the modified file is reported
+	cfg.Sync.Performance.HashAlgorithm = HashSHA256Tree
+	scanner, err = NewScanner(cfg, db, h.GetTestLogger(false))
+	h.AssertNoError(err, "create tree-hash scanner")
+	defer scanner.Close()
+	result, err := scanner.Scan(context.Background(), request)
+	h.AssertNoError(err, "second scan")
+
+	h.AssertEqual(1, len(result.ModifiedFiles), "modified files after algorithm switch")
+	h.AssertEqual(9, len(result.UnchangedFiles), "unchanged files")
+}
+
 func TestScanner_DeletedFiles(t *testing.T) {
 	h := NewTestHelpers(t)
 	tempDir := h.CreateTempDir()
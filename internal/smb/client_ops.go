@@ -2,6 +2,7 @@
 package smb
 
 import (
+	"context"
 	"fmt"
 	"io"
 	"os"
@@ -138,6 +139,70 @@ func (c *SMBClient) OpenFile(remotePath string) (io.ReadCloser, error) {
 	return remoteFile, nil
 }
 
+// ReaderAtCloser is a remote file opened for positional reads.
+type ReaderAtCloser interface {
+	io.ReaderAt
+	io.Closer
+}
+
+// OpenFileAt opens a remote file for positional reads (ReadAt), so callers
+// can read any range without streaming through the bytes before it.
+// Every request on the file is bound to ctx: cancelling it aborts a read
+// blocked on the server instead of waiting for its response.
+// The caller is responsible for closing the file.
+// remotePath is relative to the share root (e.g., "folder/file.txt")
+func (c *SMBClient) OpenFileAt(ctx context.Context, remotePath string) (ReaderAtCloser, error) {
+	c.mu.RLock()
+	if !c.connected {
+		c.mu.RUnlock()
+		return nil, fmt.Errorf("not connected to SMB server")
+	}
+	fs := c.fs
+	c.mu.RUnlock()
+
+	c.logger.Debug("opening remote file for positional reads",
+		zap.String("remote", remotePath))
+
+	remoteFile, err := fs.WithContext(ctx).Open(remotePath)
+	if err != nil {
+		return nil, fmt.Errorf("failed to open remote file %s: %w", remotePath, err)
+	}
+
+	return remoteFile, nil
+}
+
+// UpdatableFile is a remote file opened for positional writes.
+type UpdatableFile interface {
+	io.WriterAt
+	io.Closer
+	Truncate(size int64) error
+}
+
+// OpenFileForUpdate opens an existing remote file for positional writes
+// (WriteAt) and truncation, so callers can rewrite only some ranges of it.
+// Unlike Upload, changes are applied in place and are not atomic.
+// The caller is responsible for closing the file.
+// remotePath is relative to the share root (e.g., "folder/file.txt")
+func (c *SMBClient) OpenFileForUpdate(remotePath string) (UpdatableFile, error) {
+	c.mu.RLock()
+	if !c.connected {
+		c.mu.RUnlock()
+		return nil, fmt.Errorf("not connected to SMB server")
+	}
+	fs := c.fs
+	c.mu.RUnlock()
+
+	c.logger.Debug("opening remote file for update",
+		zap.String("remote", remotePath))
+
+	remoteFile, err := fs.OpenFile(remotePath, os.O_RDWR, 0644)
+	if err != nil {
+		return nil, fmt.Errorf("failed to open remote file %s for update: %w", remotePath, err)
+	}
+
+	return remoteFile, nil
+}
+
 // UploadTempSuffix is the suffix used for temporary upload files (atomic upload)
 const UploadTempSuffix = ".anemone-uploading"
 
@@ -337,3 +402,55 @@ func (c *SMBClient) Delete(remotePath string) error {
 
 	return nil
 }
+
+// RemoveAll removes a file or a directory and everything under it from the
+// remote SMB share. A missing path is not an error.
+// remotePath is relative to the share root (e.g., "folder/sub")
+func (c *SMBClient) RemoveAll(remotePath string) error {
+	c.mu.RLock()
+	if !c.connected {
+		c.mu.RUnlock()
+		return fmt.Errorf("not connected to SMB server")
+	}
+	fs := c.fs
+	c.mu.RUnlock()
+
+	c.logger.Debug("removing remote tree",
+		zap.String("remote", remotePath))
+
+	if err := fs.RemoveAll(remotePath); err != nil {
+		return fmt.Errorf("failed to remove %s: %w", remotePath, err)
+	}
+
+	c.logger.Info("remote tree removed successfully",
+		zap.String("remote", remotePath))
+
+	return nil
+}
+
+// Rename moves a file or a directory within the remote SMB share.
+// The target must not exist (rename won't overwrite on SMB).
+// Both paths are relative to the share root
+func (c *SMBClient) Rename(oldPath, newPath string) error {
+	c.mu.RLock()
+	if !c.connected {
+		c.mu.RUnlock()
+		return fmt.Errorf("not connected to SMB server")
+	}
+	fs := c.fs
+	c.mu.RUnlock()
+
+	c.logger.Debug("renaming remote path",
+		zap.String("from", oldPath),
+		zap.String("to", newPath))
+
+	if err := fs.Rename(oldPath, newPath); err != nil {
+		return fmt.Errorf("failed to rename %s to %s: %w", oldPath, newPath, err)
+	}
+
+	c.logger.Info("remote path renamed successfully",
+		zap.String("from", oldPath),
+		zap.String("to", newPath))
+
+	return nil
+}
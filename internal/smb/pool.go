@@ -0,0 +1,803 @@
+package smb
+
+import (
+	"context"
+	"errors"
+	"fmt"
+	"io"
+	"strings"
+	"sync"
+	"sync/atomic"
+	"time"
+
+	"go.uber.org/zap"
+)
+
+// Subsystem identifies a user of a Pool. Each subsystem has its own lease
+// quota, so one cannot take every session from the other.
+type Subsystem int
+
+const (
+	// SubsystemHydration serves placeholder hydration and folder listings
+	// while a user waits: latency sensitive.
+	SubsystemHydration Subsystem = iota
+	// SubsystemBulk serves sync transfers and full scans: throughput
+	// sensitive, it can wait.
+	SubsystemBulk
+
+	subsystemCount
+)
+
+// String returns the subsystem name, for logs
+func (s Subsystem) String() string {
+	switch s {
+	case SubsystemHydration:
+		return "hydration"
+	case SubsystemBulk:
+		return "bulk"
+	default:
+		return fmt.Sprintf("subsystem(%d)", int(s))
+	}
+}
+
+// Pool defaults
+const (
+	DefaultPoolSessions    = 4
+	DefaultHydrationQuota  = 8
+	DefaultBulkQuota       = 8
+	DefaultHandleCacheSize = 64
+	DefaultHandleTTL       = 5 * time.Second
+)
+
+// PoolConfig contains the configuration of a Pool
+type PoolConfig struct {
+	Sessions        int           // SMB sessions, each on its own connection (0 = default)
+	HydrationQuota  int           // Leases hydration may hold at once (0 = default)
+	BulkQuota       int           // Leases bulk transfers may hold at once (0 = default)
+	HandleCacheSize int           // Idle file handles kept open (0 = default, <0 = none)
+	HandleTTL       time.Duration // How long an idle handle is kept (0 = default)
+}
+
+// errPoolClosed is returned for leases requested after Close
+var errPoolClosed = errors.New("SMB pool closed")
+
+// Pool spreads SMB operations over several sessions to one share, each on
+// its own connection, so a single session stops being the ceiling.
+//
+// Callers lease a session for a subsystem; a lease waits while the
+// subsystem's quota is used up. Bulk leases never get the first session
+// (when there are several), so hydration always finds a session that bulk
+// transfers don't saturate; hydration leases go to the least loaded session.
+//
+// Files opened for hydration with OpenFileAt are kept open for a while after
+// Close, so the next read of the same file (CfAPI asks for a file in
+// chunks) does not pay the open/close round trips again. An open handle
+// blocks renaming over or deleting the file on Windows servers: callers
+// that change a remote file call InvalidatePath first.
+//
+// Sessions are connected on first use. A session whose connection failed is
+// reconnected on its next lease.
+type Pool struct {
+	// dial returns a new connected client
+	dial func() (*SMBClient, error)
+	// open and probe are the client operations used by the pool (overridden in tests)
+	open  func(ctx context.Context, c *SMBClient, remotePath string) (ReaderAtCloser, error)
+	probe func(c *SMBClient) error
+
+	logger *zap.Logger
+
+	// ctx is bound to cached handles; Close cancels it
+	ctx    context.Context
+	cancel context.CancelFunc
+
+	sessions []*poolSession
+	quotas   [subsystemCount]chan struct{}
+	handles  *handleCache
+
+	mu     sync.Mutex // Guards session lease counts and closed
+	closed bool
+
+	// Statistics (atomic)
+	dials        int64
+	handleHits   int64
+	handleMisses int64
+}
+
+// poolSession is one session of a Pool
+type poolSession struct {
+	id     int
+	leases int // Guarded by Pool.mu
+
+	connMu sync.Mutex
+	client *SMBClient // nil until connected
+	gen    uint64     // Incremented when the client is dropped
+}
+
+// PoolStats contains pool statistics
+type PoolStats struct {
+	Sessions     int   // Configured sessions
+	Connected    int   // Sessions currently connected
+	Dials        int64 // Connections made
+	HandleHits   int64 // Hydration opens served by a cached handle
+	HandleMisses int64 // Hydration opens that opened the file
+}
+
+// NewPool creates a pool of sessions made by dial, which must return a
+// connected client.
+func NewPool(dial func() (*SMBClient, error), cfg *PoolConfig, logger *zap.Logger) (*Pool, error) {
+	if dial == nil {
+		return nil, fmt.Errorf("dial cannot be nil")
+	}
+	if cfg == nil {
+		cfg = &PoolConfig{}
+	}
+	if logger == nil {
+		logger = zap.NewNop()
+	}
+
+	sessions := cfg.Sessions
+	if sessions <= 0 {
+		sessions = DefaultPoolSessions
+	}
+	hydrationQuota := cfg.HydrationQuota
+	if hydrationQuota <= 0 {
+		hydrationQuota = DefaultHydrationQuota
+	}
+	bulkQuota := cfg.BulkQuota
+	if bulkQuota <= 0 {
+		bulkQuota = DefaultBulkQuota
+	}
+	cacheSize := cfg.HandleCacheSize
+	if cacheSize == 0 {
+		cacheSize = DefaultHandleCacheSize
+	}
+	ttl := cfg.HandleTTL
+	if ttl <= 0 {
+		ttl = DefaultHandleTTL
+	}
+
+	ctx, cancel := context.WithCancel(context.Background())
+	p := &Pool{
+		dial: dial,
+		open: func(ctx context.Context, c *SMBClient, remotePath string) (ReaderAtCloser, error) {
+			return c.OpenFileAt(ctx, remotePath)
+		},
+		probe: func(c *SMBClient) error {
+			_, err := c.GetMetadata("")
+			return err
+		},
+		logger:   logger.With(zap.String("component", "smb_pool")),
+		ctx:      ctx,
+		cancel:   cancel,
+		sessions: make([]*poolSession, sessions),
+		handles:  &handleCache{max: cacheSize, ttl: ttl},
+	}
+	for i := range p.sessions {
+		p.sessions[i] = &poolSession{id: i}
+	}
+	p.quotas[SubsystemHydration] = make(chan struct{}, hydrationQuota)
+	p.quotas[SubsystemBulk] = make(chan struct{}, bulkQuota)
+
+	if cacheSize > 0 {
+		go p.sweepIdle(ttl)
+	}
+	return p, nil
+}
+
+// NewPoolFromKeyring creates a pool of sessions to a share, using the
+// credentials stored in the system keyring for server.
+func NewPoolFromKeyring(server, share string, cfg *PoolConfig, logger *zap.Logger) (*Pool, error) {
+	if server == "" {
+		return nil, fmt.Errorf("server cannot be empty")
+	}
+	if share == "" {
+		return nil, fmt.Errorf("share cannot be empty")
+	}
+	if logger == nil {
+		logger = zap.NewNop()
+	}
+
+	dial := func() (*SMBClient, error) {
+		client, err := NewSMBClientFromKeyring(server, share, logger)
+		if err != nil {
+			return nil, err
+		}
+		if err := client.Connect(); err != nil {
+			return nil, err
+		}
+		return client, nil
+	}
+	return NewPool(dial, cfg, logger)
+}
+
+// Lease is a session leased from a Pool. It must be released.
+type Lease struct {
+	pool    *Pool
+	session *poolSession
+	sub     Subsystem
+	client  *SMBClient
+	gen     uint64
+	once    sync.Once
+}
+
+// Client returns the client of the leased session
+func (l *Lease) Client() *SMBClient {
+	return l.client
+}
+
+// Release returns the session to the pool. It is safe to call twice.
+func (l *Lease) Release() {
+	l.once.Do(func() { l.pool.release(l.session, l.sub) })
+}
+
+// Invalidate drops the session's connection after a failure, so it is
+// reconnected on its next lease. The lease must still be released.
+func (l *Lease) Invalidate() {
+	l.session.drop(l.gen, l.pool.logger)
+}
+
+// Acquire leases a session for a subsystem, waiting while the subsystem's
+// quota is used up.
+func (p *Pool) Acquire(ctx context.Context, sub Subsystem) (*Lease, error) {
+	if err := p.waitQuota(ctx, sub); err != nil {
+		return nil, err
+	}
+
+	session, err := p.pick(sub)
+	if err != nil {
+		<-p.quotas[sub]
+		return nil, err
+	}
+	return p.lease(session, sub)
+}
+
+// Do runs fn on a leased session. If fn fails and the session no longer
+// answers, fn is retried once on a reconnected session.
+func (p *Pool) Do(ctx context.Context, sub Subsystem, fn func(c *SMBClient) error) error {
+	for attempt := 0; ; attempt++ {
+		lease, err := p.Acquire(ctx, sub)
+		if err != nil {
+			return err
+		}
+
+		err = fn(lease.Client())
+		if err != nil && attempt == 0 && p.broken(ctx, lease) {
+			lease.Release()
+			continue
+		}
+		lease.Release()
+		return err
+	}
+}
+
+// OpenFile opens a remote file for streaming reads on a leased session,
+// held until the reader is closed.
+func (p *Pool) OpenFile(ctx context.Context, sub Subsystem, remotePath string) (io.ReadCloser, error) {
+	for attempt := 0; ; attempt++ {
+		lease, err := p.Acquire(ctx, sub)
+		if err != nil {
+			return nil, err
+		}
+
+		reader, err := lease.Client().OpenFile(remotePath)
+		if err != nil {
+			retry := attempt == 0 && p.broken(ctx, lease)
+			lease.Release()
+			if retry {
+				continue
+			}
+			return nil, err
+		}
+		return &leasedReader{ReadCloser: reader, lease: lease}, nil
+	}
+}
+
+// OpenFileAt opens a remote file for positional reads on a leased session,
+// held until the file is closed. Cancelling ctx aborts the requests in
+// flight on the file, like SMBClient.OpenFileAt.
+//
+// After Close, the file stays open in the handle cache (unless ctx was
+// cancelled or a read failed) and serves the next OpenFileAt of the same
+// path. An idle handle is not reused past the configured TTL, so a file
+// replaced on the server is not served from its old handle for long.
+func (p *Pool) OpenFileAt(ctx context.Context, sub Subsystem, remotePath string) (ReaderAtCloser, error) {
+	if err := p.waitQuota(ctx, sub); err != nil {
+		return nil, err
+	}
+
+	// A cached handle on a session the subsystem may use: lease that session
+	if h := p.handles.take(remotePath, func(s *poolSession) bool { return p.mayUse(sub, s) }); h != nil {
+		p.mu.Lock()
+		h.session.leases++
+		p.mu.Unlock()
+
+		atomic.AddInt64(&p.handleHits, 1)
+		lease := &Lease{pool: p, session: h.session, sub: sub, gen: h.gen}
+		return p.newPooledFile(ctx, lease, h), nil
+	}
+	atomic.AddInt64(&p.handleMisses, 1)
+
+	for attempt := 0; ; attempt++ {
+		session, err := p.pick(sub)
+		if err != nil {
+			<-p.quotas[sub]
+			return nil, err
+		}
+		lease, err := p.lease(session, sub)
+		if err != nil {
+			return nil, err
+		}
+
+		// Bound to the pool, not to ctx: the handle may outlive this caller
+		handleCtx, cancel := context.WithCancel(p.ctx)
+		epoch := p.handles.currentEpoch()
+		file, err := p.open(handleCtx, lease.Client(), remotePath)
+		if err != nil {
+			cancel()
+			retry := attempt == 0 && p.broken(ctx, lease)
+			if retry {
+				// Keep the quota slot for the retry
+				p.mu.Lock()
+				lease.session.leases--
+				p.mu.Unlock()
+				continue
+			}
+			lease.Release()
+			return nil, err
+		}
+
+		h := &idleHandle{path: remotePath, file: file, cancel: cancel, session: session, gen: lease.gen, epoch: epoch}
+		return p.newPooledFile(ctx, lease, h), nil
+	}
+}
+
+// InvalidatePath closes the idle handles of a remote file, before it is
+// uploaded over, renamed or deleted. Handles of the file in use are not
+// cached again when they are closed.
+func (p *Pool) InvalidatePath(remotePath string) {
+	p.handles.invalidate(remotePath)
+}
+
+// sweepIdle closes expired idle handles, so they are not left open on the
+// server once the pool goes quiet
+func (p *Pool) sweepIdle(ttl time.Duration) {
+	ticker := time.NewTicker(ttl)
+	defer ticker.Stop()
+	for {
+		select {
+		case <-p.ctx.Done():
+			return
+		case <-ticker.C:
+			p.handles.sweep()
+		}
+	}
+}
+
+// IsClosed returns true once the pool is closed
+func (p *Pool) IsClosed() bool {
+	p.mu.Lock()
+	defer p.mu.Unlock()
+	return p.closed
+}
+
+// GetStats returns current pool statistics
+func (p *Pool) GetStats() PoolStats {
+	connected := 0
+	for _, s := range p.sessions {
+		s.connMu.Lock()
+		if s.client != nil {
+			connected++
+		}
+		s.connMu.Unlock()
+	}
+
+	return PoolStats{
+		Sessions:     len(p.sessions),
+		Connected:    connected,
+		Dials:        atomic.LoadInt64(&p.dials),
+		HandleHits:   atomic.LoadInt64(&p.handleHits),
+		HandleMisses: atomic.LoadInt64(&p.handleMisses),
+	}
+}
+
+// Close closes the cached handles and disconnects every session. Leases
+// still held fail on their next operation.
+func (p *Pool) Close() error {
+	p.mu.Lock()
+	if p.closed {
+		p.mu.Unlock()
+		return nil
+	}
+	p.closed = true
+	p.mu.Unlock()
+
+	p.cancel()
+	p.handles.closeAll()
+
+	for _, s := range p.sessions {
+		s.connMu.Lock()
+		if s.client != nil {
+			s.client.Disconnect()
+			s.client = nil
+			s.gen++
+		}
+		s.connMu.Unlock()
+	}
+
+	p.logger.Info("SMB pool closed",
+		zap.Int64("dials", atomic.LoadInt64(&p.dials)),
+		zap.Int64("handle_hits", atomic.LoadInt64(&p.handleHits)),
+		zap.Int64("handle_misses", atomic.LoadInt64(&p.handleMisses)),
+	)
+	return nil
+}
+
+// waitQuota takes a lease slot of a subsystem, waiting for one if needed
+func (p *Pool) waitQuota(ctx context.Context, sub Subsystem) error {
+	if sub < 0 || sub >= subsystemCount {
+		return fmt.Errorf("unknown subsystem %d", int(sub))
+	}
+
+	select {
+	case p.quotas[sub] <- struct{}{}:
+		return nil
+	case <-ctx.Done():
+		return ctx.Err()
+	case <-p.ctx.Done():
+		return errPoolClosed
+	}
+}
+
+// pick returns the least loaded session a subsystem may use, counting the
+// new lease. Ties go to the lowest session, the hydration one.
+func (p *Pool) pick(sub Subsystem) (*poolSession, error) {
+	p.mu.Lock()
+	defer p.mu.Unlock()
+
+	if p.closed {
+		return nil, errPoolClosed
+	}
+
+	candidates := p.sessionsFor(sub)
+	best := candidates[0]
+	for _, s := range candidates[1:] {
+		if s.leases < best.leases {
+			best = s
+		}
+	}
+	best.leases++
+	return best, nil
+}
+
+// sessionsFor returns the sessions a subsystem may use
+func (p *Pool) sessionsFor(sub Subsystem) []*poolSession {
+	if sub == SubsystemBulk && len(p.sessions) > 1 {
+		return p.sessions[1:] // The first session is kept for hydration
+	}
+	return p.sessions
+}
+
+// mayUse checks if a subsystem may lease a session
+func (p *Pool) mayUse(sub Subsystem, session *poolSession) bool {
+	return !(sub == SubsystemBulk && len(p.sessions) > 1 && session.id == 0)
+}
+
+// lease connects a picked session if needed and returns its lease. On
+// failure the session and quota slot are released.
+func (p *Pool) lease(session *poolSession, sub Subsystem) (*Lease, error) {
+	client, gen, err := session.connect(p)
+	if err != nil {
+		p.release(session, sub)
+		return nil, fmt.Errorf("failed to connect SMB session %d: %w", session.id, err)
+	}
+	return &Lease{pool: p, session: session, sub: sub, client: client, gen: gen}, nil
+}
+
+// release returns a session and a lease slot
+func (p *Pool) release(session *poolSession, sub Subsystem) {
+	p.mu.Lock()
+	session.leases--
+	p.mu.Unlock()
+	<-p.quotas[sub]
+}
+
+// broken reports whether a lease's session stopped answering after an
+// operation failed (not because ctx was cancelled), dropping it so the
+// next lease reconnects.
+func (p *Pool) broken(ctx context.Context, lease *Lease) bool {
+	if ctx.Err() != nil || p.IsClosed() {
+		return false
+	}
+	if err := p.probe(lease.Client()); err == nil {
+		return false // The operation failed, not the session
+	}
+	lease.Invalidate()
+	return true
+}
+
+// connect returns the session's client, connecting it if needed
+func (s *poolSession) connect(p *Pool) (*SMBClient, uint64, error) {
+	s.connMu.Lock()
+	defer s.connMu.Unlock()
+
+	if s.client == nil {
+		client, err := p.dial()
+		if err != nil {
+			return nil, 0, err
+		}
+		atomic.AddInt64(&p.dials, 1)
+		s.client = client
+
+		// Closed while dialing: don't leak the connection
+		if p.IsClosed() {
+			s.client.Disconnect()
+			s.client = nil
+			return nil, 0, errPoolClosed
+		}
+	}
+	return s.client, s.gen, nil
+}
+
+// drop disconnects the session's client if it is still the one of gen
+func (s *poolSession) drop(gen uint64, logger *zap.Logger) {
+	s.connMu.Lock()
+	defer s.connMu.Unlock()
+
+	if s.gen != gen || s.client == nil {
+		return // Already dropped
+	}
+
+	logger.Info("dropping broken SMB session", zap.Int("session", s.id))
+	s.client.Disconnect()
+	s.client = nil
+	s.gen++
+}
+
+// generation returns the session's current connection generation
+func (s *poolSession) generation() uint64 {
+	s.connMu.Lock()
+	defer s.connMu.Unlock()
+	return s.gen
+}
+
+// leasedReader releases its lease when closed
+type leasedReader struct {
+	io.ReadCloser
+	lease *Lease
+}
+
+func (r *leasedReader) Close() error {
+	err := r.ReadCloser.Close()
+	r.lease.Release()
+	return err
+}
+
+// pooledFile is a file opened by Pool.OpenFileAt, bound to the caller's ctx.
+// Close returns the handle to the cache when it is still good.
+type pooledFile struct {
+	pool   *Pool
+	lease  *Lease
+	handle *idleHandle
+	ctx    context.Context
+	stop   func() bool // Stops watching ctx
+	failed atomic.Bool // A read failed: don't cache the handle
+	once   sync.Once
+}
+
+func (p *Pool) newPooledFile(ctx context.Context, lease *Lease, h *idleHandle) *pooledFile {
+	return &pooledFile{
+		pool:   p,
+		lease:  lease,
+		handle: h,
+		ctx:    ctx,
+		stop:   context.AfterFunc(ctx, h.cancel), // Abort requests in flight
+	}
+}
+
+func (f *pooledFile) ReadAt(b []byte, off int64) (int, error) {
+	n, err := f.handle.file.ReadAt(b, off)
+	if err != nil && err != io.EOF {
+		f.failed.Store(true)
+	}
+	return n, err
+}
+
+func (f *pooledFile) Close() error {
+	var err error
+	f.once.Do(func() {
+		watching := f.stop()
+		keep := watching && f.ctx.Err() == nil && !f.failed.Load() && !f.pool.IsClosed()
+		if !keep || !f.pool.handles.put(f.handle) {
+			err = f.handle.close()
+		}
+		f.lease.Release()
+	})
+	return err
+}
+
+// idleHandle is an open file of a pool session
+type idleHandle struct {
+	path      string
+	file      ReaderAtCloser
+	cancel    context.CancelFunc // Aborts the requests of the file
+	session   *poolSession
+	gen       uint64 // Connection the file was opened on
+	epoch     uint64 // handleCache epoch when the file was opened
+	idleSince time.Time
+}
+
+func (h *idleHandle) close() error {
+	h.cancel()
+	return h.file.Close()
+}
+
+// maxInvalidatedPaths bounds the paths a handleCache remembers as
+// invalidated; past it, every handle opened before is refused instead.
+const maxInvalidatedPaths = 1024
+
+// handleCache keeps the handles of recently read files open, at most one
+// per path and session, evicting the least recently used.
+type handleCache struct {
+	mu   sync.Mutex
+	max  int
+	ttl  time.Duration
+	idle []*idleHandle // Least recently used first
+
+	// A handle opened before its path was invalidated is not cached
+	epoch   uint64            // Incremented by each invalidation
+	floor   uint64            // Handles of an older epoch are not cached
+	invalid map[string]uint64 // handleKey -> epoch of its last invalidation
+}
+
+// handleKey normalizes a remote path for invalidation: SMB paths are
+// case-insensitive and callers differ in separators.
+func handleKey(remotePath string) string {
+	return strings.ToLower(strings.Trim(strings.ReplaceAll(remotePath, "\\", "/"), "/"))
+}
+
+// currentEpoch returns the epoch to record for a handle about to be opened
+func (c *handleCache) currentEpoch() uint64 {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	return c.epoch
+}
+
+// invalidate closes the idle handles of a path and keeps the handles of it
+// already open from being cached.
+func (c *handleCache) invalidate(remotePath string) {
+	key := handleKey(remotePath)
+
+	c.mu.Lock()
+	c.epoch++
+	if len(c.invalid) >= maxInvalidatedPaths {
+		c.invalid = nil
+		c.floor = c.epoch
+	} else {
+		if c.invalid == nil {
+			c.invalid = make(map[string]uint64)
+		}
+		c.invalid[key] = c.epoch
+	}
+	var drop []*idleHandle
+	kept := c.idle[:0]
+	for _, h := range c.idle {
+		if handleKey(h.path) == key {
+			drop = append(drop, h)
+		} else {
+			kept = append(kept, h)
+		}
+	}
+	clear(c.idle[len(kept):])
+	c.idle = kept
+	c.mu.Unlock()
+
+	for _, h := range drop {
+		h.close()
+	}
+}
+
+// sweep closes the expired handles
+func (c *handleCache) sweep() {
+	c.mu.Lock()
+	drop := c.sweepLocked()
+	c.mu.Unlock()
+
+	for _, h := range drop {
+		h.close()
+	}
+}
+
+// take removes and returns the idle handle of a path, if it is still
+// usable and its session is allowed. Expired and stale handles are closed
+// on the way; a handle on another session stays cached.
+func (c *handleCache) take(path string, allowed func(s *poolSession) bool) *idleHandle {
+	var found *idleHandle
+
+	c.mu.Lock()
+	drop := c.sweepLocked()
+	for i, h := range c.idle {
+		if h.path == path && allowed(h.session) {
+			found = h
+			c.idle = append(c.idle[:i], c.idle[i+1:]...)
+			c.idle[len(c.idle):cap(c.idle)][0] = nil
+			break
+		}
+	}
+	c.mu.Unlock()
+
+	// On a dropped connection the handle is dead
+	if found != nil && found.session.generation() != found.gen {
+		drop = append(drop, found)
+		found = nil
+	}
+	for _, h := range drop {
+		h.close()
+	}
+	return found
+}
+
+// put caches a handle; it returns false if the handle was not kept (the
+// caller closes it).
+func (c *handleCache) put(h *idleHandle) bool {
+	if c.max <= 0 {
+		return false
+	}
+
+	c.mu.Lock()
+	drop := c.sweepLocked()
+	kept := h.epoch >= c.floor
+	if e, ok := c.invalid[handleKey(h.path)]; ok && e > h.epoch {
+		kept = false // Opened before the file changed
+	}
+	for _, other := range c.idle {
+		if other.path == h.path && other.session == h.session {
+			kept = false // One idle handle per path and session is enough
+			break
+		}
+	}
+	if kept {
+		h.idleSince = time.Now()
+		c.idle = append(c.idle, h)
+		if len(c.idle) > c.max {
+			drop = append(drop, c.idle[0])
+			c.idle[0] = nil
+			c.idle = c.idle[1:]
+		}
+	}
+	c.mu.Unlock()
+
+	for _, old := range drop {
+		old.close()
+	}
+	return kept
+}
+
+// sweepLocked removes the expired handles and returns them, to be closed
+// outside the lock
+func (c *handleCache) sweepLocked() []*idleHandle {
+	var expired []*idleHandle
+	now := time.Now()
+	kept := c.idle[:0]
+	for _, h := range c.idle {
+		if now.Sub(h.idleSince) > c.ttl {
+			expired = append(expired, h)
+		} else {
+			kept = append(kept, h)
+		}
+	}
+	clear(c.idle[len(kept):])
+	c.idle = kept
+	return expired
+}
+
+// closeAll closes every cached handle
+func (c *handleCache) closeAll() {
+	c.mu.Lock()
+	idle := c.idle
+	c.idle = nil
+	c.mu.Unlock()
+
+	for _, h := range idle {
+		h.close()
+	}
+}
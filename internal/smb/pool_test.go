@@ -0,0 +1,302 @@
+package smb
+
+import (
+	"context"
+	"errors"
+	"io"
+	"sync"
+	"testing"
+	"time"
+
+	"go.uber.org/zap"
+)
+
+// fakePoolFile is a remote file that counts its closes
+type fakePoolFile struct {
+	mu     sync.Mutex
+	closed int
+}
+
+func (f *fakePoolFile) ReadAt(b []byte, off int64) (int, error) { return 0, io.EOF }
+
+func (f *fakePoolFile) Close() error {
+	f.mu.Lock()
+	f.closed++
+	f.mu.Unlock()
+	return nil
+}
+
+// newTestPool creates a pool whose sessions are unconnected clients
+func newTestPool(t *testing.T, cfg *PoolConfig) (*Pool, *int) {
+	t.Helper()
+
+	var mu sync.Mutex
+	opens := 0
+	pool, err := NewPool(func() (*SMBClient, error) {
+		return &SMBClient{logger: zap.NewNop()}, nil
+	}, cfg, zap.NewNop())
+	if err != nil {
+		t.Fatalf("NewPool failed: %v", err)
+	}
+	pool.open = func(ctx context.Context, c *SMBClient, remotePath string) (ReaderAtCloser, error) {
+		mu.Lock()
+		opens++
+		mu.Unlock()
+		return &fakePoolFile{}, nil
+	}
+	pool.probe = func(c *SMBClient) error { return nil }
+	t.Cleanup(func() { pool.Close() })
+	return pool, &opens
+}
+
+func TestNewPool_Validation(t *testing.T) {
+	if _, err := NewPool(nil, nil, nil); err == nil {
+		t.Error("expected error for nil dial")
+	}
+
+	pool, _ := newTestPool(t, nil)
+	if stats := pool.GetStats(); stats.Sessions != DefaultPoolSessions || stats.Connected != 0 {
+		t.Errorf("expected %d unconnected sessions, got %+v", DefaultPoolSessions, stats)
+	}
+}
+
+func TestPool_QuotasDoNotStarve(t *testing.T) {
+	pool, _ := newTestPool(t, &PoolConfig{Sessions: 3, HydrationQuota: 2, BulkQuota: 2})
+	ctx := context.Background()
+
+	// Bulk uses up its quota, on the sessions it may use
+	var bulk []*Lease
+	for i := 0; i < 2; i++ {
+		lease, err := pool.Acquire(ctx, SubsystemBulk)
+		if err != nil {
+			t.Fatalf("bulk lease failed: %v", err)
+		}
+		if lease.session.id == 0 {
+			t.Error("bulk lease got the hydration session")
+		}
+		bulk = append(bulk, lease)
+	}
+
+	timeout, cancel := context.WithTimeout(ctx, 20*time.Millisecond)
+	defer cancel()
+	if _, err := pool.Acquire(timeout, SubsystemBulk); !errors.Is(err, context.DeadlineExceeded) {
+		t.Errorf("expected bulk to wait for its quota, got %v", err)
+	}
+
+	// Hydration is not affected, and gets the idle session
+	lease, err := pool.Acquire(ctx, SubsystemHydration)
+	if err != nil {
+		t.Fatalf("hydration lease failed: %v", err)
+	}
+	if lease.session.id != 0 {
+		t.Errorf("expected hydration on session 0, got %d", lease.session.id)
+	}
+	lease.Release()
+	lease.Release() // Twice is harmless
+
+	// A released slot is available again
+	bulk[0].Release()
+	if lease, err := pool.Acquire(ctx, SubsystemBulk); err != nil {
+		t.Errorf("expected a bulk lease after release, got %v", err)
+	} else {
+		lease.Release()
+	}
+	bulk[1].Release()
+}
+
+func TestPool_HandleCache(t *testing.T) {
+	pool, opens := newTestPool(t, nil)
+	ctx := context.Background()
+
+	for i := 0; i < 3; i++ {
+		file, err := pool.OpenFileAt(ctx, SubsystemHydration, "docs/a.bin")
+		if err != nil {
+			t.Fatalf("OpenFileAt failed: %v", err)
+		}
+		file.Close()
+	}
+	if *opens != 1 {
+		t.Errorf("expected the handle to be reused, got %d opens", *opens)
+	}
+	if stats := pool.GetStats(); stats.HandleHits != 2 || stats.HandleMisses != 1 {
+		t.Errorf("expected 2 hits and 1 miss, got %+v", stats)
+	}
+
+	// Cancelled while open: the handle is not kept
+	cancelled, cancel := context.WithCancel(ctx)
+	file, _ := pool.OpenFileAt(cancelled, SubsystemHydration, "docs/a.bin")
+	cancel()
+	file.Close()
+	file, _ = pool.OpenFileAt(ctx, SubsystemHydration, "docs/a.bin")
+	file.Close()
+	if *opens != 2 {
+		t.Errorf("expected a new open after cancellation, got %d opens", *opens)
+	}
+
+	// A dropped session kills its handles
+	lease, _ := pool.Acquire(ctx, SubsystemHydration)
+	lease.Invalidate()
+	lease.Release()
+	file, _ = pool.OpenFileAt(ctx, SubsystemHydration, "docs/a.bin")
+	file.Close()
+	if *opens != 3 {
+		t.Errorf("expected a new open after the session dropped, got %d opens", *opens)
+	}
+}
+
+func TestPool_HandleCacheKeepsBulkOffHydrationSession(t *testing.T) {
+	pool, opens := newTestPool(t, &PoolConfig{Sessions: 2})
+	ctx := context.Background()
+
+	// Cached on the hydration session
+	file, _ := pool.OpenFileAt(ctx, SubsystemHydration, "a")
+	file.Close()
+
+	// Bulk may not take it: opened again on its own session
+	file, err := pool.OpenFileAt(ctx, SubsystemBulk, "a")
+	if err != nil {
+		t.Fatalf("OpenFileAt failed: %v", err)
+	}
+	if session := file.(*pooledFile).lease.session.id; session == 0 {
+		t.Error("bulk file got the hydration session")
+	}
+	file.Close()
+	if *opens != 2 {
+		t.Errorf("expected bulk to open its own handle, got %d opens", *opens)
+	}
+
+	// Both handles are cached, each for its own subsystem
+	for _, sub := range []Subsystem{SubsystemHydration, SubsystemBulk} {
+		file, _ := pool.OpenFileAt(ctx, sub, "a")
+		file.Close()
+	}
+	if *opens != 2 {
+		t.Errorf("expected both handles to be reused, got %d opens", *opens)
+	}
+	for _, s := range pool.sessions {
+		if s.leases != 0 {
+			t.Errorf("expected session %d to have no leases, got %d", s.id, s.leases)
+		}
+	}
+}
+
+func TestPool_HandleCacheExpiry(t *testing.T) {
+	pool, opens := newTestPool(t, &PoolConfig{HandleCacheSize: 1, HandleTTL: 10 * time.Millisecond})
+	ctx := context.Background()
+
+	for _, path := range []string{"a", "b", "a"} { // b evicts a
+		file, _ := pool.OpenFileAt(ctx, SubsystemHydration, path)
+		file.Close()
+	}
+	if *opens != 3 {
+		t.Errorf("expected the cache to hold one handle, got %d opens", *opens)
+	}
+
+	time.Sleep(20 * time.Millisecond)
+	file, _ := pool.OpenFileAt(ctx, SubsystemHydration, "a")
+	file.Close()
+	if *opens != 4 {
+		t.Errorf("expected an expired handle to be reopened, got %d opens", *opens)
+	}
+}
+
+func TestPool_InvalidatePath(t *testing.T) {
+	pool, opens := newTestPool(t, nil)
+	ctx := context.Background()
+
+	// An idle handle is closed
+	file, _ := pool.OpenFileAt(ctx, SubsystemHydration, "docs/a.bin")
+	idle := file.(*pooledFile).handle.file.(*fakePoolFile)
+	file.Close()
+	pool.InvalidatePath(`docs\A.bin`)
+	if idle.closed != 1 {
+		t.Errorf("expected the idle handle to be closed, got %d closes", idle.closed)
+	}
+
+	// A handle in use is not cached again
+	file, _ = pool.OpenFileAt(ctx, SubsystemHydration, "docs/a.bin")
+	pool.InvalidatePath("docs/a.bin")
+	file.Close()
+	file, _ = pool.OpenFileAt(ctx, SubsystemHydration, "docs/a.bin")
+	file.Close()
+	if *opens != 3 {
+		t.Errorf("expected every open after an invalidation to reopen, got %d opens", *opens)
+	}
+
+	// Handles opened afterwards are cached as before
+	file, _ = pool.OpenFileAt(ctx, SubsystemHydration, "docs/a.bin")
+	file.Close()
+	if *opens != 3 {
+		t.Errorf("expected the new handle to be reused, got %d opens", *opens)
+	}
+}
+
+func TestPool_IdleHandlesSwept(t *testing.T) {
+	pool, _ := newTestPool(t, &PoolConfig{HandleTTL: 10 * time.Millisecond})
+
+	file, _ := pool.OpenFileAt(context.Background(), SubsystemHydration, "a")
+	idle := file.(*pooledFile).handle.file.(*fakePoolFile)
+	file.Close()
+
+	// Closed by the sweeper, without another open
+	deadline := time.Now().Add(time.Second)
+	for {
+		idle.mu.Lock()
+		closed := idle.closed
+		idle.mu.Unlock()
+		if closed == 1 {
+			break
+		}
+		if time.Now().After(deadline) {
+			t.Fatal("expected the expired handle to be closed")
+		}
+		time.Sleep(5 * time.Millisecond)
+	}
+}
+
+func TestPool_DoRetriesBrokenSession(t *testing.T) {
+	pool, _ := newTestPool(t, &PoolConfig{Sessions: 1})
+	ctx := context.Background()
+	failure := errors.New("connection reset")
+
+	// The session still answers: the error is returned as is
+	calls := 0
+	err := pool.Do(ctx, SubsystemBulk, func(c *SMBClient) error {
+		calls++
+		return failure
+	})
+	if !errors.Is(err, failure) || calls != 1 {
+		t.Errorf("expected one failed call, got %d (%v)", calls, err)
+	}
+
+	// The session is gone: retried once on a new connection
+	pool.probe = func(c *SMBClient) error { return failure }
+	var clients []*SMBClient
+	err = pool.Do(ctx, SubsystemBulk, func(c *SMBClient) error {
+		clients = append(clients, c)
+		if len(clients) == 1 {
+			return failure
+		}
+		return nil
+	})
+	if err != nil || len(clients) != 2 || clients[0] == clients[1] {
+		t.Errorf("expected a retry on a new client, got %d calls (%v)", len(clients), err)
+	}
+	if dials := pool.GetStats().Dials; dials != 2 {
+		t.Errorf("expected 2 dials, got %d", dials)
+	}
+}
+
+func TestPool_Closed(t *testing.T) {
+	pool, _ := newTestPool(t, nil)
+	file, _ := pool.OpenFileAt(context.Background(), SubsystemHydration, "a")
+	pool.Close()
+	file.Close()
+
+	if !pool.IsClosed() {
+		t.Error("expected the pool to be closed")
+	}
+	if _, err := pool.Acquire(context.Background(), SubsystemHydration); err == nil {
+		t.Error("expected Acquire to fail on a closed pool")
+	}
+}
@@ -0,0 +1,143 @@
+package smb
+
+import (
+	"context"
+	"sync"
+)
+
+// DefaultWalkWorkers is the number of directories listed concurrently by
+// WalkDirs when no count is given. Listing is latency-bound: over a WAN,
+// most of a listing is spent waiting for the server.
+const DefaultWalkWorkers = 8
+
+// ListDirFunc lists one directory and returns the subdirectories to descend
+// into. Calls run concurrently, one per worker. Returning an error stops the
+// walk; to skip a directory that cannot be listed, return nil subdirs and no
+// error.
+type ListDirFunc func(ctx context.Context, dir string) (subdirs []string, err error)
+
+// WalkDirs walks a directory tree from root, listing up to workers
+// directories at a time. A directory is listed only after its parent's
+// ListDirFunc returned, so whatever a ListDirFunc emits for a subdirectory
+// comes before the subdirectory's own contents.
+//
+// Each worker descends depth-first through its own queue of directories;
+// a worker with nothing left steals the oldest (shallowest) directory of
+// the busiest queue, so one wide or deep subtree doesn't leave the other
+// workers idle.
+func WalkDirs(ctx context.Context, root string, workers int, list ListDirFunc) error {
+	if workers <= 0 {
+		workers = DefaultWalkWorkers
+	}
+	if err := ctx.Err(); err != nil {
+		return err
+	}
+
+	w := &dirWalker{
+		list:    list,
+		queues:  make([][]string, workers),
+		pending: 1,
+	}
+	w.cond = sync.NewCond(&w.mu)
+	w.queues[0] = []string{root}
+
+	// Wake the workers waiting for directories when ctx is cancelled
+	stop := context.AfterFunc(ctx, func() { w.fail(ctx.Err()) })
+	defer stop()
+
+	var wg sync.WaitGroup
+	for id := 0; id < workers; id++ {
+		wg.Add(1)
+		go func(id int) {
+			defer wg.Done()
+			for {
+				dir, ok := w.next(id)
+				if !ok {
+					return
+				}
+				subdirs, err := w.list(ctx, dir)
+				w.done(id, subdirs, err)
+			}
+		}(id)
+	}
+	wg.Wait()
+
+	w.mu.Lock()
+	defer w.mu.Unlock()
+	return w.err
+}
+
+// dirWalker holds the directory queues of WalkDirs
+type dirWalker struct {
+	list ListDirFunc
+
+	mu      sync.Mutex
+	cond    *sync.Cond
+	queues  [][]string // Per-worker directories, newest last
+	pending int        // Directories queued or being listed
+	err     error      // First error, stops the walk
+}
+
+// next returns the next directory for a worker, waiting for one if other
+// workers are still listing. It returns false when the walk is over.
+func (w *dirWalker) next(id int) (string, bool) {
+	w.mu.Lock()
+	defer w.mu.Unlock()
+
+	for {
+		if w.err != nil || w.pending == 0 {
+			return "", false
+		}
+
+		// Own queue: newest first, for depth-first locality
+		if q := w.queues[id]; len(q) > 0 {
+			dir := q[len(q)-1]
+			w.queues[id] = q[:len(q)-1]
+			return dir, true
+		}
+
+		// Steal the oldest directory of the longest queue
+		victim := -1
+		for i, q := range w.queues {
+			if len(q) > 0 && (victim < 0 || len(q) > len(w.queues[victim])) {
+				victim = i
+			}
+		}
+		if victim >= 0 {
+			q := w.queues[victim]
+			dir := q[0]
+			w.queues[victim] = q[1:]
+			return dir, true
+		}
+
+		w.cond.Wait()
+	}
+}
+
+// done queues the subdirectories found by a worker
+func (w *dirWalker) done(id int, subdirs []string, err error) {
+	w.mu.Lock()
+	if err != nil {
+		if w.err == nil {
+			w.err = err
+		}
+	} else {
+		w.queues[id] = append(w.queues[id], subdirs...)
+		w.pending += len(subdirs)
+	}
+	w.pending--
+	w.mu.Unlock()
+
+	w.cond.Broadcast()
+}
+
+// fail stops the walk with err
+func (w *dirWalker) fail(err error) {
+	w.mu.Lock()
+	if w.err == nil {
+		w.err = err
+	}
+	w.mu.Unlock()
+
+	w.cond.Broadcast()
+}
@@ -0,0 +1,129 @@
+package smb
+
+import (
+	"context"
+	"errors"
+	"fmt"
+	"path"
+	"sync"
+	"testing"
+	"time"
+)
+
+// walkTree builds a tree of depth levels with fanout subdirectories each
+func walkTree(depth, fanout int) map[string][]string {
+	tree := make(map[string][]string)
+	var build func(dir string, level int)
+	build = func(dir string, level int) {
+		if level == depth {
+			return
+		}
+		for i := 0; i < fanout; i++ {
+			child := fmt.Sprintf("%s/%d", dir, i)
+			tree[dir] = append(tree[dir], child)
+			build(child, level+1)
+		}
+	}
+	build("root", 0)
+	return tree
+}
+
+func TestWalkDirs_ListsEveryDirectoryOnce(t *testing.T) {
+	tree := walkTree(4, 4) // 1 + 4 + 16 + 64 + 256 directories
+
+	var mu sync.Mutex
+	listed := make(map[string]int)
+	concurrent, maxConcurrent := 0, 0
+
+	err := WalkDirs(context.Background(), "root", 8, func(ctx context.Context, dir string) ([]string, error) {
+		mu.Lock()
+		listed[dir]++
+		concurrent++
+		if concurrent > maxConcurrent {
+			maxConcurrent = concurrent
+		}
+		mu.Unlock()
+
+		time.Sleep(time.Millisecond) // Listing latency
+
+		mu.Lock()
+		concurrent--
+		mu.Unlock()
+		return tree[dir], nil
+	})
+	if err != nil {
+		t.Fatalf("walk failed: %v", err)
+	}
+
+	if len(listed) != 341 {
+		t.Errorf("expected 341 directories listed, got %d", len(listed))
+	}
+	for dir, n := range listed {
+		if n != 1 {
+			t.Errorf("expected %s to be listed once, got %d", dir, n)
+		}
+	}
+	if maxConcurrent < 2 || maxConcurrent > 8 {
+		t.Errorf("expected 2-8 concurrent listings, got %d", maxConcurrent)
+	}
+}
+
+func TestWalkDirs_ParentsBeforeChildren(t *testing.T) {
+	tree := walkTree(3, 3)
+
+	var mu sync.Mutex
+	done := make(map[string]bool)
+
+	err := WalkDirs(context.Background(), "root", 4, func(ctx context.Context, dir string) ([]string, error) {
+		mu.Lock()
+		defer mu.Unlock()
+		if parent := path.Dir(dir); dir != "root" && !done[parent] {
+			return nil, fmt.Errorf("%s listed before its parent %s", dir, parent)
+		}
+		done[dir] = true
+		return tree[dir], nil
+	})
+	if err != nil {
+		t.Fatal(err)
+	}
+}
+
+func TestWalkDirs_ErrorStopsWalk(t *testing.T) {
+	tree := walkTree(3, 4)
+	failure := errors.New("access denied")
+
+	err := WalkDirs(context.Background(), "root", 4, func(ctx context.Context, dir string) ([]string, error) {
+		if dir == "root/1" {
+			return nil, failure
+		}
+		return tree[dir], nil
+	})
+	if !errors.Is(err, failure) {
+		t.Errorf("expected the listing error, got %v", err)
+	}
+}
+
+func TestWalkDirs_Cancellation(t *testing.T) {
+	ctx, cancel := context.WithCancel(context.Background())
+	cancel()
+
+	called := false
+	err := WalkDirs(ctx, "root", 4, func(ctx context.Context, dir string) ([]string, error) {
+		called = true
+		return nil, nil
+	})
+	if !errors.Is(err, context.Canceled) || called {
+		t.Errorf("expected a cancelled walk without listings, got %v (listed: %v)", err, called)
+	}
+
+	// Cancelled while workers wait for the directories of a slow listing
+	ctx, cancel = context.WithCancel(context.Background())
+	err = WalkDirs(ctx, "root", 4, func(ctx context.Context, dir string) ([]string, error) {
+		cancel()
+		<-ctx.Done()
+		return []string{dir + "/child"}, nil
+	})
+	if !errors.Is(err, context.Canceled) {
+		t.Errorf("expected context.Canceled, got %v", err)
+	}
+}
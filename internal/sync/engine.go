@@ -57,6 +57,7 @@ func NewEngine(cfg *config.Config, db *database.DB, logger *zap.Logger) (*Engine
 	// Create executor
 	bufferSizeMB := cfg.Sync.Performance.BufferSizeMB
 	executor := NewExecutor(bufferSizeMB, logger.Named("executor"))
+	executor.SetDeltaUpload(cacheManager, cfg.Sync.Performance.DeltaMinSizeMB)
 
 	return &Engine{
 		db:       db,
@@ -277,7 +278,7 @@ func (e *Engine) executeSync(ctx context.Context, req *SyncRequest, result *Sync
 		Percentage: 95,
 	})
 
-	if err := e.finalizeSync(ctx, req, result, job, localFiles, remoteFiles); err != nil {
+	if err := e.finalizeSync(ctx, req, result, job, localFiles, remoteFiles, cachedFiles); err != nil {
 		e.logger.Error("finalization failed", zap.Error(err))
 		// Don't return error, sync already completed
 	}
@@ -3,11 +3,13 @@ package sync
 import (
 	"context"
 	"fmt"
+	"os"
 	"path/filepath"
 	"strings"
 
 	"github.com/juste-un-gars/anemone_sync_windows/internal/cache"
 	"github.com/juste-un-gars/anemone_sync_windows/internal/database"
+	"github.com/juste-un-gars/anemone_sync_windows/internal/scanner"
 	"github.com/juste-un-gars/anemone_sync_windows/internal/smb"
 	"go.uber.org/zap"
 )
@@ -91,10 +93,8 @@ func (e *Engine) detectChanges(ctx context.Context, req *SyncRequest,
 	err error,
 ) {
 	// Use change detector for 3-way merge
-	allDecisions, err := e.detector.BatchDetermineSyncActions(req.JobID, localFiles, remoteFiles)
-	if err != nil {
-		return nil, nil, fmt.Errorf("change detection failed: %w", err)
-	}
+	// The cache was loaded once during the scan: no per-file queries here
+	allDecisions := e.detector.DetermineSyncActionsFromCache(localFiles, remoteFiles, cachedFiles)
 
 	// Separate conflicts from executable decisions
 	initialConflicts := make([]*cache.SyncDecision, 0)
@@ -213,7 +213,9 @@ func (e *Engine) executeActions(ctx context.Context, req *SyncRequest,
 	}
 
 	// Execute using executor
-	actions, err := e.executor.Execute(ctx, decisions, smbClient, progressFn)
+	executor := e.executor.forJob(req.JobID, localBasePath)
+	executor.beforeRemoteChange = req.RemoteChangeCallback
+	actions, err := executor.Execute(ctx, decisions, smbClient, progressFn)
 	if err != nil {
 		return nil, fmt.Errorf("execution failed: %w", err)
 	}
@@ -223,18 +225,20 @@ func (e *Engine) executeActions(ctx context.Context, req *SyncRequest,
 
 // finalizeSync handles Phase 5: Finalization
 func (e *Engine) finalizeSync(ctx context.Context, req *SyncRequest, result *SyncResult, job *database.SyncJob,
-	localFiles, remoteFiles map[string]*cache.FileInfo) error {
-	// Update cache for successful actions
+	localFiles, remoteFiles, cachedFiles map[string]*cache.FileInfo) error {
+	// Update cache for successful actions, in a single transaction
 	if !req.DryRun {
-		if err := e.updateCacheFromActions(req.JobID, req.LocalPath, result.Actions); err != nil {
-			return fmt.Errorf("failed to update cache: %w", err)
-		}
+		batch := e.cache.NewBatch(req.JobID)
 
 		// Initialize cache for files that are already in sync (exist on both sides with same content)
 		// This is critical for bidirectional sync to detect remote deletions correctly
-		if err := e.initializeCacheForInSyncFiles(req.JobID, localFiles, remoteFiles); err != nil {
-			e.logger.Warn("failed to initialize cache for in-sync files", zap.Error(err))
-			// Non-fatal error, continue
+		e.cacheInSyncFiles(batch, localFiles, remoteFiles, cachedFiles)
+
+		// Action results come last: they override the scan state of their files
+		e.cacheActionResults(batch, req.LocalPath, result.Actions)
+
+		if err := batch.Flush(); err != nil {
+			return fmt.Errorf("failed to update cache: %w", err)
 		}
 	}
 
@@ -278,11 +282,8 @@ func (e *Engine) finalizeSync(ctx context.Context, req *SyncRequest, result *Syn
 	return nil
 }
 
-// updateCacheFromActions updates cache based on successful actions
-func (e *Engine) updateCacheFromActions(jobID int64, localBasePath string, actions []*SyncAction) error {
-	updates := make(map[string]*cache.FileInfo)
-	remotePaths := make(map[string]string)
-
+// cacheActionResults records the cache state of files after successful actions
+func (e *Engine) cacheActionResults(batch *cache.CacheBatch, localBasePath string, actions []*SyncAction) {
 	for _, action := range actions {
 		if action.Status != ActionStatusSuccess {
 			continue
@@ -290,30 +291,42 @@ func (e *Engine) updateCacheFromActions(jobID int64, localBasePath string, actio
 
 		// Convert absolute path back to relative for cache storage
 		relPath := toRelativePath(action.FilePath, localBasePath)
+		batch.Update(relPath, action.RemotePath, syncedFileInfo(relPath, action))
+	}
+}
 
-		updates[relPath] = &cache.FileInfo{
+// syncedFileInfo returns the cache entry of a file after a successful action.
+// Transferred files are recorded with their actual local metadata and NTFS
+// identity, so the next scan recognizes them as unchanged without hashing,
+// and with the remote mtime the next remote comparison is made against.
+func syncedFileInfo(relPath string, action *SyncAction) *cache.FileInfo {
+	localInfo, err := os.Stat(action.FilePath)
+	if err != nil || (action.Action != cache.ActionUpload && action.Action != cache.ActionDownload) {
+		return &cache.FileInfo{
 			Path:  relPath,
 			Size:  action.Size,
 			MTime: timeNow(), // Current time after sync
 			Hash:  "",        // Hash will be computed on next scan if needed
 		}
-		remotePaths[relPath] = action.RemotePath
 	}
 
-	if len(updates) > 0 {
-		return e.cache.UpdateCacheBatch(jobID, updates, remotePaths)
-	}
+	info := &cache.FileInfo{
+		Path:  relPath,
+		Size:  localInfo.Size(),
+		MTime: localInfo.ModTime(),
+		Hash:  "", // Not recorded: a stale remote manifest would then look modified
 
-	return nil
+		RemoteMTime: action.RemoteMTime,
+	}
+	info.FileID, info.USN = scanner.ReadFileIdentity(action.FilePath)
+	return info
 }
 
-// initializeCacheForInSyncFiles adds files to cache that are already synchronized
+// cacheInSyncFiles adds files to cache that are already synchronized
 // (exist on both local and remote with same content). This is critical for
 // bidirectional sync to correctly detect when files are deleted on one side.
-func (e *Engine) initializeCacheForInSyncFiles(jobID int64, localFiles, remoteFiles map[string]*cache.FileInfo) error {
-	updates := make(map[string]*cache.FileInfo)
-	remotePaths := make(map[string]string)
-
+func (e *Engine) cacheInSyncFiles(batch *cache.CacheBatch, localFiles, remoteFiles, cachedFiles map[string]*cache.FileInfo) {
+	added := 0
 	for path, localInfo := range localFiles {
 		remoteInfo, existsRemote := remoteFiles[path]
 		if !existsRemote || localInfo == nil || remoteInfo == nil {
@@ -324,32 +337,30 @@ func (e *Engine) initializeCacheForInSyncFiles(jobID int64, localFiles, remoteFi
 		if localInfo.Size != remoteInfo.Size {
 			continue
 		}
-		if localInfo.Hash != "" && remoteInfo.Hash != "" && localInfo.Hash != remoteInfo.Hash {
+		if cache.HashesComparable(localInfo.Hash, remoteInfo.Hash) && localInfo.Hash != remoteInfo.Hash {
 			continue
 		}
 
 		// Files are in sync - check if already in cache
-		cachedInfo, _ := e.cache.GetCachedState(jobID, path)
-		if cachedInfo != nil {
+		if _, cached := cachedFiles[path]; cached {
 			// Already in cache, skip
 			continue
 		}
 
 		// Add to cache
-		updates[path] = &cache.FileInfo{
+		batch.Update(path, path, &cache.FileInfo{
 			Path:  path,
 			Size:  localInfo.Size,
 			MTime: localInfo.MTime,
 			Hash:  localInfo.Hash,
-		}
-		remotePaths[path] = path
+
+			RemoteMTime: remoteInfo.MTime,
+		})
+		added++
 	}
 
-	if len(updates) > 0 {
+	if added > 0 {
 		e.logger.Info("initializing cache for in-sync files",
-			zap.Int("count", len(updates)))
-		return e.cache.UpdateCacheBatch(jobID, updates, remotePaths)
+			zap.Int("count", added))
 	}
-
-	return nil
 }
@@ -6,6 +6,7 @@ import (
 	"os"
 
 	"github.com/juste-un-gars/anemone_sync_windows/internal/cache"
+	"github.com/juste-un-gars/anemone_sync_windows/internal/scanner"
 	"github.com/juste-un-gars/anemone_sync_windows/internal/smb"
 	"go.uber.org/zap"
 )
@@ -16,6 +17,16 @@ type Executor struct {
 	bufferSizeMB int
 	retryPolicy  *RetryPolicy
 	numWorkers   int // Number of workers for parallel execution (0 = sequential)
+
+	// Delta upload (nil deltaCache = always upload whole files)
+	deltaCache   *cache.CacheManager
+	hasher       *scanner.Hasher
+	deltaMinSize int64  // Files smaller than this are uploaded whole
+	jobID        int64  // Job of the decisions being executed (see forJob)
+	localBase    string // Local root of the job, for cache paths
+
+	// Called before a remote file changes (see SyncRequest.RemoteChangeCallback)
+	beforeRemoteChange func(remotePath string)
 }
 
 // NewExecutor creates a new executor
@@ -51,6 +62,39 @@ func (ex *Executor) SetParallelMode(numWorkers int) {
 	ex.logger.Info("parallel mode configured", zap.Int("workers", numWorkers))
 }
 
+// SetDeltaUpload enables delta uploads for files of at least minSizeMB:
+// their content-defined chunk signatures are kept in the cache, and a
+// re-upload only writes the chunks that changed.
+// The remote file is rewritten in place, not atomically: other clients can
+// see it half-written, and a crash partway leaves it torn. Set minSizeMB to
+// 0 (the default) to always upload whole files.
+func (ex *Executor) SetDeltaUpload(cm *cache.CacheManager, minSizeMB int) {
+	if cm == nil || minSizeMB <= 0 {
+		ex.deltaCache = nil
+		return
+	}
+	ex.deltaCache = cm
+	ex.hasher = scanner.NewHasher("sha256", ex.bufferSizeMB, ex.logger)
+	ex.deltaMinSize = int64(minSizeMB) * 1024 * 1024
+}
+
+// forJob returns a copy of the executor bound to a job, so delta uploads
+// can find the cached chunk signatures of its files.
+func (ex *Executor) forJob(jobID int64, localBase string) *Executor {
+	bound := *ex
+	bound.jobID = jobID
+	bound.localBase = localBase
+	return &bound
+}
+
+// remoteChanging reports that a remote file is about to be written or deleted,
+// so cached handles of it are closed first.
+func (ex *Executor) remoteChanging(remotePath string) {
+	if ex.beforeRemoteChange != nil {
+		ex.beforeRemoteChange(remotePath)
+	}
+}
+
 // Execute executes a batch of sync decisions
 // Uses parallel execution if numWorkers > 0, otherwise sequential
 func (ex *Executor) Execute(
@@ -214,6 +258,20 @@ func (ex *Executor) executeUpload(
 	}
 
 	action.Size = info.Size()
+	ex.remoteChanging(decision.RemotePath)
+
+	// Large files already uploaded once only send their changed chunks
+	delta := ex.deltaEnabled(action.Size)
+	if delta {
+		done, err := ex.executeDeltaUpload(ctx, decision, smbClient, action)
+		if err != nil {
+			return WrapSyncError(err, decision.LocalPath, "delta_upload")
+		}
+		if done {
+			ex.recordRemoteMTime(decision, smbClient, action)
+			return nil
+		}
+	}
 
 	// Upload file
 	ex.logger.Debug("uploading file",
@@ -227,6 +285,11 @@ func (ex *Executor) executeUpload(
 	}
 
 	action.BytesTransferred = action.Size
+	ex.recordRemoteMTime(decision, smbClient, action)
+
+	if delta {
+		ex.storeChunkSignature(decision, smbClient)
+	}
 
 	ex.logger.Info("file uploaded",
 		zap.String("path", decision.LocalPath),
@@ -237,6 +300,18 @@ func (ex *Executor) executeUpload(
 	return nil
 }
 
+// recordRemoteMTime stats the remote file after an upload: the server sets its
+// mtime to the upload time, which the next sync compares against the cache.
+// Unknown if the stat fails, the cache then falls back to the local mtime.
+func (ex *Executor) recordRemoteMTime(decision *cache.SyncDecision, smbClient *smb.SMBClient, action *SyncAction) {
+	remote, err := smbClient.GetMetadata(decision.RemotePath)
+	if err != nil {
+		ex.logger.Debug("failed to stat uploaded file", zap.String("remote", decision.RemotePath), zap.Error(err))
+		return
+	}
+	action.RemoteMTime = remote.ModTime
+}
+
 // executeDownload downloads a file from remote to local
 func (ex *Executor) executeDownload(
 	ctx context.Context,
@@ -268,6 +343,9 @@ func (ex *Executor) executeDownload(
 	}
 
 	action.BytesTransferred = action.Size
+	if decision.RemoteInfo != nil {
+		action.RemoteMTime = decision.RemoteInfo.MTime
+	}
 
 	ex.logger.Info("file downloaded",
 		zap.String("path", decision.LocalPath),
@@ -330,6 +408,7 @@ func (ex *Executor) executeDeleteRemote(
 	}
 
 	// Delete file
+	ex.remoteChanging(decision.RemotePath)
 	if err := smbClient.Delete(decision.RemotePath); err != nil {
 		// Check if file not found (acceptable race condition)
 		if isFileNotFoundError(err) {
@@ -0,0 +1,181 @@
+package sync
+
+import (
+	"context"
+	"fmt"
+	"time"
+
+	"github.com/juste-un-gars/anemone_sync_windows/internal/cache"
+	"github.com/juste-un-gars/anemone_sync_windows/internal/scanner"
+	"github.com/juste-un-gars/anemone_sync_windows/internal/smb"
+	"go.uber.org/zap"
+)
+
+// deltaEnabled checks if a file of this size is uploaded through chunk signatures
+func (ex *Executor) deltaEnabled(size int64) bool {
+	return ex.deltaCache != nil && ex.localBase != "" && size >= ex.deltaMinSize
+}
+
+// deltaRemote is the part of the SMB client used by delta uploads
+type deltaRemote interface {
+	GetMetadata(remotePath string) (*smb.RemoteFileInfo, error)
+	OpenFileForUpdate(remotePath string) (smb.UpdatableFile, error)
+}
+
+// executeDeltaUpload re-uploads a file by writing only the chunks that differ
+// from its last upload, at their offsets in the remote file.
+// Returns false (and no error) when a full upload is needed instead: no
+// signature yet, the remote file changed since the last upload, or the
+// rewrite failed after the first write.
+//
+// The remote file is rewritten in place, so a failure halfway leaves it
+// torn. The caller then uploads the whole file atomically within the same
+// action, before the next sync could take the torn file for a remote edit.
+func (ex *Executor) executeDeltaUpload(
+	ctx context.Context,
+	decision *cache.SyncDecision,
+	smbClient deltaRemote,
+	action *SyncAction,
+) (bool, error) {
+
+	relPath := toRelativePath(decision.LocalPath, ex.localBase)
+	sig, err := ex.deltaCache.GetChunkSignature(ex.jobID, relPath)
+	if err != nil || sig == nil {
+		return false, nil
+	}
+
+	// The signature describes the remote content only if nobody wrote it since
+	remote, err := smbClient.GetMetadata(decision.RemotePath)
+	if err != nil ||
+		remote.Size != sig.RemoteSize ||
+		!remote.ModTime.Truncate(time.Second).Equal(sig.RemoteMTime.Truncate(time.Second)) {
+		ex.logger.Debug("remote file changed since last upload, uploading whole file",
+			zap.String("remote", decision.RemotePath))
+		return false, nil
+	}
+
+	previous, err := scanner.DecodeChunks(sig.Chunks)
+	if err != nil {
+		ex.logger.Warn("invalid chunk signature, uploading whole file",
+			zap.String("path", relPath), zap.Error(err))
+		return false, nil
+	}
+	unchanged := make(map[int64]scanner.Chunk, len(previous))
+	for _, c := range previous {
+		unchanged[c.Offset] = c
+	}
+
+	if err := ex.deltaCache.RemoveChunkSignature(ex.jobID, relPath); err != nil {
+		return false, nil
+	}
+
+	ex.logger.Debug("uploading changed chunks",
+		zap.String("local", decision.LocalPath),
+		zap.String("remote", decision.RemotePath),
+		zap.Int64("size", action.Size),
+	)
+
+	remoteFile, err := smbClient.OpenFileForUpdate(decision.RemotePath)
+	if err != nil {
+		return false, nil
+	}
+
+	var sent int64
+	var changed int
+	written := false // The remote file may differ from its last upload
+	chunks, err := ex.hasher.ChunkFile(decision.LocalPath, func(c scanner.Chunk, data []byte) error {
+		if err := ctx.Err(); err != nil {
+			return err
+		}
+		if old, ok := unchanged[c.Offset]; ok && old.Size == c.Size && old.Sum == c.Sum {
+			return nil
+		}
+		written = true
+		if _, err := remoteFile.WriteAt(data, c.Offset); err != nil {
+			return fmt.Errorf("write chunk at %d: %w", c.Offset, err)
+		}
+		sent += int64(c.Size)
+		changed++
+		return nil
+	})
+
+	var size int64
+	for _, c := range chunks {
+		size += int64(c.Size)
+	}
+	if err == nil {
+		written = true
+		if truncErr := remoteFile.Truncate(size); truncErr != nil {
+			err = fmt.Errorf("truncate remote file: %w", truncErr)
+		}
+	}
+	if closeErr := remoteFile.Close(); err == nil && closeErr != nil {
+		err = fmt.Errorf("close remote file: %w", closeErr)
+	}
+
+	if err != nil {
+		if !written {
+			return true, err // Remote file untouched, the retry can try again
+		}
+		ex.logger.Warn("delta upload failed, uploading whole file",
+			zap.String("path", decision.LocalPath),
+			zap.Error(err))
+		return false, nil
+	}
+
+	action.Size = size
+	action.BytesTransferred = sent
+	ex.recordChunkSignature(decision, smbClient, relPath, size, chunks)
+
+	ex.logger.Info("file uploaded (delta)",
+		zap.String("path", decision.LocalPath),
+		zap.Int64("size", size),
+		zap.Int64("bytes_sent", sent),
+		zap.Int("chunks_sent", changed),
+		zap.Int("chunks_total", len(chunks)),
+	)
+
+	return true, nil
+}
+
+// storeChunkSignature chunks a file after a full upload, so the next upload
+// can be a delta. Failures only cost a full upload next time.
+func (ex *Executor) storeChunkSignature(decision *cache.SyncDecision, smbClient deltaRemote) {
+	chunks, err := ex.hasher.ChunkFile(decision.LocalPath, nil)
+	if err != nil {
+		ex.logger.Debug("failed to chunk uploaded file", zap.String("path", decision.LocalPath), zap.Error(err))
+		return
+	}
+
+	var size int64
+	for _, c := range chunks {
+		size += int64(c.Size)
+	}
+	relPath := toRelativePath(decision.LocalPath, ex.localBase)
+	ex.recordChunkSignature(decision, smbClient, relPath, size, chunks)
+}
+
+// recordChunkSignature stores the chunks of a file with the remote state
+// right after its upload
+func (ex *Executor) recordChunkSignature(
+	decision *cache.SyncDecision,
+	smbClient deltaRemote,
+	relPath string,
+	size int64,
+	chunks []scanner.Chunk,
+) {
+	remote, err := smbClient.GetMetadata(decision.RemotePath)
+	if err != nil || remote.Size != size {
+		return
+	}
+
+	err = ex.deltaCache.UpdateChunkSignature(ex.jobID, relPath, &cache.ChunkSignature{
+		Size:        size,
+		RemoteSize:  remote.Size,
+		RemoteMTime: remote.ModTime,
+		Chunks:      scanner.EncodeChunks(chunks),
+	})
+	if err != nil {
+		ex.logger.Warn("failed to store chunk signature", zap.String("path", relPath), zap.Error(err))
+	}
+}
@@ -0,0 +1,173 @@
+package sync
+
+import (
+	"bytes"
+	"context"
+	"errors"
+	"math/rand"
+	"os"
+	"path/filepath"
+	"testing"
+	"time"
+
+	"github.com/juste-un-gars/anemone_sync_windows/internal/cache"
+	"github.com/juste-un-gars/anemone_sync_windows/internal/database"
+	"github.com/juste-un-gars/anemone_sync_windows/internal/smb"
+	"go.uber.org/zap"
+)
+
+// fakeDeltaRemote is an in-memory remote file opened for update
+type fakeDeltaRemote struct {
+	data  []byte
+	mtime time.Time
+
+	failWrite    bool // WriteAt writes half the chunk, then fails
+	failTruncate bool
+	closed       int
+}
+
+func (f *fakeDeltaRemote) GetMetadata(remotePath string) (*smb.RemoteFileInfo, error) {
+	return &smb.RemoteFileInfo{Path: remotePath, Size: int64(len(f.data)), ModTime: f.mtime}, nil
+}
+
+func (f *fakeDeltaRemote) OpenFileForUpdate(remotePath string) (smb.UpdatableFile, error) {
+	return f, nil
+}
+
+func (f *fakeDeltaRemote) WriteAt(b []byte, off int64) (int, error) {
+	if f.failWrite {
+		b = b[:len(b)/2]
+	}
+	if end := off + int64(len(b)); end > int64(len(f.data)) {
+		f.data = append(f.data, make([]byte, end-int64(len(f.data)))...)
+	}
+	copy(f.data[off:], b)
+	f.mtime = f.mtime.Add(time.Minute)
+	if f.failWrite {
+		return len(b), errors.New("connection reset")
+	}
+	return len(b), nil
+}
+
+func (f *fakeDeltaRemote) Truncate(size int64) error {
+	if f.failTruncate {
+		return errors.New("access denied")
+	}
+	f.data = f.data[:size]
+	return nil
+}
+
+func (f *fakeDeltaRemote) Close() error {
+	f.closed++
+	return nil
+}
+
+// setupDeltaUpload uploads a file once (signature stored) and edits it
+// locally, returning the executor, the decision and the remote file
+func setupDeltaUpload(t *testing.T) (*Executor, *cache.SyncDecision, *fakeDeltaRemote, []byte) {
+	t.Helper()
+	tempDir := t.TempDir()
+
+	db, err := database.Open(database.Config{
+		Path:             filepath.Join(tempDir, "test.db"),
+		EncryptionKey:    "test-key-32-chars-long-123456",
+		CreateIfNotExist: true,
+	})
+	if err != nil {
+		t.Fatalf("failed to create database: %v", err)
+	}
+	t.Cleanup(func() { db.Close() })
+
+	localBase := filepath.Join(tempDir, "local")
+	if err := os.MkdirAll(localBase, 0755); err != nil {
+		t.Fatal(err)
+	}
+	localPath := filepath.Join(localBase, "big.bin")
+	original := make([]byte, 4*1024*1024)
+	rand.New(rand.NewSource(1)).Read(original)
+	if err := os.WriteFile(localPath, original, 0644); err != nil {
+		t.Fatal(err)
+	}
+
+	ex := NewExecutor(4, zap.NewNop())
+	ex.SetDeltaUpload(cache.NewCacheManager(db, zap.NewNop()), 1)
+	ex = ex.forJob(1, localBase)
+
+	decision := &cache.SyncDecision{LocalPath: localPath, RemotePath: "big.bin", Action: cache.ActionUpload}
+	remote := &fakeDeltaRemote{data: append([]byte{}, original...), mtime: time.Now().Truncate(time.Second)}
+	ex.storeChunkSignature(decision, remote)
+
+	// Edit a few bytes in the middle, in place
+	edited := append([]byte{}, original...)
+	copy(edited[2*1024*1024:], "edited in place")
+	if err := os.WriteFile(localPath, edited, 0644); err != nil {
+		t.Fatal(err)
+	}
+	return ex, decision, remote, edited
+}
+
+func TestExecuteDeltaUpload(t *testing.T) {
+	ex, decision, remote, edited := setupDeltaUpload(t)
+
+	action := &SyncAction{Size: int64(len(edited))}
+	done, err := ex.executeDeltaUpload(context.Background(), decision, remote, action)
+	if !done || err != nil {
+		t.Fatalf("expected a delta upload, got done=%v err=%v", done, err)
+	}
+	if !bytes.Equal(remote.data, edited) {
+		t.Error("remote file does not match the local file")
+	}
+	if action.BytesTransferred == 0 || action.BytesTransferred >= int64(len(edited)) {
+		t.Errorf("expected only the changed chunks to be sent, sent %d of %d", action.BytesTransferred, len(edited))
+	}
+	if remote.closed != 1 {
+		t.Errorf("expected the remote file to be closed once, got %d", remote.closed)
+	}
+
+	// The new signature allows the next delta
+	if sig, _ := ex.deltaCache.GetChunkSignature(ex.jobID, "big.bin"); sig == nil {
+		t.Error("expected a new chunk signature")
+	}
+}
+
+func TestExecuteDeltaUpload_WriteFailureFallsBack(t *testing.T) {
+	ex, decision, remote, edited := setupDeltaUpload(t)
+	remote.failWrite = true
+
+	done, err := ex.executeDeltaUpload(context.Background(), decision, remote, &SyncAction{Size: int64(len(edited))})
+	if done || err != nil {
+		t.Fatalf("expected a torn remote file to need a full upload, got done=%v err=%v", done, err)
+	}
+	if remote.closed != 1 {
+		t.Errorf("expected the remote file to be closed before the full upload, got %d", remote.closed)
+	}
+	if sig, _ := ex.deltaCache.GetChunkSignature(ex.jobID, "big.bin"); sig != nil {
+		t.Error("expected the signature of the torn file to be gone")
+	}
+}
+
+func TestExecuteDeltaUpload_TruncateFailureFallsBack(t *testing.T) {
+	ex, decision, remote, edited := setupDeltaUpload(t)
+	remote.failTruncate = true
+
+	done, err := ex.executeDeltaUpload(context.Background(), decision, remote, &SyncAction{Size: int64(len(edited))})
+	if done || err != nil {
+		t.Fatalf("expected a failed truncate to need a full upload, got done=%v err=%v", done, err)
+	}
+	if remote.closed != 1 {
+		t.Errorf("expected the remote file to be closed before the full upload, got %d", remote.closed)
+	}
+}
+
+func TestExecuteDeltaUpload_RemoteChanged(t *testing.T) {
+	ex, decision, remote, edited := setupDeltaUpload(t)
+	remote.mtime = remote.mtime.Add(time.Hour) // Written by someone else
+
+	done, err := ex.executeDeltaUpload(context.Background(), decision, remote, &SyncAction{Size: int64(len(edited))})
+	if done || err != nil {
+		t.Fatalf("expected a full upload, got done=%v err=%v", done, err)
+	}
+	if remote.closed != 0 {
+		t.Error("expected the remote file not to be opened")
+	}
+}
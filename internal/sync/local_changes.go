@@ -0,0 +1,179 @@
+package sync
+
+import (
+	"context"
+	"fmt"
+	"strings"
+
+	"github.com/juste-un-gars/anemone_sync_windows/internal/cache"
+	"github.com/juste-un-gars/anemone_sync_windows/internal/smb"
+	"go.uber.org/zap"
+)
+
+// LocalChange is a delete or rename made in the local folder of a job.
+// Paths are relative to the local folder, with forward slashes.
+type LocalChange struct {
+	Path        string
+	NewPath     string // Rename target ("" = deleted, or moved out of the folder)
+	IsDirectory bool
+}
+
+// ApplyLocalChanges propagates local deletes and renames to the remote as
+// Windows reports them, with one recursive remote call per entry: deleting
+// or moving a folder is a single RemoveAll or Rename instead of one action
+// per file at the next sync.
+//
+// An entry is only applied when the next sync would do the same: a delete
+// when every remote file under it is unchanged since the last sync, a rename
+// when the target does not exist remotely. Other entries are left to the
+// next sync, which handles them file by file (conflicts, new remote files).
+// Cache rows are kept, as for the deletes of a sync.
+//
+// Returns the number of entries applied; ErrSyncInProgress if a sync of the
+// job is running (it picks the changes up itself).
+func (e *Engine) ApplyLocalChanges(ctx context.Context, req *SyncRequest, smbClient *smb.SMBClient, changes []LocalChange) (int, error) {
+	if !req.Mode.AllowsUpload() {
+		return 0, nil // Local changes never reach the remote in this mode
+	}
+
+	e.mu.RLock()
+	closed := e.closed
+	_, syncing := e.syncing[req.JobID]
+	e.mu.RUnlock()
+	if closed {
+		return 0, ErrEngineClosed
+	}
+	if syncing {
+		return 0, ErrSyncInProgress
+	}
+
+	cachedFiles, err := e.cache.GetAllCachedFiles(req.JobID)
+	if err != nil {
+		return 0, err
+	}
+	_, _, remoteBase := parseUNCPath(req.RemotePath)
+
+	applied := 0
+	for _, change := range changes {
+		if err := ctx.Err(); err != nil {
+			return applied, err
+		}
+
+		var ok bool
+		if change.NewPath == "" {
+			ok, err = e.applyLocalDelete(ctx, req, smbClient, remoteBase, cachedFiles, change)
+		} else {
+			ok, err = e.applyLocalRename(req, smbClient, remoteBase, change)
+		}
+		if err != nil {
+			e.logger.Warn("local change left to the next sync",
+				zap.String("path", change.Path),
+				zap.Error(err),
+			)
+			continue
+		}
+		if ok {
+			applied++
+		}
+	}
+
+	e.logger.Info("local changes applied to remote",
+		zap.Int64("job_id", req.JobID),
+		zap.Int("applied", applied),
+		zap.Int("total", len(changes)),
+	)
+	return applied, nil
+}
+
+// applyLocalDelete removes the remote copy of a deleted file or folder, if
+// the remote files under it are the ones of the last sync.
+func (e *Engine) applyLocalDelete(ctx context.Context, req *SyncRequest, smbClient *smb.SMBClient,
+	remoteBase string, cachedFiles map[string]*cache.FileInfo, change LocalChange) (bool, error) {
+
+	remotePath := joinRemotePath(remoteBase, change.Path)
+
+	// Remote files and cached state under the deleted path, by job-relative path
+	remoteFiles := make(map[string]*cache.FileInfo)
+	if change.IsDirectory {
+		scanner := NewRemoteScanner(smbClient, e.logger.Named("remote_scanner"), nil)
+		result, err := scanner.Scan(ctx, remotePath)
+		if err != nil {
+			if isFileNotFoundError(err) {
+				return false, nil // Nothing left to delete
+			}
+			return false, err
+		}
+		if len(result.Errors) > 0 {
+			return false, fmt.Errorf("remote folder only partially listed: %w", result.Errors[0])
+		}
+		for rel, info := range result.Files {
+			info.Path = change.Path + "/" + rel
+			remoteFiles[info.Path] = info
+		}
+	} else {
+		meta, err := smbClient.GetMetadata(remotePath)
+		if err != nil {
+			if isFileNotFoundError(err) {
+				return false, nil
+			}
+			return false, err
+		}
+		remoteFiles[change.Path] = &cache.FileInfo{Path: change.Path, Size: meta.Size, MTime: meta.ModTime}
+	}
+
+	cached := make(map[string]*cache.FileInfo)
+	for path, info := range cachedFiles {
+		if path == change.Path || strings.HasPrefix(path, change.Path+"/") {
+			cached[path] = info
+		}
+	}
+
+	// Same 3-way rules as a sync: every remote file must be a plain delete
+	for _, decision := range e.detector.DetermineSyncActionsFromCache(nil, remoteFiles, cached) {
+		if decision.Action != cache.ActionDeleteRemote {
+			return false, fmt.Errorf("%s: %s", decision.LocalPath, decision.Reason)
+		}
+	}
+
+	if req.RemoteChangeCallback != nil {
+		for path := range remoteFiles {
+			req.RemoteChangeCallback(joinRemotePath(remoteBase, path))
+		}
+	}
+	if err := smbClient.RemoveAll(remotePath); err != nil {
+		return false, err
+	}
+	return true, nil
+}
+
+// applyLocalRename renames the remote copy of a renamed file or folder,
+// unless the target already exists remotely.
+func (e *Engine) applyLocalRename(req *SyncRequest, smbClient *smb.SMBClient, remoteBase string, change LocalChange) (bool, error) {
+	source := joinRemotePath(remoteBase, change.Path)
+	target := joinRemotePath(remoteBase, change.NewPath)
+
+	if _, err := smbClient.GetMetadata(target); err == nil {
+		return false, fmt.Errorf("%s already exists remotely", change.NewPath)
+	} else if !isFileNotFoundError(err) {
+		return false, err
+	}
+
+	if req.RemoteChangeCallback != nil {
+		req.RemoteChangeCallback(source)
+	}
+	if err := smbClient.Rename(source, target); err != nil {
+		if isFileNotFoundError(err) {
+			return false, nil // Not synced yet: the next sync uploads it
+		}
+		return false, err
+	}
+	return true, nil
+}
+
+// joinRemotePath returns the path within the share of a job-relative path
+func joinRemotePath(remoteBase, relPath string) string {
+	if remoteBase == "" {
+		return relPath
+	}
+	return remoteBase + "/" + relPath
+}
@@ -41,11 +41,20 @@ type RemoteScanResult struct {
 	PartialSuccess  bool // True if scan completed with some errors
 }
 
-// RemoteScanner scans remote SMB shares recursively
+// RemoteFileFunc receives each remote file as it is listed. Calls are
+// serialized; an error stops the scan.
+type RemoteFileFunc func(file *cache.FileInfo) error
+
+// RemoteScanner scans remote SMB shares recursively, listing several
+// directories concurrently (see smb.WalkDirs)
 type RemoteScanner struct {
 	client   SMBClientInterface
 	logger   *zap.Logger
 	callback RemoteScanCallback
+	workers  int // Directories listed concurrently (0 = smb.DefaultWalkWorkers)
+
+	// Serializes the handling of listed entries: file callbacks, progress
+	emitMu sync.Mutex
 
 	// Stats (protected by mutex)
 	mu              sync.RWMutex
@@ -69,8 +78,31 @@ func NewRemoteScanner(client SMBClientInterface, logger *zap.Logger, callback Re
 	}
 }
 
+// SetWorkers sets the number of directories listed concurrently
+// (0 = smb.DefaultWalkWorkers). The client must allow concurrent listings.
+func (rs *RemoteScanner) SetWorkers(workers int) {
+	rs.workers = workers
+}
+
 // Scan scans a remote path recursively and returns all files found
 func (rs *RemoteScanner) Scan(ctx context.Context, basePath string) (*RemoteScanResult, error) {
+	files := make(map[string]*cache.FileInfo)
+	result, err := rs.ScanStream(ctx, basePath, func(file *cache.FileInfo) error {
+		files[file.Path] = file
+		return nil
+	})
+	if err != nil {
+		return nil, err
+	}
+
+	result.Files = files
+	return result, nil
+}
+
+// ScanStream scans a remote path recursively, passing each file to fn as
+// soon as its directory is listed instead of collecting them. The returned
+// result has no Files.
+func (rs *RemoteScanner) ScanStream(ctx context.Context, basePath string, fn RemoteFileFunc) (*RemoteScanResult, error) {
 	startTime := time.Now()
 
 	rs.logger.Info("starting remote scan", zap.String("base_path", basePath))
@@ -88,13 +120,12 @@ func (rs *RemoteScanner) Scan(ctx context.Context, basePath string) (*RemoteScan
 	basePath = strings.TrimSuffix(basePath, "\\")
 
 	// Scan recursively
-	files := make(map[string]*cache.FileInfo)
-	if err := rs.scanDir(ctx, basePath, basePath, files); err != nil {
+	if err := smb.WalkDirs(ctx, basePath, rs.workers, rs.listDir(basePath, fn)); err != nil {
 		// Check if it's a partial failure
-		if len(files) > 0 {
+		if found := rs.GetStats().FilesFound; found > 0 {
 			rs.logger.Warn("remote scan completed with errors",
 				zap.Error(err),
-				zap.Int("files_found", len(files)),
+				zap.Int("files_found", found),
 			)
 		} else {
 			return nil, fmt.Errorf("remote scan failed: %w", err)
@@ -105,13 +136,12 @@ func (rs *RemoteScanner) Scan(ctx context.Context, basePath string) (*RemoteScan
 
 	rs.mu.RLock()
 	result := &RemoteScanResult{
-		Files:          files,
 		TotalFiles:     rs.filesFound,
 		TotalDirs:      rs.dirsScanned,
 		TotalBytes:     rs.bytesDiscovered,
 		Duration:       duration,
 		Errors:         rs.errors,
-		PartialSuccess: len(rs.errors) > 0 && len(files) > 0,
+		PartialSuccess: len(rs.errors) > 0 && rs.filesFound > 0,
 	}
 	rs.mu.RUnlock()
 
@@ -127,52 +157,58 @@ func (rs *RemoteScanner) Scan(ctx context.Context, basePath string) (*RemoteScan
 	return result, nil
 }
 
-// scanDir scans a single directory recursively
-func (rs *RemoteScanner) scanDir(ctx context.Context, currentPath string, basePath string, files map[string]*cache.FileInfo) error {
-	// Check context cancellation
-	select {
-	case <-ctx.Done():
-		return ctx.Err()
-	default:
-	}
-
-	// List directory contents
-	entries, err := rs.client.ListRemote(currentPath)
-	if err != nil {
-		rs.addError(fmt.Errorf("failed to list directory %s: %w", currentPath, err))
-		return err
-	}
+// listDir returns the smb.WalkDirs listing function of a scan: it lists a
+// directory, passes its files to fn and returns its subdirectories.
+// A subdirectory that cannot be listed is skipped; the base path cannot.
+func (rs *RemoteScanner) listDir(basePath string, fn RemoteFileFunc) smb.ListDirFunc {
+	basePathNorm := filepath.ToSlash(basePath)
+
+	return func(ctx context.Context, currentPath string) ([]string, error) {
+		// List directory contents (concurrently with other workers)
+		entries, err := rs.client.ListRemote(currentPath)
+		if err != nil {
+			rs.addError(fmt.Errorf("failed to list directory %s: %w", currentPath, err))
+			if currentPath == basePath {
+				return nil, err
+			}
+			// Continue scanning other directories even if one fails
+			rs.logger.Warn("failed to scan subdirectory",
+				zap.String("path", currentPath),
+				zap.Error(err),
+			)
+			return nil, nil
+		}
 
-	// Update stats
-	rs.mu.Lock()
-	rs.dirsScanned++
-	dirsScanned := rs.dirsScanned
-	rs.mu.Unlock()
+		rs.emitMu.Lock()
+		defer rs.emitMu.Unlock()
 
-	// Report progress
-	if rs.callback != nil && dirsScanned%10 == 0 {
-		rs.reportProgress(currentPath)
-	}
+		// Update stats
+		rs.mu.Lock()
+		rs.dirsScanned++
+		dirsScanned := rs.dirsScanned
+		rs.mu.Unlock()
 
-	// Process entries
-	for _, entry := range entries {
-		// Check context cancellation
-		select {
-		case <-ctx.Done():
-			return ctx.Err()
-		default:
+		// Report progress
+		if rs.callback != nil && dirsScanned%10 == 0 {
+			rs.reportProgress(currentPath)
 		}
 
-		if entry.IsDir {
-			// Recurse into subdirectory
-			if err := rs.scanDir(ctx, entry.Path, basePath, files); err != nil {
-				// Continue scanning other directories even if one fails
-				rs.logger.Warn("failed to scan subdirectory",
-					zap.String("path", entry.Path),
-					zap.Error(err),
-				)
+		// Process entries
+		var subdirs []string
+		for _, entry := range entries {
+			// Check context cancellation
+			select {
+			case <-ctx.Done():
+				return nil, ctx.Err()
+			default:
 			}
-		} else {
+
+			if entry.IsDir {
+				// Listed later, possibly by another worker
+				subdirs = append(subdirs, entry.Path)
+				continue
+			}
+
 			// Skip temporary upload files (from interrupted uploads)
 			if strings.HasSuffix(entry.Name, smb.UploadTempSuffix) {
 				rs.logger.Debug("skipping temp upload file",
@@ -183,7 +219,6 @@ func (rs *RemoteScanner) scanDir(ctx context.Context, currentPath string, basePa
 			// Add file to result
 			// Normalize slashes before comparing (entry.Path may use \ on Windows)
 			entryPath := filepath.ToSlash(entry.Path)
-			basePathNorm := filepath.ToSlash(basePath)
 			relativePath := strings.TrimPrefix(entryPath, basePathNorm)
 			relativePath = strings.TrimPrefix(relativePath, "/")
 
@@ -191,11 +226,14 @@ func (rs *RemoteScanner) scanDir(ctx context.Context, currentPath string, basePa
 				relativePath = filepath.Base(entry.Path)
 			}
 
-			files[relativePath] = &cache.FileInfo{
+			err := fn(&cache.FileInfo{
 				Path:  relativePath,
 				Size:  entry.Size,
 				MTime: entry.ModTime,
 				Hash:  "", // Hash not available from remote listing
+			})
+			if err != nil {
+				return nil, err
 			}
 
 			// Update stats
@@ -215,9 +253,9 @@ func (rs *RemoteScanner) scanDir(ctx context.Context, currentPath string, basePa
 				zap.Int64("size", entry.Size),
 			)
 		}
-	}
 
-	return nil
+		return subdirs, nil
+	}
 }
 
 // addError adds an error to the error list (thread-safe)
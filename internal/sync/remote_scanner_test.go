@@ -4,9 +4,11 @@ import (
 	"context"
 	"errors"
 	"fmt"
+	"sync"
 	"testing"
 	"time"
 
+	"github.com/juste-un-gars/anemone_sync_windows/internal/cache"
 	"github.com/juste-un-gars/anemone_sync_windows/internal/smb"
 	"go.uber.org/zap"
 )
@@ -16,6 +18,8 @@ type mockSMBClient struct {
 	files        map[string][]smb.RemoteFileInfo // Maps directory path to its contents
 	listErrors   map[string]error                 // Maps directory path to error to return
 	listCallCount int
+
+	mu sync.Mutex // ListRemote is called concurrently by the scanner
 }
 
 func newMockSMBClient() *mockSMBClient {
@@ -59,6 +63,8 @@ func (m *mockSMBClient) setListError(dir string, err error) {
 }
 
 func (m *mockSMBClient) ListRemote(path string) ([]smb.RemoteFileInfo, error) {
+	m.mu.Lock()
+	defer m.mu.Unlock()
 	m.listCallCount++
 
 	// Check for error
@@ -363,3 +369,51 @@ func TestRemoteScannerResultDuration(t *testing.T) {
 
 	t.Logf("scan duration: %v", result.Duration)
 }
+
+func TestRemoteScannerStreamConcurrent(t *testing.T) {
+	mock := newMockSMBClient()
+
+	// 3 levels of 5 subdirectories, 2 files in each directory
+	var build func(dir string, level int)
+	build = func(dir string, level int) {
+		mock.addFile(dir, "a.txt", 10)
+		mock.addFile(dir, "b.txt", 20)
+		if level == 3 {
+			return
+		}
+		for i := 0; i < 5; i++ {
+			mock.addDir(dir, fmt.Sprintf("d%d", i))
+			build(fmt.Sprintf("%s/d%d", dir, i), level+1)
+		}
+	}
+	build("/share", 0)
+	allDirs := 1 + 5 + 25 + 125
+
+	scanner := NewRemoteScanner(mock, zap.NewNop(), nil)
+	scanner.SetWorkers(4)
+
+	seen := make(map[string]bool)
+	result, err := scanner.ScanStream(context.Background(), "/share", func(file *cache.FileInfo) error {
+		if seen[file.Path] {
+			t.Errorf("file %s streamed twice", file.Path)
+		}
+		seen[file.Path] = true
+		return nil
+	})
+	if err != nil {
+		t.Fatalf("scan failed: %v", err)
+	}
+
+	if result.TotalDirs != allDirs {
+		t.Errorf("expected %d dirs scanned, got %d", allDirs, result.TotalDirs)
+	}
+	if len(seen) != 2*allDirs || result.TotalFiles != 2*allDirs {
+		t.Errorf("expected %d files, got %d streamed (%d counted)", 2*allDirs, len(seen), result.TotalFiles)
+	}
+	if !seen["d1/d2/d3/b.txt"] {
+		t.Error("d1/d2/d3/b.txt not streamed")
+	}
+	if result.Files != nil {
+		t.Error("expected no collected files from a streamed scan")
+	}
+}
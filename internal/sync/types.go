@@ -52,6 +52,10 @@ type SyncRequest struct {
 	// PlaceholderCallback is called when placeholders need to be created.
 	// Only used when FilesOnDemand is true.
 	PlaceholderCallback PlaceholderCallback
+
+	// RemoteChangeCallback is called before a remote file is uploaded over
+	// or deleted, with its path within the share (optional).
+	RemoteChangeCallback func(remotePath string)
 }
 
 // PlaceholderCallback is called to create placeholders for remote files.
@@ -137,6 +141,10 @@ type SyncAction struct {
 
 	// Timestamp when action was executed
 	Timestamp time.Time
+
+	// RemoteMTime is the modification time of the remote file after an
+	// upload or download (zero if unknown)
+	RemoteMTime time.Time
 }
 
 // ActionStatus represents the status of a sync action
@@ -3,30 +3,67 @@ package sync
 import (
 	"context"
 	"fmt"
+	"sort"
 	"sync"
 	"sync/atomic"
+	"time"
 
 	"github.com/juste-un-gars/anemone_sync_windows/internal/cache"
 	"github.com/juste-un-gars/anemone_sync_windows/internal/smb"
 	"go.uber.org/zap"
 )
 
-// WorkerPool manages parallel execution of sync actions
+const (
+	// Transfers of at least this size go to the large-file lane
+	largeJobSize = 64 * 1024 * 1024
+
+	// Large transfers running at once. One worker is always left for small
+	// files, so a big file never holds up the rest of the sync.
+	maxLargeJobs = 2
+
+	// A worker takes up to smallBatchJobs queued jobs at once, stopping once
+	// they add up to smallBatchBytes
+	smallBatchJobs  = 16
+	smallBatchBytes = 8 * 1024 * 1024
+
+	// Worker count tuning: throughput is measured every tuneInterval and a
+	// change of less than tuneGain is treated as noise
+	tuneInterval = 2 * time.Second
+	tuneGain     = 0.1
+)
+
+// WorkerPool manages parallel execution of sync actions.
+//
+// Jobs are scheduled by size: large transfers go to a shared lane, largest
+// first, with bounded parallelism; other jobs are spread over per-worker
+// queues and taken in batches. A worker with an empty queue steals half of
+// the longest one. The number of active workers starts at numWorkers and is
+// tuned from the measured throughput, up to twice that.
 type WorkerPool struct {
-	numWorkers int
+	numWorkers int // Active workers at start
+	maxWorkers int // Upper bound for tuning
 	logger     *zap.Logger
 	executor   *Executor
 
 	// Channels
-	jobs    chan *SyncJob
 	results chan *SyncJobResult
+	done    chan struct{} // Closed by Stop, ends the tuner
 
 	// State
-	mu       sync.RWMutex
-	started  bool
-	stopped  bool
-	wg       sync.WaitGroup
-	cancels  []context.CancelFunc
+	mu      sync.RWMutex
+	started bool
+	stopped bool
+	wg      sync.WaitGroup
+	cancels []context.CancelFunc
+
+	// Scheduling (guarded by mu)
+	cond         *sync.Cond
+	queues       [][]*SyncJob // Per-worker jobs, oldest first
+	large        []*SyncJob   // Large-file lane, largest first
+	largeRunning int          // Large jobs being executed
+	queued       int          // Jobs in queues and lane
+	active       int          // Workers allowed to take jobs
+	nextQueue    int          // Round-robin queue for Submit
 
 	// Statistics (atomic)
 	jobsSubmitted  int64
@@ -64,14 +101,20 @@ func NewWorkerPool(numWorkers int, executor *Executor, logger *zap.Logger) *Work
 		panic("executor cannot be nil")
 	}
 
-	return &WorkerPool{
+	maxWorkers := numWorkers * 2
+	wp := &WorkerPool{
 		numWorkers: numWorkers,
+		maxWorkers: maxWorkers,
 		logger:     logger,
 		executor:   executor,
-		jobs:       make(chan *SyncJob, numWorkers*2), // Buffer for smoother flow
-		results:    make(chan *SyncJobResult, numWorkers*2),
+		results:    make(chan *SyncJobResult, maxWorkers*2),
+		done:       make(chan struct{}),
 		cancels:    make([]context.CancelFunc, 0),
+		queues:     make([][]*SyncJob, maxWorkers),
+		active:     numWorkers,
 	}
+	wp.cond = sync.NewCond(&wp.mu)
+	return wp
 }
 
 // Start starts the worker pool
@@ -89,21 +132,31 @@ func (wp *WorkerPool) Start(ctx context.Context) error {
 
 	wp.started = true
 
-	wp.logger.Info("starting worker pool", zap.Int("workers", wp.numWorkers))
+	wp.logger.Info("starting worker pool",
+		zap.Int("workers", wp.numWorkers),
+		zap.Int("max_workers", wp.maxWorkers),
+	)
+
+	poolCtx, cancel := context.WithCancel(ctx)
+	wp.cancels = append(wp.cancels, cancel)
 
-	// Start workers
-	for i := 0; i < wp.numWorkers; i++ {
-		workerCtx, cancel := context.WithCancel(ctx)
-		wp.cancels = append(wp.cancels, cancel)
+	// Wake waiting workers when the context is cancelled
+	stop := context.AfterFunc(poolCtx, wp.wake)
+	wp.cancels = append(wp.cancels, func() { stop() })
 
+	// Start workers; those above the active count wait until tuned in
+	for i := 0; i < wp.maxWorkers; i++ {
 		wp.wg.Add(1)
-		go wp.worker(workerCtx, i)
+		go wp.worker(poolCtx, i)
 	}
 
+	wp.wg.Add(1)
+	go wp.tune(poolCtx)
+
 	return nil
 }
 
-// Stop stops the worker pool and waits for all workers to finish
+// Stop stops the worker pool and waits for all queued jobs to finish
 func (wp *WorkerPool) Stop() {
 	wp.mu.Lock()
 
@@ -112,12 +165,12 @@ func (wp *WorkerPool) Stop() {
 		return
 	}
 
+	// No more jobs: workers exit once the queues are drained
 	wp.stopped = true
-
-	// Close jobs channel to signal no more jobs
-	close(wp.jobs)
+	close(wp.done)
 
 	wp.mu.Unlock()
+	wp.cond.Broadcast()
 
 	// Wait for all workers to finish processing
 	wp.wg.Wait()
@@ -125,7 +178,7 @@ func (wp *WorkerPool) Stop() {
 	// Close results channel (all workers are done, no more results coming)
 	close(wp.results)
 
-	// Cancel all worker contexts (cleanup)
+	// Cancel the pool context (cleanup)
 	for _, cancel := range wp.cancels {
 		cancel()
 	}
@@ -139,31 +192,37 @@ func (wp *WorkerPool) Stop() {
 	)
 }
 
-// Submit submits a job to the worker pool
+// Submit queues a job on the worker pool; it does not block.
 // Returns false if the pool is stopped or the context is cancelled
 func (wp *WorkerPool) Submit(ctx context.Context, job *SyncJob) bool {
 	// Check if context is already cancelled before attempting submission
-	select {
-	case <-ctx.Done():
+	if ctx.Err() != nil {
 		return false
-	default:
 	}
 
-	wp.mu.RLock()
+	wp.mu.Lock()
 	if wp.stopped {
-		wp.mu.RUnlock()
+		wp.mu.Unlock()
 		return false
 	}
-	wp.mu.RUnlock()
-
-	atomic.AddInt64(&wp.jobsSubmitted, 1)
 
-	select {
-	case wp.jobs <- job:
-		return true
-	case <-ctx.Done():
-		return false
+	if size := jobSize(job); size >= largeJobSize {
+		// Keep the lane sorted, largest first
+		i := sort.Search(len(wp.large), func(i int) bool { return jobSize(wp.large[i]) < size })
+		wp.large = append(wp.large, nil)
+		copy(wp.large[i+1:], wp.large[i:])
+		wp.large[i] = job
+	} else {
+		q := wp.nextQueue % wp.active
+		wp.nextQueue++
+		wp.queues[q] = append(wp.queues[q], job)
 	}
+	wp.queued++
+	wp.mu.Unlock()
+
+	atomic.AddInt64(&wp.jobsSubmitted, 1)
+	wp.cond.Broadcast()
+	return true
 }
 
 // Results returns the results channel for collecting job results
@@ -173,13 +232,17 @@ func (wp *WorkerPool) Results() <-chan *SyncJobResult {
 
 // GetStats returns current worker pool statistics
 func (wp *WorkerPool) GetStats() WorkerPoolStats {
+	wp.mu.RLock()
+	active := wp.active
+	wp.mu.RUnlock()
+
 	return WorkerPoolStats{
 		JobsSubmitted:  atomic.LoadInt64(&wp.jobsSubmitted),
 		JobsCompleted:  atomic.LoadInt64(&wp.jobsCompleted),
 		JobsSucceeded:  atomic.LoadInt64(&wp.jobsSucceeded),
 		JobsFailed:     atomic.LoadInt64(&wp.jobsFailed),
 		BytesProcessed: atomic.LoadInt64(&wp.bytesProcessed),
-		NumWorkers:     wp.numWorkers,
+		NumWorkers:     active,
 	}
 }
 
@@ -190,7 +253,7 @@ type WorkerPoolStats struct {
 	JobsSucceeded  int64
 	JobsFailed     int64
 	BytesProcessed int64
-	NumWorkers     int
+	NumWorkers     int // Currently active workers
 }
 
 // worker is the main worker goroutine
@@ -200,27 +263,217 @@ func (wp *WorkerPool) worker(ctx context.Context, workerID int) {
 	wp.logger.Debug("worker started", zap.Int("worker_id", workerID))
 
 	for {
-		select {
-		case <-ctx.Done():
-			wp.logger.Debug("worker cancelled", zap.Int("worker_id", workerID))
+		batch, large := wp.next(ctx, workerID)
+		if batch == nil {
+			wp.logger.Debug("worker finished", zap.Int("worker_id", workerID))
 			return
+		}
+
+		for _, job := range batch {
+			if ctx.Err() != nil {
+				break
+			}
+
+			// Always send the result (don't lose results due to context cancellation)
+			wp.results <- wp.processJob(ctx, workerID, job)
+		}
+
+		if large {
+			wp.mu.Lock()
+			wp.largeRunning--
+			wp.mu.Unlock()
+			wp.cond.Broadcast()
+		}
+	}
+}
+
+// next returns the next jobs for a worker, waiting for some if needed: a
+// large job when the lane has room, otherwise a batch from the worker's queue
+// or stolen from the longest one. It returns nil when the pool is stopped and
+// drained, or the context is cancelled.
+func (wp *WorkerPool) next(ctx context.Context, workerID int) ([]*SyncJob, bool) {
+	wp.mu.Lock()
+	defer wp.mu.Unlock()
+
+	for {
+		if ctx.Err() != nil || (wp.stopped && wp.queued == 0) {
+			wp.cond.Broadcast() // Idle workers may have missed the last job leaving
+			return nil, false
+		}
+
+		if workerID < wp.active {
+			// Large files first, so the biggest transfers don't form the tail
+			if len(wp.large) > 0 && wp.largeRunning < wp.largeLimit() {
+				job := wp.large[0]
+				wp.large = wp.large[1:]
+				wp.largeRunning++
+				wp.queued--
+				return []*SyncJob{job}, true
+			}
+
+			if batch := wp.takeBatch(workerID); len(batch) > 0 {
+				wp.queued -= len(batch)
+				return batch, false
+			}
+		}
 
-		case job, ok := <-wp.jobs:
-			if !ok {
-				// Jobs channel closed, exit
-				wp.logger.Debug("worker finished (jobs closed)", zap.Int("worker_id", workerID))
-				return
+		wp.cond.Wait()
+	}
+}
+
+// takeBatch takes a batch of jobs from the front of a worker's queue,
+// stealing the newer half of the longest queue first if it is empty.
+func (wp *WorkerPool) takeBatch(workerID int) []*SyncJob {
+	if len(wp.queues[workerID]) == 0 {
+		victim := -1
+		for i, q := range wp.queues {
+			if len(q) > 0 && (victim < 0 || len(q) > len(wp.queues[victim])) {
+				victim = i
 			}
+		}
+		if victim < 0 {
+			return nil
+		}
+
+		q := wp.queues[victim]
+		half := len(q) / 2
+		wp.queues[workerID] = append(wp.queues[workerID], q[half:]...)
+		wp.queues[victim] = q[:half]
+	}
+
+	q := wp.queues[workerID]
+	n := 0
+	var bytes int64
+	for n < len(q) && n < smallBatchJobs && bytes < smallBatchBytes {
+		bytes += jobSize(q[n])
+		n++
+	}
 
-			// Process job
-			result := wp.processJob(ctx, workerID, job)
+	batch := make([]*SyncJob, n)
+	copy(batch, q[:n])
+	wp.queues[workerID] = q[n:]
+	return batch
+}
 
-			// Always try to send result (don't lose results due to context cancellation)
-			wp.results <- result
+// largeLimit returns how many large jobs may run at once
+func (wp *WorkerPool) largeLimit() int {
+	limit := wp.active - 1
+	if limit > maxLargeJobs {
+		limit = maxLargeJobs
+	}
+	if limit < 1 {
+		limit = 1
+	}
+	return limit
+}
+
+// wake wakes all waiting workers
+func (wp *WorkerPool) wake() {
+	// Taking the lock orders the wake-up after a worker's check and wait
+	wp.mu.Lock()
+	wp.mu.Unlock()
+	wp.cond.Broadcast()
+}
+
+// tune periodically adjusts the number of active workers to the measured
+// throughput while jobs are waiting
+func (wp *WorkerPool) tune(ctx context.Context) {
+	defer wp.wg.Done()
+
+	ticker := time.NewTicker(tuneInterval)
+	defer ticker.Stop()
+
+	tuner := &throughputTuner{min: 1, max: wp.maxWorkers, workers: wp.numWorkers, step: 1}
+	lastBytes := atomic.LoadInt64(&wp.bytesProcessed)
+	lastTime := time.Now()
+
+	for {
+		select {
+		case <-ctx.Done():
+			return
+		case <-wp.done:
+			return
+		case now := <-ticker.C:
+			bytes := atomic.LoadInt64(&wp.bytesProcessed)
+			rate := float64(bytes-lastBytes) / now.Sub(lastTime).Seconds()
+			lastBytes, lastTime = bytes, now
+
+			wp.mu.Lock()
+			if wp.queued == 0 {
+				wp.mu.Unlock()
+				continue // Nothing waiting: more workers would not help
+			}
+			previous := wp.active
+			wp.active = tuner.next(rate)
+			active := wp.active
+			wp.mu.Unlock()
+
+			if active != previous {
+				wp.logger.Debug("worker count tuned",
+					zap.Int("workers", active),
+					zap.Float64("bytes_per_sec", rate),
+				)
+				wp.cond.Broadcast()
+			}
 		}
 	}
 }
 
+// throughputTuner picks a worker count by hill climbing: it keeps stepping
+// one way while throughput improves, turns back when it drops, and holds on
+// a plateau.
+type throughputTuner struct {
+	min, max int
+	workers  int
+	step     int // +1 or -1
+	lastRate float64
+}
+
+// next returns the worker count to use after measuring rate bytes/s with
+// the current count
+func (t *throughputTuner) next(rate float64) int {
+	if rate <= 0 {
+		return t.workers // Nothing completed, nothing to compare
+	}
+
+	switch {
+	case t.lastRate == 0:
+		// First measure: probe upwards
+	case rate > t.lastRate*(1+tuneGain):
+		// Last step helped: keep going
+	case rate < t.lastRate*(1-tuneGain):
+		t.step = -t.step // Last step hurt: go back
+	default:
+		t.lastRate = rate
+		return t.workers
+	}
+	t.lastRate = rate
+
+	t.workers += t.step
+	if t.workers > t.max {
+		t.workers = t.max
+	}
+	if t.workers < t.min {
+		t.workers = t.min
+	}
+	return t.workers
+}
+
+// jobSize returns the number of bytes a job transfers
+func jobSize(job *SyncJob) int64 {
+	d := job.Decision
+	if d == nil {
+		return 0
+	}
+	if d.Action == cache.ActionUpload && d.LocalInfo != nil {
+		return d.LocalInfo.Size
+	}
+	if d.Action == cache.ActionDownload && d.RemoteInfo != nil {
+		return d.RemoteInfo.Size
+	}
+	return 0
+}
+
 // processJob processes a single job
 func (wp *WorkerPool) processJob(ctx context.Context, workerID int, job *SyncJob) *SyncJobResult {
 	wp.logger.Debug("processing job",
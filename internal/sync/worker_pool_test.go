@@ -420,3 +420,103 @@ func TestSetParallelMode(t *testing.T) {
 		t.Errorf("expected 0 workers for negative value, got %d", executor.numWorkers)
 	}
 }
+
+func sizedJob(id int, size int64) *SyncJob {
+	return &SyncJob{
+		ID: id,
+		Decision: &cache.SyncDecision{
+			LocalPath: fmt.Sprintf("file%d.bin", id),
+			Action:    cache.ActionUpload,
+			LocalInfo: &cache.FileInfo{Size: size},
+		},
+	}
+}
+
+func TestWorkerPoolLargeLane(t *testing.T) {
+	executor := NewExecutor(4, zap.NewNop())
+	pool := NewWorkerPool(4, executor, zap.NewNop())
+	ctx := context.Background()
+
+	pool.Submit(ctx, sizedJob(0, 1024))
+	pool.Submit(ctx, sizedJob(1, 100*1024*1024))
+	pool.Submit(ctx, sizedJob(2, 20*1024*1024*1024))
+	pool.Submit(ctx, sizedJob(3, 500*1024*1024))
+
+	// Largest first, at most maxLargeJobs at once
+	for i, want := range []int{2, 3} {
+		batch, large := pool.next(ctx, i)
+		if len(batch) != 1 || !large || batch[0].ID != want {
+			t.Fatalf("expected large job %d, got %d jobs (large: %v)", want, len(batch), large)
+		}
+	}
+	batch, large := pool.next(ctx, 2)
+	if len(batch) != 1 || large || batch[0].ID != 0 {
+		t.Errorf("expected the small job while the lane is full, got %d jobs (large: %v)", len(batch), large)
+	}
+}
+
+func TestWorkerPoolBatchAndSteal(t *testing.T) {
+	executor := NewExecutor(4, zap.NewNop())
+	pool := NewWorkerPool(2, executor, zap.NewNop())
+	ctx := context.Background()
+
+	// Round-robin over the 2 active workers: 20 jobs each
+	for i := 0; i < 40; i++ {
+		pool.Submit(ctx, sizedJob(i, 1024))
+	}
+
+	batch, _ := pool.next(ctx, 0)
+	if len(batch) != smallBatchJobs {
+		t.Errorf("expected a batch of %d jobs, got %d", smallBatchJobs, len(batch))
+	}
+
+	// Worker 1's queue, then stolen from worker 0: every job exactly once
+	seen := make(map[int]bool)
+	for _, job := range batch {
+		seen[job.ID] = true
+	}
+	for len(seen) < 40 {
+		batch, _ := pool.next(ctx, 1)
+		for _, job := range batch {
+			if seen[job.ID] {
+				t.Fatalf("job %d scheduled twice", job.ID)
+			}
+			seen[job.ID] = true
+		}
+	}
+
+	// Batches stop at smallBatchBytes: 4 jobs of 5 MB per queue
+	for i := 0; i < 8; i++ {
+		pool.Submit(ctx, sizedJob(100+i, 5*1024*1024))
+	}
+	if batch, _ := pool.next(ctx, 0); len(batch) != 2 {
+		t.Errorf("expected 2 jobs of 5 MB in a batch, got %d", len(batch))
+	}
+}
+
+func TestThroughputTuner(t *testing.T) {
+	tuner := &throughputTuner{min: 1, max: 8, workers: 4, step: 1}
+
+	// Throughput grows with workers: climb to the maximum
+	rate := 10.0
+	for i := 0; i < 10; i++ {
+		tuner.next(rate)
+		rate *= 1.5
+	}
+	if tuner.workers != 8 {
+		t.Errorf("expected 8 workers while throughput grows, got %d", tuner.workers)
+	}
+
+	// Throughput drops: back off
+	if n := tuner.next(rate / 2); n != 7 {
+		t.Errorf("expected 7 workers after a drop, got %d", n)
+	}
+
+	// Plateau or no measure: hold
+	if n := tuner.next(rate / 2); n != 7 {
+		t.Errorf("expected 7 workers on a plateau, got %d", n)
+	}
+	if n := tuner.next(0); n != 7 {
+		t.Errorf("expected 7 workers without a measure, got %d", n)
+	}
+}